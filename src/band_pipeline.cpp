@@ -0,0 +1,128 @@
+/**
+ * @file band_pipeline.cpp
+ * @brief Send an image to the display while it is still being decoded.
+ */
+#include "band_pipeline.h"
+
+#include <algorithm>
+
+BandPipeline::BandPipeline(LayerStack &layers, Epd &epd, int width, int height):
+    layers(layers),
+    epd(epd),
+    width(width),
+    height(height),
+    stride(width / 8)
+{
+}
+
+bool BandPipeline::begin()
+{
+#ifdef ESP8266
+    bands[0].full = bands[1].full = false;
+    send_index = 0;
+#endif
+    fill_index = 0;
+    next_row = 0;
+    times = BandPipelineTiming{};
+    started = micros();
+    running = epd.BeginFrameMemory(0, 0, width, height) == height;
+    times.send = micros() - started;
+    return running;
+}
+
+void BandPipeline::submit(int rows)
+{
+    Band &band{bands[fill_index]};
+#ifdef ESP8266
+    if (band.full)
+    {
+        // Both buffers are queued; the older must be sent first.
+        transfer(SIZE_MAX);
+    }
+#endif
+    uint32_t composing{micros()};
+    for (int row = 0; row < rows; ++row)
+    {
+        layers.compose(next_row + row, 0, stride, &band.data[row * stride]);
+    }
+    band.length = static_cast<size_t>(rows) * stride;
+    next_row += rows;
+    times.compose += micros() - composing;
+#ifdef ESP8266
+    band.sent = 0;
+    band.full = true;
+#else
+    uint32_t sending{micros()};
+#if BAND_PIPELINE_SERIAL
+    epd.WriteFrameMemory(band.data, static_cast<int>(band.length));
+#else
+    // This waits for the band before, so the buffer composed into next is free;
+    // this band is sent while the next is decoded.
+    epd.StartWriteFrameMemory(band.data, static_cast<int>(band.length));
+#endif
+    times.send += micros() - sending;
+#endif
+    fill_index ^= 1;
+#if defined(ESP8266) && BAND_PIPELINE_SERIAL
+    transfer(SIZE_MAX);
+#endif
+}
+
+void BandPipeline::rows_ready(int rows)
+{
+    if (!running)
+    {
+        return;
+    }
+    rows = std::min(rows, height);
+    while (rows - next_row >= band_rows)
+    {
+        submit(band_rows);
+    }
+#ifdef ESP8266
+    // About a row for each row decoded keeps up with the decoder.
+    transfer(stride);
+#endif
+}
+
+void BandPipeline::finish()
+{
+    if (!running)
+    {
+        return;
+    }
+    while (next_row < height)
+    {
+        submit(std::min(band_rows, height - next_row));
+    }
+#ifdef ESP8266
+    transfer(SIZE_MAX);
+#else
+    uint32_t sending{micros()};
+    epd.FinishWriteFrameMemory();
+    times.send += micros() - sending;
+#endif
+    times.total = micros() - started;
+    running = false;
+}
+
+#ifdef ESP8266
+void BandPipeline::transfer(size_t budget)
+{
+    while (budget > 0 && bands[send_index].full)
+    {
+        Band &band{bands[send_index]};
+        size_t count{std::min(budget, band.length - band.sent)};
+        uint32_t sending{micros()};
+        epd.WriteFrameMemory(&band.data[band.sent], count);
+        times.send += micros() - sending;
+        band.sent += count;
+        budget -= count;
+        if (band.sent == band.length)
+        {
+            band.full = false;
+            send_index ^= 1;
+        }
+    }
+}
+#endif
@@ -0,0 +1,124 @@
+/**
+ * @file band_pipeline.h
+ * @brief Send an image to the display while it is still being decoded.
+ *
+ * The decoder reports each row of the frame buffer as it finishes it. Every
+ * band of `band_rows` rows is composed with the other layers into one of two
+ * band buffers, and sent to the display's frame memory while the decoder goes
+ * on with the next band into the other buffer.
+ *
+ * On the ESP32 each band is sent by DMA (`Epd::StartWriteFrameMemory`), so
+ * decoding and sending can overlap. On the ESP8266 SPI writes keep the CPU
+ * busy, so nothing is gained in time; the sending is interleaved with the
+ * decoding instead: about one row is sent for each row decoded, so the network
+ * stack is never kept waiting for the whole frame to be sent.
+ *
+ * The time spent composing and in the display calls is recorded for each
+ * frame (`timing`). Building with BAND_PIPELINE_SERIAL=1 sends each band
+ * completely as soon as it is composed, so nothing overlaps; the time left
+ * over is then the decoding alone, and the time in the display calls the
+ * transfer alone, to compare with the total of the default build.
+ *
+ * Rows must be finished in order from the top, as both decoders do.
+ */
+#ifndef BAND_PIPELINE_H
+#define BAND_PIPELINE_H
+
+#include <Arduino.h>
+#include "epd/epd1in54_V2.h"
+#include "layer_stack.h"
+
+#ifndef BAND_PIPELINE_SERIAL
+#define BAND_PIPELINE_SERIAL 0  //!< 1 to send each band before decoding the next, for timing.
+#endif
+
+//!< Where the time of the last frame went, in microseconds.
+struct BandPipelineTiming
+{
+    uint32_t total;    //!< From `begin` to the end of `finish`.
+    uint32_t compose;  //!< Composing bands with the other layers.
+    uint32_t send;     //!< In the display calls, sending bands or waiting for them to be sent.
+};
+
+class BandPipeline
+{
+public:
+    static constexpr int band_rows{8};
+    static constexpr size_t max_band_bytes{band_rows * LayerStack::max_row_bytes};
+
+    /**
+     * @param layers Layers composed as they are sent; the background is decoded into.
+     * @param epd    Display.
+     * @param width  Of the frame, in pixels; a multiple of 8.
+     * @param height Of the frame, in pixels.
+     */
+    BandPipeline(LayerStack &layers, Epd &epd, int width, int height);
+
+    BandPipeline(const BandPipeline &) = delete;
+    BandPipeline &operator=(const BandPipeline &) = delete;
+
+    /**
+     * @brief Start sending a whole frame.
+     *
+     * @return false if the display refused the area.
+     */
+    bool begin();
+
+    /**
+     * @brief Record that the rows above @p rows are final.
+     */
+    void rows_ready(int rows);
+
+    /**
+     * @brief Send the rest of the frame, and wait until it has all been sent.
+     *
+     * The display is not refreshed.
+     */
+    void finish();
+
+    bool active() const
+    {
+        return running;
+    }
+
+    //!< Of the last frame, once `finish` has returned.
+    const BandPipelineTiming &timing() const
+    {
+        return times;
+    }
+
+private:
+    struct Band
+    {
+        uint8_t data[max_band_bytes];
+        size_t length;
+#ifdef ESP8266
+        size_t sent;
+        bool full;
+#endif
+    };
+
+    //!< Compose the next band into a free buffer, and queue it.
+    void submit(int rows);
+#ifdef ESP8266
+    //!< Send up to @p budget bytes of the queued bands.
+    void transfer(size_t budget);
+#endif
+
+    LayerStack &layers;
+    Epd &epd;
+    int width;
+    int height;
+    int stride;
+    Band bands[2];
+    int next_row{0};      //!< First row not yet queued.
+    size_t fill_index{0};
+#ifdef ESP8266
+    size_t send_index{0};
+#endif
+    bool running{false};
+    uint32_t started{0};
+    BandPipelineTiming times{};
+};
+
+#endif
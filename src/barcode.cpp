@@ -0,0 +1,645 @@
+/**
+ * @file barcode.cpp
+ * @brief Code 128, EAN-13 and Data Matrix barcodes.
+ */
+#include "barcode.h"
+
+#include <algorithm>
+#include "bitblit.h"
+
+namespace
+{
+    //!< Bar and space widths of the Code 128 symbols, one hex digit each, bar first.
+    const uint32_t code128_patterns[] PROGMEM = {
+        0x212222, 0x222122, 0x222221, 0x121223, 0x121322, 0x131222, 0x122213, 0x122312, 0x132212, 0x221213,
+        0x221312, 0x231212, 0x112232, 0x122132, 0x122231, 0x113222, 0x123122, 0x123221, 0x223211, 0x221132,
+        0x221231, 0x213212, 0x223112, 0x312131, 0x311222, 0x321122, 0x321221, 0x312212, 0x322112, 0x322211,
+        0x212123, 0x212321, 0x232121, 0x111323, 0x131123, 0x131321, 0x112313, 0x132113, 0x132311, 0x211313,
+        0x231113, 0x231311, 0x112133, 0x112331, 0x132131, 0x113123, 0x113321, 0x133121, 0x313121, 0x211331,
+        0x231131, 0x213113, 0x213311, 0x213131, 0x311123, 0x311321, 0x331121, 0x312113, 0x312311, 0x332111,
+        0x314111, 0x221411, 0x431111, 0x111224, 0x111422, 0x121124, 0x121421, 0x141122, 0x141221, 0x112214,
+        0x112412, 0x122114, 0x122411, 0x142112, 0x142211, 0x241211, 0x221114, 0x413111, 0x241112, 0x134111,
+        0x111242, 0x121142, 0x121241, 0x114212, 0x124112, 0x124211, 0x411212, 0x421112, 0x421211, 0x212141,
+        0x214121, 0x412121, 0x111143, 0x111341, 0x131141, 0x114113, 0x114311, 0x411113, 0x411311, 0x113141,
+        0x114131, 0x311141, 0x411131, 0x211412, 0x211214, 0x211232,
+    };
+    constexpr uint32_t code128_stop{0x2331112};
+    constexpr uint8_t code128_code_b{100};
+    constexpr uint8_t code128_code_c{99};
+    constexpr uint8_t code128_start_b{104};
+    constexpr uint8_t code128_start_c{105};
+    constexpr int code128_max_symbols{64};
+
+    //!< EAN-13 left-hand odd parity ("L") digit patterns; "R" is the complement and "G" the reversed "R".
+    constexpr uint8_t ean_l_patterns[10]{0x0D, 0x19, 0x13, 0x3D, 0x23, 0x31, 0x2F, 0x3B, 0x37, 0x0B};
+    //!< Which of the six left-hand digits use "G", by first digit; most significant bit first.
+    constexpr uint8_t ean_parity[10]{0x00, 0x0B, 0x0D, 0x0E, 0x13, 0x19, 0x1C, 0x15, 0x16, 0x1A};
+
+    struct MatrixSize
+    {
+        uint8_t size;
+        uint8_t region;
+        uint8_t data;
+        uint8_t ecc;
+    };
+
+    //!< Square ECC 200 symbols with a single Reed-Solomon block.
+    constexpr MatrixSize matrix_sizes[]{
+        {10, 8, 3, 5}, {12, 10, 5, 7}, {14, 12, 8, 10}, {16, 14, 12, 12}, {18, 16, 18, 14},
+        {20, 18, 22, 18}, {22, 20, 30, 20}, {24, 22, 36, 24}, {26, 24, 44, 28}, {32, 14, 62, 36},
+        {36, 16, 86, 42}, {40, 18, 114, 48}, {44, 20, 144, 56}, {48, 22, 174, 68},
+    };
+    constexpr int max_mapping{44};
+    constexpr int max_matrix_codewords{174 + 68};
+
+    //!< Work buffers for Data Matrix placement.
+    uint8_t matrix_codewords[max_matrix_codewords];
+    uint8_t mapping_placed[max_mapping * max_mapping / 8];
+    uint8_t mapping_dark[max_mapping * max_mapping / 8];
+
+    uint8_t gf_multiply(uint8_t x, uint8_t y)
+    {
+        // Multiplication in GF(2^8) modulo x^8 + x^5 + x^3 + x^2 + 1, as Data Matrix uses.
+        uint8_t z{0};
+        for (int i = 7; i >= 0; --i)
+        {
+            z = static_cast<uint8_t>((z << 1) ^ ((z >> 7) * 0x2D));
+            z ^= ((y >> i) & 1) * x;
+        }
+        return z;
+    }
+
+    /**
+     * @brief Append the Reed-Solomon check codewords to the data codewords.
+     */
+    void matrix_error_correction(uint8_t *codewords, int data_length, int ecc_length)
+    {
+        // Generator with roots alpha^1 to alpha^n, highest power first, leading 1 omitted.
+        uint8_t divisor[68]{};
+        divisor[ecc_length - 1] = 1;
+        uint8_t root{2};
+        for (int i = 0; i < ecc_length; ++i)
+        {
+            for (int j = 0; j < ecc_length; ++j)
+            {
+                divisor[j] = gf_multiply(divisor[j], root);
+                if (j + 1 < ecc_length)
+                {
+                    divisor[j] ^= divisor[j + 1];
+                }
+            }
+            root = gf_multiply(root, 0x02);
+        }
+
+        uint8_t *remainder{&codewords[data_length]};
+        memset(remainder, 0, ecc_length);
+        for (int i = 0; i < data_length; ++i)
+        {
+            uint8_t factor{static_cast<uint8_t>(codewords[i] ^ remainder[0])};
+            memmove(remainder, remainder + 1, ecc_length - 1);
+            remainder[ecc_length - 1] = 0;
+            for (int j = 0; j < ecc_length; ++j)
+            {
+                remainder[j] ^= gf_multiply(divisor[j], factor);
+            }
+        }
+    }
+
+    /**
+     * @brief ECC 200 codeword placement in the mapping matrix (ISO/IEC 16022 annex F).
+     */
+    class MatrixPlacement
+    {
+    public:
+        MatrixPlacement(const uint8_t *codewords, int size) : codewords(codewords), rows(size), columns(size)
+        {
+            memset(mapping_placed, 0, sizeof(mapping_placed));
+            memset(mapping_dark, 0, sizeof(mapping_dark));
+        }
+
+        void run()
+        {
+            int codeword{0};
+            int row{4};
+            int column{0};
+            do
+            {
+                if (row == rows && column == 0)
+                {
+                    corner(codeword++, corner1);
+                }
+                if (row == rows - 2 && column == 0 && columns % 4 != 0)
+                {
+                    corner(codeword++, corner2);
+                }
+                if (row == rows - 2 && column == 0 && columns % 8 == 4)
+                {
+                    corner(codeword++, corner3);
+                }
+                if (row == rows + 4 && column == 2 && columns % 8 == 0)
+                {
+                    corner(codeword++, corner4);
+                }
+                // Up and to the right...
+                do
+                {
+                    if (row < rows && column >= 0 && !placed(row, column))
+                    {
+                        utah(row, column, codeword++);
+                    }
+                    row -= 2;
+                    column += 2;
+                } while (row >= 0 && column < columns);
+                row += 1;
+                column += 3;
+                // ...then down and to the left.
+                do
+                {
+                    if (row >= 0 && column < columns && !placed(row, column))
+                    {
+                        utah(row, column, codeword++);
+                    }
+                    row += 2;
+                    column -= 2;
+                } while (row < rows && column >= 0);
+                row += 3;
+                column += 1;
+            } while (row < rows || column < columns);
+
+            if (!placed(rows - 1, columns - 1))
+            {
+                // Fixed pattern in the otherwise unused bottom right corner.
+                set(rows - 1, columns - 1, true);
+                set(rows - 2, columns - 2, true);
+            }
+        }
+
+        static bool dark(int row, int column, int size)
+        {
+            int offset{row * size + column};
+            return (mapping_dark[offset >> 3] & (0x80 >> (offset & 7))) != 0;
+        }
+
+    private:
+        //!< Module positions of the eight bits of each corner case, most significant bit first;
+        //!< negative values count from the last row or column.
+        static constexpr int8_t corner1[8][2]{{-1, 0}, {-1, 1}, {-1, 2}, {0, -2}, {0, -1}, {1, -1}, {2, -1}, {3, -1}};
+        static constexpr int8_t corner2[8][2]{{-3, 0}, {-2, 0}, {-1, 0}, {0, -4}, {0, -3}, {0, -2}, {0, -1}, {1, -1}};
+        static constexpr int8_t corner3[8][2]{{-3, 0}, {-2, 0}, {-1, 0}, {0, -2}, {0, -1}, {1, -1}, {2, -1}, {3, -1}};
+        static constexpr int8_t corner4[8][2]{{-1, 0}, {-1, -1}, {0, -3}, {0, -2}, {0, -1}, {1, -3}, {1, -2}, {1, -1}};
+
+        bool placed(int row, int column) const
+        {
+            int offset{row * columns + column};
+            return (mapping_placed[offset >> 3] & (0x80 >> (offset & 7))) != 0;
+        }
+
+        void set(int row, int column, bool is_dark)
+        {
+            int offset{row * columns + column};
+            mapping_placed[offset >> 3] |= 0x80 >> (offset & 7);
+            if (is_dark)
+            {
+                mapping_dark[offset >> 3] |= 0x80 >> (offset & 7);
+            }
+        }
+
+        void module(int row, int column, int codeword, int bit)
+        {
+            if (row < 0)
+            {
+                row += rows;
+                column += 4 - ((rows + 4) % 8);
+            }
+            if (column < 0)
+            {
+                column += columns;
+                row += 4 - ((columns + 4) % 8);
+            }
+            set(row, column, ((codewords[codeword] >> (7 - bit)) & 1) != 0);
+        }
+
+        void utah(int row, int column, int codeword)
+        {
+            module(row - 2, column - 2, codeword, 0);
+            module(row - 2, column - 1, codeword, 1);
+            module(row - 1, column - 2, codeword, 2);
+            module(row - 1, column - 1, codeword, 3);
+            module(row - 1, column, codeword, 4);
+            module(row, column - 2, codeword, 5);
+            module(row, column - 1, codeword, 6);
+            module(row, column, codeword, 7);
+        }
+
+        void corner(int codeword, const int8_t (&positions)[8][2])
+        {
+            for (int bit = 0; bit < 8; ++bit)
+            {
+                int row{positions[bit][0] < 0 ? rows + positions[bit][0] : positions[bit][0]};
+                int column{positions[bit][1] < 0 ? columns + positions[bit][1] : positions[bit][1]};
+                module(row, column, codeword, bit);
+            }
+        }
+
+        const uint8_t *codewords;
+        int rows;
+        int columns;
+    };
+
+    constexpr int8_t MatrixPlacement::corner1[8][2];
+    constexpr int8_t MatrixPlacement::corner2[8][2];
+    constexpr int8_t MatrixPlacement::corner3[8][2];
+    constexpr int8_t MatrixPlacement::corner4[8][2];
+
+    bool is_digit(char c)
+    {
+        return c >= '0' && c <= '9';
+    }
+
+    int digits_at(const char *text)
+    {
+        int count{0};
+        while (is_digit(text[count]))
+        {
+            ++count;
+        }
+        return count;
+    }
+}
+
+bool Barcode::parse_type(const String &name, BarcodeType &barcode_type)
+{
+    if (name == "code128")
+    {
+        barcode_type = BarcodeType::code128;
+    }
+    else if (name == "ean13")
+    {
+        barcode_type = BarcodeType::ean13;
+    }
+    else if (name == "datamatrix")
+    {
+        barcode_type = BarcodeType::datamatrix;
+    }
+    else
+    {
+        return false;
+    }
+    return true;
+}
+
+int Barcode::quiet_zone() const
+{
+    switch (symbology)
+    {
+    case BarcodeType::code128:
+        return 10;
+    case BarcodeType::ean13:
+        return 11;
+    default:
+        return 1;
+    }
+}
+
+bool Barcode::encode(BarcodeType barcode_type, const char *text)
+{
+    switch (barcode_type)
+    {
+    case BarcodeType::code128:
+        return encode_code128(text);
+    case BarcodeType::ean13:
+        return encode_ean13(text);
+    default:
+        return encode_datamatrix(text);
+    }
+}
+
+void Barcode::reset(BarcodeType barcode_type, int width, int height)
+{
+    symbology = barcode_type;
+    symbol_width = width;
+    symbol_height = height;
+    position = 0;
+    run_dark = true;
+    memset(modules, 0, sizeof(modules));
+}
+
+void Barcode::set_module(int x, int y, bool dark)
+{
+    uint32_t offset{static_cast<uint32_t>(y) * symbol_width + x};
+    if (dark)
+    {
+        modules[offset >> 3] |= 0x80 >> (offset & 7);
+    }
+}
+
+bool Barcode::append_run(bool dark, int count)
+{
+    if (position + count > max_modules_bytes * 8)
+    {
+        return false;
+    }
+    if (dark)
+    {
+        bitblit_fill(modules, position, position + count, true);
+    }
+    position += count;
+    return true;
+}
+
+/**
+ * @brief Append alternating bars and spaces, continuing from the last run.
+ *
+ * @param widths Widths, one hex digit each, first run in the most significant digit.
+ * @param count  Number of runs.
+ */
+void Barcode::append_widths(uint32_t widths, int count)
+{
+    for (int i = count - 1; i >= 0; --i)
+    {
+        append_run(run_dark, (widths >> (4 * i)) & 0xF);
+        run_dark = !run_dark;
+    }
+}
+
+bool Barcode::encode_code128(const char *text)
+{
+    uint8_t values[code128_max_symbols];
+    int count{0};
+    int length{static_cast<int>(strlen(text))};
+    if (length == 0)
+    {
+        return false;
+    }
+
+    // Code set C packs two digits per symbol; it is worth switching to for
+    // four digits at the start or end, or six in the middle.
+    int leading_digits{digits_at(text)};
+    bool set_c{leading_digits >= 4 || (leading_digits == 2 && length == 2)};
+    values[count++] = set_c ? code128_start_c : code128_start_b;
+    for (int i = 0; i < length;)
+    {
+        if (count + 3 > code128_max_symbols)
+        {
+            // No room for this symbol, a switch, the check symbol.
+            return false;
+        }
+        int digits{digits_at(&text[i])};
+        if (set_c)
+        {
+            if (digits >= 2)
+            {
+                values[count++] = static_cast<uint8_t>((text[i] - '0') * 10 + (text[i + 1] - '0'));
+                i += 2;
+            }
+            else
+            {
+                values[count++] = code128_code_b;
+                set_c = false;
+            }
+        }
+        else if (digits >= 6 || (digits >= 4 && i + digits == length))
+        {
+            if (digits % 2 != 0)
+            {
+                // Odd digit out in code set B, so the rest pair up.
+                values[count++] = static_cast<uint8_t>(text[i++] - ' ');
+            }
+            values[count++] = code128_code_c;
+            set_c = true;
+        }
+        else
+        {
+            uint8_t c{static_cast<uint8_t>(text[i++])};
+            if (c < ' ' || c > 127)
+            {
+                return false;
+            }
+            values[count++] = c - ' ';
+        }
+    }
+
+    uint32_t checksum{values[0]};
+    for (int i = 1; i < count; ++i)
+    {
+        checksum += static_cast<uint32_t>(values[i]) * i;
+    }
+    values[count++] = checksum % 103;
+
+    reset(BarcodeType::code128, count * 11 + 13, 1);
+    for (int i = 0; i < count; ++i)
+    {
+        append_widths(pgm_read_dword(&code128_patterns[values[i]]), 6);
+    }
+    append_widths(code128_stop, 7);
+    return true;
+}
+
+bool Barcode::encode_ean13(const char *text)
+{
+    int length{static_cast<int>(strlen(text))};
+    if ((length != 12 && length != 13) || digits_at(text) != length)
+    {
+        return false;
+    }
+    uint8_t digits[13];
+    int sum{0};
+    for (int i = 0; i < 12; ++i)
+    {
+        digits[i] = text[i] - '0';
+        sum += digits[i] * (i % 2 == 0 ? 1 : 3);
+    }
+    digits[12] = (10 - sum % 10) % 10;
+    if (length == 13 && text[12] - '0' != digits[12])
+    {
+        return false;
+    }
+
+    reset(BarcodeType::ean13, 95, 1);
+    // Each digit is seven modules; the patterns are written as module bits.
+    auto append_bits = [this](uint8_t bits, int count)
+    {
+        for (int i = count - 1; i >= 0; --i)
+        {
+            append_run(((bits >> i) & 1) != 0, 1);
+        }
+    };
+    append_bits(0x5, 3);
+    for (int i = 1; i <= 6; ++i)
+    {
+        uint8_t pattern{ean_l_patterns[digits[i]]};
+        if ((ean_parity[digits[0]] >> (6 - i)) & 1)
+        {
+            // "G": the "R" pattern reversed.
+            uint8_t reversed{0};
+            for (int bit = 0; bit < 7; ++bit)
+            {
+                reversed = static_cast<uint8_t>((reversed << 1) | (((~pattern) >> bit) & 1));
+            }
+            pattern = reversed;
+        }
+        append_bits(pattern, 7);
+    }
+    append_bits(0x0A, 5);
+    for (int i = 7; i <= 12; ++i)
+    {
+        append_bits(static_cast<uint8_t>(~ean_l_patterns[digits[i]]), 7);
+    }
+    append_bits(0x5, 3);
+    return true;
+}
+
+bool Barcode::encode_datamatrix(const char *text)
+{
+    // ASCII encodation: digit pairs in one codeword, extended characters shifted.
+    int count{0};
+    for (const char *c = text; *c != '\0';)
+    {
+        if (count + 2 > max_matrix_codewords)
+        {
+            return false;
+        }
+        uint8_t value{static_cast<uint8_t>(*c)};
+        if (is_digit(c[0]) && is_digit(c[1]))
+        {
+            matrix_codewords[count++] = static_cast<uint8_t>(130 + (c[0] - '0') * 10 + (c[1] - '0'));
+            c += 2;
+            continue;
+        }
+        if (value >= 128)
+        {
+            matrix_codewords[count++] = 235;
+            value -= 128;
+        }
+        matrix_codewords[count++] = value + 1;
+        ++c;
+    }
+
+    const MatrixSize *chosen{nullptr};
+    for (auto &size : matrix_sizes)
+    {
+        if (size.data >= count)
+        {
+            chosen = &size;
+            break;
+        }
+    }
+    if (chosen == nullptr)
+    {
+        return false;
+    }
+
+    // Pad with 129, then with the 253-state randomised pad value.
+    for (int first_pad = count; count < chosen->data; ++count)
+    {
+        int pad{129 + (149 * (count + 1)) % 253 + 1};
+        matrix_codewords[count] = static_cast<uint8_t>(count == first_pad ? 129 : pad > 254 ? pad - 254 : pad);
+    }
+    matrix_error_correction(matrix_codewords, chosen->data, chosen->ecc);
+
+    int regions{chosen->size / (chosen->region + 2)};
+    int mapping_size{regions * chosen->region};
+    MatrixPlacement(matrix_codewords, mapping_size).run();
+
+    // Each data region has a solid "L" on its left and bottom edges, and
+    // alternating modules along its top and right edges.
+    reset(BarcodeType::datamatrix, chosen->size, chosen->size);
+    int block{chosen->region + 2};
+    for (int y = 0; y < chosen->size; ++y)
+    {
+        int region_y{y % block};
+        for (int x = 0; x < chosen->size; ++x)
+        {
+            int region_x{x % block};
+            bool dark;
+            if (region_y == block - 1 || region_x == 0)
+            {
+                dark = true;
+            }
+            else if (region_y == 0)
+            {
+                dark = region_x % 2 == 0;
+            }
+            else if (region_x == block - 1)
+            {
+                dark = region_y % 2 != 0;
+            }
+            else
+            {
+                dark = MatrixPlacement::dark(y / block * chosen->region + region_y - 1, x / block * chosen->region + region_x - 1, mapping_size);
+            }
+            set_module(x, y, dark);
+        }
+    }
+    return true;
+}
+
+int barcode_fit_scale(const Barcode &barcode, int width, int height)
+{
+    int quiet_zone{barcode.quiet_zone()};
+    int scale{width / (barcode.width() + 2 * quiet_zone)};
+    if (!barcode.linear())
+    {
+        scale = std::min(scale, height / (barcode.height() + 2 * quiet_zone));
+    }
+    return scale;
+}
+
+void barcode_render(Paint &paint, const Barcode &barcode, int x, int y, int scale, int bar_height)
+{
+    if (scale < 1 || x < 0 || y < 0 || x >= paint.GetWidth())
+    {
+        return;
+    }
+    int rows{barcode.linear() ? 1 : barcode.height()};
+    int row_height{barcode.linear() ? bar_height : scale};
+    int right{std::min(x + barcode.width() * scale, paint.GetWidth())};
+    int stride{paint.GetWidth() / 8};
+    uint8_t *image{paint.GetImage()};
+
+    for (int module_y = 0; module_y < rows; ++module_y)
+    {
+        int pixel_y{y + module_y * row_height};
+        if (pixel_y >= paint.GetHeight())
+        {
+            break;
+        }
+        int last_y{std::min(pixel_y + row_height, paint.GetHeight())};
+
+        // One pixel row, a run of like modules at a time.
+        uint8_t *first{&image[pixel_y * stride]};
+        for (int module_x = 0; module_x < barcode.width();)
+        {
+            bool dark{barcode.module(module_x, module_y)};
+            int end{module_x + 1};
+            while (end < barcode.width() && barcode.module(end, module_y) == dark)
+            {
+                ++end;
+            }
+            int x0{x + module_x * scale};
+            int x1{std::min(x + end * scale, right)};
+            if (paint.GetRotate() != ROTATE_0)
+            {
+                // Byte spans assume an unrotated frame buffer.
+                if (x0 < x1)
+                {
+                    paint.DrawFilledRectangle(x0, pixel_y, x1 - 1, last_y - 1, dark ? 0 /* black */ : 1 /* white */);
+                }
+            }
+            else
+            {
+                // Dark modules are black, i.e. clear bits.
+                bitblit_fill(first, x0, x1, !dark);
+            }
+            module_x = end;
+        }
+        if (paint.GetRotate() != ROTATE_0)
+        {
+            continue;
+        }
+        for (int copy_y = pixel_y + 1; copy_y < last_y; ++copy_y)
+        {
+            bitblit_copy_span(&image[copy_y * stride], first, x, right);
+        }
+    }
+}
@@ -0,0 +1,127 @@
+/**
+ * @file barcode.h
+ * @brief Code 128, EAN-13 and Data Matrix barcodes.
+ *
+ * The encoders build the symbol as runs of light and dark modules in a packed
+ * module bitmap; `barcode_render` writes each run of a row into the frame
+ * buffer as a byte span, so there is no per-module drawing. Symbols are small
+ * and quick to encode, so they are regenerated on every request.
+ */
+#ifndef BARCODE_H
+#define BARCODE_H
+
+#include <Arduino.h>
+#include "epd/epdpaint.h"
+
+enum class BarcodeType : uint8_t
+{
+    code128,
+    ean13,
+    datamatrix
+};
+
+class Barcode
+{
+public:
+    //!< Largest Data Matrix symbol supported; larger ones need interleaved blocks.
+    static constexpr int max_matrix_size{48};
+
+    /**
+     * @brief Encode a text.
+     *
+     * - Code 128 accepts printable ASCII, and uses code set C for runs of digits.
+     * - EAN-13 accepts 12 digits, or 13 digits with a correct check digit.
+     * - Data Matrix (ECC 200, square symbols up to 48x48) accepts any bytes; the
+     *   smallest symbol that holds the text is used.
+     *
+     * @param barcode_type Symbology.
+     * @param text         Text to encode.
+     * @return true if the text was encoded; false if it is invalid or too long.
+     */
+    bool encode(BarcodeType barcode_type, const char *text);
+
+    BarcodeType type() const
+    {
+        return symbology;
+    }
+
+    /**
+     * @brief Whether the symbol is a single row of bars.
+     */
+    bool linear() const
+    {
+        return symbology != BarcodeType::datamatrix;
+    }
+
+    //!< Width, in modules, excluding the quiet zone.
+    int width() const
+    {
+        return symbol_width;
+    }
+
+    //!< Height, in modules; 1 for linear symbols.
+    int height() const
+    {
+        return symbol_height;
+    }
+
+    //!< Quiet zone required on each side, in modules.
+    int quiet_zone() const;
+
+    bool module(int x, int y) const
+    {
+        uint32_t offset{static_cast<uint32_t>(y) * symbol_width + x};
+        return (modules[offset >> 3] & (0x80 >> (offset & 7))) != 0;
+    }
+
+    /**
+     * @brief Parse a symbology name: "code128", "ean13" or "datamatrix".
+     *
+     * @return true if the name is known.
+     */
+    static bool parse_type(const String &name, BarcodeType &barcode_type);
+
+private:
+    static constexpr size_t max_modules_bytes{max_matrix_size * max_matrix_size / 8};
+
+    void reset(BarcodeType barcode_type, int width, int height);
+    bool append_run(bool dark, int count);
+    void append_widths(uint32_t widths, int count);
+    bool encode_code128(const char *text);
+    bool encode_ean13(const char *text);
+    bool encode_datamatrix(const char *text);
+    void set_module(int x, int y, bool dark);
+
+    BarcodeType symbology{BarcodeType::code128};
+    int symbol_width{0};
+    int symbol_height{0};
+    uint32_t position{0};
+    bool run_dark{true};
+    uint8_t modules[max_modules_bytes]{};
+};
+
+/**
+ * @brief Largest integer scale at which a barcode, with its quiet zone, fits an area.
+ *
+ * Linear symbols only need to fit the width.
+ *
+ * @return The scale, or 0 if the symbol does not fit.
+ */
+int barcode_fit_scale(const Barcode &barcode, int width, int height);
+
+/**
+ * @brief Draw a barcode into a paint.
+ *
+ * Light modules are drawn white, so the area need not be cleared first. The
+ * symbol is clipped to the paint.
+ *
+ * @param paint      Destination.
+ * @param barcode    Encoded symbol.
+ * @param x          Left edge, in pixels.
+ * @param y          Top edge, in pixels.
+ * @param scale      Size of a module, in pixels.
+ * @param bar_height Height of the bars of a linear symbol, in pixels; ignored for 2-D symbols.
+ */
+void barcode_render(Paint &paint, const Barcode &barcode, int x, int y, int scale, int bar_height);
+
+#endif
@@ -0,0 +1,7 @@
+/**
+ * @file bit_expansion.cpp
+ * @brief Tables that scale 1 bit per pixel rows horizontally by an integer factor.
+ */
+#include "bit_expansion.h"
+
+constexpr BitExpansionTable bit_expansion_table PROGMEM{};
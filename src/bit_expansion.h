@@ -0,0 +1,55 @@
+/**
+ * @file bit_expansion.h
+ * @brief Tables that scale 1 bit per pixel rows horizontally by an integer factor.
+ *
+ * Each entry expands four pixels (a nibble, most significant bit first) into
+ * those pixels each repeated `scale` times, left aligned in 32 bits; a row of
+ * any width is scaled one nibble at a time. The tables are computed at
+ * compile time, and live in flash.
+ */
+#ifndef BIT_EXPANSION_H
+#define BIT_EXPANSION_H
+
+#include <Arduino.h>
+
+//!< Largest scale in the tables; four pixels must fit in 32 bits.
+static constexpr int bit_expansion_max_scale{8};
+
+struct BitExpansionTable
+{
+    uint32_t entries[bit_expansion_max_scale][16];
+
+    constexpr BitExpansionTable():
+        entries{}
+    {
+        for (int scale = 1; scale <= bit_expansion_max_scale; ++scale)
+        {
+            uint32_t pixel_bits{(1u << scale) - 1};
+            for (uint32_t nibble = 0; nibble < 16; ++nibble)
+            {
+                uint32_t bits{0};
+                for (int pixel = 0; pixel < 4; ++pixel)
+                {
+                    bits = (bits << scale) | ((nibble & (8u >> pixel)) != 0 ? pixel_bits : 0);
+                }
+                entries[scale - 1][nibble] = 4 * scale == 32 ? bits : bits << (32 - 4 * scale);
+            }
+        }
+    }
+};
+
+extern const BitExpansionTable bit_expansion_table;
+
+/**
+ * @brief Expand four pixels.
+ *
+ * @param scale  Scale, 1 to `bit_expansion_max_scale`.
+ * @param nibble Four pixels, most significant bit first.
+ * @return The 4 * scale pixels, left aligned.
+ */
+static inline uint32_t bit_expansion(int scale, uint8_t nibble)
+{
+    return pgm_read_dword(&bit_expansion_table.entries[scale - 1][nibble & 0x0F]);
+}
+
+#endif
@@ -0,0 +1,235 @@
+/**
+ * @file bitblit.h
+ * @brief Byte-span operations on 1 bit per pixel frame buffer rows.
+ *
+ * The layout is that of `Paint`: the most significant bit of a byte is the
+ * leftmost pixel, and a set bit is white. These work a byte at a time (or
+ * `memset`/`memcpy` for the whole bytes in a span) instead of a pixel at a time.
+ * All ranges are half-open: [x0, x1).
+ */
+#ifndef BITBLIT_H
+#define BITBLIT_H
+
+#include <stdint.h>
+#include <string.h>
+
+/**
+ * @brief Mask of the bits at and to the right of pixel @p x within its byte.
+ */
+static inline uint8_t bitblit_head_mask(int x)
+{
+    return static_cast<uint8_t>(0xFFu >> (x & 7));
+}
+
+/**
+ * @brief Mask of the bits to the left of pixel @p x within its byte.
+ */
+static inline uint8_t bitblit_tail_mask(int x)
+{
+    return static_cast<uint8_t>(~(0xFFu >> (x & 7)));
+}
+
+/**
+ * @brief Set or clear the pixels [x0, x1) of a row.
+ *
+ * @param row Start of the row.
+ * @param x0  First pixel.
+ * @param x1  One past the last pixel.
+ * @param set true to set the bits (white), false to clear them (black).
+ */
+static inline void bitblit_fill(uint8_t *row, int x0, int x1, bool set)
+{
+    if (x0 >= x1)
+    {
+        return;
+    }
+    int first{x0 >> 3};
+    int last{(x1 - 1) >> 3};
+    uint8_t head{bitblit_head_mask(x0)};
+    uint8_t tail{static_cast<uint8_t>((x1 & 7) == 0 ? 0xFF : bitblit_tail_mask(x1))};
+    if (first == last)
+    {
+        uint8_t mask{static_cast<uint8_t>(head & tail)};
+        row[first] = set ? (row[first] | mask) : (row[first] & ~mask);
+        return;
+    }
+    row[first] = set ? (row[first] | head) : (row[first] & ~head);
+    memset(&row[first + 1], set ? 0xFF : 0x00, last - first - 1);
+    row[last] = set ? (row[last] | tail) : (row[last] & ~tail);
+}
+
+/**
+ * @brief Set or clear the pixels [x0, x1) of a row where a repeating byte pattern has set bits.
+ *
+ * @param row     Start of the row.
+ * @param x0      First pixel.
+ * @param x1      One past the last pixel.
+ * @param pattern Bits to change in each byte of the row; pixels of clear bits are left as they are.
+ * @param set     true to set the bits (white), false to clear them (black).
+ */
+static inline void bitblit_fill_pattern(uint8_t *row, int x0, int x1, uint8_t pattern, bool set)
+{
+    if (x0 >= x1)
+    {
+        return;
+    }
+    int first{x0 >> 3};
+    int last{(x1 - 1) >> 3};
+    uint8_t head{static_cast<uint8_t>(bitblit_head_mask(x0) & pattern)};
+    uint8_t tail{static_cast<uint8_t>(((x1 & 7) == 0 ? 0xFF : bitblit_tail_mask(x1)) & pattern)};
+    if (first == last)
+    {
+        uint8_t mask{static_cast<uint8_t>(head & tail)};
+        row[first] = set ? (row[first] | mask) : (row[first] & ~mask);
+        return;
+    }
+    if (set)
+    {
+        row[first] |= head;
+        for (int i = first + 1; i < last; ++i)
+        {
+            row[i] |= pattern;
+        }
+        row[last] |= tail;
+    }
+    else
+    {
+        uint8_t clear{static_cast<uint8_t>(~pattern)};
+        row[first] &= ~head;
+        for (int i = first + 1; i < last; ++i)
+        {
+            row[i] &= clear;
+        }
+        row[last] &= ~tail;
+    }
+}
+
+/**
+ * @brief Copy the pixels [x0, x1) from one row to another at the same position.
+ *
+ * Whole bytes are copied with `memcpy`; only the edge bytes are masked.
+ *
+ * @param destination Destination row.
+ * @param source      Source row.
+ * @param x0          First pixel.
+ * @param x1          One past the last pixel.
+ */
+static inline void bitblit_copy_span(uint8_t *destination, const uint8_t *source, int x0, int x1)
+{
+    if (x0 >= x1)
+    {
+        return;
+    }
+    int first{x0 >> 3};
+    int last{(x1 - 1) >> 3};
+    uint8_t head{bitblit_head_mask(x0)};
+    uint8_t tail{static_cast<uint8_t>((x1 & 7) == 0 ? 0xFF : bitblit_tail_mask(x1))};
+    if (first == last)
+    {
+        uint8_t mask{static_cast<uint8_t>(head & tail)};
+        destination[first] = (destination[first] & ~mask) | (source[first] & mask);
+        return;
+    }
+    destination[first] = (destination[first] & ~head) | (source[first] & head);
+    memcpy(&destination[first + 1], &source[first + 1], last - first - 1);
+    destination[last] = (destination[last] & ~tail) | (source[last] & tail);
+}
+
+/**
+ * @brief Copy a run of bits, starting at bit 0 of @p source, to pixel @p x of a row.
+ *
+ * @param row        Destination row.
+ * @param x          First destination pixel.
+ * @param source     Source bits, most significant first.
+ * @param bit_count  Number of bits to copy.
+ */
+static inline void bitblit_copy_bits(uint8_t *row, int x, const uint8_t *source, int bit_count)
+{
+    if (bit_count <= 0)
+    {
+        return;
+    }
+    int shift{x & 7};
+    uint8_t *destination{&row[x >> 3]};
+    int end{x + bit_count};
+    if (shift == 0)
+    {
+        int whole{bit_count >> 3};
+        memcpy(destination, source, whole);
+        if ((bit_count & 7) != 0)
+        {
+            uint8_t mask{bitblit_tail_mask(bit_count)};
+            destination[whole] = (destination[whole] & ~mask) | (source[whole] & mask);
+        }
+        return;
+    }
+
+    // Each source byte straddles two destination bytes.
+    int x_pos{x};
+    for (int i = 0; x_pos < end; ++i, x_pos += 8)
+    {
+        uint16_t bits{static_cast<uint16_t>(source[i] << (8 - shift))};
+        uint16_t mask{static_cast<uint16_t>(0xFF00u >> shift)};
+        if (end - x_pos < 8)
+        {
+            // Partial last source byte.
+            mask &= static_cast<uint16_t>(0xFFFFu << (16 - shift - (end - x_pos)));
+        }
+        uint8_t *out{&destination[i]};
+        out[0] = (out[0] & ~(mask >> 8)) | ((bits >> 8) & (mask >> 8));
+        if ((mask & 0xFF) != 0)
+        {
+            out[1] = (out[1] & ~(mask & 0xFF)) | (bits & mask & 0xFF);
+        }
+    }
+}
+
+/**
+ * @brief Merge the set bits of a run, starting at bit 0 of @p source, into a row at pixel @p x.
+ *
+ * Pixels of clear source bits are left as they are, as for drawn text.
+ *
+ * @param row        Destination row.
+ * @param x          First destination pixel.
+ * @param source     Source bits, most significant first.
+ * @param bit_count  Number of bits to merge.
+ * @param set        true to set the destination bits (white), false to clear them (black).
+ */
+static inline void bitblit_merge_bits(uint8_t *row, int x, const uint8_t *source, int bit_count, bool set)
+{
+    int shift{x & 7};
+    uint8_t *destination{&row[x >> 3]};
+    int bytes{(bit_count + 7) >> 3};
+    for (int i = 0; i < bytes; ++i)
+    {
+        uint8_t bits{source[i]};
+        if (i == bytes - 1 && (bit_count & 7) != 0)
+        {
+            bits &= bitblit_tail_mask(bit_count);
+        }
+        if (bits == 0)
+        {
+            continue;
+        }
+        uint8_t first{static_cast<uint8_t>(bits >> shift)};
+        uint8_t second{static_cast<uint8_t>(shift == 0 ? 0 : bits << (8 - shift))};
+        if (set)
+        {
+            destination[i] |= first;
+            if (second != 0)
+            {
+                destination[i + 1] |= second;
+            }
+        }
+        else
+        {
+            destination[i] &= ~first;
+            if (second != 0)
+            {
+                destination[i + 1] &= ~second;
+            }
+        }
+    }
+}
+
+#endif
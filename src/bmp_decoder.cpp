@@ -0,0 +1,178 @@
+/**
+ * @file bmp_decoder.cpp
+ * @brief Decode a 24 or 1 bit per pixel BMP into a paint, a row at a time.
+ */
+#include "bmp_decoder.h"
+
+#include <algorithm>
+
+namespace
+{
+    constexpr int black{0};
+    constexpr int white{1};
+}
+
+bool BmpDecoder::begin(Paint &paint, const char *filename, int left, int top)
+{
+    target = &paint;
+    return open(filename, left, top, paint.GetWidth(), paint.GetHeight());
+}
+
+bool BmpDecoder::begin_banded(Paint &band, const char *filename, int frame_width, int frame_height)
+{
+    target = &band;
+    return open(filename, 0, 0, frame_width, frame_height);
+}
+
+bool BmpDecoder::open(const char *filename, int left, int top, int frame_width, int frame_height)
+{
+    x = left;
+    y = top;
+    row = 0;
+    height = 0;
+    band_top = 0;
+    start_time = millis();
+    if ((x >= frame_width) || (y >= frame_height))
+    {
+        return false;
+    }
+
+    Serial.println();
+    Serial.print(F("Loading image '"));
+    Serial.print(filename);
+    Serial.println('\'');
+    if (!reader.open(filename))
+    {
+        Serial.println(F("File not found"));
+        return false;
+    }
+
+    uint16_t signature{0};
+    uint16_t planes{0};
+    uint32_t value32{0};
+    uint32_t header_size{0};
+    int32_t file_width{0};
+    // Parse BMP header
+    bool good{false};
+    if (reader.read(signature) && signature == 0x4D42)
+    {
+        reader.read(value32);
+        Serial.println(F("File size: ")); Serial.println(value32);
+        reader.read(value32); // Read & ignore creator bytes
+        reader.read(image_offset); // Start of image data
+        Serial.print(F("Image Offset: ")); Serial.println(image_offset, DEC);
+        // Read DIB header
+        reader.read(header_size);
+        Serial.print(F("Header size: ")); Serial.println(header_size);
+        reader.read(file_width);
+        reader.read(file_height);
+        // 1 plane, 24 or 1 bits per pixel, uncompressed.
+        good = reader.read(planes) && planes == 1 && reader.read(depth) && (depth == 24 || depth == 1) &&
+            reader.read(value32) && value32 == 0;
+    }
+    if (!good)
+    {
+        Serial.println(F("BMP format not recognized."));
+        reader.close();
+        return false;
+    }
+    Serial.print(F("Bit Depth: ")); Serial.println(depth);
+    Serial.print(F("Image size: "));
+    Serial.print(file_width);
+    Serial.print('x');
+    Serial.println(file_height);
+
+    palette[0] = black;
+    palette[1] = white;
+    // BMP rows are padded (if needed) to 4-byte boundary
+    if (depth == 24)
+    {
+        row_size = (file_width * 3 + 3) & ~3;
+    }
+    else
+    {
+        row_size = ((file_width + 31) / 32) * 4;
+        // The two entry palette follows the DIB header. As for 24 bit
+        // images, anything but pure black is shown as white.
+        reader.seek(14 + header_size);
+        const uint8_t *entries{reader.peek(8)};
+        if (entries != nullptr)
+        {
+            palette[0] = (entries[0] | entries[1] | entries[2]) != 0 ? white : black;
+            palette[1] = (entries[4] | entries[5] | entries[6]) != 0 ? white : black;
+        }
+    }
+
+    // If the height is negative, the image is in top-down order.
+    // This is not canon but has been observed in the wild.
+    flip = file_height >= 0;
+    file_height = std::abs(file_height);
+
+    // Crop area to be loaded
+    width = std::min<int>(file_width, frame_width - x);
+    height = std::min<int>(file_height, frame_height - y);
+
+    // Rows are visited top-down, which for a normal bottom-up BMP means
+    // backwards through the file; the read-ahead goes the same way.
+    reader.set_direction(flip ? BufferedReader::Direction::backward : BufferedReader::Direction::forward);
+    return true;
+}
+
+bool BmpDecoder::next_row()
+{
+    if (row >= height)
+    {
+        // Nothing to draw; the file is closed after the last row otherwise.
+        reader.close();
+        return false;
+    }
+    reader.seek(image_offset + (flip ? file_height - 1 - row : row) * row_size);
+
+    if (depth == 1)
+    {
+        const uint8_t *bits{reader.peek((width + 7) / 8)};
+        for (int col = 0; bits != nullptr && col < width; ++col)
+        {
+            target->DrawPixel(x + col, y + row - band_top, palette[(bits[col / 8] >> (7 - col % 8)) & 1]);
+        }
+    }
+    else
+    {
+        // A row normally fits in the buffer; very wide images are taken in pieces.
+        for (int col = 0; col < width; )
+        {
+            int count{std::min<int>(width - col, BufferedReader::buffer_size / 3)};
+            const uint8_t *pixels{reader.peek(count * 3)};
+            if (pixels == nullptr)
+            {
+                break;
+            }
+            for (int end = col + count; col < end; ++col, pixels += 3)
+            {
+                target->DrawPixel(x + col, y + row - band_top, (pixels[0] | pixels[1] | pixels[2]) != 0 ? white : black);
+            }
+            reader.consume(count * 3);
+        }
+    }
+
+    if (++row == height)
+    {
+        reader.close();
+        Serial.print(F("Loaded in "));
+        Serial.print(millis() - start_time);
+        Serial.println(" ms");
+    }
+    return true;
+}
+
+bool BmpDecoder::step(const Budget &budget)
+{
+    while (next_row())
+    {
+        if (budget.expired())
+        {
+            return row < height;
+        }
+    }
+    return false;
+}
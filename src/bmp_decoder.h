@@ -0,0 +1,101 @@
+/**
+ * @file bmp_decoder.h
+ * @brief Decode a 24 or 1 bit per pixel BMP into a paint, a row at a time.
+ *
+ * Adapted from the Adafruit BMP loader. The file is read through a
+ * `BufferedReader`, a row at a time where possible. The header is read by
+ * `begin`; each row is decoded by `next_row`, so the caller can do other work,
+ * such as sending the rows done so far, between rows. As a cooperative task,
+ * it decodes rows until its budget has been used. Where there is no room for
+ * the whole frame, it can be decoded into a band of rows at a time.
+ *
+ * Anything but pure black is drawn as white.
+ */
+#ifndef BMP_DECODER_H
+#define BMP_DECODER_H
+
+#include <Arduino.h>
+#include "buffered_reader.h"
+#include "cooperative.h"
+#include "epd/epdpaint.h"
+
+class BmpDecoder : public CooperativeTask
+{
+public:
+    explicit BmpDecoder(BufferedReader &reader) : reader(reader)
+    {
+    }
+
+    /**
+     * @brief Open a file, and read its header.
+     *
+     * @param target   Paint to draw into.
+     * @param filename File to read from.
+     * @param x        Offset in the paint of the image.
+     * @param y        Offset in the paint of the image.
+     * @return false if the file is missing, or not a BMP that can be decoded.
+     */
+    bool begin(Paint &target, const char *filename, int x, int y);
+
+    /**
+     * @brief Open a file to decode into a band of rows at a time, for a frame with no buffer of its own.
+     *
+     * The rows are drawn into @p band, with the first row of the band at its
+     * top; `next_band` moves it down by its height once it is done.
+     *
+     * @param band         Paint holding a band of rows, as wide as the frame.
+     * @param filename     File to read from.
+     * @param frame_width  Width of the frame the image is cropped to.
+     * @param frame_height Height of the frame the image is cropped to.
+     * @return false if the file is missing, or not a BMP that can be decoded.
+     */
+    bool begin_banded(Paint &band, const char *filename, int frame_width, int frame_height);
+
+    //!< Draw the following rows into the band, now holding the next band of rows.
+    void next_band()
+    {
+        band_top += target->GetHeight();
+    }
+
+    /**
+     * @brief Decode the next row; the file is closed after the last.
+     *
+     * @return false if there were no more rows.
+     */
+    bool next_row();
+
+    bool step(const Budget &budget) override;
+
+    //!< Rows of the paint, from the top, that are finished.
+    int rows_done() const
+    {
+        return y + row;
+    }
+
+    //!< Rows of the image that are drawn, once `begin` has read its header.
+    int rows() const
+    {
+        return height;
+    }
+
+private:
+    bool open(const char *filename, int left, int top, int frame_width, int frame_height);
+
+    BufferedReader &reader;
+    Paint *target{nullptr};
+    int x{0};
+    int y{0};
+    int width{0};           //!< Of the part of the image drawn, in pixels.
+    int height{0};
+    int32_t file_height{0};
+    uint16_t depth{0};
+    uint32_t image_offset{0};
+    uint32_t row_size{0};   //!< Not always the width; rows are padded.
+    bool flip{true};        //!< BMP is stored bottom-to-top.
+    int palette[2]{};       //!< For 1bpp images.
+    int row{0};
+    int band_top{0};        //!< Row of the frame at the top of the target.
+    uint32_t start_time{0};
+};
+
+#endif
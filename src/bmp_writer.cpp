@@ -0,0 +1,71 @@
+/**
+ * @file bmp_writer.cpp
+ * @brief Write a 1 bit per pixel frame buffer as a monochrome BMP.
+ */
+#include "bmp_writer.h"
+
+namespace
+{
+    void put32(uint8_t *destination, uint32_t value)
+    {
+        destination[0] = static_cast<uint8_t>(value);
+        destination[1] = static_cast<uint8_t>(value >> 8);
+        destination[2] = static_cast<uint8_t>(value >> 16);
+        destination[3] = static_cast<uint8_t>(value >> 24);
+    }
+}
+
+void bmp1_header(uint8_t (&header)[bmp1_header_size], int width, int height)
+{
+    static const uint8_t prototype[bmp1_header_size] = {
+        // File header: signature, size, reserved, offset of pixel data.
+        'B','M', 0,0,0,0, 0,0, 0,0, bmp1_header_size,0,0,0,
+        // Info header: size, width, height, planes, bits per pixel, compression,
+        // image size, resolution (2835 pixels/metre, i.e. 72 DPI), palette size, important colours.
+        40,0,0,0, 0,0,0,0, 0,0,0,0, 1,0, 1,0, 0,0,0,0,
+        0,0,0,0, 0x13,0x0B,0,0, 0x13,0x0B,0,0, 2,0,0,0, 2,0,0,0,
+        // Palette: index 0 black, index 1 white; blue, green, red, reserved.
+        0x00,0x00,0x00,0x00, 0xFF,0xFF,0xFF,0x00,
+    };
+    memcpy(header, prototype, sizeof(header));
+    put32(&header[2], bmp1_file_size(width, height));
+    put32(&header[18], width);
+    put32(&header[22], height);
+    put32(&header[34], bmp1_row_stride(width) * height);
+}
+
+size_t bmp1_fill(const uint8_t *image, int width, int height, size_t index, uint8_t *buffer, size_t max_length)
+{
+    size_t produced{0};
+    if (index < bmp1_header_size)
+    {
+        uint8_t header[bmp1_header_size];
+        bmp1_header(header, width, height);
+        produced = std::min(max_length, bmp1_header_size - index);
+        memcpy(buffer, &header[index], produced);
+        index += produced;
+    }
+
+    size_t source_stride{static_cast<size_t>(width / 8)};
+    size_t stride{bmp1_row_stride(width)};
+    size_t end{bmp1_file_size(width, height)};
+    while (produced < max_length && index < end)
+    {
+        size_t file_row{(index - bmp1_header_size) / stride};
+        size_t column{(index - bmp1_header_size) % stride};
+        const uint8_t *source{&image[(height - 1 - file_row) * source_stride]};
+        size_t count{std::min(max_length - produced, stride - column)};
+        if (column < source_stride)
+        {
+            count = std::min(count, source_stride - column);
+            memcpy(&buffer[produced], &source[column], count);
+        }
+        else
+        {
+            memset(&buffer[produced], 0, count);
+        }
+        produced += count;
+        index += count;
+    }
+    return produced;
+}
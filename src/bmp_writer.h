@@ -0,0 +1,59 @@
+/**
+ * @file bmp_writer.h
+ * @brief Write a 1 bit per pixel frame buffer as a monochrome BMP.
+ *
+ * The frame buffer layout is that of `Paint`: rows of `width / 8` bytes, most
+ * significant bit leftmost, a set bit being white. That is also the layout of a
+ * 1bpp BMP row with a black/white palette, so rows are written as they are,
+ * with padding to a 4 byte boundary, bottom row first.
+ */
+#ifndef BMP_WRITER_H
+#define BMP_WRITER_H
+
+#include <Arduino.h>
+
+//!< File header, info header and a two entry palette.
+static constexpr size_t bmp1_header_size{14 + 40 + 2 * 4};
+
+/**
+ * @brief Bytes per BMP row, including padding.
+ */
+static inline size_t bmp1_row_stride(int width)
+{
+    return ((width + 31) / 32) * 4;
+}
+
+/**
+ * @brief Size of the complete BMP file.
+ */
+static inline size_t bmp1_file_size(int width, int height)
+{
+    return bmp1_header_size + bmp1_row_stride(width) * height;
+}
+
+/**
+ * @brief Build the BMP headers and palette.
+ *
+ * @param header Buffer for the headers.
+ * @param width  Image width, in pixels.
+ * @param height Image height, in pixels.
+ */
+void bmp1_header(uint8_t (&header)[bmp1_header_size], int width, int height);
+
+/**
+ * @brief Produce part of the BMP file for a frame buffer.
+ *
+ * Intended for a chunked HTTP response, so an image can be served straight
+ * from RAM without writing it to flash.
+ *
+ * @param image      Frame buffer.
+ * @param width      Width in pixels; a multiple of 8, as in `Paint`.
+ * @param height     Height in pixels.
+ * @param index      Offset in the BMP file of the first byte wanted.
+ * @param buffer     Destination.
+ * @param max_length Size of the destination.
+ * @return Number of bytes produced; 0 at the end of the file.
+ */
+size_t bmp1_fill(const uint8_t *image, int width, int height, size_t index, uint8_t *buffer, size_t max_length);
+
+#endif
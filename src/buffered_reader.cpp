@@ -0,0 +1,127 @@
+/**
+ * @file buffered_reader.cpp
+ * @brief Block-aligned read-ahead over a LittleFS file.
+ */
+#include "buffered_reader.h"
+
+#include <LittleFS.h>
+
+bool BufferedReader::open(const char *filename)
+{
+    close();
+    file = LittleFS.open(filename, "r");
+    if (!file)
+    {
+        return false;
+    }
+    file_size = file.size();
+    return true;
+}
+
+void BufferedReader::close()
+{
+    if (file)
+    {
+        file.close();
+    }
+    file_size = 0;
+    file_position = 0;
+    buffer_start = 0;
+    buffer_length = 0;
+    read_direction = Direction::forward;
+}
+
+bool BufferedReader::seek(uint32_t position)
+{
+    if (position > file_size)
+    {
+        return false;
+    }
+    file_position = position;
+    return true;
+}
+
+const uint8_t *BufferedReader::peek(size_t length)
+{
+    if (file_position < buffer_start || file_position + length > buffer_start + buffer_length)
+    {
+        if (!fill(file_position, length))
+        {
+            return nullptr;
+        }
+    }
+    return &buffer[file_position - buffer_start];
+}
+
+size_t BufferedReader::read(uint8_t *destination, size_t length)
+{
+    length = std::min<size_t>(length, file_size - std::min(file_position, file_size));
+    size_t copied{0};
+    while (copied < length)
+    {
+        // Take whatever is buffered first; then large reads bypass the buffer.
+        if (file_position >= buffer_start && file_position < buffer_start + buffer_length)
+        {
+            size_t available{std::min<size_t>(buffer_start + buffer_length - file_position, length - copied)};
+            memcpy(destination + copied, &buffer[file_position - buffer_start], available);
+            copied += available;
+            file_position += available;
+        }
+        else if (length - copied >= buffer_size)
+        {
+            size_t direct{(length - copied) & ~(block_size - 1)};
+            file.seek(file_position, fs::SeekSet);
+            size_t got{static_cast<size_t>(file.read(destination + copied, direct))};
+            copied += got;
+            file_position += got;
+            if (got != direct)
+            {
+                break;
+            }
+        }
+        else if (!fill(file_position, 1))
+        {
+            break;
+        }
+    }
+    return copied;
+}
+
+/**
+ * @brief Load the buffer so it contains [position, position + length).
+ *
+ * The buffer is aligned to `block_size`; reading forward it starts at or just
+ * before @p position, reading backward it ends at or just after the requested data.
+ */
+bool BufferedReader::fill(uint32_t position, size_t length)
+{
+    if (!file || length > buffer_size || position + length > file_size)
+    {
+        return false;
+    }
+
+    uint32_t start;
+    if (read_direction == Direction::forward)
+    {
+        start = position & ~static_cast<uint32_t>(block_size - 1);
+    }
+    else
+    {
+        uint32_t end{static_cast<uint32_t>((position + length + block_size - 1) & ~(block_size - 1))};
+        start = end > buffer_size ? end - buffer_size : 0;
+    }
+    if (start > position || position + length > start + buffer_size)
+    {
+        // Alignment doesn't leave room; fall back to an unaligned read.
+        start = position;
+    }
+
+    size_t to_read{std::min<size_t>(buffer_size, file_size - start)};
+    if (!file.seek(start, fs::SeekSet))
+    {
+        return false;
+    }
+    buffer_start = start;
+    buffer_length = file.read(buffer, to_read);
+    return position + length <= buffer_start + buffer_length;
+}
@@ -0,0 +1,150 @@
+/**
+ * @file buffered_reader.h
+ * @brief Block-aligned read-ahead over a LittleFS file, shared by the image decoders.
+ *
+ * Every `File::read` goes through the LittleFS cache and its own bookkeeping,
+ * so reading a header field at a time or a handful of pixels at a time is
+ * slow. This reads whole aligned blocks into a buffer and lets decoders work
+ * directly on the buffered bytes with `peek` and `consume`.
+ *
+ * Reads can be anticipated in either direction: when reading backwards (e.g.
+ * the rows of a bottom-up BMP) the block is positioned so the buffer holds the
+ * data *preceding* the requested range, which is what the next request will want.
+ */
+#ifndef BUFFERED_READER_H
+#define BUFFERED_READER_H
+
+#include <Arduino.h>
+#include <FS.h>
+
+class BufferedReader
+{
+public:
+    //!< Alignment of reads from the file system.
+    static constexpr size_t block_size{512};
+    //!< Size of the read-ahead buffer; a multiple of the block size.
+    static constexpr size_t buffer_size{4 * block_size};
+
+    enum class Direction : uint8_t
+    {
+        forward,
+        backward
+    };
+
+    /**
+     * @brief Open a file for reading.
+     *
+     * Any previously open file is closed.
+     *
+     * @param filename File to open.
+     * @return true if the file was opened.
+     */
+    bool open(const char *filename);
+
+    /**
+     * @brief Close the file and discard buffered data.
+     */
+    void close();
+
+    bool is_open() const
+    {
+        return static_cast<bool>(file);
+    }
+
+    uint32_t size() const
+    {
+        return file_size;
+    }
+
+    uint32_t position() const
+    {
+        return file_position;
+    }
+
+    /**
+     * @brief Set the logical read position.
+     *
+     * No I/O happens until the next `peek` or `read`.
+     *
+     * @param position New position.
+     * @return true if the position is within the file.
+     */
+    bool seek(uint32_t position);
+
+    /**
+     * @brief Set the direction subsequent seeks are expected to go.
+     *
+     * @param direction Read-ahead direction.
+     */
+    void set_direction(Direction direction)
+    {
+        read_direction = direction;
+    }
+
+    /**
+     * @brief Get a pointer to buffered bytes at the current position.
+     *
+     * The position is not changed; use `consume` to advance it.
+     * The pointer is valid until the next call that changes the buffer.
+     *
+     * @param length Number of bytes required; at most `buffer_size`.
+     * @return Pointer to @p length bytes, or nullptr if they are not available.
+     */
+    const uint8_t *peek(size_t length);
+
+    /**
+     * @brief Advance the position.
+     *
+     * @param length Number of bytes to skip.
+     */
+    void consume(size_t length)
+    {
+        file_position += length;
+    }
+
+    /**
+     * @brief Copy bytes from the current position, advancing it.
+     *
+     * For clients, such as libraries, that want the data in their own buffer.
+     *
+     * @param destination Destination buffer.
+     * @param length      Number of bytes to read.
+     * @return Number of bytes read.
+     */
+    size_t read(uint8_t *destination, size_t length);
+
+    /**
+     * @brief Read an arbitrary binary value, in platform order.
+     *
+     * Intended for POD types, such as int16 or int32.
+     *
+     * @tparam T    Value type.
+     * @param value Value read.
+     * @return true if the value was read.
+     */
+    template<typename T>
+    bool read(T &value)
+    {
+        auto data{peek(sizeof(T))};
+        if (data == nullptr)
+        {
+            return false;
+        }
+        memcpy(&value, data, sizeof(T));
+        consume(sizeof(T));
+        return true;
+    }
+
+private:
+    bool fill(uint32_t position, size_t length);
+
+    fs::File file;
+    uint32_t file_size{0};
+    uint32_t file_position{0};
+    uint32_t buffer_start{0};
+    uint32_t buffer_length{0};
+    Direction read_direction{Direction::forward};
+    uint8_t buffer[buffer_size];
+};
+
+#endif
@@ -0,0 +1,58 @@
+/**
+ * @file clear_task.cpp
+ * @brief Clear the display to white a few rows at a time.
+ */
+#include "clear_task.h"
+
+namespace
+{
+    //!< RAM write commands.
+    constexpr unsigned char write_black_ram{0x24};
+    constexpr unsigned char write_red_ram{0x26};
+}
+
+void ClearTask::begin()
+{
+    state = State::black_ram;
+    row = 0;
+}
+
+bool ClearTask::step(const Budget &budget)
+{
+    for (;;)
+    {
+        switch (state)
+        {
+        case State::black_ram:
+        case State::red_ram:
+            if (row == 0)
+            {
+                epd.SendCommand(state == State::black_ram ? write_black_ram : write_red_ram);
+            }
+            epd.FillFrameMemory(0xff, 1);
+            if (++row == static_cast<int>(epd.height))
+            {
+                row = 0;
+                state = state == State::black_ram ? State::red_ram : State::refresh;
+                if (state == State::refresh)
+                {
+                    epd.StartDisplayFrame();
+                }
+            }
+            break;
+        case State::refresh:
+            if (epd.IsBusy())
+            {
+                return true;
+            }
+            state = State::done;
+            return false;
+        case State::done:
+            return false;
+        }
+        if (budget.expired())
+        {
+            return true;
+        }
+    }
+}
@@ -0,0 +1,45 @@
+/**
+ * @file clear_task.h
+ * @brief Clear the display to white a few rows at a time.
+ *
+ * `Epd::Clear` fills both RAMs of the panel, 10,000 bytes, and then waits
+ * seconds for the full refresh. This does the same as a cooperative task: the
+ * rows are sent a few at a time, and the refresh is waited for by checking the
+ * busy line at each step rather than by blocking.
+ */
+#ifndef CLEAR_TASK_H
+#define CLEAR_TASK_H
+
+#include <Arduino.h>
+#include "cooperative.h"
+#include "epd/epd1in54_V2.h"
+
+class ClearTask : public CooperativeTask
+{
+public:
+    explicit ClearTask(Epd &epd) : epd(epd)
+    {
+    }
+
+    /**
+     * @brief Set up to clear; the display has been initialised (`LDirInit` or `HDirInit`).
+     */
+    void begin();
+
+    bool step(const Budget &budget) override;
+
+private:
+    enum class State : uint8_t
+    {
+        black_ram,
+        red_ram,
+        refresh,
+        done
+    };
+
+    Epd &epd;
+    State state{State::done};
+    int row{0};
+};
+
+#endif
@@ -0,0 +1,55 @@
+/**
+ * @file cooperative.cpp
+ * @brief Long operations as resumable tasks, each run for a slice of time.
+ */
+#include "cooperative.h"
+
+bool Scheduler::queued(const CooperativeTask &task) const
+{
+    for (size_t i = 0; i < count; ++i)
+    {
+        if (tasks[(head + i) % max_tasks] == &task)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool Scheduler::add(CooperativeTask &task)
+{
+    if (count == max_tasks || queued(task))
+    {
+        return false;
+    }
+    tasks[(head + count) % max_tasks] = &task;
+    ++count;
+    return true;
+}
+
+bool Scheduler::run(uint32_t microseconds)
+{
+    Budget budget{microseconds};
+    while (count != 0)
+    {
+        // A finished task is taken off before the next starts; it may have queued more.
+        if (!tasks[head]->step(budget))
+        {
+            head = (head + 1) % max_tasks;
+            --count;
+        }
+        if (budget.expired())
+        {
+            break;
+        }
+    }
+    return count != 0;
+}
+
+void Scheduler::finish(uint32_t microseconds)
+{
+    while (run(microseconds))
+    {
+        yield();
+    }
+}
@@ -0,0 +1,98 @@
+/**
+ * @file cooperative.h
+ * @brief Long operations as resumable tasks, each run for a slice of time.
+ *
+ * A task is an explicit state machine: `step` does work until its budget has
+ * been used, then returns, keeping where it was in its members, and carries on
+ * from there at the next step. The scheduler runs the tasks queued, oldest
+ * first, for a budget in microseconds per call, so whatever calls it (`loop()`
+ * on the ESP8266) gets control back, and the network stack is serviced, within
+ * about that budget plus the longest single piece of work a task does between
+ * looking at the clock.
+ *
+ * Tasks run one at a time, in the order they were queued, so that tasks
+ * sharing the display and frame buffer do not interleave.
+ *
+ * The toolchains used (C++17) do not have coroutines; these are what C++20
+ * coroutines would be written as.
+ */
+#ifndef COOPERATIVE_H
+#define COOPERATIVE_H
+
+#include <Arduino.h>
+
+/**
+ * @brief Time allowed for a slice of work, from when it is made.
+ */
+class Budget
+{
+public:
+    explicit Budget(uint32_t microseconds):
+        start(micros()),
+        length(microseconds)
+    {
+    }
+
+    bool expired() const
+    {
+        return static_cast<uint32_t>(micros()) - start >= length;
+    }
+
+private:
+    uint32_t start;
+    uint32_t length;
+};
+
+class CooperativeTask
+{
+public:
+    virtual ~CooperativeTask() = default;
+
+    /**
+     * @brief Do the next part of the work, returning once @p budget has expired, or sooner.
+     *
+     * At least some progress is made, however little budget is left.
+     *
+     * @return true if there is more to do.
+     */
+    virtual bool step(const Budget &budget) = 0;
+};
+
+class Scheduler
+{
+public:
+    static constexpr size_t max_tasks{8};
+
+    /**
+     * @brief Queue a task, already set up to run.
+     *
+     * @return false if it is already queued, or the queue is full.
+     */
+    bool add(CooperativeTask &task);
+
+    /**
+     * @brief Run the queued tasks for up to @p microseconds.
+     *
+     * @return true if there is more to do.
+     */
+    bool run(uint32_t microseconds);
+
+    /**
+     * @brief Run the queued tasks to completion, yielding every @p microseconds.
+     */
+    void finish(uint32_t microseconds);
+
+    bool busy() const
+    {
+        return count != 0;
+    }
+
+    bool queued(const CooperativeTask &task) const;
+
+private:
+    CooperativeTask *tasks[max_tasks]{};
+    size_t head{0};
+    size_t count{0};
+};
+
+#endif
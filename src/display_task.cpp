@@ -0,0 +1,177 @@
+/**
+ * @file display_task.cpp
+ * @brief One owner of the display, fed commands through a bounded queue.
+ */
+#include "display_task.h"
+
+DisplayTask::DisplayTask(DisplayHandler handler, DisplayStep step):
+    handler(handler),
+    step(step)
+{
+}
+
+DisplayTask::~DisplayTask()
+{
+#if !defined(ESP32) && !defined(ESP8266)
+    if (thread.joinable())
+    {
+        stopping = true;
+        queued.notify_one();
+        thread.join();
+    }
+#endif
+}
+
+void DisplayTask::begin()
+{
+    if (started)
+    {
+        return;
+    }
+    started = true;
+#ifdef ESP32
+    // Created here; FreeRTOS is not running when statics are constructed.
+    queue = xQueueCreate(queue_length, sizeof(DisplayCommand));
+    lock = xSemaphoreCreateRecursiveMutex();
+    xTaskCreatePinnedToCore(task_main, "display", stack_size, this, 1, nullptr, core);
+#elif !defined(ESP8266)
+    thread = std::thread(&DisplayTask::run, this);
+#endif
+}
+
+bool DisplayTask::post(DisplayCommandType type, const char *file)
+{
+    DisplayCommand command{};
+    command.type = type;
+    if (file != nullptr)
+    {
+        if (strlen(file) >= DisplayCommand::max_file)
+        {
+            return false;
+        }
+        strcpy(command.file, file);
+    }
+#ifdef ESP32
+    return queue != nullptr && xQueueSend(queue, &command, 0) == pdTRUE;
+#else
+#ifndef ESP8266
+    std::lock_guard<std::mutex> hold{queue_mutex};
+#endif
+    if (count == queue_length)
+    {
+        return false;
+    }
+    commands[(head + count) % queue_length] = command;
+    ++count;
+#ifndef ESP8266
+    queued.notify_one();
+#endif
+    return true;
+#endif
+}
+
+#ifndef ESP32
+bool DisplayTask::pop(DisplayCommand &command)
+{
+    if (count == 0)
+    {
+        return false;
+    }
+    command = commands[head];
+    head = (head + 1) % queue_length;
+    --count;
+    return true;
+}
+#endif
+
+bool DisplayTask::run_one(uint32_t wait_ms)
+{
+    DisplayCommand command;
+#ifdef ESP32
+    if (xQueueReceive(queue, &command, pdMS_TO_TICKS(wait_ms)) != pdTRUE)
+    {
+        return false;
+    }
+#elif defined(ESP8266)
+    (void)wait_ms;
+    if (!pop(command))
+    {
+        return false;
+    }
+#else
+    {
+        std::unique_lock<std::mutex> hold{queue_mutex};
+        queued.wait_for(hold, std::chrono::milliseconds(wait_ms), [this]() { return count != 0 || stopping; });
+        if (!pop(command))
+        {
+            return false;
+        }
+    }
+#endif
+    handler(command);
+    return true;
+}
+
+#ifndef ESP8266
+void DisplayTask::run()
+{
+    bool busy{false};
+#ifdef ESP32
+    for (;;)
+#else
+    while (!stopping)
+#endif
+    {
+        // While the step has work, commands are taken between steps without waiting.
+        if (!run_one(busy ? 0 : idle_wait_ms))
+        {
+            busy = step();
+        }
+    }
+}
+#endif
+
+#ifdef ESP32
+void DisplayTask::task_main(void *parameter)
+{
+    static_cast<DisplayTask *>(parameter)->run();
+}
+#endif
+
+void DisplayTask::poll()
+{
+#ifdef ESP8266
+    while (run_one(0))
+    {
+    }
+    step();
+#else
+    // The display task does the work.
+    delay(1000);
+#endif
+}
+
+DisplayTask::Guard::Guard(DisplayTask &task):
+    task(task)
+{
+#ifdef ESP32
+    if (task.lock != nullptr)
+    {
+        xSemaphoreTakeRecursive(task.lock, portMAX_DELAY);
+    }
+#elif !defined(ESP8266)
+    task.lock.lock();
+#endif
+}
+
+DisplayTask::Guard::~Guard()
+{
+#ifdef ESP32
+    if (task.lock != nullptr)
+    {
+        xSemaphoreGiveRecursive(task.lock);
+    }
+#elif !defined(ESP8266)
+    task.lock.unlock();
+#endif
+}
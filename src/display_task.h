@@ -0,0 +1,183 @@
+/**
+ * @file display_task.h
+ * @brief One owner of the display, fed commands through a bounded queue.
+ *
+ * The display, its paint and frame buffers are used only by the display task.
+ * Request handlers, on whatever core or in whatever context the web server
+ * runs them, post commands to it and return at once; anything else they share
+ * with the display task is read or written under `DisplayTask::Guard`, except
+ * the storage manager, which has a lock of its own.
+ *
+ * Between commands, the task runs a step callback, which does the work left
+ * pending by request flags (QR codes, scenes, the playlist, widgets).
+ *
+ * - ESP32: a FreeRTOS task pinned to the application core (core 1), with a
+ *   FreeRTOS queue; the network stack runs on the other core, so uploads and
+ *   requests are served while an image is decoded or the panel refreshed.
+ * - ESP8266: there is one core; `poll`, called from `loop()`, runs the queued
+ *   commands and the step.
+ * - Otherwise, for host builds (the native test environment), a `std::thread`
+ *   with a mutex and condition variable around the same ring buffer.
+ */
+#ifndef DISPLAY_TASK_H
+#define DISPLAY_TASK_H
+
+#include <Arduino.h>
+
+#ifdef ESP32
+#include <freertos/FreeRTOS.h>
+#include <freertos/queue.h>
+#include <freertos/semphr.h>
+#include <freertos/task.h>
+#elif !defined(ESP8266)
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#endif
+
+enum class DisplayCommandType : uint8_t
+{
+    image,      //!< Decode and show `file`.
+    sleep,      //!< Put the panel to sleep.
+    clear       //!< Clear the panel to white.
+};
+
+struct DisplayCommand
+{
+    static constexpr size_t max_file{64};
+
+    DisplayCommandType type;
+    char file[max_file];
+};
+
+/**
+ * @brief Carry out a command; called on the display task.
+ */
+typedef void (*DisplayHandler)(const DisplayCommand &command);
+
+/**
+ * @brief Do pending work; called on the display task between commands.
+ *
+ * @return true while there is more to do, so the step is called again without waiting.
+ */
+typedef bool (*DisplayStep)();
+
+class DisplayTask
+{
+public:
+    //!< Commands waiting to be run; more are refused.
+    static constexpr size_t queue_length{8};
+    //!< Wait for a command before the step is called again, when it has nothing to do, in ms.
+    static constexpr uint32_t idle_wait_ms{10};
+    static constexpr uint32_t stack_size{8192};
+    static constexpr int core{1};
+
+    DisplayTask(DisplayHandler handler, DisplayStep step);
+    ~DisplayTask();
+
+    DisplayTask(const DisplayTask &) = delete;
+    DisplayTask &operator=(const DisplayTask &) = delete;
+
+    /**
+     * @brief Start the task; the display must not be used outside it afterwards.
+     */
+    void begin();
+
+    /**
+     * @brief Queue a command; does not wait.
+     *
+     * @param type Command.
+     * @param file File name, for `DisplayCommandType::image`.
+     * @return false if the queue is full, or the file name too long.
+     */
+    bool post(DisplayCommandType type, const char *file = nullptr);
+
+    /**
+     * @brief Run the queued commands, then the step; called from `loop()`.
+     *
+     * Only the ESP8266 runs the commands here. Elsewhere the task runs them,
+     * and this only sleeps.
+     */
+    void poll();
+
+    /**
+     * @brief Holds the lock on state shared between request handlers and the display task.
+     *
+     * The lock is recursive, and held briefly: never across decoding, a refresh or a file write.
+     */
+    class Guard
+    {
+    public:
+        explicit Guard(DisplayTask &task);
+        ~Guard();
+
+        Guard(const Guard &) = delete;
+        Guard &operator=(const Guard &) = delete;
+
+    private:
+        DisplayTask &task;
+    };
+
+private:
+    //!< Run one command if there is one, waiting up to @p wait_ms for it.
+    bool run_one(uint32_t wait_ms);
+#ifndef ESP8266
+    void run();
+#endif
+
+    DisplayHandler handler;
+    DisplayStep step;
+    bool started{false};
+#ifdef ESP32
+    static void task_main(void *parameter);
+    QueueHandle_t queue{nullptr};
+    SemaphoreHandle_t lock{nullptr};
+#else
+    bool pop(DisplayCommand &command);
+
+    DisplayCommand commands[queue_length];
+    size_t head{0};
+    size_t count{0};
+#ifndef ESP8266
+    std::thread thread;
+    std::mutex queue_mutex;
+    std::condition_variable queued;
+    std::recursive_mutex lock;
+    std::atomic<bool> stopping{false};
+#endif
+#endif
+};
+
+/**
+ * @brief A string written by the display task and read by request handlers.
+ */
+class SharedString
+{
+public:
+    SharedString(DisplayTask &task, const char *initial):
+        task(task),
+        value(initial)
+    {
+    }
+
+    SharedString &operator=(const String &text)
+    {
+        DisplayTask::Guard guard{task};
+        value = text;
+        return *this;
+    }
+
+    //!< A copy of the string.
+    String get() const
+    {
+        DisplayTask::Guard guard{task};
+        return value;
+    }
+
+private:
+    DisplayTask &task;
+    String value;
+};
+
+#endif
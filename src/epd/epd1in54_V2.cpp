@@ -104,6 +104,8 @@ Epd::Epd()
 	busy_pin = BUSY_PIN;
 	width = EPD_WIDTH;
 	height = EPD_HEIGHT;
+	refreshing = false;
+	direction = EPD_DIR_NONE;
 };
 
 /**
@@ -111,6 +113,9 @@ Epd::Epd()
  */
 void Epd::SendCommand(unsigned char command)
 {
+	if (refreshing) {
+		FinishRefresh();
+	}
 	DigitalWrite(dc_pin, LOW);
 	SpiTransfer(command);
 }
@@ -213,10 +218,31 @@ int Epd::HDirInit(void)
 
 	SetLut(WF_Full_1IN54);
 	/* EPD hardware init end */
+	direction = EPD_DIR_HIGH;
 
 	return 0;
 }
 
+/**
+ *  @brief: set up as HDirInit does, without the reset and init if the panel
+ *          is still set up by it; the RAM window and pointer are set back to
+ *          the whole frame
+ */
+int Epd::HDirResume(void)
+{
+	if (direction != EPD_DIR_HIGH) {
+		return HDirInit();
+	}
+	SetMemoryArea(0, EPD_HEIGHT - 1, EPD_WIDTH - 1, 0);
+	/* as SetMemoryPointer does, without its wait; the panel is idle */
+	SendCommand(0x4E);   // set RAM x address count to 0;
+	SendData(0x00);
+	SendCommand(0x4F);   // set RAM y address count to 0X199;
+	SendData(0xC7);
+	SendData(0x00);
+	return 0;
+}
+
 // Low Direction
 int Epd::LDirInit(void)
 {
@@ -268,6 +294,7 @@ int Epd::LDirInit(void)
 
 	SetLut(WF_Full_1IN54);
 	/* EPD hardware init end */
+	direction = EPD_DIR_LOW;
 
 	return 0;
 }
@@ -280,6 +307,10 @@ int Epd::LDirInit(void)
  */
 void Epd::Reset(void)
 {
+	if (refreshing) {
+		FinishRefresh();
+	}
+	direction = EPD_DIR_NONE;
 	DigitalWrite(reset_pin, HIGH);
 	DelayMs(20);
 	DigitalWrite(reset_pin, LOW);                //module reset
@@ -290,26 +321,30 @@ void Epd::Reset(void)
 
 void Epd::Clear(void)
 {
-	int w, h;
-	w = (EPD_WIDTH % 8 == 0)? (EPD_WIDTH / 8 ): (EPD_WIDTH / 8 + 1);
-	h = EPD_HEIGHT;
+	int h = EPD_HEIGHT;
 
 	SendCommand(0x24);
-	for (int j = 0; j < h; j++) {
-		for (int i = 0; i < w; i++) {
-			SendData(0xff);
-		}
-	}
+	FillFrameMemory(0xff, h);
 	SendCommand(0x26);
-	for (int j = 0; j < h; j++) {
-		for (int i = 0; i < w; i++) {
-			SendData(0xff);
-		}
-	}
+	FillFrameMemory(0xff, h);
 	//DISPLAY REFRESH
 	DisplayFrame();
 }
 
+/**
+ *  @brief: after SendCommand(0x24) or SendCommand(0x26), fill rows of the RAM
+ *          with a value, one SPI transfer per row
+ */
+void Epd::FillFrameMemory(unsigned char value, int rows)
+{
+	unsigned char row[(EPD_WIDTH + 7) / 8];
+	memset(row, value, sizeof(row));
+	DigitalWrite(dc_pin, HIGH);
+	for (int j = 0; j < rows; j++) {
+		SpiTransfer(row, sizeof(row));
+	}
+}
+
 void Epd::Display(const unsigned char* frame_buffer)
 {
 	int w = (EPD_WIDTH % 8 == 0)? (EPD_WIDTH / 8 ): (EPD_WIDTH / 8 + 1);
@@ -451,6 +486,49 @@ void Epd::DisplayPartFrame(void)
 	WaitUntilIdle();
 }
 
+/**
+ *  @brief: start a full refresh, as DisplayFrame does, without waiting for it;
+ *          the frame buffer may be drawn into while the panel refreshes.
+ *          The next command waits for the refresh to finish.
+ */
+void Epd::StartDisplayFrame(void)
+{
+	SendCommand(0x22);
+	SendData(0xc7);
+	SendCommand(0x20);
+	refreshing = true;
+}
+
+/**
+ *  @brief: start a partial refresh, as DisplayPartFrame does, without waiting for it
+ */
+void Epd::StartDisplayPartFrame(void)
+{
+	SendCommand(0x22);
+	SendData(0xcF);
+	SendCommand(0x20);
+	refreshing = true;
+}
+
+/**
+ *  @brief: whether the panel is still refreshing
+ */
+int Epd::IsBusy(void)
+{
+	return DigitalRead(busy_pin) == 1;
+}
+
+/**
+ *  @brief: wait for a refresh started by StartDisplayFrame or StartDisplayPartFrame
+ */
+void Epd::FinishRefresh(void)
+{
+	while (IsBusy()) {
+		DelayMs(1);
+	}
+	refreshing = false;
+}
+
 
 void Epd::SetFrameMemory(
         const unsigned char* image_buffer,
@@ -463,6 +541,7 @@ void Epd::SetFrameMemory(
 	int x_end;
 	int y_end;
 
+	direction = EPD_DIR_NONE;
 	DigitalWrite(reset_pin, LOW);                //module reset
 	DelayMs(2);
 	DigitalWrite(reset_pin, HIGH);
@@ -501,6 +580,87 @@ void Epd::SetFrameMemory(
 	}
 }
 
+/**
+ *  @brief: start writing an area of the frame memory, as SetFrameMemory does,
+ *          without a buffer; the rows, each (x_end - x + 1) / 8 bytes, follow
+ *          with WriteFrameMemory
+ *  @return: the number of rows to write, 0 if the area is empty
+ */
+int Epd::BeginFrameMemory(
+        int x,
+        int y,
+        int image_width,
+        int image_height
+)
+{
+	int x_end;
+	int y_end;
+
+	if (refreshing) {
+		FinishRefresh();
+	}
+	direction = EPD_DIR_NONE;
+	DigitalWrite(reset_pin, LOW);                //module reset
+	DelayMs(2);
+	DigitalWrite(reset_pin, HIGH);
+	DelayMs(2);
+	SendCommand(0x3c);
+	SendData(0x80);
+
+	if (
+	        x < 0 || image_width <= 0 ||
+	        y < 0 || image_height <= 0
+	) {
+		return 0;
+	}
+	/* x point must be the multiple of 8 or the last 3 bits will be ignored */
+	x &= 0xF8;
+	image_width &= 0xF8;
+	if (x + image_width >= this->width) {
+		x_end = this->width - 1;
+	} else {
+		x_end = x + image_width - 1;
+	}
+	if (y + image_height >= this->height) {
+		y_end = this->height - 1;
+	} else {
+		y_end = y + image_height - 1;
+	}
+	SetMemoryArea(x, y, x_end, y_end);
+	SetMemoryPointer(x, y);
+	SendCommand(0x24);
+	return y_end - y + 1;
+}
+
+/**
+ *  @brief: send image data after BeginFrameMemory, in one SPI transfer
+ */
+void Epd::WriteFrameMemory(const unsigned char* data, int length)
+{
+	DigitalWrite(dc_pin, HIGH);
+	SpiTransfer(data, length);
+}
+
+/**
+ *  @brief: start sending image data after BeginFrameMemory, as WriteFrameMemory
+ *          does, without waiting for it; on the ESP32 it is sent by DMA. data
+ *          must not change until FinishWriteFrameMemory, or SpiTransferDone.
+ *          Any other use of the display waits for it first.
+ */
+void Epd::StartWriteFrameMemory(const unsigned char* data, int length)
+{
+	DigitalWrite(dc_pin, HIGH);
+	SpiTransferAsync(data, length);
+}
+
+/**
+ *  @brief: wait for data sent by StartWriteFrameMemory
+ */
+void Epd::FinishWriteFrameMemory(void)
+{
+	SpiWaitTransfer();
+}
+
 void Epd::SetFrameMemoryPartial(
         const unsigned char* image_buffer,
         int x,
@@ -512,6 +672,7 @@ void Epd::SetFrameMemoryPartial(
 	int x_end;
 	int y_end;
 
+	direction = EPD_DIR_NONE;
 	DigitalWrite(reset_pin, LOW);                //module reset
 	DelayMs(2);
 	DigitalWrite(reset_pin, HIGH);
@@ -582,6 +743,7 @@ void Epd::Sleep()
 	SendCommand(0x10); //enter deep sleep
 	SendData(0x01);
 	DelayMs(200);
+	direction = EPD_DIR_NONE;
 
 	DigitalWrite(reset_pin, LOW);
 }
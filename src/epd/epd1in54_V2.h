@@ -37,22 +37,31 @@
 #define EPD_WIDTH       200
 #define EPD_HEIGHT      200
 
+// Which init the panel was last set up by
+#define EPD_DIR_NONE    0
+#define EPD_DIR_LOW     1
+#define EPD_DIR_HIGH    2
+
 class Epd : EpdIf
 {
 public:
 	unsigned long width;
 	unsigned long height;
+	bool refreshing;
+	int direction;
 
 	Epd();
 	~Epd();
 	// int  Init(void);
 	int LDirInit(void);
 	int HDirInit(void);
+	int HDirResume(void);
 	void SendCommand(unsigned char command);
 	void SendData(unsigned char data);
 	void WaitUntilIdle(void);
 	void Reset(void);
 	void Clear(void);
+	void FillFrameMemory(unsigned char value, int rows);
 	void Display(const unsigned char* frame_buffer);
 	void DisplayPartBaseImage(const unsigned char* frame_buffer);
 	void DisplayPartBaseWhiteImage(void);
@@ -71,8 +80,21 @@ public:
 	        int image_width,
 	        int image_height
 	);
+	int BeginFrameMemory(
+	        int x,
+	        int y,
+	        int image_width,
+	        int image_height
+	);
+	void WriteFrameMemory(const unsigned char* data, int length);
+	void StartWriteFrameMemory(const unsigned char* data, int length);
+	void FinishWriteFrameMemory(void);
 	void DisplayFrame(void);
 	void DisplayPartFrame(void);
+	void StartDisplayFrame(void);
+	void StartDisplayPartFrame(void);
+	int IsBusy(void);
+	void FinishRefresh(void);
 
 	void Sleep(void);
 private:
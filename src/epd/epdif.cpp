@@ -26,7 +26,185 @@
  */
 
 #include "epdif.h"
+#ifdef ESP32
+#include <driver/spi_master.h>
+#elif defined(ESP8266)
 #include <SPI.h>
+#else
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+#endif
+
+#ifndef ESP8266
+/* Frame data is queued in transactions of up to spi_max_transfer bytes, sent
+ * by DMA through the ESP-IDF SPI master driver on the ESP32, and by a fake bus
+ * on a host. Chip select is driven here, as it is for the ESP8266, and raised
+ * once the last transaction of a transfer has completed. */
+static constexpr unsigned int spi_max_transfer = 4092;
+static constexpr int spi_queue_size = 4;
+static int spi_pending = 0;
+#endif
+
+#ifdef ESP32
+static spi_device_handle_t spi_device = nullptr;
+static spi_transaction_t spi_transactions[spi_queue_size];
+static int spi_next = 0;
+
+/**
+ *  @brief: queue a transaction; data must not change until it has completed
+ */
+static void spi_queue(const unsigned char* data, unsigned int length) {
+    spi_transaction_t& transaction = spi_transactions[spi_next];
+    spi_next = (spi_next + 1) % spi_queue_size;
+    transaction = {};
+    transaction.length = length * 8;
+    transaction.tx_buffer = data;
+    spi_device_queue_trans(spi_device, &transaction, portMAX_DELAY);
+}
+
+/**
+ *  @brief: take the result of a completed transaction, waiting for one if wait is set
+ */
+static bool spi_result(bool wait) {
+    spi_transaction_t* done;
+    return spi_device_get_trans_result(spi_device, &done, wait ? portMAX_DELAY : 0) == ESP_OK;
+}
+
+static void spi_send_byte(unsigned char data) {
+    spi_transaction_t transaction = {};
+    transaction.flags = SPI_TRANS_USE_TXDATA;
+    transaction.length = 8;
+    transaction.tx_data[0] = data;
+    spi_device_polling_transmit(spi_device, &transaction);
+}
+#elif !defined(ESP8266)
+/* The fake bus sends queued transactions on a thread of its own, at the pace
+ * of the 2 MHz clock, and records each byte with the DC and CS levels it went
+ * out with. It is never destroyed, as its thread runs until the process ends. */
+static constexpr unsigned int fake_us_per_byte = 4;
+
+struct FakeTransaction {
+    const unsigned char* data;
+    unsigned int length;
+};
+
+struct FakeBus {
+    std::mutex mutex;
+    std::condition_variable changed;
+    std::deque<FakeTransaction> queue;
+    unsigned int completed = 0;
+    std::vector<EpdIfFakeByte> sent;
+    int pins_changed = 0;
+    std::thread thread;
+};
+
+static void fake_run(FakeBus& bus);
+
+static FakeBus& fake_bus(void) {
+    static FakeBus* bus = nullptr;
+    static std::once_flag started;
+    std::call_once(started, [] {
+        bus = new FakeBus;
+        bus->thread = std::thread(fake_run, std::ref(*bus));
+        bus->thread.detach();
+    });
+    return *bus;
+}
+
+static void fake_run(FakeBus& bus) {
+    std::unique_lock<std::mutex> hold(bus.mutex);
+    for (;;) {
+        bus.changed.wait(hold, [&bus] { return !bus.queue.empty(); });
+        FakeTransaction transaction = bus.queue.front();
+        hold.unlock();
+        unsigned char dc = digitalRead(DC_PIN);
+        unsigned char cs = digitalRead(CS_PIN);
+        std::this_thread::sleep_for(std::chrono::microseconds(transaction.length * fake_us_per_byte));
+        bool pins_changed = digitalRead(DC_PIN) != dc || digitalRead(CS_PIN) != cs;
+        hold.lock();
+        for (unsigned int i = 0; i < transaction.length; i++) {
+            bus.sent.push_back(EpdIfFakeByte{transaction.data[i], dc, cs});
+        }
+        bus.pins_changed += pins_changed;
+        bus.queue.pop_front();
+        ++bus.completed;
+        bus.changed.notify_all();
+    }
+}
+
+static void spi_queue(const unsigned char* data, unsigned int length) {
+    FakeBus& bus = fake_bus();
+    std::lock_guard<std::mutex> hold(bus.mutex);
+    bus.queue.push_back(FakeTransaction{data, length});
+    bus.changed.notify_all();
+}
+
+static bool spi_result(bool wait) {
+    FakeBus& bus = fake_bus();
+    std::unique_lock<std::mutex> hold(bus.mutex);
+    if (wait) {
+        bus.changed.wait(hold, [&bus] { return bus.completed > 0; });
+    }
+    if (bus.completed == 0) {
+        return false;
+    }
+    --bus.completed;
+    return true;
+}
+
+static void spi_send_byte(unsigned char data) {
+    spi_queue(&data, 1);
+    spi_result(true);
+}
+
+unsigned int EpdIfFakeBus::InFlight(void) {
+    FakeBus& bus = fake_bus();
+    std::lock_guard<std::mutex> hold(bus.mutex);
+    return bus.queue.size();
+}
+
+unsigned int EpdIfFakeBus::Sent(EpdIfFakeByte* bytes, unsigned int max) {
+    FakeBus& bus = fake_bus();
+    std::lock_guard<std::mutex> hold(bus.mutex);
+    unsigned int count = bus.sent.size() < max ? bus.sent.size() : max;
+    std::copy(bus.sent.begin(), bus.sent.begin() + count, bytes);
+    return bus.sent.size();
+}
+
+int EpdIfFakeBus::PinsChangedMidTransfer(void) {
+    FakeBus& bus = fake_bus();
+    std::lock_guard<std::mutex> hold(bus.mutex);
+    return bus.pins_changed;
+}
+
+void EpdIfFakeBus::Reset(void) {
+    EpdIf::SpiWaitTransfer();
+    FakeBus& bus = fake_bus();
+    std::lock_guard<std::mutex> hold(bus.mutex);
+    bus.sent.clear();
+    bus.pins_changed = 0;
+}
+#endif
+
+#ifndef ESP8266
+/**
+ *  @brief: collect a completed transaction, waiting for it if wait is set;
+ *          chip select is raised once the last one is in
+ */
+static bool spi_collect(bool wait) {
+    if (!spi_result(wait)) {
+        return false;
+    }
+    if (--spi_pending == 0) {
+        digitalWrite(CS_PIN, HIGH);
+    }
+    return true;
+}
+#endif
 
 EpdIf::EpdIf() {
 };
@@ -34,7 +212,11 @@ EpdIf::EpdIf() {
 EpdIf::~EpdIf() {
 };
 
+/**
+ *  @brief: DC and CS are not changed while a transfer is under way
+ */
 void EpdIf::DigitalWrite(int pin, int value) {
+    SpiWaitTransfer();
     digitalWrite(pin, value);
 }
 
@@ -47,18 +229,106 @@ void EpdIf::DelayMs(unsigned int delaytime) {
 }
 
 void EpdIf::SpiTransfer(unsigned char data) {
+    SpiWaitTransfer();
     digitalWrite(CS_PIN, LOW);
+#ifdef ESP8266
     SPI.transfer(data);
+#else
+    spi_send_byte(data);
+#endif
     digitalWrite(CS_PIN, HIGH);
 }
 
+/**
+ *  @brief: this sends a run of bytes with one chip select
+ */
+void EpdIf::SpiTransfer(const unsigned char* data, unsigned int length) {
+    SpiTransferAsync(data, length);
+    SpiWaitTransfer();
+}
+
+/**
+ *  @brief: start sending a run of bytes with one chip select, without waiting
+ *          for it; data must not change until SpiTransferDone or SpiWaitTransfer
+ *          report the transfer complete. DC is set by the caller beforehand.
+ *          The ESP8266 sends the bytes at once.
+ */
+void EpdIf::SpiTransferAsync(const unsigned char* data, unsigned int length) {
+    SpiWaitTransfer();
+    if (length == 0) {
+        return;
+    }
+    digitalWrite(CS_PIN, LOW);
+#ifdef ESP8266
+    SPI.writeBytes(data, length);
+    digitalWrite(CS_PIN, HIGH);
+#else
+    while (length > 0) {
+        if (spi_pending == spi_queue_size) {
+            spi_collect(true);
+        }
+        unsigned int count = length < spi_max_transfer ? length : spi_max_transfer;
+        ++spi_pending;
+        spi_queue(data, count);
+        data += count;
+        length -= count;
+    }
+#endif
+}
+
+/**
+ *  @brief: whether the transfer started by SpiTransferAsync has completed
+ */
+int EpdIf::SpiTransferDone(void) {
+#ifdef ESP8266
+    return 1;
+#else
+    while (spi_pending > 0 && spi_collect(false)) {
+    }
+    return spi_pending == 0;
+#endif
+}
+
+/**
+ *  @brief: wait for the transfer started by SpiTransferAsync; on the ESP32 the
+ *          CPU is free for other tasks meanwhile
+ */
+void EpdIf::SpiWaitTransfer(void) {
+#ifndef ESP8266
+    while (spi_pending > 0) {
+        spi_collect(true);
+    }
+#endif
+}
+
 int EpdIf::IfInit(void) {
     pinMode(CS_PIN, OUTPUT);
     pinMode(RST_PIN, OUTPUT);
     pinMode(DC_PIN, OUTPUT);
     pinMode(BUSY_PIN, INPUT);
 
+#ifdef ESP32
+    if (spi_device == nullptr) {
+        spi_bus_config_t bus = {};
+        bus.mosi_io_num = DIN_PIN;
+        bus.miso_io_num = -1;
+        bus.sclk_io_num = CLK_PIN;
+        bus.quadwp_io_num = -1;
+        bus.quadhd_io_num = -1;
+        bus.max_transfer_sz = spi_max_transfer;
+        spi_device_interface_config_t device = {};
+        device.clock_speed_hz = 2000000;
+        device.mode = 0;
+        device.spics_io_num = -1;
+        device.queue_size = spi_queue_size;
+        if (spi_bus_initialize(SPI3_HOST, &bus, SPI_DMA_CH_AUTO) != ESP_OK ||
+                spi_bus_add_device(SPI3_HOST, &device, &spi_device) != ESP_OK) {
+            return -1;
+        }
+    }
+#elif defined(ESP8266)
     SPI.begin();
     SPI.beginTransaction(SPISettings(2000000, MSBFIRST, SPI_MODE0));
+#endif
     return 0;
 }
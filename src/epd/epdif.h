@@ -42,6 +42,8 @@ static constexpr auto RST_PIN = 18;
 static constexpr auto DC_PIN = 23;
 static constexpr auto CS_PIN = 4;
 static constexpr auto BUSY_PIN = 19;
+static constexpr auto CLK_PIN = 22;
+static constexpr auto DIN_PIN = 21;
 #else
 #define RST_PIN         8
 #define DC_PIN          9
@@ -59,6 +61,28 @@ public:
     static int  DigitalRead(int pin);
     static void DelayMs(unsigned int delaytime);
     static void SpiTransfer(unsigned char data);
+    static void SpiTransfer(const unsigned char* data, unsigned int length);
+    static void SpiTransferAsync(const unsigned char* data, unsigned int length);
+    static int  SpiTransferDone(void);
+    static void SpiWaitTransfer(void);
 };
 
+#if !defined(ESP32) && !defined(ESP8266)
+/* Host builds (the native tests) send through a fake bus, which completes
+ * queued transfers on a thread of its own, as DMA would. */
+struct EpdIfFakeByte {
+    unsigned char value;
+    unsigned char dc;       // DC level the byte was sent with
+    unsigned char cs;       // CS level the byte was sent with
+};
+
+class EpdIfFakeBus {
+public:
+    static unsigned int InFlight(void);
+    static unsigned int Sent(EpdIfFakeByte* bytes, unsigned int max);
+    static int  PinsChangedMidTransfer(void);
+    static void Reset(void);
+};
+#endif
+
 #endif
@@ -25,7 +25,12 @@
  */
 
 #include <avr/pgmspace.h>
+#include <string.h>
 #include "epdpaint.h"
+#include "../bit_expansion.h"
+#include "../bitblit.h"
+#include "../fill_pattern.h"
+#include "../font.h"
 
 Paint::Paint(unsigned char* image, int width, int height) {
     this->rotate = ROTATE_0;
@@ -141,9 +146,13 @@ void Paint::DrawPixel(int x, int y, int colored) {
 
 /**
  *  @brief: this draws a charactor on the frame buffer but not refresh
+ *          characters outside printable ASCII are not in the font, and are not drawn
  */
 void Paint::DrawCharAt(int x, int y, char ascii_char, sFONT* font, int colored) {
     int i, j;
+    if (ascii_char < ' ' || ascii_char > '~') {
+        return;
+    }
     unsigned int char_offset = (ascii_char - ' ') * font->Height * (font->Width / 8 + (font->Width % 8 ? 1 : 0));
     const unsigned char* ptr = &font->table[char_offset];
 
@@ -164,21 +173,166 @@ void Paint::DrawCharAt(int x, int y, char ascii_char, sFONT* font, int colored)
 
 /**
 *  @brief: this displays a string on the frame buffer but not refresh
+*          the text is UTF-8; characters outside printable ASCII are drawn as '?'
 */
 void Paint::DrawStringAt(int x, int y, const char* text, sFONT* font, int colored) {
     const char* p_text = text;
-    unsigned int counter = 0;
+    const char* end = text + strlen(text);
     int refcolumn = x;
     
     /* Send the string character by character on EPD */
-    while (*p_text != 0) {
+    while (p_text != end) {
+        uint32_t codepoint = utf8_next(p_text, end);
         /* Display one character on EPD */
-        DrawCharAt(refcolumn, y, *p_text, font, colored);
+        DrawCharAt(refcolumn, y, codepoint >= ' ' && codepoint <= '~' ? static_cast<char>(codepoint) : '?', font, colored);
         /* Decrement the column position by 16 */
         refcolumn += font->Width;
-        /* Point on the next character */
-        p_text++;
-        counter++;
+    }
+}
+
+/**
+ *  @brief: this draws a character of a proportional or loaded font
+ *          a character the font does not have is drawn as its replacement glyph
+ *          scale (1 to 8) multiplies each pixel of the glyph
+ *  @return: the advance to the next character
+ */
+int Paint::DrawCharAt(int x, int y, uint32_t codepoint, Font* font, int colored, int scale) {
+    Glyph glyph;
+    if (!font->find(codepoint, glyph)) {
+        return 0;
+    }
+    if (scale <= 1) {
+        DrawGlyph(x + glyph.metrics.x_offset, y + glyph.metrics.y_offset, glyph, colored);
+        return glyph.metrics.advance;
+    }
+    scale = scale > bit_expansion_max_scale ? bit_expansion_max_scale : scale;
+    DrawScaledGlyph(x + glyph.metrics.x_offset * scale, y + glyph.metrics.y_offset * scale, glyph, colored, scale);
+    return glyph.metrics.advance * scale;
+}
+
+/**
+*  @brief: this displays a UTF-8 string of a proportional or loaded font
+*/
+void Paint::DrawStringAt(int x, int y, const char* text, Font* font, int colored, int scale) {
+    const char* end = text + strlen(text);
+    while (text != end) {
+        x += DrawCharAt(x, y, utf8_next(text, end), font, colored, scale);
+    }
+}
+
+/**
+ *  @brief: this draws the set pixels of a glyph bitmap
+ *          unrotated, each byte of a row is merged into the frame buffer as a whole;
+ *          otherwise, and at the edges, pixels are drawn one at a time
+ */
+void Paint::DrawGlyph(int x, int y, const Glyph& glyph, int colored) {
+    int row_bytes = (glyph.metrics.width + 7) / 8;
+    const uint8_t* ptr = glyph.bitmap;
+    bool set = IF_INVERT_COLOR ? colored : !colored;
+    for (int j = 0; j < glyph.metrics.height; j++, ptr += row_bytes) {
+        int row = y + j;
+        if (this->rotate == ROTATE_0 && (row < 0 || row >= this->height)) {
+            continue;
+        }
+        for (int k = 0; k < row_bytes; k++) {
+            uint8_t bits = glyph.progmem ? pgm_read_byte(ptr + k) : ptr[k];
+            if (bits == 0) {
+                continue;
+            }
+            int column = x + k * 8;
+            if (this->rotate == ROTATE_0 && column >= 0 && column + 8 <= this->width) {
+                unsigned char* dst = &this->image[(row * this->width + column) / 8];
+                int shift = column % 8;
+                uint8_t first = bits >> shift;
+                uint8_t second = shift ? static_cast<uint8_t>(bits << (8 - shift)) : 0;
+                if (set) {
+                    dst[0] |= first;
+                    if (second) {
+                        dst[1] |= second;
+                    }
+                } else {
+                    dst[0] &= ~first;
+                    if (second) {
+                        dst[1] &= ~second;
+                    }
+                }
+                continue;
+            }
+            for (int i = 0; i < 8; i++) {
+                if (bits & (0x80 >> i)) {
+                    DrawPixel(column + i, row, colored);
+                }
+            }
+        }
+    }
+}
+
+/**
+ *  @brief: this draws a glyph with each pixel multiplied by scale
+ *          unrotated, each glyph row is expanded a nibble at a time through
+ *          bit_expansion, and the expanded row is merged as a byte span into
+ *          each of the scale frame buffer rows it covers; otherwise, and if the
+ *          glyph starts left of the frame, each pixel is drawn as a rectangle
+ */
+void Paint::DrawScaledGlyph(int x, int y, const Glyph& glyph, int colored, int scale) {
+    static const int max_row_bytes = 64;
+    int row_bytes = (glyph.metrics.width + 7) / 8;
+    const uint8_t* ptr = glyph.bitmap;
+
+    if (this->rotate != ROTATE_0 || x < 0) {
+        for (int j = 0; j < glyph.metrics.height; j++, ptr += row_bytes) {
+            for (int i = 0; i < glyph.metrics.width; i++) {
+                uint8_t bits = glyph.progmem ? pgm_read_byte(ptr + i / 8) : ptr[i / 8];
+                if (bits & (0x80 >> (i % 8))) {
+                    DrawFilledRectangle(x + i * scale, y + j * scale, x + (i + 1) * scale - 1, y + (j + 1) * scale - 1, colored);
+                }
+            }
+        }
+        return;
+    }
+
+    int width = glyph.metrics.width * scale;
+    width = width < this->width - x ? width : this->width - x;
+    width = width < max_row_bytes * 8 ? width : max_row_bytes * 8;
+    if (width <= 0) {
+        return;
+    }
+    int source_pixels = (width + scale - 1) / scale;
+    int stride = this->width / 8;
+    bool set = IF_INVERT_COLOR ? colored : !colored;
+    // Room for the last group of four pixels overhanging the width.
+    uint8_t expanded[max_row_bytes + 4 * bit_expansion_max_scale / 8 + 1];
+
+    for (int j = 0; j < glyph.metrics.height; j++, ptr += row_bytes) {
+        int row = y + j * scale;
+        if (row >= this->height) {
+            break;
+        }
+        if (row + scale <= 0) {
+            continue;
+        }
+        uint64_t accumulator = 0;
+        int pending = 0;
+        uint8_t* out = expanded;
+        for (int i = 0; i < source_pixels; i += 4) {
+            uint8_t bits = glyph.progmem ? pgm_read_byte(ptr + i / 8) : ptr[i / 8];
+            uint8_t nibble = i % 8 == 0 ? bits >> 4 : bits & 0x0F;
+            accumulator |= (static_cast<uint64_t>(bit_expansion(scale, nibble)) << 32) >> pending;
+            pending += 4 * scale;
+            while (pending >= 8) {
+                *out++ = static_cast<uint8_t>(accumulator >> 56);
+                accumulator <<= 8;
+                pending -= 8;
+            }
+        }
+        if (pending > 0) {
+            *out = static_cast<uint8_t>(accumulator >> 56);
+        }
+        for (int copy = 0; copy < scale; copy++) {
+            if (row + copy >= 0 && row + copy < this->height) {
+                bitblit_merge_bits(&this->image[(row + copy) * stride], x, expanded, width, set);
+            }
+        }
     }
 }
 
@@ -206,14 +360,61 @@ void Paint::DrawLine(int x0, int y0, int x1, int y1, int colored) {
     }
 }
 
+/**
+ *  @brief: this draws the pixels [x0, x1) of row y, clipped as DrawPixel clips
+ *          unrotated or upside down the span is a run of one physical row, and
+ *          is filled a byte at a time; otherwise it is drawn a pixel at a time
+ *          with a pattern, only the pixels of its set bits are drawn; it is
+ *          tiled from the frame buffer origin, whatever the rotation
+ */
+void Paint::DrawSpan(int x0, int x1, int y, int colored, const FillPattern* pattern) {
+    if (this->rotate == ROTATE_90 || this->rotate == ROTATE_270) {
+        x0 = x0 > 0 ? x0 : 0;
+        x1 = x1 < this->height ? x1 : this->height;
+        if (y < 0 || y >= this->width) {
+            return;
+        }
+        for (int i = x0; i < x1; i++) {
+            if (pattern == 0) {
+                DrawPixel(i, y, colored);
+                continue;
+            }
+            int x_pos = this->rotate == ROTATE_90 ? this->width - y : y;
+            int y_pos = this->rotate == ROTATE_90 ? i : this->height - i;
+            if (pattern->row(y_pos) & (0x80 >> (x_pos % 8))) {
+                DrawAbsolutePixel(x_pos, y_pos, colored);
+            }
+        }
+        return;
+    }
+    x0 = x0 > 0 ? x0 : 0;
+    x1 = x1 < this->width ? x1 : this->width;
+    if (y < 0 || y >= this->height || x0 >= x1) {
+        return;
+    }
+    if (this->rotate == ROTATE_180) {
+        /* pixel x is drawn at width - x, so logical 0 is off the frame */
+        int first = this->width - x1 + 1;
+        x1 = this->width - x0 + 1 < this->width ? this->width - x0 + 1 : this->width;
+        x0 = first;
+        y = this->height - y;
+        if (y >= this->height) {
+            return;
+        }
+    }
+    bool set = IF_INVERT_COLOR ? colored : !colored;
+    if (pattern == 0) {
+        bitblit_fill(&this->image[y * (this->width / 8)], x0, x1, set);
+    } else {
+        bitblit_fill_pattern(&this->image[y * (this->width / 8)], x0, x1, pattern->row(y), set);
+    }
+}
+
 /**
 *  @brief: this draws a horizontal line on the frame buffer
 */
 void Paint::DrawHorizontalLine(int x, int y, int line_width, int colored) {
-    int i;
-    for (i = x; i < x + line_width; i++) {
-        DrawPixel(i, y, colored);
-    }
+    DrawSpan(x, x + line_width, y, colored);
 }
 
 /**
@@ -243,9 +444,9 @@ void Paint::DrawRectangle(int x0, int y0, int x1, int y1, int colored) {
 }
 
 /**
-*  @brief: this draws a filled rectangle
+*  @brief: this draws a filled rectangle, solid or with a pattern
 */
-void Paint::DrawFilledRectangle(int x0, int y0, int x1, int y1, int colored) {
+void Paint::DrawFilledRectangle(int x0, int y0, int x1, int y1, int colored, const FillPattern* pattern) {
     int min_x, min_y, max_x, max_y;
     int i;
     min_x = x1 > x0 ? x0 : x1;
@@ -253,8 +454,8 @@ void Paint::DrawFilledRectangle(int x0, int y0, int x1, int y1, int colored) {
     min_y = y1 > y0 ? y0 : y1;
     max_y = y1 > y0 ? y1 : y0;
     
-    for (i = min_x; i <= max_x; i++) {
-      DrawVerticalLine(i, min_y, max_y - min_y + 1, colored);
+    for (i = min_y; i <= max_y; i++) {
+      DrawSpan(min_x, max_x + 1, i, colored, pattern);
     }
 }
 
@@ -288,6 +489,7 @@ void Paint::DrawCircle(int x, int y, int radius, int colored) {
 
 /**
 *  @brief: this draws a filled circle
+*          each row is drawn once, as a span, when the outline first reaches it
 */
 void Paint::DrawFilledCircle(int x, int y, int radius, int colored) {
     /* Bresenham algorithm */
@@ -295,14 +497,16 @@ void Paint::DrawFilledCircle(int x, int y, int radius, int colored) {
     int y_pos = 0;
     int err = 2 - 2 * radius;
     int e2;
+    int drawn_row = -1;
 
     do {
-        DrawPixel(x - x_pos, y + y_pos, colored);
-        DrawPixel(x + x_pos, y + y_pos, colored);
-        DrawPixel(x + x_pos, y - y_pos, colored);
-        DrawPixel(x - x_pos, y - y_pos, colored);
-        DrawHorizontalLine(x + x_pos, y + y_pos, 2 * (-x_pos) + 1, colored);
-        DrawHorizontalLine(x + x_pos, y - y_pos, 2 * (-x_pos) + 1, colored);
+        if (y_pos != drawn_row) {
+            DrawSpan(x + x_pos, x - x_pos + 1, y + y_pos, colored);
+            if (y_pos != 0) {
+                DrawSpan(x + x_pos, x - x_pos + 1, y - y_pos, colored);
+            }
+            drawn_row = y_pos;
+        }
         e2 = err;
         if (e2 <= y_pos) {
             err += ++y_pos * 2 + 1;
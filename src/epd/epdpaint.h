@@ -36,8 +36,13 @@
 // Color inverse. 1 or 0 = set or reset a bit if set a colored pixel
 #define IF_INVERT_COLOR     1
 
+#include <stdint.h>
 #include "fonts.h"
 
+class Font;
+struct FillPattern;
+struct Glyph;
+
 class Paint {
 public:
     Paint(unsigned char* image, int width, int height);
@@ -54,15 +59,21 @@ public:
     void DrawPixel(int x, int y, int colored);
     void DrawCharAt(int x, int y, char ascii_char, sFONT* font, int colored);
     void DrawStringAt(int x, int y, const char* text, sFONT* font, int colored);
+    int  DrawCharAt(int x, int y, uint32_t codepoint, Font* font, int colored, int scale = 1);
+    void DrawStringAt(int x, int y, const char* text, Font* font, int colored, int scale = 1);
     void DrawLine(int x0, int y0, int x1, int y1, int colored);
+    void DrawSpan(int x0, int x1, int y, int colored, const FillPattern* pattern = 0);
     void DrawHorizontalLine(int x, int y, int width, int colored);
     void DrawVerticalLine(int x, int y, int height, int colored);
     void DrawRectangle(int x0, int y0, int x1, int y1, int colored);
-    void DrawFilledRectangle(int x0, int y0, int x1, int y1, int colored);
+    void DrawFilledRectangle(int x0, int y0, int x1, int y1, int colored, const FillPattern* pattern = 0);
     void DrawCircle(int x, int y, int radius, int colored);
     void DrawFilledCircle(int x, int y, int radius, int colored);
 
 private:
+    void DrawGlyph(int x, int y, const Glyph& glyph, int colored);
+    void DrawScaledGlyph(int x, int y, const Glyph& glyph, int colored, int scale);
+
     unsigned char* image;
     int width;
     int height;
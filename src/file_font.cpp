@@ -0,0 +1,172 @@
+/**
+ * @file file_font.cpp
+ * @brief Bitmap font loaded from a LittleFS file.
+ */
+#include "file_font.h"
+
+#include <LittleFS.h>
+
+bool FileFont::begin(const char *path)
+{
+    end();
+    if (!LittleFS.exists(path))
+    {
+        return false;
+    }
+    file = LittleFS.open(path, "r");
+    if (!file)
+    {
+        return false;
+    }
+    FileHeader header;
+    if (file.read(reinterpret_cast<uint8_t *>(&header), sizeof(header)) != sizeof(header) || header.magic != file_magic ||
+        header.glyph_count == 0 || header.height == 0 || file.size() < sizeof(header) + header.glyph_count * sizeof(FileGlyph))
+    {
+        Serial.println(String("Not a font file: ") + path);
+        file.close();
+        return false;
+    }
+    glyph_count = header.glyph_count;
+    height = header.height;
+    return true;
+}
+
+void FileFont::end()
+{
+    if (glyph_count != 0)
+    {
+        file.close();
+    }
+    glyph_count = 0;
+    height = 0;
+    entry_count = 0;
+    arena_used = 0;
+}
+
+bool FileFont::read_index(uint32_t codepoint, FileGlyph &found)
+{
+    int low{0};
+    int high{glyph_count - 1};
+    while (low <= high)
+    {
+        int middle{(low + high) / 2};
+        if (!file.seek(sizeof(FileHeader) + middle * sizeof(FileGlyph)) ||
+            file.read(reinterpret_cast<uint8_t *>(&found), sizeof(found)) != sizeof(found))
+        {
+            return false;
+        }
+        if (found.codepoint == codepoint)
+        {
+            return true;
+        }
+        if (found.codepoint < codepoint)
+        {
+            low = middle + 1;
+        }
+        else
+        {
+            high = middle - 1;
+        }
+    }
+    return false;
+}
+
+void FileFont::evict(size_t index)
+{
+    // Bitmaps are packed in entry order; close the gap.
+    Entry removed{entries[index]};
+    memmove(&arena[removed.offset], &arena[removed.offset + removed.length], arena_used - removed.offset - removed.length);
+    arena_used -= removed.length;
+    for (size_t i = index + 1; i < entry_count; ++i)
+    {
+        entries[i].offset -= removed.length;
+        entries[i - 1] = entries[i];
+    }
+    --entry_count;
+}
+
+FileFont::Entry *FileFont::insert(uint32_t codepoint, const FileGlyph *found)
+{
+    size_t length{0};
+    if (found != nullptr)
+    {
+        length = static_cast<size_t>((found->metrics.width + 7) / 8) * found->metrics.height;
+        if (length > arena_size)
+        {
+            return nullptr;
+        }
+    }
+    while (entry_count == max_entries || arena_used + length > arena_size)
+    {
+        size_t oldest{0};
+        for (size_t i = 1; i < entry_count; ++i)
+        {
+            if (entries[i].last_access < entries[oldest].last_access)
+            {
+                oldest = i;
+            }
+        }
+        evict(oldest);
+    }
+
+    Entry &entry{entries[entry_count]};
+    entry = Entry{codepoint, GlyphMetrics{}, false, static_cast<uint16_t>(arena_used), static_cast<uint16_t>(length), ++access_clock};
+    if (found != nullptr)
+    {
+        size_t position{sizeof(FileHeader) + glyph_count * sizeof(FileGlyph) + found->offset};
+        if (!file.seek(position) || file.read(&arena[arena_used], length) != static_cast<int>(length))
+        {
+            return nullptr;
+        }
+        entry.metrics = found->metrics;
+        entry.present = true;
+    }
+    arena_used += length;
+    ++entry_count;
+    return &entry;
+}
+
+FileFont::Entry *FileFont::lookup(uint32_t codepoint)
+{
+    if (glyph_count == 0)
+    {
+        return nullptr;
+    }
+    for (size_t i = 0; i < entry_count; ++i)
+    {
+        if (entries[i].codepoint == codepoint)
+        {
+            entries[i].last_access = ++access_clock;
+            return &entries[i];
+        }
+    }
+
+    // Missing glyphs are cached too, so that their replacement doesn't search the file each time.
+    FileGlyph found;
+    bool present{codepoint <= 0xFFFF && read_index(codepoint, found)};
+    return insert(codepoint, present ? &found : nullptr);
+}
+
+bool FileFont::metrics(uint32_t codepoint, GlyphMetrics &metrics)
+{
+    auto entry{lookup(codepoint)};
+    if (entry == nullptr || !entry->present)
+    {
+        return false;
+    }
+    metrics = entry->metrics;
+    return true;
+}
+
+bool FileFont::glyph(uint32_t codepoint, Glyph &glyph)
+{
+    auto entry{lookup(codepoint)};
+    if (entry == nullptr || !entry->present)
+    {
+        return false;
+    }
+    glyph.metrics = entry->metrics;
+    glyph.bitmap = &arena[entry->offset];
+    glyph.progmem = false;
+    return true;
+}
@@ -0,0 +1,103 @@
+/**
+ * @file file_font.h
+ * @brief Bitmap font loaded from a LittleFS file.
+ *
+ * The file, written by tools/make_font.py, is little endian:
+ * - Header: magic "EPF1", glyph count (16 bits), line height (8 bits), 8 reserved bits.
+ * - Glyph index, sorted by codepoint: for each glyph the offset of its bitmap
+ *   from the end of the index (32 bits), codepoint (16 bits), then the bitmap
+ *   width, height, x offset, y offset and advance, and a reserved byte.
+ * - Bitmaps: rows of (width + 7) / 8 bytes, leftmost pixel in the MSB.
+ *
+ * Glyphs are read as they are used, and kept in a small cache, so repeated
+ * characters don't read the file again.
+ */
+#ifndef FILE_FONT_H
+#define FILE_FONT_H
+
+#include <Arduino.h>
+#include <FS.h>
+#include "font.h"
+
+class FileFont : public Font
+{
+public:
+    //!< "EPF1", little endian.
+    static constexpr uint32_t file_magic{0x31465045};
+
+    FileFont() = default;
+    FileFont(const FileFont &) = delete;
+    FileFont &operator=(const FileFont &) = delete;
+
+    /**
+     * @brief Open a font file.
+     *
+     * @param path Path of the file in LittleFS.
+     * @return true if the file is a valid font.
+     */
+    bool begin(const char *path);
+
+    //!< Close the file, and empty the cache.
+    void end();
+
+    bool loaded() const
+    {
+        return glyph_count != 0;
+    }
+
+    int line_height() const override
+    {
+        return height;
+    }
+
+    bool metrics(uint32_t codepoint, GlyphMetrics &metrics) override;
+    bool glyph(uint32_t codepoint, Glyph &glyph) override;
+
+private:
+    //!< Bytes of glyph bitmaps cached; larger glyphs cannot be drawn.
+    static constexpr size_t arena_size{1024};
+    static constexpr size_t max_entries{32};
+
+    struct FileHeader
+    {
+        uint32_t magic;
+        uint16_t glyph_count;
+        uint8_t height;
+        uint8_t reserved;
+    };
+
+    struct FileGlyph
+    {
+        uint32_t offset;
+        uint16_t codepoint;
+        GlyphMetrics metrics;
+        uint8_t reserved;
+    };
+
+    struct Entry
+    {
+        uint32_t codepoint;
+        GlyphMetrics metrics;
+        bool present;          //!< false if the font has no glyph for the codepoint.
+        uint16_t offset;       //!< Of the bitmap in the arena.
+        uint16_t length;
+        uint32_t last_access;
+    };
+
+    Entry *lookup(uint32_t codepoint);
+    bool read_index(uint32_t codepoint, FileGlyph &found);
+    Entry *insert(uint32_t codepoint, const FileGlyph *found);
+    void evict(size_t index);
+
+    fs::File file;
+    uint16_t glyph_count{0};
+    uint8_t height{0};
+
+    Entry entries[max_entries];
+    size_t entry_count{0};
+    uint8_t arena[arena_size];
+    size_t arena_used{0};
+    uint32_t access_clock{0};
+};
+
+#endif
@@ -0,0 +1,7 @@
+/**
+ * @file fill_pattern.cpp
+ * @brief 8 by 8 pixel patterns for shading areas of a 1 bit per pixel frame buffer.
+ */
+#include "fill_pattern.h"
+
+constexpr FillPatternTable fill_pattern_table PROGMEM{};
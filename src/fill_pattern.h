@@ -0,0 +1,86 @@
+/**
+ * @file fill_pattern.h
+ * @brief 8 by 8 pixel patterns for shading areas of a 1 bit per pixel frame buffer.
+ *
+ * A pattern is tiled from the origin of the frame buffer, so that adjacent
+ * fills line up, and each of its rows is one byte: a row of a fill is that
+ * byte ORed into the frame buffer (or its complement ANDed, for black), at the
+ * cost of a solid fill. Pixels of clear pattern bits are left as they are.
+ *
+ * The standard levels are an ordered dither, from empty (level 0) to solid
+ * (`fill_pattern_levels - 1`); each level sets four more pixels than the one
+ * before, spread as evenly as an 8 by 8 Bayer matrix spreads them.
+ */
+#ifndef FILL_PATTERN_H
+#define FILL_PATTERN_H
+
+#include <Arduino.h>
+
+//!< Number of ordered dither levels, including empty and solid.
+static constexpr int fill_pattern_levels{17};
+
+struct FillPattern
+{
+    uint8_t rows[8];  //!< Leftmost pixel in the MSB; a set bit is drawn.
+
+    //!< Row of the pattern for a frame buffer row.
+    uint8_t row(int y) const
+    {
+        return rows[y & 7];
+    }
+};
+
+struct FillPatternTable
+{
+    FillPattern levels[fill_pattern_levels];
+
+    constexpr FillPatternTable():
+        levels{}
+    {
+        // Bayer matrix of order 8, built up from order 2 by interleaving.
+        int bayer[8][8]{};
+        for (int size = 1; size < 8; size *= 2)
+        {
+            for (int y = 0; y < size; ++y)
+            {
+                for (int x = 0; x < size; ++x)
+                {
+                    int value{4 * bayer[y][x]};
+                    bayer[y][x] = value;
+                    bayer[y][x + size] = value + 2;
+                    bayer[y + size][x] = value + 3;
+                    bayer[y + size][x + size] = value + 1;
+                }
+            }
+        }
+        for (int level = 0; level < fill_pattern_levels; ++level)
+        {
+            for (int y = 0; y < 8; ++y)
+            {
+                uint8_t bits{0};
+                for (int x = 0; x < 8; ++x)
+                {
+                    bits = static_cast<uint8_t>((bits << 1) | (bayer[y][x] < level * 4 ? 1 : 0));
+                }
+                levels[level].rows[y] = bits;
+            }
+        }
+    }
+};
+
+extern const FillPatternTable fill_pattern_table;
+
+/**
+ * @brief A standard level of gray.
+ *
+ * @param level 0 (empty) to `fill_pattern_levels - 1` (solid); clamped.
+ */
+static inline FillPattern fill_pattern_level(int level)
+{
+    level = level < 0 ? 0 : level >= fill_pattern_levels ? fill_pattern_levels - 1 : level;
+    FillPattern pattern;
+    memcpy_P(&pattern, &fill_pattern_table.levels[level], sizeof(pattern));
+    return pattern;
+}
+
+#endif
@@ -0,0 +1,35 @@
+/**
+ * @file fnv1a.h
+ * @brief 32-bit FNV-1a hash, used to name and find cached frames and bitmaps.
+ *
+ * Not collision resistant: anything keyed by it must also compare what it was
+ * made from before using a cached result.
+ */
+#ifndef FNV1A_H
+#define FNV1A_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+//!< Starting value of a hash.
+static constexpr uint32_t fnv1a_basis{2166136261u};
+
+/**
+ * @brief Hash some bytes, continuing from @p hash.
+ *
+ * @param hash   `fnv1a_basis`, or the hash of what came before.
+ * @param data   Bytes to hash.
+ * @param length Number of bytes.
+ * @return The hash.
+ */
+static inline uint32_t fnv1a(uint32_t hash, const void *data, size_t length)
+{
+    auto bytes{static_cast<const uint8_t *>(data)};
+    for (size_t i = 0; i < length; ++i)
+    {
+        hash = (hash ^ bytes[i]) * 16777619u;
+    }
+    return hash;
+}
+
+#endif
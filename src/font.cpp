@@ -0,0 +1,165 @@
+/**
+ * @file font.cpp
+ * @brief Fonts with per-glyph metrics, looked up by Unicode codepoint.
+ */
+#include "font.h"
+
+int Font::advance(uint32_t codepoint)
+{
+    GlyphMetrics glyph_metrics;
+    if (metrics(codepoint, glyph_metrics) || metrics(replacement_codepoint, glyph_metrics))
+    {
+        return glyph_metrics.advance;
+    }
+    return 0;
+}
+
+bool MonoFont::metrics(uint32_t codepoint, GlyphMetrics &metrics)
+{
+    if (codepoint < ' ' || codepoint > '~')
+    {
+        return false;
+    }
+    metrics = GlyphMetrics{static_cast<uint8_t>(font.Width), static_cast<uint8_t>(font.Height), 0, 0, static_cast<uint8_t>(font.Width)};
+    return true;
+}
+
+bool MonoFont::glyph(uint32_t codepoint, Glyph &glyph)
+{
+    if (!metrics(codepoint, glyph.metrics))
+    {
+        return false;
+    }
+    glyph.bitmap = &font.table[(codepoint - ' ') * font.Height * ((font.Width + 7) / 8)];
+    glyph.progmem = true;
+    return true;
+}
+
+bool BitmapFont::find_glyph(uint32_t codepoint, FontGlyph &found) const
+{
+    if (codepoint >= first_codepoint && codepoint - first_codepoint < direct_count)
+    {
+        memcpy_P(&found, &glyphs[codepoint - first_codepoint], sizeof(found));
+        return true;
+    }
+
+    int low{direct_count};
+    int high{glyph_count - 1};
+    while (low <= high)
+    {
+        int middle{(low + high) / 2};
+        memcpy_P(&found, &glyphs[middle], sizeof(found));
+        if (found.codepoint == codepoint)
+        {
+            return true;
+        }
+        if (found.codepoint < codepoint)
+        {
+            low = middle + 1;
+        }
+        else
+        {
+            high = middle - 1;
+        }
+    }
+    return false;
+}
+
+bool BitmapFont::metrics(uint32_t codepoint, GlyphMetrics &metrics)
+{
+    FontGlyph found;
+    if (!find_glyph(codepoint, found))
+    {
+        return false;
+    }
+    metrics = found.metrics;
+    return true;
+}
+
+bool BitmapFont::glyph(uint32_t codepoint, Glyph &glyph)
+{
+    FontGlyph found;
+    if (!find_glyph(codepoint, found))
+    {
+        return false;
+    }
+    // Expand the repeated rows.
+    size_t row_bytes{static_cast<size_t>((found.metrics.width + 7) / 8)};
+    size_t flag_bytes{static_cast<size_t>((found.metrics.height + 7) / 8)};
+    const uint8_t *flags{&bitmaps[found.offset]};
+    const uint8_t *source{flags + flag_bytes};
+    uint8_t *row{decoded};
+    for (int y = 0; y < found.metrics.height; ++y, row += row_bytes)
+    {
+        if (pgm_read_byte(&flags[y / 8]) & (0x80 >> (y % 8)))
+        {
+            memcpy(row, row - row_bytes, row_bytes);
+        }
+        else
+        {
+            memcpy_P(row, source, row_bytes);
+            source += row_bytes;
+        }
+    }
+    glyph.metrics = found.metrics;
+    glyph.bitmap = decoded;
+    glyph.progmem = false;
+    return true;
+}
+
+uint32_t utf8_next(const char *&text, const char *end)
+{
+    static constexpr uint32_t invalid{0xFFFD};
+    auto bytes{reinterpret_cast<const uint8_t *>(text)};
+    uint8_t lead{bytes[0]};
+    ++text;
+    if (lead < 0x80)
+    {
+        return lead;
+    }
+
+    int continuation;
+    uint32_t codepoint;
+    uint32_t minimum;
+    if ((lead & 0xE0) == 0xC0)
+    {
+        continuation = 1;
+        codepoint = lead & 0x1F;
+        minimum = 0x80;
+    }
+    else if ((lead & 0xF0) == 0xE0)
+    {
+        continuation = 2;
+        codepoint = lead & 0x0F;
+        minimum = 0x800;
+    }
+    else if ((lead & 0xF8) == 0xF0)
+    {
+        continuation = 3;
+        codepoint = lead & 0x07;
+        minimum = 0x10000;
+    }
+    else
+    {
+        return invalid;
+    }
+    if (end - text < continuation)
+    {
+        return invalid;
+    }
+    for (int i = 1; i <= continuation; ++i)
+    {
+        if ((bytes[i] & 0xC0) != 0x80)
+        {
+            return invalid;
+        }
+        codepoint = (codepoint << 6) | (bytes[i] & 0x3F);
+    }
+    // Overlong forms, surrogates and values beyond Unicode are malformed.
+    if (codepoint < minimum || (codepoint >= 0xD800 && codepoint <= 0xDFFF) || codepoint > 0x10FFFF)
+    {
+        return invalid;
+    }
+    text += continuation;
+    return codepoint;
+}
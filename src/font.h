@@ -0,0 +1,179 @@
+/**
+ * @file font.h
+ * @brief Fonts with per-glyph metrics, looked up by Unicode codepoint.
+ *
+ * `Font` is the interface `Paint` and `TextLayout` draw and measure text
+ * through. `MonoFont` adapts the fixed-width Waveshare `sFONT` tables, which
+ * hold printable ASCII only; `BitmapFont` is a proportional font with a
+ * bounding box and advance for each glyph, and a table of glyphs sorted by
+ * codepoint. Text is UTF-8.
+ *
+ * Fonts are not destroyed through the interface, and have no virtual
+ * destructor, so that a `BitmapFont` is constant-initialized and the linker
+ * can drop one that is not used.
+ */
+#ifndef FONT_H
+#define FONT_H
+
+#include <Arduino.h>
+#include "epd/fonts.h"
+
+//!< Drawn in place of a character the font does not have.
+static constexpr uint32_t replacement_codepoint{'?'};
+
+struct GlyphMetrics
+{
+    uint8_t width;    //!< Of the bitmap, in pixels.
+    uint8_t height;   //!< Of the bitmap, in pixels.
+    int8_t x_offset;  //!< From the pen position to the left of the bitmap.
+    int8_t y_offset;  //!< From the top of the line to the top of the bitmap.
+    uint8_t advance;  //!< Distance to the next pen position.
+};
+
+struct Glyph
+{
+    GlyphMetrics metrics;
+    const uint8_t *bitmap;  //!< Rows of (width + 7) / 8 bytes, leftmost pixel in the MSB.
+    bool progmem;           //!< Whether `bitmap` is in flash, and must be read with `pgm_read_byte`.
+};
+
+class Font
+{
+public:
+    //!< Distance between successive lines, in pixels.
+    virtual int line_height() const = 0;
+
+    /**
+     * @brief Get the metrics of a glyph.
+     *
+     * @return false if the font has no glyph for the codepoint.
+     */
+    virtual bool metrics(uint32_t codepoint, GlyphMetrics &metrics) = 0;
+
+    /**
+     * @brief Get a glyph.
+     *
+     * The bitmap is valid until the next call.
+     *
+     * @return false if the font has no glyph for the codepoint.
+     */
+    virtual bool glyph(uint32_t codepoint, Glyph &glyph) = 0;
+
+    /**
+     * @brief Get a glyph, or the replacement glyph if the font has no glyph for the codepoint.
+     */
+    bool find(uint32_t codepoint, Glyph &glyph)
+    {
+        return this->glyph(codepoint, glyph) || this->glyph(replacement_codepoint, glyph);
+    }
+
+    /**
+     * @brief Advance of a codepoint, as drawn by `find`.
+     */
+    int advance(uint32_t codepoint);
+
+protected:
+    ~Font() = default;
+};
+
+/**
+ * @brief Adapter for a fixed-width `sFONT`.
+ */
+class MonoFont : public Font
+{
+public:
+    explicit MonoFont(sFONT &font):
+        font(font)
+    {
+    }
+
+    int line_height() const override
+    {
+        return font.Height;
+    }
+
+    bool metrics(uint32_t codepoint, GlyphMetrics &metrics) override;
+    bool glyph(uint32_t codepoint, Glyph &glyph) override;
+
+private:
+    sFONT &font;
+};
+
+/**
+ * @brief A glyph of a `BitmapFont`; the table of these is in flash.
+ */
+struct FontGlyph
+{
+    uint16_t codepoint;
+    uint16_t offset;  //!< Of the encoded bitmap in the font's bitmap table.
+    GlyphMetrics metrics;
+};
+
+/**
+ * @brief Proportional font compiled in as tables in flash.
+ *
+ * Glyphs are sorted by codepoint. A codepoint within the leading run of
+ * consecutive codepoints (printable ASCII) is found by indexing; any other is
+ * found by a binary search.
+ *
+ * Each bitmap is stored with repeated rows removed: (height + 7) / 8 bytes of
+ * flags, MSB first, with a set bit for each row that is the same as the row
+ * above, followed by the rows that are not. These tables are generated by
+ * tools/make_font.py, as selected by font_config.h.
+ */
+class BitmapFont : public Font
+{
+public:
+    //!< Largest decoded glyph bitmap.
+    static constexpr size_t max_glyph_bytes{64};
+
+    constexpr BitmapFont(const FontGlyph *glyphs, uint16_t glyph_count, const uint8_t *bitmaps, uint8_t height,
+        uint16_t first_codepoint, uint16_t direct_count):
+        glyphs(glyphs),
+        glyph_count(glyph_count),
+        bitmaps(bitmaps),
+        height(height),
+        first_codepoint(first_codepoint),
+        direct_count(direct_count)
+    {
+    }
+
+    int line_height() const override
+    {
+        return height;
+    }
+
+    bool metrics(uint32_t codepoint, GlyphMetrics &metrics) override;
+    bool glyph(uint32_t codepoint, Glyph &glyph) override;
+
+private:
+    bool find_glyph(uint32_t codepoint, FontGlyph &found) const;
+
+    const FontGlyph *glyphs;
+    uint16_t glyph_count;
+    const uint8_t *bitmaps;
+    uint8_t height;
+    uint16_t first_codepoint;  //!< Of the leading run of consecutive codepoints.
+    uint16_t direct_count;     //!< Length of the leading run.
+    uint8_t decoded[max_glyph_bytes]{};
+};
+
+//!< Proportional versions of the Waveshare fonts; only the sizes selected in font_config.h exist.
+extern BitmapFont Prop8;
+extern BitmapFont Prop12;
+extern BitmapFont Prop16;
+extern BitmapFont Prop20;
+extern BitmapFont Prop24;
+
+/**
+ * @brief Decode the next UTF-8 character.
+ *
+ * A malformed sequence decodes as U+FFFD, consuming one byte.
+ *
+ * @param text Position in the text; advanced past the character.
+ * @param end  End of the text.
+ * @return The codepoint.
+ */
+uint32_t utf8_next(const char *&text, const char *end);
+
+#endif
@@ -0,0 +1,26 @@
+/**
+ * @file font_config.h
+ * @brief Selection of the built-in proportional fonts.
+ *
+ * tools/make_font.py reads this before each build (it is a PlatformIO extra
+ * script), and regenerates src/font_prop<size>.cpp for each selected size,
+ * holding only the selected characters. Fonts that are not referenced by the
+ * code are dropped by the linker regardless.
+ */
+#ifndef FONT_CONFIG_H
+#define FONT_CONFIG_H
+
+#define FONT_CHARSET_REFERENCED 0  //!< Characters in string literals in src, plus FONT_EXTRA_CHARACTERS.
+#define FONT_CHARSET_ASCII      1  //!< Printable ASCII.
+#define FONT_CHARSET_LATIN1     2  //!< Printable ASCII, the degree sign and the accented Latin-1 letters.
+
+//!< Sizes to build, from those of the Waveshare fonts: 8 12 16 20 24; PropN is generated from FontN.
+//!< The status screens use Prop16 and Prop24.
+#define FONT_SIZES "16 24"
+
+#define FONT_CHARSET FONT_CHARSET_LATIN1
+
+//!< With FONT_CHARSET_REFERENCED, characters that appear only in run-time text, such as addresses.
+#define FONT_EXTRA_CHARACTERS "0123456789.:-_/ ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz"
+
+#endif
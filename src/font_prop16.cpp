@@ -0,0 +1,278 @@
+/**
+ * @file font_prop16.cpp
+ * @brief Proportional font Prop16, generated from font16.c by tools/make_font.py.
+ *
+ * Do not edit; see font_config.h.
+ */
+#include "font.h"
+
+namespace
+{
+    const uint8_t bitmaps[] PROGMEM = {
+        0x7F, 0x00, 0xC0, 0x00, 0xC0, 0x58, 0xEE, 0x44, 0x70, 0xE0, 0x36, 0xFF, 0x6C, 0xFF, 0x6C, 0x10,
+        0x48, 0x10, 0x7E, 0xC6, 0xE0, 0x78, 0x3C, 0x0E, 0xC6, 0xFC, 0x10, 0x20, 0x80, 0x60, 0x90, 0x63,
+        0x1E, 0x78, 0xC6, 0x09, 0x06, 0x30, 0x00, 0x3C, 0x60, 0x30, 0x76, 0xDC, 0xCC, 0x76, 0x58, 0xE0,
+        0x40, 0x47, 0x10, 0x30, 0x60, 0xE0, 0xC0, 0xE0, 0x60, 0x30, 0x4F, 0x80, 0xC0, 0x60, 0x30, 0x60,
+        0xE0, 0xC0, 0x50, 0x18, 0xFF, 0x3C, 0x7E, 0x66, 0x66, 0x10, 0xFE, 0x10, 0x08, 0x60, 0x40, 0xC0,
+        0x80, 0x00, 0xFE, 0x40, 0xC0, 0x54, 0xA8, 0x03, 0x06, 0x0C, 0x18, 0x30, 0x60, 0xC0, 0x1F, 0x00,
+        0x38, 0x6C, 0xC6, 0x6C, 0x38, 0x1F, 0x80, 0x18, 0xF8, 0x18, 0xFF, 0x10, 0x00, 0x3C, 0x66, 0xC6,
+        0x0C, 0x18, 0x30, 0x60, 0xC0, 0xFE, 0x01, 0x00, 0x7E, 0xC3, 0x03, 0x06, 0x3E, 0x07, 0x03, 0xC3,
+        0x7E, 0x40, 0x00, 0x1C, 0x3C, 0x2C, 0x6C, 0x4C, 0xCC, 0xFE, 0x0C, 0x3E, 0x31, 0x00, 0x7E, 0x60,
+        0x7C, 0x46, 0x06, 0x86, 0x7C, 0x01, 0x00, 0x1E, 0x70, 0x60, 0xC0, 0xDC, 0xE6, 0xC6, 0x66, 0x3C,
+        0x0E, 0xC0, 0xFE, 0x86, 0x06, 0x0C, 0x18, 0x33, 0x80, 0x7C, 0xC6, 0x7C, 0xC6, 0x7C, 0x10, 0x00,
+        0x78, 0xCC, 0xC6, 0xCE, 0x76, 0x06, 0x0C, 0x1C, 0xF0, 0x5A, 0xC0, 0x00, 0xC0, 0x58, 0x80, 0x30,
+        0x00, 0x60, 0x40, 0x80, 0x00, 0x00, 0x01, 0x80, 0x06, 0x00, 0x08, 0x00, 0x30, 0x00, 0xC0, 0x00,
+        0x30, 0x00, 0x08, 0x00, 0x06, 0x00, 0x01, 0x80, 0x00, 0xFF, 0x80, 0x00, 0x00, 0xFF, 0x80, 0x00,
+        0x00, 0xC0, 0x00, 0x30, 0x00, 0x08, 0x00, 0x06, 0x00, 0x01, 0x80, 0x06, 0x00, 0x08, 0x00, 0x30,
+        0x00, 0xC0, 0x00, 0x22, 0x00, 0x7C, 0xC6, 0x06, 0x1C, 0x30, 0x00, 0x30, 0x12, 0x00, 0x38, 0x44,
+        0x84, 0x9C, 0xA4, 0x9C, 0x80, 0x44, 0x38, 0x09, 0x00, 0x7E, 0x00, 0x1E, 0x00, 0x12, 0x00, 0x33,
+        0x00, 0x3F, 0x00, 0x61, 0x80, 0xF3, 0xC0, 0x33, 0x00, 0xFE, 0x63, 0x7E, 0x63, 0xFE, 0x0C, 0x00,
+        0x3E, 0x80, 0x61, 0x80, 0xC0, 0x80, 0xC0, 0x00, 0xC0, 0x80, 0x61, 0x00, 0x3E, 0x00, 0x1E, 0x00,
+        0xFE, 0x00, 0x63, 0x00, 0x61, 0x80, 0x63, 0x00, 0xFE, 0x00, 0x21, 0x00, 0xFF, 0x61, 0x64, 0x7C,
+        0x64, 0x61, 0xFF, 0x21, 0x00, 0xFF, 0x80, 0x60, 0x80, 0x64, 0x00, 0x7C, 0x00, 0x64, 0x00, 0x60,
+        0x00, 0xF8, 0x00, 0x08, 0x00, 0x3D, 0x00, 0x63, 0x00, 0xC1, 0x00, 0xC0, 0x00, 0xCF, 0x80, 0xC3,
+        0x00, 0x63, 0x00, 0x3E, 0x00, 0x33, 0x00, 0xF7, 0x80, 0x63, 0x00, 0x7F, 0x00, 0x63, 0x00, 0xF7,
+        0x80, 0x3F, 0x00, 0xFF, 0x18, 0xFF, 0x3B, 0x00, 0x3F, 0x80, 0x06, 0x00, 0xC6, 0x00, 0x7C, 0x00,
+        0x00, 0x00, 0xF7, 0x80, 0x63, 0x00, 0x66, 0x00, 0x6C, 0x00, 0x78, 0x00, 0x7C, 0x00, 0x66, 0x00,
+        0x63, 0x00, 0xF3, 0x80, 0x3B, 0x00, 0xFC, 0x00, 0x30, 0x00, 0x30, 0x80, 0xFF, 0x80, 0x00, 0x00,
+        0xE0, 0xE0, 0x60, 0xC0, 0x71, 0xC0, 0x7B, 0xC0, 0x6A, 0xC0, 0x6E, 0xC0, 0x64, 0xC0, 0x60, 0xC0,
+        0xFB, 0xE0, 0x00, 0x00, 0xE7, 0x80, 0x63, 0x00, 0x73, 0x00, 0x7B, 0x00, 0x6B, 0x00, 0x6F, 0x00,
+        0x67, 0x00, 0x63, 0x00, 0xF3, 0x00, 0x1E, 0x00, 0x3E, 0x00, 0x63, 0x00, 0xC1, 0x80, 0x63, 0x00,
+        0x3E, 0x00, 0x39, 0x00, 0xFE, 0x63, 0x7E, 0x60, 0xFC, 0x1E, 0x00, 0x3E, 0x00, 0x63, 0x00, 0xC1,
+        0x80, 0x63, 0x00, 0x3E, 0x00, 0x19, 0x80, 0x3F, 0x00, 0x31, 0x00, 0xFE, 0x00, 0x63, 0x00, 0x7C,
+        0x00, 0x66, 0x00, 0x63, 0x00, 0xF9, 0xC0, 0x21, 0x00, 0x7E, 0xC6, 0xE0, 0x7C, 0x0E, 0xC6, 0xFC,
+        0x37, 0x00, 0xFF, 0x99, 0x18, 0x7E, 0x3F, 0x00, 0xF7, 0x80, 0x63, 0x00, 0x3E, 0x00, 0x2C, 0x80,
+        0xF7, 0x80, 0x63, 0x00, 0x36, 0x00, 0x14, 0x00, 0x1C, 0x00, 0x09, 0x00, 0xFB, 0xE0, 0x60, 0xC0,
+        0x64, 0xC0, 0x6E, 0xC0, 0x2A, 0x80, 0x3B, 0x80, 0x31, 0x80, 0x0C, 0x00, 0xF7, 0x80, 0x63, 0x00,
+        0x36, 0x00, 0x1C, 0x00, 0x36, 0x00, 0x63, 0x00, 0xF7, 0x80, 0x07, 0x00, 0xF3, 0xC0, 0x61, 0x80,
+        0x33, 0x00, 0x1E, 0x00, 0x0C, 0x00, 0x3F, 0x00, 0x00, 0x00, 0xFE, 0x86, 0x8C, 0x18, 0x10, 0x30,
+        0x62, 0xC2, 0xFE, 0x3F, 0xE0, 0xF0, 0xC0, 0xF0, 0x54, 0xA8, 0xC0, 0x60, 0x30, 0x18, 0x0C, 0x06,
+        0x03, 0x3F, 0xE0, 0xF0, 0x30, 0xF0, 0x24, 0x10, 0x28, 0x44, 0x82, 0x00, 0xFF, 0xE0, 0x00, 0x80,
+        0x40, 0x20, 0x20, 0x7C, 0x06, 0x7E, 0xC6, 0xCE, 0x77, 0x23, 0x00, 0xE0, 0x00, 0x60, 0x00, 0x6E,
+        0x00, 0x73, 0x00, 0x61, 0x80, 0x73, 0x00, 0xEE, 0x00, 0x00, 0x3D, 0x63, 0xC1, 0xC0, 0xC1, 0x63,
+        0x3E, 0x23, 0x00, 0x07, 0x00, 0x03, 0x00, 0x3B, 0x00, 0x67, 0x00, 0xC3, 0x00, 0x67, 0x00, 0x3B,
+        0x80, 0x00, 0x3E, 0x00, 0x63, 0x00, 0xC1, 0x80, 0xFF, 0x80, 0xC0, 0x00, 0x61, 0x80, 0x3F, 0x00,
+        0x27, 0x80, 0x1F, 0x80, 0x30, 0x00, 0xFE, 0x00, 0x30, 0x00, 0xFE, 0x00, 0x18, 0x80, 0x3B, 0x80,
+        0x67, 0x00, 0xC3, 0x00, 0x67, 0x00, 0x3B, 0x00, 0x03, 0x00, 0x3E, 0x00, 0x23, 0x80, 0xE0, 0x00,
+        0x60, 0x00, 0x6E, 0x00, 0x73, 0x00, 0x63, 0x00, 0xF7, 0x80, 0x47, 0x80, 0x18, 0x00, 0x78, 0x18,
+        0xFF, 0x47, 0xF0, 0x18, 0x00, 0xFC, 0x0C, 0xF8, 0x22, 0x00, 0xE0, 0x00, 0x60, 0x00, 0x6F, 0x00,
+        0x6C, 0x00, 0x78, 0x00, 0x6C, 0x00, 0x66, 0x00, 0xEF, 0x80, 0x3F, 0x80, 0x78, 0x18, 0xFF, 0x3C,
+        0xFF, 0x00, 0x6D, 0x80, 0xED, 0xC0, 0x1C, 0xEE, 0x00, 0x73, 0x00, 0x63, 0x00, 0xF7, 0x80, 0x18,
+        0x3E, 0x00, 0x63, 0x00, 0xC1, 0x80, 0x63, 0x00, 0x3E, 0x00, 0x18, 0x80, 0xEE, 0x00, 0x73, 0x00,
+        0x61, 0x80, 0x73, 0x00, 0x6E, 0x00, 0x60, 0x00, 0xF8, 0x00, 0x18, 0x80, 0x3B, 0x80, 0x67, 0x00,
+        0xC3, 0x00, 0x67, 0x00, 0x3B, 0x00, 0x03, 0x00, 0x0F, 0x80, 0x1C, 0xF7, 0x00, 0x39, 0x80, 0x30,
+        0x00, 0xFE, 0x00, 0x00, 0x7E, 0xC6, 0xF0, 0x7C, 0x0E, 0xC6, 0xFC, 0x67, 0x00, 0x30, 0xFE, 0x30,
+        0x31, 0x1E, 0x38, 0xE7, 0x00, 0x63, 0x00, 0x67, 0x00, 0x3B, 0x80, 0x2A, 0xF7, 0x80, 0x63, 0x00,
+        0x36, 0x00, 0x1C, 0x00, 0x04, 0xF1, 0xE0, 0x60, 0xC0, 0x64, 0xC0, 0x6E, 0xC0, 0x3B, 0x80, 0x31,
+        0x80, 0x18, 0xF7, 0x80, 0x36, 0x00, 0x1C, 0x00, 0x36, 0x00, 0xF7, 0x80, 0x11, 0x00, 0xF3, 0xC0,
+        0x61, 0x80, 0x33, 0x00, 0x16, 0x00, 0x1E, 0x00, 0x0C, 0x00, 0x18, 0x00, 0x7C, 0x00, 0x00, 0xFE,
+        0x86, 0x0C, 0x38, 0x60, 0xC2, 0xFE, 0x3C, 0xE0, 0x30, 0x60, 0xC0, 0x60, 0x30, 0x7F, 0xF0, 0xC0,
+        0x3C, 0xE0, 0xC0, 0x60, 0x30, 0x60, 0xC0, 0x00, 0x60, 0x92, 0x0C, 0x20, 0x60, 0x90, 0x60, 0x01,
+        0x20, 0x30, 0x00, 0x0C, 0x00, 0x00, 0x00, 0x7E, 0x00, 0x1E, 0x00, 0x12, 0x00, 0x33, 0x00, 0x3F,
+        0x00, 0x61, 0x80, 0xF3, 0xC0, 0x01, 0x20, 0x06, 0x00, 0x18, 0x00, 0x00, 0x00, 0x7E, 0x00, 0x1E,
+        0x00, 0x12, 0x00, 0x33, 0x00, 0x3F, 0x00, 0x61, 0x80, 0xF3, 0xC0, 0x01, 0x20, 0x1C, 0x00, 0x36,
+        0x00, 0x00, 0x00, 0x7E, 0x00, 0x1E, 0x00, 0x12, 0x00, 0x33, 0x00, 0x3F, 0x00, 0x61, 0x80, 0xF3,
+        0xC0, 0x01, 0x20, 0x1A, 0x00, 0x2C, 0x00, 0x00, 0x00, 0x7E, 0x00, 0x1E, 0x00, 0x12, 0x00, 0x33,
+        0x00, 0x3F, 0x00, 0x61, 0x80, 0xF3, 0xC0, 0x41, 0x20, 0x36, 0x00, 0x00, 0x00, 0x7E, 0x00, 0x1E,
+        0x00, 0x12, 0x00, 0x33, 0x00, 0x3F, 0x00, 0x61, 0x80, 0xF3, 0xC0, 0x00, 0x90, 0x1C, 0x00, 0x36,
+        0x00, 0x1C, 0x00, 0x00, 0x00, 0x7E, 0x00, 0x1E, 0x00, 0x12, 0x00, 0x33, 0x00, 0x3F, 0x00, 0x61,
+        0x80, 0xF3, 0xC0, 0x0C, 0x00, 0x3E, 0x80, 0x61, 0x80, 0xC0, 0x80, 0xC0, 0x00, 0xC0, 0x80, 0x61,
+        0x00, 0x3E, 0x00, 0x0C, 0x00, 0x18, 0x00, 0x04, 0x20, 0x60, 0x18, 0x00, 0xFF, 0x61, 0x64, 0x7C,
+        0x64, 0x61, 0xFF, 0x04, 0x20, 0x0C, 0x30, 0x00, 0xFF, 0x61, 0x64, 0x7C, 0x64, 0x61, 0xFF, 0x04,
+        0x20, 0x38, 0x6C, 0x00, 0xFF, 0x61, 0x64, 0x7C, 0x64, 0x61, 0xFF, 0x44, 0x20, 0x6C, 0x00, 0xFF,
+        0x61, 0x64, 0x7C, 0x64, 0x61, 0xFF, 0x07, 0xE0, 0x60, 0x18, 0x00, 0xFF, 0x18, 0xFF, 0x07, 0xE0,
+        0x0C, 0x30, 0x00, 0xFF, 0x18, 0xFF, 0x07, 0xE0, 0x38, 0x6C, 0x00, 0xFF, 0x18, 0xFF, 0x47, 0xE0,
+        0x6C, 0x00, 0xFF, 0x18, 0xFF, 0x00, 0x00, 0x1A, 0x00, 0x2C, 0x00, 0x00, 0x00, 0xE7, 0x80, 0x63,
+        0x00, 0x73, 0x00, 0x7B, 0x00, 0x6B, 0x00, 0x6F, 0x00, 0x67, 0x00, 0x63, 0x00, 0xF3, 0x00, 0x03,
+        0xC0, 0x30, 0x00, 0x0C, 0x00, 0x00, 0x00, 0x3E, 0x00, 0x63, 0x00, 0xC1, 0x80, 0x63, 0x00, 0x3E,
+        0x00, 0x03, 0xC0, 0x06, 0x00, 0x18, 0x00, 0x00, 0x00, 0x3E, 0x00, 0x63, 0x00, 0xC1, 0x80, 0x63,
+        0x00, 0x3E, 0x00, 0x03, 0xC0, 0x1C, 0x00, 0x36, 0x00, 0x00, 0x00, 0x3E, 0x00, 0x63, 0x00, 0xC1,
+        0x80, 0x63, 0x00, 0x3E, 0x00, 0x03, 0xC0, 0x1A, 0x00, 0x2C, 0x00, 0x00, 0x00, 0x3E, 0x00, 0x63,
+        0x00, 0xC1, 0x80, 0x63, 0x00, 0x3E, 0x00, 0x43, 0xC0, 0x36, 0x00, 0x00, 0x00, 0x3E, 0x00, 0x63,
+        0x00, 0xC1, 0x80, 0x63, 0x00, 0x3E, 0x00, 0x07, 0xE0, 0x30, 0x00, 0x0C, 0x00, 0x00, 0x00, 0xF7,
+        0x80, 0x63, 0x00, 0x3E, 0x00, 0x07, 0xE0, 0x06, 0x00, 0x18, 0x00, 0x00, 0x00, 0xF7, 0x80, 0x63,
+        0x00, 0x3E, 0x00, 0x07, 0xE0, 0x1C, 0x00, 0x36, 0x00, 0x00, 0x00, 0xF7, 0x80, 0x63, 0x00, 0x3E,
+        0x00, 0x47, 0xE0, 0x36, 0x00, 0x00, 0x00, 0xF7, 0x80, 0x63, 0x00, 0x3E, 0x00, 0x00, 0xE0, 0x06,
+        0x00, 0x18, 0x00, 0x00, 0x00, 0xF3, 0xC0, 0x61, 0x80, 0x33, 0x00, 0x1E, 0x00, 0x0C, 0x00, 0x3F,
+        0x00, 0x04, 0x00, 0x60, 0x18, 0x00, 0x7C, 0x06, 0x7E, 0xC6, 0xCE, 0x77, 0x04, 0x00, 0x0C, 0x30,
+        0x00, 0x7C, 0x06, 0x7E, 0xC6, 0xCE, 0x77, 0x04, 0x00, 0x38, 0x6C, 0x00, 0x7C, 0x06, 0x7E, 0xC6,
+        0xCE, 0x77, 0x04, 0x00, 0x34, 0x58, 0x00, 0x7C, 0x06, 0x7E, 0xC6, 0xCE, 0x77, 0x44, 0x00, 0x6C,
+        0x00, 0x7C, 0x06, 0x7E, 0xC6, 0xCE, 0x77, 0x02, 0x00, 0x38, 0x6C, 0x38, 0x00, 0x7C, 0x06, 0x7E,
+        0xC6, 0xCE, 0x77, 0x00, 0x00, 0x3D, 0x63, 0xC1, 0xC0, 0xC1, 0x63, 0x3E, 0x0C, 0x18, 0x00, 0x00,
+        0x30, 0x00, 0x0C, 0x00, 0x00, 0x00, 0x3E, 0x00, 0x63, 0x00, 0xC1, 0x80, 0xFF, 0x80, 0xC0, 0x00,
+        0x61, 0x80, 0x3F, 0x00, 0x00, 0x00, 0x06, 0x00, 0x18, 0x00, 0x00, 0x00, 0x3E, 0x00, 0x63, 0x00,
+        0xC1, 0x80, 0xFF, 0x80, 0xC0, 0x00, 0x61, 0x80, 0x3F, 0x00, 0x00, 0x00, 0x1C, 0x00, 0x36, 0x00,
+        0x00, 0x00, 0x3E, 0x00, 0x63, 0x00, 0xC1, 0x80, 0xFF, 0x80, 0xC0, 0x00, 0x61, 0x80, 0x3F, 0x00,
+        0x40, 0x00, 0x36, 0x00, 0x00, 0x00, 0x3E, 0x00, 0x63, 0x00, 0xC1, 0x80, 0xFF, 0x80, 0xC0, 0x00,
+        0x61, 0x80, 0x3F, 0x00, 0x07, 0x80, 0x60, 0x18, 0x00, 0x78, 0x18, 0xFF, 0x07, 0x80, 0x0C, 0x30,
+        0x00, 0x78, 0x18, 0xFF, 0x07, 0x80, 0x38, 0x6C, 0x00, 0x78, 0x18, 0xFF, 0x47, 0x80, 0x6C, 0x00,
+        0x78, 0x18, 0xFF, 0x03, 0x80, 0x1A, 0x00, 0x2C, 0x00, 0x00, 0x00, 0xEE, 0x00, 0x73, 0x00, 0x63,
+        0x00, 0xF7, 0x80, 0x03, 0x00, 0x30, 0x00, 0x0C, 0x00, 0x00, 0x00, 0x3E, 0x00, 0x63, 0x00, 0xC1,
+        0x80, 0x63, 0x00, 0x3E, 0x00, 0x03, 0x00, 0x06, 0x00, 0x18, 0x00, 0x00, 0x00, 0x3E, 0x00, 0x63,
+        0x00, 0xC1, 0x80, 0x63, 0x00, 0x3E, 0x00, 0x03, 0x00, 0x1C, 0x00, 0x36, 0x00, 0x00, 0x00, 0x3E,
+        0x00, 0x63, 0x00, 0xC1, 0x80, 0x63, 0x00, 0x3E, 0x00, 0x03, 0x00, 0x1A, 0x00, 0x2C, 0x00, 0x00,
+        0x00, 0x3E, 0x00, 0x63, 0x00, 0xC1, 0x80, 0x63, 0x00, 0x3E, 0x00, 0x43, 0x00, 0x36, 0x00, 0x00,
+        0x00, 0x3E, 0x00, 0x63, 0x00, 0xC1, 0x80, 0x63, 0x00, 0x3E, 0x00, 0x07, 0x00, 0x30, 0x00, 0x0C,
+        0x00, 0x00, 0x00, 0xE7, 0x00, 0x63, 0x00, 0x67, 0x00, 0x3B, 0x80, 0x07, 0x00, 0x06, 0x00, 0x18,
+        0x00, 0x00, 0x00, 0xE7, 0x00, 0x63, 0x00, 0x67, 0x00, 0x3B, 0x80, 0x07, 0x00, 0x1C, 0x00, 0x36,
+        0x00, 0x00, 0x00, 0xE7, 0x00, 0x63, 0x00, 0x67, 0x00, 0x3B, 0x80, 0x47, 0x00, 0x36, 0x00, 0x00,
+        0x00, 0xE7, 0x00, 0x63, 0x00, 0x67, 0x00, 0x3B, 0x80, 0x02, 0x20, 0x06, 0x00, 0x18, 0x00, 0x00,
+        0x00, 0xF3, 0xC0, 0x61, 0x80, 0x33, 0x00, 0x16, 0x00, 0x1E, 0x00, 0x0C, 0x00, 0x18, 0x00, 0x7C,
+        0x00, 0x42, 0x20, 0x36, 0x00, 0x00, 0x00, 0xF3, 0xC0, 0x61, 0x80, 0x33, 0x00, 0x16, 0x00, 0x1E,
+        0x00, 0x0C, 0x00, 0x18, 0x00, 0x7C, 0x00,
+    };
+
+    const FontGlyph glyphs[] PROGMEM = {
+        {0x0020,     0, { 0,  0, 0,  0,  6}},  //  
+        {0x0021,     0, { 2, 10, 0,  1,  3}},  // !
+        {0x0022,     5, { 7,  5, 0,  2,  8}},  // "
+        {0x0023,     8, { 8, 11, 0,  1,  9}},  // #
+        {0x0024,    15, { 7, 13, 0,  0,  8}},  // $
+        {0x0025,    27, { 8, 10, 0,  1,  9}},  // %
+        {0x0026,    37, { 7,  9, 0,  2,  8}},  // &
+        {0x0027,    46, { 3,  5, 0,  2,  4}},  // '
+        {0x0028,    49, { 4, 12, 0,  1,  5}},  // (
+        {0x0029,    58, { 4, 12, 0,  1,  5}},  // )
+        {0x002A,    66, { 8,  7, 0,  1,  9}},  // *
+        {0x002B,    72, { 7,  7, 0,  3,  8}},  // +
+        {0x002C,    76, { 3,  5, 0,  9,  4}},  // ,
+        {0x002D,    81, { 7,  1, 0,  6,  8}},  // -
+        {0x002E,    83, { 2,  2, 0,  9,  3}},  // .
+        {0x002F,    85, { 8, 13, 0,  0,  9}},  // /
+        {0x0030,    94, { 7, 10, 0,  1,  8}},  // 0
+        {0x0031,   101, { 8, 10, 0,  1,  9}},  // 1
+        {0x0032,   107, { 7, 10, 0,  1,  8}},  // 2
+        {0x0033,   118, { 8, 10, 0,  1,  9}},  // 3
+        {0x0034,   129, { 7, 10, 0,  1,  8}},  // 4
+        {0x0035,   140, { 7, 10, 0,  1,  8}},  // 5
+        {0x0036,   149, { 7, 10, 0,  1,  8}},  // 6
+        {0x0037,   160, { 7, 10, 0,  1,  8}},  // 7
+        {0x0038,   167, { 7, 10, 0,  1,  8}},  // 8
+        {0x0039,   174, { 7, 10, 0,  1,  8}},  // 9
+        {0x003A,   185, { 2,  7, 0,  4,  3}},  // :
+        {0x003B,   189, { 4,  9, 0,  4,  5}},  // ;
+        {0x003C,   196, { 9,  9, 0,  2, 10}},  // <
+        {0x003D,   216, { 9,  3, 0,  5, 10}},  // =
+        {0x003E,   223, { 9,  9, 0,  2, 10}},  // >
+        {0x003F,   243, { 7,  9, 0,  2,  8}},  // ?
+        {0x0040,   252, { 6, 11, 0,  1,  7}},  // @
+        {0x0041,   263, {10,  9, 0,  2, 11}},  // A
+        {0x0042,   279, { 8,  9, 0,  2,  9}},  // B
+        {0x0043,   286, { 9,  9, 0,  2, 10}},  // C
+        {0x0044,   302, { 9,  9, 0,  2, 10}},  // D
+        {0x0045,   314, { 8,  9, 0,  2,  9}},  // E
+        {0x0046,   323, { 9,  9, 0,  2, 10}},  // F
+        {0x0047,   339, { 9,  9, 0,  2, 10}},  // G
+        {0x0048,   357, { 9,  9, 0,  2, 10}},  // H
+        {0x0049,   369, { 8,  9, 0,  2,  9}},  // I
+        {0x004A,   374, { 9,  9, 0,  2, 10}},  // J
+        {0x004B,   384, { 9,  9, 0,  2, 10}},  // K
+        {0x004C,   404, { 9,  9, 0,  2, 10}},  // L
+        {0x004D,   414, {11,  9, 0,  2, 12}},  // M
+        {0x004E,   434, { 9,  9, 0,  2, 10}},  // N
+        {0x004F,   454, { 9,  9, 0,  2, 10}},  // O
+        {0x0050,   466, { 8,  9, 0,  2,  9}},  // P
+        {0x0051,   473, { 9, 11, 0,  2, 10}},  // Q
+        {0x0052,   489, {10,  9, 0,  2, 11}},  // R
+        {0x0053,   503, { 7,  9, 0,  2,  8}},  // S
+        {0x0054,   512, { 8,  9, 0,  2,  9}},  // T
+        {0x0055,   518, { 9,  9, 0,  2, 10}},  // U
+        {0x0056,   526, { 9,  9, 0,  2, 10}},  // V
+        {0x0057,   538, {11,  9, 0,  2, 12}},  // W
+        {0x0058,   554, { 9,  9, 0,  2, 10}},  // X
+        {0x0059,   570, {10,  9, 0,  2, 11}},  // Y
+        {0x005A,   584, { 7,  9, 0,  2,  8}},  // Z
+        {0x005B,   595, { 4, 12, 0,  1,  5}},  // [
+        {0x005C,   600, { 8, 13, 0,  0,  9}},  // backslash
+        {0x005D,   609, { 4, 12, 0,  1,  5}},  // ]
+        {0x005E,   614, { 7,  6, 0,  0,  8}},  // ^
+        {0x005F,   619, {11,  1, 0, 15, 12}},  // _
+        {0x0060,   622, { 3,  3, 0,  0,  4}},  // `
+        {0x0061,   626, { 8,  7, 0,  4,  9}},  // a
+        {0x0062,   633, { 9, 10, 0,  1, 10}},  // b
+        {0x0063,   649, { 8,  7, 0,  4,  9}},  // c
+        {0x0064,   657, { 9, 10, 0,  1, 10}},  // d
+        {0x0065,   673, { 9,  7, 0,  4, 10}},  // e
+        {0x0066,   688, { 9, 10, 0,  1, 10}},  // f
+        {0x0067,   700, { 9, 10, 0,  4, 10}},  // g
+        {0x0068,   716, { 9, 10, 0,  1, 10}},  // h
+        {0x0069,   730, { 8, 10, 0,  1,  9}},  // i
+        {0x006A,   737, { 6, 13, 0,  1,  7}},  // j
+        {0x006B,   744, { 9, 10, 0,  1, 10}},  // k
+        {0x006C,   762, { 8, 10, 0,  1,  9}},  // l
+        {0x006D,   767, {10,  7, 0,  4, 11}},  // m
+        {0x006E,   774, { 9,  7, 0,  4, 10}},  // n
+        {0x006F,   783, { 9,  7, 0,  4, 10}},  // o
+        {0x0070,   794, { 9, 10, 0,  4, 10}},  // p
+        {0x0071,   810, { 9, 10, 0,  4, 10}},  // q
+        {0x0072,   826, { 9,  7, 0,  4, 10}},  // r
+        {0x0073,   835, { 7,  7, 0,  4,  8}},  // s
+        {0x0074,   843, { 8, 10, 0,  1,  9}},  // t
+        {0x0075,   850, { 9,  7, 0,  4, 10}},  // u
+        {0x0076,   859, { 9,  7, 0,  4, 10}},  // v
+        {0x0077,   868, {11,  7, 0,  4, 12}},  // w
+        {0x0078,   881, { 9,  7, 0,  4, 10}},  // x
+        {0x0079,   892, {10, 10, 0,  4, 11}},  // y
+        {0x007A,   910, { 7,  7, 0,  4,  8}},  // z
+        {0x007B,   918, { 4, 12, 0,  1,  5}},  // {
+        {0x007C,   925, { 2, 12, 0,  1,  3}},  // |
+        {0x007D,   928, { 4, 12, 0,  1,  5}},  // }
+        {0x007E,   935, { 7,  3, 0,  5,  8}},  // ~
+        {0x00B0,   939, { 4,  4, 0,  2,  5}},  // °
+        {0x00C0,   943, {10, 12, 0, -1, 11}},  // À
+        {0x00C1,   965, {10, 12, 0, -1, 11}},  // Á
+        {0x00C2,   987, {10, 12, 0, -1, 11}},  // Â
+        {0x00C3,  1009, {10, 12, 0, -1, 11}},  // Ã
+        {0x00C4,  1031, {10, 12, 0, -1, 11}},  // Ä
+        {0x00C5,  1051, {10, 13, 0, -2, 11}},  // Å
+        {0x00C7,  1075, { 9, 11, 0,  2, 10}},  // Ç
+        {0x00C8,  1095, { 8, 12, 0, -1,  9}},  // È
+        {0x00C9,  1107, { 8, 12, 0, -1,  9}},  // É
+        {0x00CA,  1119, { 8, 12, 0, -1,  9}},  // Ê
+        {0x00CB,  1131, { 8, 12, 0, -1,  9}},  // Ë
+        {0x00CC,  1142, { 8, 12, 0, -1,  9}},  // Ì
+        {0x00CD,  1150, { 8, 12, 0, -1,  9}},  // Í
+        {0x00CE,  1158, { 8, 12, 0, -1,  9}},  // Î
+        {0x00CF,  1166, { 8, 12, 0, -1,  9}},  // Ï
+        {0x00D1,  1173, { 9, 12, 0, -1, 10}},  // Ñ
+        {0x00D2,  1199, { 9, 12, 0, -1, 10}},  // Ò
+        {0x00D3,  1217, { 9, 12, 0, -1, 10}},  // Ó
+        {0x00D4,  1235, { 9, 12, 0, -1, 10}},  // Ô
+        {0x00D5,  1253, { 9, 12, 0, -1, 10}},  // Õ
+        {0x00D6,  1271, { 9, 12, 0, -1, 10}},  // Ö
+        {0x00D9,  1287, { 9, 12, 0, -1, 10}},  // Ù
+        {0x00DA,  1301, { 9, 12, 0, -1, 10}},  // Ú
+        {0x00DB,  1315, { 9, 12, 0, -1, 10}},  // Û
+        {0x00DC,  1329, { 9, 12, 0, -1, 10}},  // Ü
+        {0x00DD,  1341, {10, 12, 0, -1, 11}},  // Ý
+        {0x00E0,  1361, { 8, 10, 0,  1,  9}},  // à
+        {0x00E1,  1372, { 8, 10, 0,  1,  9}},  // á
+        {0x00E2,  1383, { 8, 10, 0,  1,  9}},  // â
+        {0x00E3,  1394, { 8, 10, 0,  1,  9}},  // ã
+        {0x00E4,  1405, { 8, 10, 0,  1,  9}},  // ä
+        {0x00E5,  1415, { 8, 11, 0,  0,  9}},  // å
+        {0x00E7,  1427, { 8,  9, 0,  4,  9}},  // ç
+        {0x00E8,  1438, { 9, 10, 0,  1, 10}},  // è
+        {0x00E9,  1460, { 9, 10, 0,  1, 10}},  // é
+        {0x00EA,  1482, { 9, 10, 0,  1, 10}},  // ê
+        {0x00EB,  1504, { 9, 10, 0,  1, 10}},  // ë
+        {0x00EC,  1524, { 8, 10, 0,  1,  9}},  // ì
+        {0x00ED,  1532, { 8, 10, 0,  1,  9}},  // í
+        {0x00EE,  1540, { 8, 10, 0,  1,  9}},  // î
+        {0x00EF,  1548, { 8, 10, 0,  1,  9}},  // ï
+        {0x00F1,  1555, { 9, 10, 0,  1, 10}},  // ñ
+        {0x00F2,  1571, { 9, 10, 0,  1, 10}},  // ò
+        {0x00F3,  1589, { 9, 10, 0,  1, 10}},  // ó
+        {0x00F4,  1607, { 9, 10, 0,  1, 10}},  // ô
+        {0x00F5,  1625, { 9, 10, 0,  1, 10}},  // õ
+        {0x00F6,  1643, { 9, 10, 0,  1, 10}},  // ö
+        {0x00F9,  1659, { 9, 10, 0,  1, 10}},  // ù
+        {0x00FA,  1675, { 9, 10, 0,  1, 10}},  // ú
+        {0x00FB,  1691, { 9, 10, 0,  1, 10}},  // û
+        {0x00FC,  1707, { 9, 10, 0,  1, 10}},  // ü
+        {0x00FD,  1721, {10, 13, 0,  1, 11}},  // ý
+        {0x00FF,  1745, {10, 13, 0,  1, 11}},  // ÿ
+    };
+}
+
+BitmapFont Prop16{glyphs, sizeof(glyphs) / sizeof(glyphs[0]), bitmaps, 16, 0x0020, 95};
@@ -0,0 +1,351 @@
+/**
+ * @file font_prop24.cpp
+ * @brief Proportional font Prop24, generated from font24.c by tools/make_font.py.
+ *
+ * Do not edit; see font_config.h.
+ */
+#include "font.h"
+
+namespace
+{
+    const uint8_t bitmaps[] PROGMEM = {
+        0x7F, 0xAA, 0xE0, 0x40, 0x00, 0xE0, 0x6E, 0xE7, 0x42, 0x7A, 0x2F, 0x19, 0x80, 0xFF, 0xE0, 0x19,
+        0x80, 0x33, 0x00, 0xFF, 0xE0, 0x33, 0x00, 0x44, 0x00, 0xE0, 0x0C, 0x00, 0x3D, 0x80, 0x7F, 0x80,
+        0xC3, 0x80, 0xE0, 0x00, 0x7C, 0x00, 0x3F, 0x00, 0x07, 0x80, 0xC1, 0x80, 0xE1, 0x80, 0xE3, 0x80,
+        0xFF, 0x00, 0xDE, 0x00, 0x0C, 0x00, 0x08, 0x10, 0x3C, 0x00, 0x7E, 0x00, 0xE7, 0x00, 0xC3, 0x00,
+        0xE7, 0x00, 0x7F, 0xC0, 0x3F, 0x00, 0xFF, 0x80, 0x39, 0xC0, 0x30, 0xC0, 0x39, 0xC0, 0x1F, 0x80,
+        0x0F, 0x00, 0x08, 0x00, 0x1F, 0x80, 0x3F, 0x80, 0x63, 0x00, 0x60, 0x00, 0x30, 0x00, 0x38, 0x00,
+        0x7C, 0xE0, 0xEF, 0xE0, 0xC7, 0x80, 0xC3, 0x80, 0x7F, 0xE0, 0x3E, 0xE0, 0x6E, 0xE0, 0x40, 0x05,
+        0xF5, 0x00, 0x0C, 0x1C, 0x38, 0x78, 0x70, 0xE0, 0x70, 0x38, 0x1C, 0x0C, 0x15, 0xF4, 0x00, 0xC0,
+        0xE0, 0x70, 0x38, 0x1C, 0x38, 0x78, 0x70, 0xE0, 0xC0, 0x61, 0x40, 0x0C, 0x00, 0xED, 0xC0, 0xFF,
+        0xC0, 0x3F, 0x00, 0x1E, 0x00, 0x33, 0x00, 0x7A, 0xF0, 0x06, 0x00, 0xFF, 0xF0, 0x06, 0x00, 0x0A,
+        0x38, 0x30, 0x70, 0x60, 0xC0, 0x40, 0xFF, 0xC0, 0x60, 0xF0, 0x42, 0xAA, 0x10, 0x00, 0xC0, 0x01,
+        0xC0, 0x01, 0x80, 0x03, 0x80, 0x03, 0x00, 0x06, 0x00, 0x0C, 0x00, 0x18, 0x00, 0x30, 0x00, 0x70,
+        0x00, 0x60, 0x00, 0xE0, 0x00, 0xC0, 0x00, 0x17, 0xE8, 0x1E, 0x00, 0x3F, 0x00, 0x61, 0x80, 0xC0,
+        0xC0, 0x61, 0x80, 0x3F, 0x00, 0x1E, 0x00, 0x07, 0xFA, 0x04, 0x00, 0x3C, 0x00, 0xFC, 0x00, 0xEC,
+        0x00, 0x0C, 0x00, 0xFF, 0xC0, 0x08, 0x02, 0x1F, 0x00, 0x7F, 0xC0, 0xE0, 0xC0, 0xC0, 0x60, 0x00,
+        0x60, 0x00, 0xC0, 0x01, 0x80, 0x07, 0x00, 0x0E, 0x00, 0x18, 0x00, 0x30, 0x00, 0x60, 0x00, 0xFF,
+        0xE0, 0x08, 0x30, 0x1E, 0x00, 0x7F, 0x00, 0x63, 0x80, 0x01, 0x80, 0x03, 0x00, 0x1E, 0x00, 0x1F,
+        0x00, 0x03, 0x80, 0x00, 0xC0, 0xC1, 0xC0, 0xFF, 0x80, 0x7E, 0x00, 0x25, 0x12, 0x03, 0x80, 0x07,
+        0x80, 0x0D, 0x80, 0x19, 0x80, 0x31, 0x80, 0x61, 0x80, 0xC1, 0x80, 0xFF, 0xE0, 0x01, 0x80, 0x0F,
+        0xE0, 0x58, 0x70, 0x7F, 0xC0, 0x60, 0x00, 0x6F, 0x00, 0x7F, 0xC0, 0x70, 0xC0, 0x00, 0x60, 0xC0,
+        0xC0, 0xFF, 0xC0, 0x3F, 0x00, 0x00, 0x30, 0x07, 0xC0, 0x1F, 0xC0, 0x38, 0x00, 0x70, 0x00, 0x60,
+        0x00, 0xC0, 0x00, 0xDE, 0x00, 0xFF, 0x80, 0xE1, 0x80, 0xC0, 0xC0, 0x61, 0xC0, 0x7F, 0x80, 0x1F,
+        0x00, 0x44, 0x92, 0xFF, 0xC0, 0xC0, 0xC0, 0xC1, 0xC0, 0x01, 0x80, 0x03, 0x80, 0x03, 0x00, 0x07,
+        0x00, 0x06, 0x00, 0x0E, 0x00, 0x0C, 0x00, 0x09, 0x30, 0x3F, 0x00, 0x7F, 0x80, 0xE1, 0xC0, 0xC0,
+        0xC0, 0x61, 0x80, 0x3F, 0x00, 0x61, 0x80, 0xC0, 0xC0, 0xE1, 0xC0, 0x7F, 0x80, 0x3F, 0x00, 0x0C,
+        0x00, 0x3E, 0x00, 0x7F, 0x80, 0xE1, 0x80, 0xC0, 0xC0, 0x61, 0xC0, 0x7F, 0xC0, 0x1E, 0xC0, 0x00,
+        0xC0, 0x01, 0x80, 0x03, 0x80, 0x07, 0x00, 0xFE, 0x00, 0xF8, 0x00, 0x6F, 0x60, 0xF0, 0x00, 0xF0,
+        0x6E, 0x20, 0x3C, 0x00, 0x38, 0x70, 0x60, 0xC0, 0x80, 0x00, 0x00, 0x00, 0x1C, 0x00, 0x3C, 0x00,
+        0xF0, 0x03, 0xC0, 0x0F, 0x00, 0x3C, 0x00, 0xF0, 0x00, 0x3C, 0x00, 0x0F, 0x00, 0x03, 0xC0, 0x00,
+        0xF0, 0x00, 0x3C, 0x00, 0x1C, 0x54, 0xFF, 0xF8, 0x00, 0x00, 0xFF, 0xF8, 0x00, 0x00, 0xE0, 0x00,
+        0xF0, 0x00, 0x3C, 0x00, 0x0F, 0x00, 0x03, 0xC0, 0x00, 0xF0, 0x00, 0x3C, 0x00, 0xF0, 0x03, 0xC0,
+        0x0F, 0x00, 0x3C, 0x00, 0xF0, 0x00, 0xE0, 0x00, 0x08, 0x14, 0x3E, 0x00, 0x7F, 0x00, 0xC3, 0x80,
+        0xC1, 0x80, 0x03, 0x80, 0x07, 0x00, 0x1E, 0x00, 0x1C, 0x00, 0x18, 0x00, 0x00, 0x00, 0x38, 0x00,
+        0x00, 0xC0, 0x00, 0x1F, 0x00, 0x3F, 0x80, 0x71, 0xC0, 0x60, 0xC0, 0xC3, 0xC0, 0xC7, 0xC0, 0xCE,
+        0xC0, 0xCC, 0xC0, 0xC7, 0xC0, 0xC3, 0xC0, 0xC0, 0x00, 0x60, 0x00, 0x70, 0xC0, 0x3F, 0xC0, 0x1F,
+        0x00, 0x0A, 0x04, 0x1F, 0x80, 0x1F, 0xC0, 0x01, 0xC0, 0x03, 0x60, 0x06, 0x30, 0x0C, 0x30, 0x0F,
+        0xF8, 0x1F, 0xF8, 0x18, 0x0C, 0x30, 0x0C, 0xFC, 0x7F, 0x08, 0x30, 0xFF, 0xC0, 0xFF, 0xE0, 0x30,
+        0x70, 0x30, 0x30, 0x30, 0x70, 0x3F, 0xE0, 0x3F, 0xF0, 0x30, 0x38, 0x30, 0x18, 0xFF, 0xF0, 0xFF,
+        0xE0, 0x03, 0xC0, 0x0F, 0xB0, 0x3F, 0xF0, 0x70, 0x70, 0x60, 0x30, 0xC0, 0x30, 0xC0, 0x00, 0x60,
+        0x30, 0x70, 0x70, 0x3F, 0xE0, 0x0F, 0xC0, 0x07, 0xC0, 0xFF, 0x80, 0xFF, 0xE0, 0x30, 0x70, 0x30,
+        0x30, 0x30, 0x18, 0x30, 0x30, 0x30, 0x70, 0xFF, 0xE0, 0xFF, 0xC0, 0x51, 0x14, 0xFF, 0xF0, 0x30,
+        0x30, 0x33, 0x30, 0x33, 0x00, 0x3F, 0x00, 0x33, 0x00, 0x33, 0x30, 0x30, 0x30, 0xFF, 0xF0, 0x51,
+        0x54, 0xFF, 0xF0, 0x30, 0x30, 0x33, 0x30, 0x33, 0x00, 0x3F, 0x00, 0x33, 0x00, 0x30, 0x00, 0xFF,
+        0x00, 0x02, 0x80, 0x0F, 0xB0, 0x3F, 0xF0, 0x70, 0x70, 0x60, 0x30, 0xC0, 0x30, 0xC0, 0x00, 0xC3,
+        0xF8, 0xC0, 0x30, 0xE0, 0x30, 0x70, 0x70, 0x3F, 0xF0, 0x0F, 0xC0, 0x5D, 0x74, 0xFC, 0xFC, 0x30,
+        0x30, 0x3F, 0xF0, 0x30, 0x30, 0xFC, 0xFC, 0x5F, 0xF4, 0xFF, 0xC0, 0x0C, 0x00, 0xFF, 0xC0, 0x5E,
+        0xE0, 0x1F, 0xF8, 0x00, 0xC0, 0xC0, 0xC0, 0xC1, 0x80, 0xFF, 0x80, 0x3E, 0x00, 0x40, 0x04, 0xFE,
+        0x7C, 0x30, 0x60, 0x30, 0xC0, 0x31, 0x80, 0x33, 0x00, 0x37, 0x00, 0x3F, 0x80, 0x39, 0xC0, 0x30,
+        0xE0, 0x30, 0x60, 0x30, 0x70, 0xFE, 0x3E, 0x5F, 0x74, 0xFF, 0x00, 0x18, 0x00, 0x18, 0x18, 0xFF,
+        0xF8, 0x0A, 0x94, 0xF0, 0x0F, 0xF8, 0x1F, 0x38, 0x1C, 0x3C, 0x3C, 0x36, 0x6C, 0x33, 0xCC, 0x31,
+        0x8C, 0x30, 0x0C, 0xFE, 0x7F, 0x40, 0x04, 0xF1, 0xFC, 0x38, 0x30, 0x3C, 0x30, 0x3E, 0x30, 0x36,
+        0x30, 0x37, 0x30, 0x33, 0xB0, 0x31, 0xB0, 0x31, 0xF0, 0x30, 0xF0, 0x30, 0x70, 0xFE, 0x30, 0x03,
+        0x80, 0x0F, 0x00, 0x3F, 0xC0, 0x70, 0xE0, 0x60, 0x60, 0xE0, 0x70, 0xC0, 0x30, 0xE0, 0x70, 0x60,
+        0x60, 0x70, 0xE0, 0x3F, 0xC0, 0x0F, 0x00, 0x0C, 0x34, 0xFF, 0xC0, 0xFF, 0xE0, 0x30, 0x70, 0x30,
+        0x30, 0x30, 0x60, 0x3F, 0xE0, 0x3F, 0x80, 0x30, 0x00, 0xFF, 0x00, 0x03, 0x80, 0x00, 0x0F, 0x00,
+        0x3F, 0xC0, 0x70, 0xE0, 0x60, 0x60, 0xE0, 0x70, 0xC0, 0x30, 0xE0, 0x70, 0x60, 0x60, 0x70, 0xE0,
+        0x3F, 0xC0, 0x1F, 0x00, 0x1F, 0x30, 0x3F, 0xF0, 0x30, 0xE0, 0x08, 0x00, 0xFF, 0xC0, 0xFF, 0xE0,
+        0x30, 0x70, 0x30, 0x30, 0x30, 0x70, 0x3F, 0xE0, 0x3F, 0x80, 0x31, 0xC0, 0x30, 0xE0, 0x30, 0x60,
+        0x30, 0x70, 0xFE, 0x3C, 0xFE, 0x1C, 0x08, 0x20, 0x3E, 0xC0, 0x7F, 0xC0, 0xE1, 0xC0, 0xC0, 0xC0,
+        0xF0, 0x00, 0x7E, 0x00, 0x1F, 0x80, 0x03, 0xC0, 0xC0, 0xC0, 0xE1, 0xC0, 0xFF, 0x80, 0xDF, 0x00,
+        0x5D, 0xF4, 0xFF, 0xF0, 0xC6, 0x30, 0x06, 0x00, 0x3F, 0xC0, 0x5F, 0xE0, 0xFC, 0xFC, 0x30, 0x30,
+        0x18, 0x60, 0x1F, 0xE0, 0x07, 0x80, 0x4D, 0x68, 0xFE, 0xFE, 0x30, 0x18, 0x18, 0x30, 0x0C, 0x60,
+        0x06, 0xC0, 0x03, 0x80, 0x01, 0x00, 0x52, 0x94, 0xFE, 0x3F, 0x80, 0x30, 0x06, 0x00, 0x30, 0x86,
+        0x00, 0x19, 0xCC, 0x00, 0x1B, 0x6C, 0x00, 0x1E, 0x7C, 0x00, 0x0E, 0x38, 0x00, 0x0C, 0x18, 0x00,
+        0x41, 0x04, 0xFC, 0xFC, 0x30, 0x30, 0x18, 0x60, 0x0C, 0xC0, 0x07, 0x80, 0x03, 0x00, 0x07, 0x80,
+        0x0C, 0xC0, 0x18, 0x60, 0x30, 0x30, 0xFC, 0xFC, 0x44, 0xF4, 0xF8, 0xFC, 0x30, 0x30, 0x18, 0x60,
+        0x0C, 0xC0, 0x07, 0x80, 0x03, 0x00, 0x1F, 0xE0, 0x40, 0x04, 0x7F, 0xE0, 0x60, 0x60, 0x60, 0xC0,
+        0x61, 0x80, 0x63, 0x00, 0x06, 0x00, 0x0C, 0x00, 0x18, 0x60, 0x30, 0x60, 0x60, 0x60, 0xC0, 0x60,
+        0xFF, 0xE0, 0x5F, 0xFF, 0x40, 0xF8, 0xC0, 0xF8, 0x42, 0xAA, 0x10, 0xC0, 0x00, 0xE0, 0x00, 0x60,
+        0x00, 0x70, 0x00, 0x30, 0x00, 0x18, 0x00, 0x0C, 0x00, 0x06, 0x00, 0x03, 0x00, 0x03, 0x80, 0x01,
+        0x80, 0x01, 0xC0, 0x00, 0xC0, 0x5F, 0xFF, 0x40, 0xF8, 0x18, 0xF8, 0x00, 0x04, 0x00, 0x0E, 0x00,
+        0x1F, 0x00, 0x3B, 0x80, 0x31, 0x80, 0x60, 0xC0, 0xC0, 0x60, 0x80, 0x20, 0x40, 0xFF, 0xFF, 0x00,
+        0xC0, 0xE0, 0x38, 0x18, 0x10, 0x00, 0x3F, 0x00, 0x7F, 0x80, 0x00, 0xC0, 0x1F, 0xC0, 0x7F, 0xC0,
+        0xE0, 0xC0, 0xC0, 0xC0, 0xC1, 0xC0, 0x7F, 0xF0, 0x3E, 0xF0, 0x50, 0xF0, 0xF0, 0x00, 0x30, 0x00,
+        0x37, 0xC0, 0x3F, 0xF0, 0x38, 0x30, 0x30, 0x18, 0x38, 0x30, 0xFF, 0xF0, 0xF7, 0xC0, 0x02, 0x00,
+        0x0F, 0xB0, 0x3F, 0xF0, 0x70, 0x70, 0xE0, 0x30, 0xC0, 0x30, 0xC0, 0x00, 0xE0, 0x30, 0x70, 0x70,
+        0x3F, 0xE0, 0x0F, 0xC0, 0x50, 0xF0, 0x01, 0xE0, 0x00, 0x60, 0x1F, 0x60, 0x7F, 0xE0, 0x60, 0xE0,
+        0xC0, 0x60, 0x60, 0xE0, 0x7F, 0xF8, 0x1F, 0x78, 0x05, 0x00, 0x1F, 0x80, 0x7F, 0xE0, 0x60, 0x60,
+        0xC0, 0x30, 0xFF, 0xF0, 0xC0, 0x00, 0x60, 0x30, 0x7F, 0xF0, 0x1F, 0xC0, 0x15, 0xFA, 0x07, 0xF0,
+        0x0F, 0xF0, 0x18, 0x00, 0xFF, 0xE0, 0x18, 0x00, 0xFF, 0xC0, 0x0F, 0x08, 0x1F, 0x78, 0x7F, 0xF8,
+        0x60, 0xE0, 0xC0, 0x60, 0x60, 0xE0, 0x7F, 0xE0, 0x1F, 0x60, 0x00, 0x60, 0x00, 0xE0, 0x3F, 0xC0,
+        0x3F, 0x00, 0x50, 0xFA, 0xF0, 0x00, 0x30, 0x00, 0x37, 0xC0, 0x3F, 0xE0, 0x38, 0x70, 0x30, 0x30,
+        0xFC, 0xFC, 0x55, 0xFA, 0x06, 0x00, 0x00, 0x00, 0x7E, 0x00, 0x06, 0x00, 0xFF, 0xF0, 0x55, 0xFF,
+        0x80, 0x06, 0x00, 0x00, 0x00, 0xFF, 0x80, 0x01, 0x80, 0x03, 0x80, 0xFF, 0x00, 0xFC, 0x00, 0x54,
+        0x02, 0xF0, 0x00, 0x30, 0x00, 0x33, 0xE0, 0x33, 0x00, 0x36, 0x00, 0x3E, 0x00, 0x3C, 0x00, 0x3E,
+        0x00, 0x37, 0x00, 0x33, 0x80, 0xF1, 0xF0, 0x5F, 0xFA, 0x7E, 0x00, 0x06, 0x00, 0xFF, 0xF0, 0x0F,
+        0xA0, 0xF7, 0x78, 0xFF, 0xFC, 0x39, 0xCC, 0x31, 0x8C, 0xFD, 0xEF, 0x0F, 0xA0, 0xF7, 0xC0, 0xFF,
+        0xE0, 0x38, 0x70, 0x30, 0x30, 0xFC, 0xFC, 0x06, 0x00, 0x0F, 0x00, 0x3F, 0xC0, 0x70, 0xE0, 0xE0,
+        0x70, 0xC0, 0x30, 0xE0, 0x70, 0x70, 0xE0, 0x3F, 0xC0, 0x0F, 0x00, 0x0F, 0x0D, 0xF7, 0xC0, 0xFF,
+        0xF0, 0x38, 0x30, 0x30, 0x18, 0x38, 0x30, 0x3F, 0xF0, 0x37, 0xC0, 0x30, 0x00, 0xFE, 0x00, 0x0F,
+        0x0D, 0x1F, 0x78, 0x7F, 0xF8, 0x60, 0xE0, 0xC0, 0x60, 0x60, 0xE0, 0x7F, 0xE0, 0x1F, 0x60, 0x00,
+        0x60, 0x03, 0xF8, 0x07, 0xA0, 0xF9, 0xE0, 0xFB, 0xF0, 0x1F, 0x30, 0x1C, 0x00, 0x18, 0x00, 0xFF,
+        0xC0, 0x10, 0x00, 0x3F, 0xC0, 0x7F, 0xC0, 0xC0, 0xC0, 0xFC, 0x00, 0x7F, 0x80, 0x07, 0xC0, 0xC0,
+        0xC0, 0xC1, 0xC0, 0xFF, 0x80, 0xFF, 0x00, 0x75, 0xF0, 0x30, 0x00, 0xFF, 0xC0, 0x30, 0x00, 0x30,
+        0x70, 0x1F, 0xF0, 0x0F, 0xC0, 0x5F, 0x00, 0xF0, 0xF0, 0x30, 0x30, 0x30, 0x70, 0x1F, 0xFC, 0x0F,
+        0xBC, 0x55, 0x20, 0xF8, 0x7C, 0x30, 0x30, 0x18, 0x60, 0x0C, 0xC0, 0x0F, 0xC0, 0x07, 0x80, 0x49,
+        0x20, 0xF0, 0x78, 0x62, 0x30, 0x67, 0x30, 0x35, 0x60, 0x3D, 0xE0, 0x38, 0xC0, 0x18, 0xC0, 0x40,
+        0x20, 0xF9, 0xF0, 0x30, 0xC0, 0x19, 0x80, 0x0F, 0x00, 0x06, 0x00, 0x0F, 0x00, 0x19, 0x80, 0x30,
+        0xC0, 0xF9, 0xF0, 0x4A, 0x09, 0xFC, 0x3E, 0x30, 0x18, 0x18, 0x30, 0x0C, 0x60, 0x06, 0xC0, 0x07,
+        0xC0, 0x03, 0x80, 0x01, 0x80, 0x03, 0x00, 0x06, 0x00, 0x7F, 0x80, 0x40, 0x20, 0xFF, 0xC0, 0xC1,
+        0x80, 0xC3, 0x00, 0x06, 0x00, 0x0C, 0x00, 0x18, 0x00, 0x30, 0xC0, 0x60, 0xC0, 0xFF, 0xC0, 0x1F,
+        0x0F, 0x00, 0x1C, 0x3C, 0x30, 0x70, 0xE0, 0x70, 0x30, 0x3C, 0x1C, 0x7F, 0xFF, 0xC0, 0xC0, 0x1F,
+        0x0F, 0x00, 0xE0, 0xF0, 0x30, 0x38, 0x1C, 0x38, 0x30, 0xF0, 0xE0, 0x00, 0x38, 0x00, 0x7C, 0x60,
+        0xEE, 0xE0, 0xC7, 0xC0, 0x03, 0x80, 0x20, 0x60, 0x90, 0x60, 0x01, 0x40, 0x80, 0x06, 0x00, 0x01,
+        0x80, 0x00, 0x00, 0x1F, 0x80, 0x1F, 0xC0, 0x01, 0xC0, 0x03, 0x60, 0x06, 0x30, 0x0C, 0x30, 0x0F,
+        0xF8, 0x1F, 0xF8, 0x18, 0x0C, 0x30, 0x0C, 0xFC, 0x7F, 0x01, 0x40, 0x80, 0x00, 0xC0, 0x03, 0x00,
+        0x00, 0x00, 0x1F, 0x80, 0x1F, 0xC0, 0x01, 0xC0, 0x03, 0x60, 0x06, 0x30, 0x0C, 0x30, 0x0F, 0xF8,
+        0x1F, 0xF8, 0x18, 0x0C, 0x30, 0x0C, 0xFC, 0x7F, 0x01, 0x40, 0x80, 0x03, 0x80, 0x06, 0xC0, 0x00,
+        0x00, 0x1F, 0x80, 0x1F, 0xC0, 0x01, 0xC0, 0x03, 0x60, 0x06, 0x30, 0x0C, 0x30, 0x0F, 0xF8, 0x1F,
+        0xF8, 0x18, 0x0C, 0x30, 0x0C, 0xFC, 0x7F, 0x01, 0x40, 0x80, 0x03, 0x40, 0x05, 0x80, 0x00, 0x00,
+        0x1F, 0x80, 0x1F, 0xC0, 0x01, 0xC0, 0x03, 0x60, 0x06, 0x30, 0x0C, 0x30, 0x0F, 0xF8, 0x1F, 0xF8,
+        0x18, 0x0C, 0x30, 0x0C, 0xFC, 0x7F, 0x41, 0x40, 0x80, 0x06, 0xC0, 0x00, 0x00, 0x1F, 0x80, 0x1F,
+        0xC0, 0x01, 0xC0, 0x03, 0x60, 0x06, 0x30, 0x0C, 0x30, 0x0F, 0xF8, 0x1F, 0xF8, 0x18, 0x0C, 0x30,
+        0x0C, 0xFC, 0x7F, 0x00, 0xA0, 0x40, 0x03, 0x80, 0x06, 0xC0, 0x03, 0x80, 0x00, 0x00, 0x1F, 0x80,
+        0x1F, 0xC0, 0x01, 0xC0, 0x03, 0x60, 0x06, 0x30, 0x0C, 0x30, 0x0F, 0xF8, 0x1F, 0xF8, 0x18, 0x0C,
+        0x30, 0x0C, 0xFC, 0x7F, 0x03, 0xC0, 0x0F, 0xB0, 0x3F, 0xF0, 0x70, 0x70, 0x60, 0x30, 0xC0, 0x30,
+        0xC0, 0x00, 0x60, 0x30, 0x70, 0x70, 0x3F, 0xE0, 0x0F, 0xC0, 0x03, 0x00, 0x06, 0x00, 0x0A, 0x22,
+        0x80, 0x18, 0x00, 0x06, 0x00, 0x00, 0x00, 0xFF, 0xF0, 0x30, 0x30, 0x33, 0x30, 0x33, 0x00, 0x3F,
+        0x00, 0x33, 0x00, 0x33, 0x30, 0x30, 0x30, 0xFF, 0xF0, 0x0A, 0x22, 0x80, 0x03, 0x00, 0x0C, 0x00,
+        0x00, 0x00, 0xFF, 0xF0, 0x30, 0x30, 0x33, 0x30, 0x33, 0x00, 0x3F, 0x00, 0x33, 0x00, 0x33, 0x30,
+        0x30, 0x30, 0xFF, 0xF0, 0x0A, 0x22, 0x80, 0x0E, 0x00, 0x1B, 0x00, 0x00, 0x00, 0xFF, 0xF0, 0x30,
+        0x30, 0x33, 0x30, 0x33, 0x00, 0x3F, 0x00, 0x33, 0x00, 0x33, 0x30, 0x30, 0x30, 0xFF, 0xF0, 0x4A,
+        0x22, 0x80, 0x1B, 0x00, 0x00, 0x00, 0xFF, 0xF0, 0x30, 0x30, 0x33, 0x30, 0x33, 0x00, 0x3F, 0x00,
+        0x33, 0x00, 0x33, 0x30, 0x30, 0x30, 0xFF, 0xF0, 0x0B, 0xFE, 0x80, 0x30, 0x00, 0x0C, 0x00, 0x00,
+        0x00, 0xFF, 0xC0, 0x0C, 0x00, 0xFF, 0xC0, 0x0B, 0xFE, 0x80, 0x06, 0x00, 0x18, 0x00, 0x00, 0x00,
+        0xFF, 0xC0, 0x0C, 0x00, 0xFF, 0xC0, 0x0B, 0xFE, 0x80, 0x1C, 0x00, 0x36, 0x00, 0x00, 0x00, 0xFF,
+        0xC0, 0x0C, 0x00, 0xFF, 0xC0, 0x4B, 0xFE, 0x80, 0x36, 0x00, 0x00, 0x00, 0xFF, 0xC0, 0x0C, 0x00,
+        0xFF, 0xC0, 0x08, 0x00, 0x80, 0x06, 0x80, 0x0B, 0x00, 0x00, 0x00, 0xF1, 0xFC, 0x38, 0x30, 0x3C,
+        0x30, 0x3E, 0x30, 0x36, 0x30, 0x37, 0x30, 0x33, 0xB0, 0x31, 0xB0, 0x31, 0xF0, 0x30, 0xF0, 0x30,
+        0x70, 0xFE, 0x30, 0x00, 0x70, 0x00, 0x18, 0x00, 0x06, 0x00, 0x00, 0x00, 0x0F, 0x00, 0x3F, 0xC0,
+        0x70, 0xE0, 0x60, 0x60, 0xE0, 0x70, 0xC0, 0x30, 0xE0, 0x70, 0x60, 0x60, 0x70, 0xE0, 0x3F, 0xC0,
+        0x0F, 0x00, 0x00, 0x70, 0x00, 0x03, 0x00, 0x0C, 0x00, 0x00, 0x00, 0x0F, 0x00, 0x3F, 0xC0, 0x70,
+        0xE0, 0x60, 0x60, 0xE0, 0x70, 0xC0, 0x30, 0xE0, 0x70, 0x60, 0x60, 0x70, 0xE0, 0x3F, 0xC0, 0x0F,
+        0x00, 0x00, 0x70, 0x00, 0x0E, 0x00, 0x1B, 0x00, 0x00, 0x00, 0x0F, 0x00, 0x3F, 0xC0, 0x70, 0xE0,
+        0x60, 0x60, 0xE0, 0x70, 0xC0, 0x30, 0xE0, 0x70, 0x60, 0x60, 0x70, 0xE0, 0x3F, 0xC0, 0x0F, 0x00,
+        0x00, 0x70, 0x00, 0x0D, 0x00, 0x16, 0x00, 0x00, 0x00, 0x0F, 0x00, 0x3F, 0xC0, 0x70, 0xE0, 0x60,
+        0x60, 0xE0, 0x70, 0xC0, 0x30, 0xE0, 0x70, 0x60, 0x60, 0x70, 0xE0, 0x3F, 0xC0, 0x0F, 0x00, 0x40,
+        0x70, 0x00, 0x1B, 0x00, 0x00, 0x00, 0x0F, 0x00, 0x3F, 0xC0, 0x70, 0xE0, 0x60, 0x60, 0xE0, 0x70,
+        0xC0, 0x30, 0xE0, 0x70, 0x60, 0x60, 0x70, 0xE0, 0x3F, 0xC0, 0x0F, 0x00, 0x0B, 0xFC, 0x00, 0x0C,
+        0x00, 0x03, 0x00, 0x00, 0x00, 0xFC, 0xFC, 0x30, 0x30, 0x18, 0x60, 0x1F, 0xE0, 0x07, 0x80, 0x0B,
+        0xFC, 0x00, 0x01, 0x80, 0x06, 0x00, 0x00, 0x00, 0xFC, 0xFC, 0x30, 0x30, 0x18, 0x60, 0x1F, 0xE0,
+        0x07, 0x80, 0x0B, 0xFC, 0x00, 0x07, 0x00, 0x0D, 0x80, 0x00, 0x00, 0xFC, 0xFC, 0x30, 0x30, 0x18,
+        0x60, 0x1F, 0xE0, 0x07, 0x80, 0x4B, 0xFC, 0x00, 0x0D, 0x80, 0x00, 0x00, 0xFC, 0xFC, 0x30, 0x30,
+        0x18, 0x60, 0x1F, 0xE0, 0x07, 0x80, 0x08, 0x9E, 0x80, 0x01, 0x80, 0x06, 0x00, 0x00, 0x00, 0xF8,
+        0xFC, 0x30, 0x30, 0x18, 0x60, 0x0C, 0xC0, 0x07, 0x80, 0x03, 0x00, 0x1F, 0xE0, 0x02, 0x00, 0x18,
+        0x00, 0x06, 0x00, 0x00, 0x00, 0x3F, 0x00, 0x7F, 0x80, 0x00, 0xC0, 0x1F, 0xC0, 0x7F, 0xC0, 0xE0,
+        0xC0, 0xC0, 0xC0, 0xC1, 0xC0, 0x7F, 0xF0, 0x3E, 0xF0, 0x02, 0x00, 0x03, 0x00, 0x0C, 0x00, 0x00,
+        0x00, 0x3F, 0x00, 0x7F, 0x80, 0x00, 0xC0, 0x1F, 0xC0, 0x7F, 0xC0, 0xE0, 0xC0, 0xC0, 0xC0, 0xC1,
+        0xC0, 0x7F, 0xF0, 0x3E, 0xF0, 0x02, 0x00, 0x0E, 0x00, 0x1B, 0x00, 0x00, 0x00, 0x3F, 0x00, 0x7F,
+        0x80, 0x00, 0xC0, 0x1F, 0xC0, 0x7F, 0xC0, 0xE0, 0xC0, 0xC0, 0xC0, 0xC1, 0xC0, 0x7F, 0xF0, 0x3E,
+        0xF0, 0x02, 0x00, 0x0D, 0x00, 0x16, 0x00, 0x00, 0x00, 0x3F, 0x00, 0x7F, 0x80, 0x00, 0xC0, 0x1F,
+        0xC0, 0x7F, 0xC0, 0xE0, 0xC0, 0xC0, 0xC0, 0xC1, 0xC0, 0x7F, 0xF0, 0x3E, 0xF0, 0x42, 0x00, 0x1B,
+        0x00, 0x00, 0x00, 0x3F, 0x00, 0x7F, 0x80, 0x00, 0xC0, 0x1F, 0xC0, 0x7F, 0xC0, 0xE0, 0xC0, 0xC0,
+        0xC0, 0xC1, 0xC0, 0x7F, 0xF0, 0x3E, 0xF0, 0x01, 0x00, 0x0E, 0x00, 0x1B, 0x00, 0x0E, 0x00, 0x00,
+        0x00, 0x3F, 0x00, 0x7F, 0x80, 0x00, 0xC0, 0x1F, 0xC0, 0x7F, 0xC0, 0xE0, 0xC0, 0xC0, 0xC0, 0xC1,
+        0xC0, 0x7F, 0xF0, 0x3E, 0xF0, 0x02, 0x00, 0x0F, 0xB0, 0x3F, 0xF0, 0x70, 0x70, 0xE0, 0x30, 0xC0,
+        0x30, 0xC0, 0x00, 0xE0, 0x30, 0x70, 0x70, 0x3F, 0xE0, 0x0F, 0xC0, 0x03, 0x00, 0x06, 0x00, 0x00,
+        0xA0, 0x18, 0x00, 0x06, 0x00, 0x00, 0x00, 0x1F, 0x80, 0x7F, 0xE0, 0x60, 0x60, 0xC0, 0x30, 0xFF,
+        0xF0, 0xC0, 0x00, 0x60, 0x30, 0x7F, 0xF0, 0x1F, 0xC0, 0x00, 0xA0, 0x03, 0x00, 0x0C, 0x00, 0x00,
+        0x00, 0x1F, 0x80, 0x7F, 0xE0, 0x60, 0x60, 0xC0, 0x30, 0xFF, 0xF0, 0xC0, 0x00, 0x60, 0x30, 0x7F,
+        0xF0, 0x1F, 0xC0, 0x00, 0xA0, 0x0E, 0x00, 0x1B, 0x00, 0x00, 0x00, 0x1F, 0x80, 0x7F, 0xE0, 0x60,
+        0x60, 0xC0, 0x30, 0xFF, 0xF0, 0xC0, 0x00, 0x60, 0x30, 0x7F, 0xF0, 0x1F, 0xC0, 0x40, 0xA0, 0x1B,
+        0x00, 0x00, 0x00, 0x1F, 0x80, 0x7F, 0xE0, 0x60, 0x60, 0xC0, 0x30, 0xFF, 0xF0, 0xC0, 0x00, 0x60,
+        0x30, 0x7F, 0xF0, 0x1F, 0xC0, 0x0B, 0xF4, 0x18, 0x00, 0x06, 0x00, 0x00, 0x00, 0x7E, 0x00, 0x06,
+        0x00, 0xFF, 0xF0, 0x0B, 0xF4, 0x03, 0x00, 0x0C, 0x00, 0x00, 0x00, 0x7E, 0x00, 0x06, 0x00, 0xFF,
+        0xF0, 0x0B, 0xF4, 0x0E, 0x00, 0x1B, 0x00, 0x00, 0x00, 0x7E, 0x00, 0x06, 0x00, 0xFF, 0xF0, 0x4B,
+        0xF4, 0x1B, 0x00, 0x00, 0x00, 0x7E, 0x00, 0x06, 0x00, 0xFF, 0xF0, 0x01, 0xF4, 0x06, 0x80, 0x0B,
+        0x00, 0x00, 0x00, 0xF7, 0xC0, 0xFF, 0xE0, 0x38, 0x70, 0x30, 0x30, 0xFC, 0xFC, 0x00, 0xC0, 0x18,
+        0x00, 0x06, 0x00, 0x00, 0x00, 0x0F, 0x00, 0x3F, 0xC0, 0x70, 0xE0, 0xE0, 0x70, 0xC0, 0x30, 0xE0,
+        0x70, 0x70, 0xE0, 0x3F, 0xC0, 0x0F, 0x00, 0x00, 0xC0, 0x03, 0x00, 0x0C, 0x00, 0x00, 0x00, 0x0F,
+        0x00, 0x3F, 0xC0, 0x70, 0xE0, 0xE0, 0x70, 0xC0, 0x30, 0xE0, 0x70, 0x70, 0xE0, 0x3F, 0xC0, 0x0F,
+        0x00, 0x00, 0xC0, 0x0E, 0x00, 0x1B, 0x00, 0x00, 0x00, 0x0F, 0x00, 0x3F, 0xC0, 0x70, 0xE0, 0xE0,
+        0x70, 0xC0, 0x30, 0xE0, 0x70, 0x70, 0xE0, 0x3F, 0xC0, 0x0F, 0x00, 0x00, 0xC0, 0x0D, 0x00, 0x16,
+        0x00, 0x00, 0x00, 0x0F, 0x00, 0x3F, 0xC0, 0x70, 0xE0, 0xE0, 0x70, 0xC0, 0x30, 0xE0, 0x70, 0x70,
+        0xE0, 0x3F, 0xC0, 0x0F, 0x00, 0x40, 0xC0, 0x1B, 0x00, 0x00, 0x00, 0x0F, 0x00, 0x3F, 0xC0, 0x70,
+        0xE0, 0xE0, 0x70, 0xC0, 0x30, 0xE0, 0x70, 0x70, 0xE0, 0x3F, 0xC0, 0x0F, 0x00, 0x0B, 0xE0, 0x0C,
+        0x00, 0x03, 0x00, 0x00, 0x00, 0xF0, 0xF0, 0x30, 0x30, 0x30, 0x70, 0x1F, 0xFC, 0x0F, 0xBC, 0x0B,
+        0xE0, 0x01, 0x80, 0x06, 0x00, 0x00, 0x00, 0xF0, 0xF0, 0x30, 0x30, 0x30, 0x70, 0x1F, 0xFC, 0x0F,
+        0xBC, 0x0B, 0xE0, 0x07, 0x00, 0x0D, 0x80, 0x00, 0x00, 0xF0, 0xF0, 0x30, 0x30, 0x30, 0x70, 0x1F,
+        0xFC, 0x0F, 0xBC, 0x4B, 0xE0, 0x0D, 0x80, 0x00, 0x00, 0xF0, 0xF0, 0x30, 0x30, 0x30, 0x70, 0x1F,
+        0xFC, 0x0F, 0xBC, 0x09, 0x41, 0x20, 0x00, 0xC0, 0x03, 0x00, 0x00, 0x00, 0xFC, 0x3E, 0x30, 0x18,
+        0x18, 0x30, 0x0C, 0x60, 0x06, 0xC0, 0x07, 0xC0, 0x03, 0x80, 0x01, 0x80, 0x03, 0x00, 0x06, 0x00,
+        0x7F, 0x80, 0x49, 0x41, 0x20, 0x06, 0xC0, 0x00, 0x00, 0xFC, 0x3E, 0x30, 0x18, 0x18, 0x30, 0x0C,
+        0x60, 0x06, 0xC0, 0x07, 0xC0, 0x03, 0x80, 0x01, 0x80, 0x03, 0x00, 0x06, 0x00, 0x7F, 0x80,
+    };
+
+    const FontGlyph glyphs[] PROGMEM = {
+        {0x0020,     0, { 0,  0, 0,  0,  9}},  //  
+        {0x0021,     0, { 3, 15, 0,  2,  5}},  // !
+        {0x0022,     6, { 8,  7, 0,  3, 10}},  // "
+        {0x0023,     9, {11, 16, 0,  2, 13}},  // #
+        {0x0024,    23, { 9, 19, 0,  1, 11}},  // $
+        {0x0025,    54, {10, 15, 0,  2, 12}},  // %
+        {0x0026,    82, {11, 13, 0,  4, 13}},  // &
+        {0x0027,   108, { 3,  7, 0,  3,  5}},  // '
+        {0x0028,   111, { 6, 18, 0,  2,  8}},  // (
+        {0x0029,   124, { 6, 18, 0,  2,  8}},  // )
+        {0x002A,   137, {10, 10, 0,  2, 12}},  // *
+        {0x002B,   151, {12, 12, 0,  4, 14}},  // +
+        {0x002C,   159, { 5,  7, 0, 14,  7}},  // ,
+        {0x002D,   165, {10,  2, 0,  9, 12}},  // -
+        {0x002E,   168, { 4,  3, 0, 14,  6}},  // .
+        {0x002F,   170, {10, 20, 0,  0, 12}},  // /
+        {0x0030,   199, {10, 15, 0,  2, 12}},  // 0
+        {0x0031,   215, {10, 15, 0,  2, 12}},  // 1
+        {0x0032,   229, {11, 15, 0,  2, 13}},  // 2
+        {0x0033,   257, {10, 15, 0,  2, 12}},  // 3
+        {0x0034,   283, {11, 15, 0,  2, 13}},  // 4
+        {0x0035,   305, {11, 15, 0,  2, 13}},  // 5
+        {0x0036,   325, {10, 15, 0,  2, 12}},  // 6
+        {0x0037,   353, {10, 15, 0,  2, 12}},  // 7
+        {0x0038,   375, {10, 15, 0,  2, 12}},  // 8
+        {0x0039,   399, {10, 15, 0,  2, 12}},  // 9
+        {0x003A,   427, { 4, 11, 0,  6,  6}},  // :
+        {0x003B,   432, { 6, 13, 0,  6,  8}},  // ;
+        {0x003C,   441, {14, 13, 0,  4, 16}},  // <
+        {0x003D,   469, {13,  6, 0,  7, 15}},  // =
+        {0x003E,   476, {14, 13, 0,  4, 16}},  // >
+        {0x003F,   504, { 9, 14, 0,  3, 11}},  // ?
+        {0x0040,   528, {10, 17, 0,  2, 12}},  // @
+        {0x0041,   561, {16, 14, 0,  3, 18}},  // A
+        {0x0042,   585, {13, 14, 0,  3, 15}},  // B
+        {0x0043,   609, {12, 14, 0,  3, 14}},  // C
+        {0x0044,   631, {13, 14, 0,  3, 15}},  // D
+        {0x0045,   651, {12, 14, 0,  3, 14}},  // E
+        {0x0046,   671, {12, 14, 0,  3, 14}},  // F
+        {0x0047,   689, {13, 14, 0,  3, 15}},  // G
+        {0x0048,   715, {14, 14, 0,  3, 16}},  // H
+        {0x0049,   727, {10, 14, 0,  3, 12}},  // I
+        {0x004A,   735, {13, 14, 0,  3, 15}},  // J
+        {0x004B,   749, {15, 14, 0,  3, 17}},  // K
+        {0x004C,   775, {13, 14, 0,  3, 15}},  // L
+        {0x004D,   785, {16, 14, 0,  3, 18}},  // M
+        {0x004E,   805, {14, 14, 0,  3, 16}},  // N
+        {0x004F,   831, {12, 14, 0,  3, 14}},  // O
+        {0x0050,   855, {12, 14, 0,  3, 14}},  // P
+        {0x0051,   875, {12, 17, 0,  3, 14}},  // Q
+        {0x0052,   906, {14, 14, 0,  3, 16}},  // R
+        {0x0053,   934, {10, 14, 0,  3, 12}},  // S
+        {0x0054,   960, {12, 14, 0,  3, 14}},  // T
+        {0x0055,   970, {14, 14, 0,  3, 16}},  // U
+        {0x0056,   982, {15, 14, 0,  3, 17}},  // V
+        {0x0057,   998, {17, 14, 0,  3, 19}},  // W
+        {0x0058,  1024, {14, 14, 0,  3, 16}},  // X
+        {0x0059,  1048, {14, 14, 0,  3, 16}},  // Y
+        {0x005A,  1064, {11, 14, 0,  3, 13}},  // Z
+        {0x005B,  1090, { 5, 18, 0,  2,  7}},  // [
+        {0x005C,  1096, {10, 20, 0,  0, 12}},  // backslash
+        {0x005D,  1125, { 5, 18, 0,  2,  7}},  // ]
+        {0x005E,  1131, {11,  8, 0,  1, 13}},  // ^
+        {0x005F,  1148, {16,  2, 0, 22, 18}},  // _
+        {0x0060,  1151, { 5,  4, 0,  1,  7}},  // `
+        {0x0061,  1156, {12, 11, 0,  6, 14}},  // a
+        {0x0062,  1178, {13, 15, 0,  2, 15}},  // b
+        {0x0063,  1198, {12, 11, 0,  6, 14}},  // c
+        {0x0064,  1220, {13, 15, 0,  2, 15}},  // d
+        {0x0065,  1240, {12, 11, 0,  6, 14}},  // e
+        {0x0066,  1260, {12, 15, 0,  2, 14}},  // f
+        {0x0067,  1274, {13, 16, 0,  6, 15}},  // g
+        {0x0068,  1298, {14, 15, 0,  2, 16}},  // h
+        {0x0069,  1314, {12, 15, 0,  2, 14}},  // i
+        {0x006A,  1326, { 9, 20, 0,  2, 11}},  // j
+        {0x006B,  1343, {12, 15, 0,  2, 14}},  // k
+        {0x006C,  1367, {12, 15, 0,  2, 14}},  // l
+        {0x006D,  1375, {16, 11, 0,  6, 18}},  // m
+        {0x006E,  1387, {14, 11, 0,  6, 16}},  // n
+        {0x006F,  1399, {12, 11, 0,  6, 14}},  // o
+        {0x0070,  1419, {13, 16, 0,  6, 15}},  // p
+        {0x0071,  1439, {13, 16, 0,  6, 15}},  // q
+        {0x0072,  1459, {12, 11, 0,  6, 14}},  // r
+        {0x0073,  1473, {10, 11, 0,  6, 12}},  // s
+        {0x0074,  1495, {12, 15, 0,  2, 14}},  // t
+        {0x0075,  1509, {14, 11, 0,  6, 16}},  // u
+        {0x0076,  1521, {14, 11, 0,  6, 16}},  // v
+        {0x0077,  1535, {13, 11, 0,  6, 15}},  // w
+        {0x0078,  1551, {12, 11, 0,  6, 14}},  // x
+        {0x0079,  1571, {15, 16, 0,  6, 17}},  // y
+        {0x007A,  1595, {10, 11, 0,  6, 12}},  // z
+        {0x007B,  1615, { 6, 18, 0,  2,  8}},  // {
+        {0x007C,  1627, { 2, 18, 0,  2,  4}},  // |
+        {0x007D,  1631, { 6, 18, 0,  2,  8}},  // }
+        {0x007E,  1643, {11,  5, 0,  8, 13}},  // ~
+        {0x00B0,  1654, { 4,  4, 0,  3,  6}},  // °
+        {0x00C0,  1658, {16, 17, 0,  0, 18}},  // À
+        {0x00C1,  1689, {16, 17, 0,  0, 18}},  // Á
+        {0x00C2,  1720, {16, 17, 0,  0, 18}},  // Â
+        {0x00C3,  1751, {16, 17, 0,  0, 18}},  // Ã
+        {0x00C4,  1782, {16, 17, 0,  0, 18}},  // Ä
+        {0x00C5,  1811, {16, 18, 0, -1, 18}},  // Å
+        {0x00C7,  1844, {12, 16, 0,  3, 14}},  // Ç
+        {0x00C8,  1870, {12, 17, 0,  0, 14}},  // È
+        {0x00C9,  1897, {12, 17, 0,  0, 14}},  // É
+        {0x00CA,  1924, {12, 17, 0,  0, 14}},  // Ê
+        {0x00CB,  1951, {12, 17, 0,  0, 14}},  // Ë
+        {0x00CC,  1976, {10, 17, 0,  0, 12}},  // Ì
+        {0x00CD,  1991, {10, 17, 0,  0, 12}},  // Í
+        {0x00CE,  2006, {10, 17, 0,  0, 12}},  // Î
+        {0x00CF,  2021, {10, 17, 0,  0, 12}},  // Ï
+        {0x00D1,  2034, {14, 17, 0,  0, 16}},  // Ñ
+        {0x00D2,  2067, {12, 17, 0,  0, 14}},  // Ò
+        {0x00D3,  2098, {12, 17, 0,  0, 14}},  // Ó
+        {0x00D4,  2129, {12, 17, 0,  0, 14}},  // Ô
+        {0x00D5,  2160, {12, 17, 0,  0, 14}},  // Õ
+        {0x00D6,  2191, {12, 17, 0,  0, 14}},  // Ö
+        {0x00D9,  2220, {14, 17, 0,  0, 16}},  // Ù
+        {0x00DA,  2239, {14, 17, 0,  0, 16}},  // Ú
+        {0x00DB,  2258, {14, 17, 0,  0, 16}},  // Û
+        {0x00DC,  2277, {14, 17, 0,  0, 16}},  // Ü
+        {0x00DD,  2294, {14, 17, 0,  0, 16}},  // Ý
+        {0x00E0,  2317, {12, 14, 0,  3, 14}},  // à
+        {0x00E1,  2345, {12, 14, 0,  3, 14}},  // á
+        {0x00E2,  2373, {12, 14, 0,  3, 14}},  // â
+        {0x00E3,  2401, {12, 14, 0,  3, 14}},  // ã
+        {0x00E4,  2429, {12, 14, 0,  3, 14}},  // ä
+        {0x00E5,  2455, {12, 15, 0,  2, 14}},  // å
+        {0x00E7,  2485, {12, 13, 0,  6, 14}},  // ç
+        {0x00E8,  2511, {12, 14, 0,  3, 14}},  // è
+        {0x00E9,  2537, {12, 14, 0,  3, 14}},  // é
+        {0x00EA,  2563, {12, 14, 0,  3, 14}},  // ê
+        {0x00EB,  2589, {12, 14, 0,  3, 14}},  // ë
+        {0x00EC,  2613, {12, 14, 0,  3, 14}},  // ì
+        {0x00ED,  2627, {12, 14, 0,  3, 14}},  // í
+        {0x00EE,  2641, {12, 14, 0,  3, 14}},  // î
+        {0x00EF,  2655, {12, 14, 0,  3, 14}},  // ï
+        {0x00F1,  2667, {14, 14, 0,  3, 16}},  // ñ
+        {0x00F2,  2685, {12, 14, 0,  3, 14}},  // ò
+        {0x00F3,  2711, {12, 14, 0,  3, 14}},  // ó
+        {0x00F4,  2737, {12, 14, 0,  3, 14}},  // ô
+        {0x00F5,  2763, {12, 14, 0,  3, 14}},  // õ
+        {0x00F6,  2789, {12, 14, 0,  3, 14}},  // ö
+        {0x00F9,  2813, {14, 14, 0,  3, 16}},  // ù
+        {0x00FA,  2831, {14, 14, 0,  3, 16}},  // ú
+        {0x00FB,  2849, {14, 14, 0,  3, 16}},  // û
+        {0x00FC,  2867, {14, 14, 0,  3, 16}},  // ü
+        {0x00FD,  2883, {15, 19, 0,  3, 17}},  // ý
+        {0x00FF,  2914, {15, 19, 0,  3, 17}},  // ÿ
+    };
+}
+
+BitmapFont Prop24{glyphs, sizeof(glyphs) / sizeof(glyphs[0]), bitmaps, 24, 0x0020, 95};
@@ -0,0 +1,131 @@
+/**
+ * @file frame_buffers.cpp
+ * @brief Back and front frame buffers, so the next frame is drawn while the panel refreshes.
+ */
+#include "frame_buffers.h"
+
+#include <algorithm>
+#include "fnv1a.h"
+
+FrameBuffers::FrameBuffers(const uint8_t *back, uint8_t *front, int width, int height):
+    back(back),
+    front(front),
+    width(width),
+    height(std::min(height, max_height)),
+    stride(width / 8)
+{
+}
+
+uint32_t FrameBuffers::band_hash(int band) const
+{
+    int first{band * band_rows};
+    int last{std::min(first + band_rows, height)};
+    return fnv1a(fnv1a_basis, &back[first * stride], static_cast<size_t>(last - first) * stride);
+}
+
+bool FrameBuffers::row_changed(int row, int &first, int &last) const
+{
+    const uint8_t *back_row{&back[row * stride]};
+    const uint8_t *front_row{&front[row * stride]};
+    if (memcmp(back_row, front_row, stride) == 0)
+    {
+        return false;
+    }
+    first = 0;
+    while (back_row[first] == front_row[first])
+    {
+        ++first;
+    }
+    last = stride - 1;
+    while (back_row[last] == front_row[last])
+    {
+        --last;
+    }
+    return true;
+}
+
+DirtyRegion FrameBuffers::next_run(int &row) const
+{
+    DirtyRegion run;
+    if (front == nullptr)
+    {
+        int band{row / band_rows};
+        while (band * band_rows < height && band_hash(band) == band_hashes[band])
+        {
+            ++band;
+        }
+        while (band * band_rows < height && band_hash(band) != band_hashes[band])
+        {
+            run.add(0, band * band_rows, width, std::min((band + 1) * band_rows, height));
+            ++band;
+        }
+        row = std::min(band * band_rows, height);
+        return run;
+    }
+
+    int first{0};
+    int last{0};
+    while (row < height && !row_changed(row, first, last))
+    {
+        ++row;
+    }
+    while (row < height && row_changed(row, first, last))
+    {
+        run.add(first * 8, row, (last + 1) * 8, row + 1);
+        ++row;
+    }
+    return run;
+}
+
+DirtyRegion FrameBuffers::present(Epd &epd, LayerStack &layers, bool all)
+{
+    DirtyRegion sent;
+    auto send = [&]()
+    {
+        DirtyRegion part{layers.present(epd)};
+        sent.add(part.x0, part.y0, part.x1, part.y1);
+    };
+    if (all || !front_valid)
+    {
+        layers.mark_all(Layer::background);
+        send();
+    }
+    else
+    {
+        // The other layers' changes first, so they are not merged with the runs below.
+        send();
+        // Each run of changed rows is its own window, so the rows between runs are not sent.
+        for (int row = 0; row < height;)
+        {
+            DirtyRegion run{next_run(row)};
+            if (run.empty())
+            {
+                break;
+            }
+            layers.mark(Layer::background, run.x0, run.y0, run.x1, run.y1);
+            send();
+        }
+    }
+    if (!sent.empty())
+    {
+        epd.StartDisplayPartFrame();
+    }
+    sync();
+    return sent;
+}
+
+void FrameBuffers::sync()
+{
+    if (front != nullptr)
+    {
+        memcpy(front, back, static_cast<size_t>(stride) * height);
+    }
+    else
+    {
+        for (int band = 0; band * band_rows < height; ++band)
+        {
+            band_hashes[band] = band_hash(band);
+        }
+    }
+    front_valid = true;
+}
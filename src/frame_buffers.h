@@ -0,0 +1,90 @@
+/**
+ * @file frame_buffers.h
+ * @brief Back and front frame buffers, so the next frame is drawn while the panel refreshes.
+ *
+ * The back buffer is the one the paint draws into. The front is what was last
+ * sent to the panel. `present` sends the rows of the back buffer that differ
+ * from the front, and starts the refresh without waiting for it. Drawing the
+ * next frame can start at once, because the panel refreshes from its own RAM;
+ * the next command sent to the panel waits for the refresh to finish.
+ *
+ * With a front buffer, the difference is found byte by byte, and each run of
+ * changed rows is sent as a window of the changed bytes. Without one, for
+ * builds short of RAM, the front is a hash of each band of rows, and runs of
+ * whole bands are sent.
+ *
+ * The back buffer is copied to the front rather than swapped with it, so the
+ * paint always holds the latest frame and can be drawn into incrementally.
+ */
+#ifndef FRAME_BUFFERS_H
+#define FRAME_BUFFERS_H
+
+#include <Arduino.h>
+#include "epd/epd1in54_V2.h"
+#include "layer_stack.h"
+
+class FrameBuffers
+{
+public:
+    //!< Rows in each band hashed when there is no front buffer.
+    static constexpr int band_rows{8};
+    //!< Tallest frame buffer, in pixels.
+    static constexpr int max_height{256};
+
+    /**
+     * @param back   Frame buffer that is drawn into.
+     * @param front  Frame buffer of the same size, or null to keep hashes of bands of rows instead.
+     * @param width  Of each frame buffer, in pixels; a multiple of 8.
+     * @param height Of each frame buffer, in pixels.
+     */
+    FrameBuffers(const uint8_t *back, uint8_t *front, int width, int height);
+
+    FrameBuffers(const FrameBuffers &) = delete;
+    FrameBuffers &operator=(const FrameBuffers &) = delete;
+
+    /**
+     * @brief Send what changed, and start a partial refresh.
+     *
+     * The back buffer is compared with the front, and the changes are marked
+     * in the background layer, so they are sent with the other layers' dirty
+     * regions. The refresh is not waited for.
+     *
+     * @param epd    Display.
+     * @param layers Layers composed as they are sent.
+     * @param all    Whether to send the whole frame, changed or not.
+     * @return The region sent; empty if nothing was.
+     */
+    DirtyRegion present(Epd &epd, LayerStack &layers, bool all = false);
+
+    /**
+     * @brief Record that the back buffer has been sent by other means, such as `Epd::DisplayPart`.
+     */
+    void sync();
+
+    /**
+     * @brief Record that the panel no longer shows the front, as after it has been cleared.
+     *
+     * The next `present` sends the whole frame.
+     */
+    void invalidate()
+    {
+        front_valid = false;
+    }
+
+private:
+    //!< Whether a row differs from the front, and if so its first and last differing bytes.
+    bool row_changed(int row, int &first, int &last) const;
+    //!< Find the next run of changed rows, from @p row, and move @p row past it.
+    DirtyRegion next_run(int &row) const;
+    uint32_t band_hash(int band) const;
+
+    const uint8_t *back;
+    uint8_t *front;
+    int width;
+    int height;
+    int stride;
+    bool front_valid{false};
+    uint32_t band_hashes[(max_height + band_rows - 1) / band_rows]{};
+};
+
+#endif
@@ -0,0 +1,153 @@
+/**
+ * @file layer_stack.cpp
+ * @brief Background, overlay and mask frame buffers, composed as they are sent to the display.
+ */
+#include "layer_stack.h"
+
+#include <algorithm>
+#include <string.h>
+
+void DirtyRegion::add(int left, int top, int right, int bottom)
+{
+    if (left >= right || top >= bottom)
+    {
+        return;
+    }
+    if (empty())
+    {
+        x0 = left;
+        y0 = top;
+        x1 = right;
+        y1 = bottom;
+        return;
+    }
+    x0 = std::min<int>(x0, left);
+    y0 = std::min<int>(y0, top);
+    x1 = std::max<int>(x1, right);
+    y1 = std::max<int>(y1, bottom);
+}
+
+LayerStack::LayerStack(uint8_t *background, uint8_t *overlay, uint8_t *mask, int width, int height):
+    background_image(background),
+    overlay_image(overlay),
+    mask_image(mask),
+    width(width),
+    height(height),
+    stride(width / 8),
+    overlay_paint(overlay, width, height),
+    mask_paint(mask, width, height)
+{
+    memset(overlay_image, 0xFF, stride * height);
+    if (mask_image != nullptr)
+    {
+        memset(mask_image, 0xFF, stride * height);
+    }
+}
+
+void LayerStack::mark(Layer layer, int x0, int y0, int x1, int y1)
+{
+    x0 = std::max(x0, 0);
+    y0 = std::max(y0, 0);
+    x1 = std::min(x1, width);
+    y1 = std::min(y1, height);
+    regions[static_cast<size_t>(layer)].add(x0, y0, x1, y1);
+    if (layer != Layer::background)
+    {
+        drawn.add(x0, y0, x1, y1);
+    }
+}
+
+void LayerStack::clear_overlay()
+{
+    if (drawn.empty())
+    {
+        return;
+    }
+    // What was drawn must be sent again, now without the overlay.
+    regions[static_cast<size_t>(Layer::overlay)].add(drawn.x0, drawn.y0, drawn.x1, drawn.y1);
+    for (int row = drawn.y0; row < drawn.y1; ++row)
+    {
+        memset(&overlay_image[row * stride], 0xFF, stride);
+        if (mask_image != nullptr)
+        {
+            memset(&mask_image[row * stride], 0xFF, stride);
+        }
+    }
+    drawn.clear();
+}
+
+DirtyRegion LayerStack::dirty() const
+{
+    DirtyRegion region;
+    for (const auto &layer_region : regions)
+    {
+        region.add(layer_region.x0, layer_region.y0, layer_region.x1, layer_region.y1);
+    }
+    return region;
+}
+
+void LayerStack::compose(int row, int first, int count, uint8_t *output) const
+{
+    size_t offset{static_cast<size_t>(row) * stride + first};
+    const uint8_t *background{&background_image[offset]};
+    if (drawn.empty())
+    {
+        memcpy(output, background, count);
+        return;
+    }
+    const uint8_t *overlay{&overlay_image[offset]};
+    const uint8_t *mask{mask_image != nullptr ? &mask_image[offset] : nullptr};
+
+    // Rows need not be word aligned; memcpy lets the compiler use whatever loads are safe.
+    int i{0};
+    for (; i + 4 <= count; i += 4)
+    {
+        uint32_t background_word;
+        uint32_t overlay_word;
+        memcpy(&background_word, &background[i], sizeof(background_word));
+        memcpy(&overlay_word, &overlay[i], sizeof(overlay_word));
+        if (mask != nullptr)
+        {
+            uint32_t mask_word;
+            memcpy(&mask_word, &mask[i], sizeof(mask_word));
+            background_word |= ~mask_word;
+        }
+        uint32_t result{overlay_word & background_word};
+        memcpy(&output[i], &result, sizeof(result));
+    }
+    for (; i < count; ++i)
+    {
+        output[i] = overlay[i] & (background[i] | (mask != nullptr ? static_cast<uint8_t>(~mask[i]) : 0));
+    }
+}
+
+DirtyRegion LayerStack::present(Epd &epd, bool all)
+{
+    DirtyRegion region{dirty()};
+    if (all)
+    {
+        region.add(0, 0, width, height);
+    }
+    for (auto &layer_region : regions)
+    {
+        layer_region.clear();
+    }
+    if (region.empty())
+    {
+        return region;
+    }
+
+    // The display addresses whole bytes.
+    region.x0 &= ~7;
+    region.x1 = std::min((region.x1 + 7) & ~7, width);
+    int first{region.x0 / 8};
+    int count{std::min((region.x1 - region.x0) / 8, max_row_bytes)};
+    int rows{epd.BeginFrameMemory(region.x0, region.y0, count * 8, region.y1 - region.y0)};
+    uint8_t output[max_row_bytes];
+    for (int row = 0; row < rows; ++row)
+    {
+        compose(region.y0 + row, first, count, output);
+        epd.WriteFrameMemory(output, count);
+    }
+    return region;
+}
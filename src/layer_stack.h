@@ -0,0 +1,149 @@
+/**
+ * @file layer_stack.h
+ * @brief Background, overlay and mask frame buffers, composed as they are sent to the display.
+ *
+ * The background holds a decoded image, and is only redrawn when the image
+ * changes. The overlay holds captions, icons and codes drawn over it, and the
+ * optional mask says where the overlay is opaque. All three are 1 bit per
+ * pixel frame buffers of the display's size, in the layout of `Paint`.
+ *
+ * Where the mask is white (or there is no mask), the overlay is transparent
+ * except for its black pixels; where the mask is black, the overlay replaces
+ * the background. That is, each output byte is
+ * `overlay & (background | ~mask)`, which is computed a 32 bit word at a time
+ * for each row just before the row is sent.
+ *
+ * Each layer has a dirty region; `present` sends only the union of them, so
+ * changing a caption sends the rows it covers, and never decodes the
+ * background again.
+ */
+#ifndef LAYER_STACK_H
+#define LAYER_STACK_H
+
+#include <Arduino.h>
+#include "epd/epd1in54_V2.h"
+#include "epd/epdpaint.h"
+
+enum class Layer : uint8_t
+{
+    background,
+    overlay,
+    mask,
+    count
+};
+
+/**
+ * @brief A rectangle of a frame buffer, in pixels; [x0, x1) by [y0, y1).
+ */
+struct DirtyRegion
+{
+    int16_t x0{0};
+    int16_t y0{0};
+    int16_t x1{0};
+    int16_t y1{0};
+
+    bool empty() const
+    {
+        return x0 >= x1 || y0 >= y1;
+    }
+
+    //!< Grow to include a rectangle.
+    void add(int left, int top, int right, int bottom);
+
+    void clear()
+    {
+        x0 = y0 = x1 = y1 = 0;
+    }
+};
+
+class LayerStack
+{
+public:
+    //!< Widest frame buffer row, in bytes.
+    static constexpr int max_row_bytes{64};
+
+    /**
+     * @param background Frame buffer of the background; usually the one the images are decoded into.
+     * @param overlay    Frame buffer of the overlay.
+     * @param mask       Frame buffer of the mask, or null for none.
+     * @param width      Of each frame buffer, in pixels; a multiple of 8.
+     * @param height     Of each frame buffer, in pixels.
+     */
+    LayerStack(uint8_t *background, uint8_t *overlay, uint8_t *mask, int width, int height);
+
+    LayerStack(const LayerStack &) = delete;
+    LayerStack &operator=(const LayerStack &) = delete;
+
+    bool has_mask() const
+    {
+        return mask_image != nullptr;
+    }
+
+    //!< Paint of the overlay, or of the mask if there is one; the background is drawn with its own paint.
+    Paint &paint(Layer layer)
+    {
+        return layer == Layer::mask ? mask_paint : overlay_paint;
+    }
+
+    /**
+     * @brief Record that part of a layer has been drawn.
+     *
+     * Coordinates are those of the frame buffer, whatever the rotation of the paint.
+     */
+    void mark(Layer layer, int x0, int y0, int x1, int y1);
+
+    void mark_all(Layer layer)
+    {
+        mark(layer, 0, 0, width, height);
+    }
+
+    /**
+     * @brief Make the overlay, and the mask if there is one, transparent.
+     */
+    void clear_overlay();
+
+    //!< Whether the overlay or mask has anything drawn on it.
+    bool overlay_visible() const
+    {
+        return !drawn.empty();
+    }
+
+    //!< Union of the dirty regions of the layers.
+    DirtyRegion dirty() const;
+
+    /**
+     * @brief Compose the dirty rows and send them to the display's frame memory.
+     *
+     * The region is widened to whole bytes, as the display requires. The dirty
+     * regions are cleared; the display is not refreshed.
+     *
+     * @param epd Display.
+     * @param all Whether to send the whole frame, dirty or not.
+     * @return The region sent; empty if nothing was.
+     */
+    DirtyRegion present(Epd &epd, bool all = false);
+
+    /**
+     * @brief Compose bytes [first, first + count) of a row.
+     *
+     * @param row    Row.
+     * @param first  First byte.
+     * @param count  Number of bytes.
+     * @param output Composed bytes.
+     */
+    void compose(int row, int first, int count, uint8_t *output) const;
+
+private:
+    uint8_t *background_image;
+    uint8_t *overlay_image;
+    uint8_t *mask_image;
+    int width;
+    int height;
+    int stride;
+    Paint overlay_paint;
+    Paint mask_paint;
+    DirtyRegion drawn;  //!< Of the overlay and mask since they were last cleared.
+    DirtyRegion regions[static_cast<size_t>(Layer::count)];
+};
+
+#endif
@@ -26,6 +26,30 @@
  *  static inline uint8_t generic_pgm_read_byte(const void* addr) { return *reinterpret_cast<const uint8_t *>(addr); }
  *  #endif
  *
+ * - epdpaint.h/.cpp: `DrawCharAt` ignores characters outside printable ASCII (they indexed past
+ *   the font table), `DrawStringAt` decodes UTF-8, and `DrawCharAt`/`DrawStringAt` overloads
+ *   draw a `Font` (font.h), merging whole glyph bytes into the frame buffer when unrotated.
+ *   These take an integer scale, 1 to 8, which expands glyph rows through bit_expansion.h.
+ * - epd1in54_V2.h/.cpp: `BeginFrameMemory` and `WriteFrameMemory` split `SetFrameMemory` so that rows can be
+ *   composed as they are sent, and epdif.h/.cpp has a `SpiTransfer` overload that sends a run of bytes.
+ * - epd1in54_V2.h/.cpp: `StartDisplayFrame` and `StartDisplayPartFrame` start a refresh without waiting for it,
+ *   and `SendCommand`, `Reset` and `BeginFrameMemory` wait for a refresh so started (`FinishRefresh`) first.
+ * - epdif.h/.cpp: on the ESP32, SPI goes through the ESP-IDF SPI master driver, and `SpiTransferAsync` sends a
+ *   run of bytes by DMA without waiting (`SpiTransferDone`, `SpiWaitTransfer`); `DigitalWrite` and `SpiTransfer`
+ *   wait for it first, so DC and CS are left alone while it is on the wire. The ESP8266 sends at once, through
+ *   the Arduino SPI library, and `SpiTransferAsync` returns when it is done. Host builds send through a fake
+ *   bus (`EpdIfFakeBus`) that completes queued transfers on a thread of its own, for test/test_epdif. ESP32 SPI
+ *   uses CLK_PIN and DIN_PIN, as wired below. epd1in54_V2.h/.cpp: `StartWriteFrameMemory` and
+ *   `FinishWriteFrameMemory` use it.
+ * - epd1in54_V2.h/.cpp: `direction` records which init the panel was last set up by, cleared by anything that
+ *   resets it; `HDirResume` skips the reset and init of `HDirInit` when the panel is still set up by it.
+ * - epd1in54_V2.h/.cpp: `Clear` sends each row in one SPI transfer, through `FillFrameMemory`, instead of
+ *   10,000 single byte transfers; `FillFrameMemory` also lets a clear be done a few rows at a time (clear_task.h).
+ * - epdpaint.h/.cpp: `DrawSpan` fills part of a row a byte at a time (bitblit.h), clipped as `DrawPixel`
+ *   clips; horizontal lines and filled rectangles are drawn with it, and `DrawFilledCircle` draws each
+ *   row once as a span instead of overdrawing it. shapes.h builds polygons, ellipses and arcs on it.
+ *   `DrawSpan` and `DrawFilledRectangle` take an optional 8x8 fill pattern (fill_pattern.h).
+ *
  * Reference for the Waveshare display, the 1.54" black/white model: https://www.waveshare.com/wiki/1.54inch_e-Paper_Module
  * See also https://www.waveshare.com/w/upload/e/e5/1.54inch_e-paper_V2_Datasheet.pdf
  * Note that, during operation, Waveshare recommends a full display reset at least every 24 hours. This will cause
@@ -80,7 +104,11 @@
  * The Waveshare displays do not have any read capability
  */
 
-#include <Ticker.h>
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <new>
+#include <time.h>
 
 #ifdef ESP32
 #include <WiFi.h>
@@ -128,9 +156,44 @@ static constexpr int WHITE     = 1;
 #include "epd/epd1in54_V2.h"
 #include "epd/epdpaint.h"
 #include "epd/fonts.h"
+#include "band_pipeline.h"
+#include "barcode.h"
+#include "bmp_decoder.h"
+#include "bmp_writer.h"
+#include "buffered_reader.h"
+#include "clear_task.h"
+#include "cooperative.h"
+#include "display_task.h"
+#include "file_font.h"
+#include "fnv1a.h"
+#include "frame_buffers.h"
+#include "layer_stack.h"
+#include "native_frame.h"
+#include "playlist.h"
+#include "qr_cache.h"
+#include "qr_encoder.h"
+#include "qr_render.h"
+#include "scene.h"
+#include "storage_manager.h"
+#include "text_cache.h"
+#include "text_layout.h"
+#include "widgets.h"
+
+static void run_display_command(const DisplayCommand &command);
+static bool step_display();
+
+//!< Owns `epd`, `paint` and the frame buffers once started; request handlers post commands to it.
+static DisplayTask display_task(run_display_command, step_display);
 
 static Epd epd;
 
+//!< Long operations (decoding, clearing, QR codes, snapshots), run a slice at a time between commands.
+static Scheduler scheduler;
+//!< Time each slice of them may take, in microseconds, before the network stack is serviced again.
+static constexpr uint32_t task_slice_us{5000};
+//!< Read-ahead buffer shared by the image decoders; only one image is decoded at a time.
+static BufferedReader reader;
+
 // The display size, in pixels.
 static constexpr size_t image_width = 200;
 static constexpr size_t image_height = 200;
@@ -140,16 +203,128 @@ static constexpr size_t image_height = 200;
 // out to exactly 5,000 bytes.
 static unsigned char image[image_width * image_height / 8];
 static Paint paint(image, image_width, image_height);
-static String currentImage{"<none>"};
-static String epdState{"Powered"};
 
+//!< Overlay drawn over the image, and, where there is memory for it, a mask of where it is opaque.
+static unsigned char overlay_image[sizeof(image)];
+#ifdef ESP8266
+static constexpr unsigned char *mask_image{nullptr};
+#else
+static unsigned char mask_image[sizeof(image)];
+#endif
+static LayerStack layers(image, overlay_image, mask_image, image_width, image_height);
+// What was last sent to the display; `image` is the back buffer. The ESP8266
+// keeps hashes of bands of rows instead of a copy.
+#ifdef ESP8266
+static constexpr unsigned char *front_image{nullptr};
+#else
+static unsigned char front_image[sizeof(image)];
+#endif
+static FrameBuffers frames(image, front_image, image_width, image_height);
+//!< Sends an image to the display as it is decoded.
+static BandPipeline pipeline(layers, epd, image_width, image_height);
+//!< Told of each row the decoders finish, while an image is decoded into `paint` for display.
+static BandPipeline *decode_pipeline{nullptr};
+//!< Set by the /overlay handler with the overlay below, under the guard; cleared once they are copied.
+static std::atomic<bool> overlay_requested{false};
+static String overlay_text;
+static bool overlay_top{false};
+static bool overlay_opaque{false};
+
+//!< Scene posted to /render, drawn in the loop; the buffer is not written while a scene is pending.
+static constexpr size_t scene_max_bytes{2048};
+static uint8_t scene_body[scene_max_bytes];
+static size_t scene_length{0};
+static size_t scene_total{0};
+static std::atomic<bool> scene_requested{false};
+//!< Whether the frame buffer holds the scene on the display, so a new scene need only send the rows that differ.
+static bool scene_shown{false};
+
+static WidgetBoard widgets;
+//!< Whether the widgets are drawn; not over generated codes, nor on a cleared or sleeping display.
+static bool widgets_active{false};
+
+// Playlist; a posted playlist is applied in the loop.
+static Playlist playlist;
+static constexpr size_t playlist_max_bytes{1024};
+static uint8_t playlist_body[playlist_max_bytes];
+static size_t playlist_length{0};
+static size_t playlist_total{0};
+static std::atomic<bool> playlist_requested{false};
+//!< Set while the display is asleep or cleared; posting the playlist again resumes it.
+static bool playlist_paused{false};
+static int playlist_current{-1};
+static int playlist_upcoming{-1};
+static uint32_t playlist_next_at{0};
+#ifndef ESP8266
+// The next item is decoded here while the current one is shown. The ESP8266
+// cannot spare the RAM; it writes the native frame of the next item instead,
+// a band of rows at a time, so it is shown with a single read.
+static unsigned char next_image[sizeof(image)];
+static Paint next_paint(next_image, image_width, image_height);
+static bool playlist_prepared{false};
+#else
+//!< Playlist item whose native frame has been written ahead of time, or tried.
+static int playlist_written{-1};
+#endif
+
+//!< Times before this have not been set from the network; 2020-01-01.
+static constexpr time_t clock_set_after{1577836800};
 
-static String qr_code_text;
-static int qr_code_version{0};
-static int qr_code_ecc{0};
-static bool qr_code_scale{false};
+static SharedString currentImage{display_task, "<none>"};
+static SharedString epdState{display_task, "Powered"};
+
+
+//!< A QR code, as requested of /qr.
+struct QrRequest
+{
+    String text;
+    int version;
+    int ecc;
+    bool scale;
+    bool persist;
+};
+//!< Set by the /qr handler with `qr_posted`, under the guard; the encode is started, and stepped, from `loop`.
+static std::atomic<bool> qr_code_requested{false};
+static QrRequest qr_posted{};
+//!< The QR code being generated, copied from `qr_posted`; used only by the display task.
+static QrRequest qr_code{};
+static QrEncoder qr_encoder;
+//!< Cache key of the requested QR code.
+static QrCache::Key qr_code_key;
+
+//!< Set by the /barcode handler once the text is encoded, under the guard; drawn from `loop`.
+static std::atomic<bool> barcode_requested{false};
+static bool barcode_persist{false};
+static String barcode_text;
+//!< Encoded by the /barcode handler; the display task draws a copy.
+static Barcode barcode;
+
+//!< A copy of the frame buffer for /screenshot; the response, which may outlive the request, shares it.
+struct Screenshot
+{
+    std::unique_ptr<uint8_t[]> image;
+    int width{0};
+    int height{0};
+    std::atomic<bool> ready{false};
+};
+//!< Set by the /screenshot handler with `screenshot_pending`, under the guard; the display task makes the copy.
+static std::atomic<bool> screenshot_requested{false};
+static std::shared_ptr<Screenshot> screenshot_pending;
 
 static AsyncWebServer server(80);
+static StorageManager storage;
+static QrCache qr_cache(storage);
+
+//!< Fonts of status messages: the first line, and the rest.
+//!< Uploading title.epf or message.epf (see tools/make_font.py) replaces the built-in font.
+static FileFont title_file_font;
+static FileFont message_file_font;
+static Font *title_font{&Prop24};
+static Font *message_font{&Prop16};
+
+//!< Layouts and rendered lines of the status and caption text; these are redrawn with the same text often.
+static TextLayoutCache text_layouts;
+static TextCache text_cache;
 
 static char password[64] = "PassWord348";
 
@@ -164,64 +339,6 @@ static const char index_html[] PROGMEM =
     "function _(el) {\n"
     "  return document.getElementById(el);\n"
     "}\n"
-    "function recalcSize()\n"
-    "{\n"
-    "    var version = parseInt(_(\"version\").value);\n"
-    "    var ecc = parseInt(_(\"ecc\").value);\n"
-    "    var ecc_sizes;\n"
-    // Alphanumeric only is upper case, numbers, space and '$%*+-./:',
-    // which implies an *upper case* URL could fit in smaller codes.
-    "    switch(version) {\n"
-    "    case 1: ecc_sizes = [[41, 25, 17], [34, 20, 14], [27, 16, 11], [17, 10, 7]]; break;\n"
-    "    case 2: ecc_sizes = [[77, 47, 32], [63, 38, 26], [48, 29, 20], [34, 20, 14]]; break;\n"
-    "    case 3: ecc_sizes = [[127, 77, 53], [101, 61, 42], [77, 47, 32], [58, 35, 24]]; break;\n"
-    "    case 4: ecc_sizes = [[187, 114, 78], [149, 90, 62], [111, 67, 46], [82, 50, 34]]; break;\n"
-    "    case 5: ecc_sizes = [[2555, 154, 106], [202, 122, 84], [144, 87, 60], [106, 64, 44]]; break;\n"
-    "    case 6: ecc_sizes = [[322, 195, 134], [255, 154, 106], [178, 108, 74], [139, 84, 58]]; break;\n"
-    "    case 7: ecc_sizes = [[370, 224, 154], [293, 178, 122], [207, 125, 86], [154, 93, 64]]; break;\n"
-    "    case 8: ecc_sizes = [[461, 279, 192], [365, 221, 152], [259, 157, 108], [202, 122, 84]]; break;\n"
-    "    case 9: ecc_sizes = [[552, 335, 230], [432, 262, 180], [312, 189, 130], [235, 143, 98]]; break;\n"
-    "    case 10: ecc_sizes = [[652, 395, 271], [513, 311, 213], [364, 221, 151], [288, 174, 119]]; break;\n"
-    "    case 11: ecc_sizes = [[772, 468, 321], [604, 366, 251], [427, 259, 177], [331, 200, 137]]; break;\n"
-    "    case 12: ecc_sizes = [[883, 535, 367], [691, 419, 287], [489, 296, 203], [374, 227, 155]]; break;\n"
-    "    case 13: ecc_sizes = [[1022, 619, 425], [796, 483, 331], [580, 352, 241], [427, 259, 177]]; break;\n"
-    "    case 14: ecc_sizes = [[1101, 667, 458], [871, 528, 362], [621, 376, 258], [468, 283, 194]]; break;\n"
-    "    case 15: ecc_sizes = [[1250, 758, 520], [991, 600, 412], [703, 426, 292], [530, 321, 220]]; break;\n"
-    "    case 16: ecc_sizes = [[1408, 854, 586], [1082, 656, 450], [775, 470, 322], [602, 365, 250]]; break;\n"
-    "    case 17: ecc_sizes = [[1548, 938, 644], [1212, 734, 504], [876, 531, 364], [674, 408, 280]]; break;\n"
-    "    case 18: ecc_sizes = [[1725, 1046, 718], [1346, 816, 560], [948, 574, 394], [746, 452, 310]]; break;\n"
-    "    case 19: ecc_sizes = [[1903, 1153, 792], [1500, 909, 624], [1063, 644, 442], [813, 493, 338]]; break;\n"
-    "    case 20: ecc_sizes = [[2061, 1249, 858], [1600, 970, 666], [1159, 702, 482], [919, 557, 382]]; break;\n"
-    "    case 21: ecc_sizes = [[2232, 1352, 929], [1708, 1035, 711], [1224, 742, 509], [969, 587, 403]]; break;\n"
-    "    case 22: ecc_sizes = [[2409, 1460, 1003], [1872, 1134, 779], [1358, 823, 565], [1056, 640, 439]]; break;\n"
-    "    case 23: ecc_sizes = [[2620, 1588, 1091], [2059, 1248, 857], [1468, 890, 611], [1108, 672, 461]]; break;\n"
-    "    case 24: ecc_sizes = [[2812, 1704, 1171], [2188, 1326, 911], [1588, 963, 661], [1228, 744, 511]]; break;\n"
-    "    case 25: ecc_sizes = [[3057, 1853, 1273], [2395, 1451, 997], [1718, 1041, 715], [1286, 779, 535]]; break;\n"
-    "    case 26: ecc_sizes = [[3283, 1990, 1367], [2544, 1542, 1059], [1804, 1094, 751], [1425, 864, 593]]; break;\n"
-    "    case 27: ecc_sizes = [[3517, 2132, 1465], [2701, 1637, 1125], [1933, 1172, 805], [1501, 910, 625]]; break;\n"
-    "    case 28: ecc_sizes = [[3669, 2223, 1528], [2857, 1732, 1190], [2085, 1263, 868], [1581, 958, 658]]; break;\n"
-    "    case 29: ecc_sizes = [[3909, 2369, 1628], [3035, 1839, 1264], [2181, 1322, 908], [1677, 1016, 698]]; break;\n"
-    "    case 30: ecc_sizes = [[4158, 2520, 1732], [3289, 1994, 1370], [2358, 1429, 982], [1782, 1080, 742]]; break;\n"
-    "    case 31: ecc_sizes = [[4417, 2677, 1840], [3486, 2113, 1452], [2473, 1499, 1030], [1897, 1150, 790]]; break;\n"
-    "    case 32: ecc_sizes = [[4686, 2840, 1952], [3693, 2238, 1538], [2670, 1618, 1112], [2022, 1226, 842]]; break;\n"
-    "    case 33: ecc_sizes = [[4965, 3009, 2068], [3909, 2369, 1628], [2805, 1700, 1168], [2157, 1307, 898]]; break;\n"
-    "    case 34: ecc_sizes = [[5253, 3183, 2188], [4134, 2506, 1722], [2949, 1787, 1228], [2301, 1394, 958]]; break;\n"
-    "    case 35: ecc_sizes = [[5529, 3351, 2303], [4343, 2632, 1809], [3081, 1867, 1283], [2361, 1431, 983]]; break;\n"
-    "    case 36: ecc_sizes = [[5836, 3537, 2431], [4588, 2780, 1911], [3244, 1966, 1351], [2524, 1530, 1051]]; break;\n"
-    "    case 37: ecc_sizes = [[6153, 3729, 2563], [4775, 2894, 1989], [3417, 2071, 1423], [2625, 1591, 1093]]; break;\n"
-    "    case 38: ecc_sizes = [[6479, 3927, 2699], [5039, 3054, 2099], [3599, 2181, 1499], [2735, 1658, 1139]]; break;\n"
-    "    case 39: ecc_sizes = [[6743, 4087, 2809], [5313, 3220, 2213], [3791, 2298, 1579], [2927, 1774, 1219]]; break;\n"
-    "    case 40: ecc_sizes = [[7089, 4296, 2953], [5596, 3391, 2331], [3993, 2420, 1663], [3057, 1852, 1273]]; break;\n"
-    "    }\n"
-    "    _(\"size\").innerText = ecc_sizes[ecc];\n"
-    "    checkSize();\n"
-    "}\n"
-    "function checkSize()\n"
-    "{\n"
-    "    var textValue = _(\"text\").value, size = _(\"size\"), generate = _(\"generate\"),\n"
-    "       maxLength = JSON.parse(\"[\" + size.innerText + \"]\")[/^[0-9]*$/.test(textValue) ? 0 : /^[A-Z0-9 $%%*+-.\\/:]*$/.test(textValue) ? 1 : 2];\n"
-    "    generate.disabled = textValue.length > maxLength;\n"
-    "}\n"
     "function updateStatus() {\n"
     "  xmlhttp=new XMLHttpRequest();\n"
     "  xmlhttp.open(\"GET\", \"/state\", false);\n"
@@ -232,6 +349,9 @@ static const char index_html[] PROGMEM =
     "   _(\"freestorage\").innerText = statusData.freestorage;\n"
     "   _(\"usedstorage\").innerText = statusData.usedstorage;\n"
     "   _(\"totalstorage\").innerText = statusData.totalstorage;\n"
+    "   _(\"classstorage\").innerText = Object.keys(statusData.storage).map(function(k) {\n"
+    "       return k + \": \" + statusData.storage[k].used + \" of \" + statusData.storage[k].quota;\n"
+    "     }).join(\" | \");\n"
     "  };"
     "  xmlhttp.send();\n"
     "}\n"
@@ -263,6 +383,19 @@ static const char index_html[] PROGMEM =
     "   _(\"status\").innerText = xmlhttp.responseText;\n"
     "   listFilesButton();"
     "}"
+    "function loadPlaylistButton() {\n"
+    "  xmlhttp=new XMLHttpRequest();\n"
+    "  xmlhttp.open(\"GET\", \"/playlist\", false);\n"
+    "  xmlhttp.send();\n"
+    "  _(\"playlist\").value = xmlhttp.responseText;\n"
+    "}\n"
+    "function savePlaylistButton() {\n"
+    "  xmlhttp=new XMLHttpRequest();\n"
+    "  xmlhttp.open(\"POST\", \"/playlist\", false);\n"
+    "  xmlhttp.setRequestHeader(\"Content-Type\", \"application/json\");\n"
+    "  xmlhttp.send(_(\"playlist\").value);\n"
+    "  _(\"playliststatus\").innerText = xmlhttp.responseText;\n"
+    "}\n"
     "function listFilesButton() {\n"
     "  xmlhttp=new XMLHttpRequest();\n"
     "  xmlhttp.open(\"GET\", \"/listfiles\", false);\n"
@@ -328,19 +461,17 @@ static const char index_html[] PROGMEM =
     "</script>"
     "<body onload=\"listFilesButton()\">"
     "  <h1>Status</h1>"
-    "  <p>Free Storage: <span id=\"freestorage\">%FREESPIFFS%</span> | Used Storage: <span id=\"usedstorage\">%USEDSPIFFS%</span> | Total Storage: <span id=\"totalstorage\">%TOTALSPIFFS%</span> | Current image: <span id=\"currentimage\">%CURRENTIMAGE%</span> | State: <span id=\"epdstate\">%EPDSTATE%</span></p>"
+    "  <p>Free Storage: <span id=\"freestorage\">%FREESPIFFS%</span> | Used Storage: <span id=\"usedstorage\">%USEDSPIFFS%</span> | Total Storage: <span id=\"totalstorage\">%TOTALSPIFFS%</span> | Current image: <span id=\"currentimage\">%CURRENTIMAGE%</span> | State: <span id=\"epdstate\">%EPDSTATE%</span><br><span id=\"classstorage\"></span></p>"
     "  <h1>QR Code Generation</h1>"
-#ifdef ESP8266
-    "   <h2>WARNING: Large versions (typically around 17 or higher) will cause watchdog timer resets on ESP8266.</h2>"
-#endif
     "  <form method=\"POST\" action=\"/qr\">"
-    "   <input type=\"text\" name=\"text\" id=\"text\"/ onchange=\"checkSize()\" oninput=\"checkSize()\">"
+    "   <input type=\"text\" name=\"text\" id=\"text\"/>"
     "   <label for=\"version\">QR version:</label>"
-    "   <select name=\"version\" id=\"version\" onchange=\"recalcSize()\">"
+    "   <select name=\"version\" id=\"version\">"
+    "      <option value=\"0\" selected>Automatic</option>"
     "      <option value=\"1\">1</option>"
     "      <option value=\"2\">2</option>"
     "      <option value=\"3\">3</option>"
-    "      <option value=\"4\" selected>4</option>"
+    "      <option value=\"4\">4</option>"
     "      <option value=\"5\">5</option>"
     "      <option value=\"6\">6</option>"
     "      <option value=\"7\">7</option>"
@@ -378,23 +509,73 @@ static const char index_html[] PROGMEM =
     "      <option value=\"39\">39</option>"
     "      <option value=\"40\">40</option>"
     "   </select> "
-    "   <label for=\"ecc\">EEC:</label>"
-    "   <select name=\"ecc\" id=\"ecc\" onchange=\"recalcSize()\">"
+    "   <label for=\"ecc\">Minimum ECC:</label>"
+    "   <select name=\"ecc\" id=\"ecc\">"
     "     <option value=\"0\">Low</option>"
-    "     <option value=\"1\">Medium</option>"
+    "     <option value=\"1\" selected>Medium</option>"
     "     <option value=\"2\">Quartile</option>"
-    "     <option value=\"3\" selected>High</option>"
+    "     <option value=\"3\">High</option>"
     "   </select> "
     "   <label for=\"scale\">Scale image to fit:</label>"
     "   <input type=\"radio\" name=\"scale\" value=\"scale\" title=\"Scale to fit\" checked=\"true\">"
+    "   <label for=\"persist\">Save snapshot:</label>"
+    "   <input type=\"checkbox\" name=\"persist\" id=\"persist\" value=\"persist\" title=\"Save a copy to flash\">"
     "   <input type=\"submit\" id=\"generate\" name=\"generate\" value=\"Generate\" title=\"Generate QR\">"
-    "   Maximum lengths (numeric, alphanumeric, others): <span id=\"size\"> 139,84,58 </span>"
-    "   <br> Maximum lengths are for numeric only, <em>upper</em> case alphanumeric, <b>$%%*+-./:</b> characters and space, and finally for general data."
-    "   <br>Generation is asynchronous; refresh the file list shortly after the QR code is shown on the display."
+    "   <br>The smallest version that holds the text is used unless one is chosen; the error correction is raised as far as the version allows."
+    "   Numeric only, or <em>upper</em> case alphanumeric with <b>$%%*+-./:</b> and space, fits more characters than general text."
+    "   <br>Generation is asynchronous. If a snapshot is saved, refresh the file list shortly after the QR code is shown on the display."
+    "   </form>"
+    "  <h1>Barcode Generation</h1>"
+    "  <form method=\"POST\" action=\"/barcode\">"
+    "   <input type=\"text\" name=\"text\" id=\"barcodetext\"/>"
+    "   <label for=\"type\">Type:</label>"
+    "   <select name=\"type\" id=\"type\">"
+    "     <option value=\"code128\" selected>Code 128</option>"
+    "     <option value=\"ean13\">EAN-13</option>"
+    "     <option value=\"datamatrix\">Data Matrix</option>"
+    "   </select> "
+    "   <label for=\"barcodepersist\">Save snapshot:</label>"
+    "   <input type=\"checkbox\" name=\"persist\" id=\"barcodepersist\" value=\"persist\" title=\"Save a copy to flash\">"
+    "   <input type=\"submit\" value=\"Generate\" title=\"Generate barcode\">"
+    "   <br>Code 128 takes printable ASCII; EAN-13 takes 12 digits, or 13 with the check digit; Data Matrix takes up to 174 characters (348 digits)."
+    "   </form>"
+    "  <h1>Caption</h1>"
+    "  <form method=\"POST\" action=\"/overlay\">"
+    "   <input type=\"text\" name=\"text\" id=\"overlaytext\"/>"
+    "   <label for=\"overlaytop\">Top:</label>"
+    "   <input type=\"checkbox\" name=\"top\" id=\"overlaytop\" value=\"top\" title=\"Place the caption at the top\">"
+    "   <label for=\"overlayopaque\">Opaque:</label>"
+    "   <input type=\"checkbox\" name=\"opaque\" id=\"overlayopaque\" value=\"opaque\" title=\"Draw the caption on a white band\">"
+    "   <input type=\"submit\" value=\"Show\" title=\"Show caption\">"
+    "   <br>The caption is drawn over the current image without reloading it; an empty caption removes it. The white band is not available on the ESP8266."
     "   </form>"
+    "  <h1>Widget</h1>"
+    "  <form method=\"POST\" action=\"/widget\">"
+    "   <label for=\"widgetname\">Name:</label>"
+    "   <input type=\"text\" name=\"name\" id=\"widgetname\" size=\"8\"/>"
+    "   <select name=\"type\" id=\"widgettype\">"
+    "     <option value=\"clock\" selected>Clock</option>"
+    "     <option value=\"counter\">Counter</option>"
+    "     <option value=\"text\">Text</option>"
+    "     <option value=\"sparkline\">Sparkline</option>"
+    "   </select> "
+    "   X <input type=\"number\" name=\"x\" value=\"0\" min=\"0\" max=\"199\"/>"
+    "   Y <input type=\"number\" name=\"y\" value=\"0\" min=\"0\" max=\"199\"/>"
+    "   W <input type=\"number\" name=\"w\" value=\"96\" min=\"1\" max=\"200\"/>"
+    "   H <input type=\"number\" name=\"h\" value=\"32\" min=\"1\" max=\"200\"/>"
+    "   Every <input type=\"number\" name=\"interval\" value=\"0\" min=\"0\"/> s"
+    "   <input type=\"submit\" value=\"Place\" title=\"Place widget\">"
+    "   <br>Widgets are drawn over images and scenes. Push values with POST /widget/value (name, value); an interval of 0 redraws only on a new value (a clock defaults to every minute)."
+    "   </form>"
+    "  <h1>Playlist</h1>"
+    "  <textarea id=\"playlist\" rows=\"6\" cols=\"60\">{\"enabled\": true, \"shuffle\": false, \"tz\": \"UTC0\", \"items\": [{\"file\": \"/image.bmp\", \"dwell\": 60}]}</textarea><br>"
+    "  <button onclick=\"loadPlaylistButton()\">Load</button>"
+    "  <button onclick=\"savePlaylistButton()\">Save</button> <span id=\"playliststatus\"></span>"
+    "  <br>Each item has a file and a dwell time in seconds, and optionally a \"from\" and \"to\" time (\"HH:MM\") to show it only then; \"tz\" is a POSIX time zone."
     "  <h1>Display Control</h1>"
     "  <p><button onclick=\"sleepButton()\">Sleep E-Ink</button>"
-    "  <button onclick=\"clearDisplayButton()\">Clear Display</button><br>"
+    "  <button onclick=\"clearDisplayButton()\">Clear Display</button>"
+    "  <a href=\"/screenshot\" target=\"_blank\">Screenshot</a><br>"
     "   Power can be turned off without corrupting a sleeping display; otherwise corruption may occur.<br>"
     "   <b>Note: Do not set display to sleep for long-term storage with an image shown.</b>"
     "  <p><h1>File Upload</h1></p>"
@@ -414,46 +595,334 @@ static String humanReadableSize(const size_t bytes);
 static String listFiles(bool ishtml);
 static void display_image(const String *filename);
 static void snapshot(Paint &snapshotPaint);
-static void display_qr_code();
+static bool draw_qr_code(QRCode &qrcode);
+static bool draw_barcode(const Barcode &symbol, const String &text);
+static void display_overlay();
+static bool draw_scene();
+static void show_image_frame(bool sent = false);
+static WidgetStyle widget_style();
+static void step_widgets();
+static bool decode_png(Paint &target, const String &filename);
+static void start_clock();
+static void step_playlist();
+static void show_playlist_item(bool loaded);
+
+/**
+ * @brief Show an image file: clear the display, then decode the image, sending bands of it as they are done.
+ *
+ * BMP files are decoded a row at a time. PNGdec decodes a whole file in one call, so a PNG takes one step.
+ */
+class ImageTask : public CooperativeTask
+{
+public:
+    void begin(const String &name)
+    {
+        filename = name;
+        state = State::init;
+    }
+
+    bool step(const Budget &budget) override;
+
+private:
+    enum class State : uint8_t
+    {
+        init,
+        clear,
+        decode,
+        show,
+        done
+    };
+
+    String filename;
+    State state{State::done};
+    ClearTask clear{epd};
+    BmpDecoder decoder{reader};
+};
+
+/**
+ * @brief Push a generated frame in the paint to the display.
+ *
+ * The panel is cleared with a `ClearTask`, the frame is sent a few rows at a
+ * time, and the partial refresh is waited for by checking the busy line.
+ */
+class FrameTask : public CooperativeTask
+{
+public:
+    /**
+     * @brief Initialise the display, and set up to show the paint.
+     *
+     * @param persist     Whether to also save a snapshot to flash.
+     * @param description What was generated, for the status; a string literal.
+     * @param clear       Whether to clear the panel first, with a full refresh; a
+     *                    cached frame is shown with just the partial update, and
+     *                    without the reset if the last frame was shown this way.
+     */
+    void begin(bool persist, const char *description, bool clear = true);
+
+    bool step(const Budget &budget) override;
+
+private:
+    enum class State : uint8_t
+    {
+        clear,
+        send,
+        refresh,
+        done
+    };
+
+    State state{State::done};
+    ClearTask clear{epd};
+    int row{0};
+    bool persist{false};
+    const char *description{""};
+};
+
+/**
+ * @brief Encode the requested QR code, a few encoder steps at a time, and show it.
+ */
+class QrTask : public CooperativeTask
+{
+public:
+    void begin()
+    {
+        state = State::start;
+    }
+
+    bool step(const Budget &budget) override;
+
+private:
+    enum class State : uint8_t
+    {
+        start,
+        encode,
+        show,
+        done
+    };
+
+    State state{State::done};
+    FrameTask frame;
+};
+
+/**
+ * @brief Draw the requested barcode, and show it.
+ */
+class BarcodeTask : public CooperativeTask
+{
+public:
+    //!< Take the posted barcode; the caller has seen `barcode_requested` set.
+    void begin();
+
+    bool step(const Budget &budget) override;
+
+private:
+    enum class State : uint8_t
+    {
+        draw,
+        show,
+        done
+    };
+
+    State state{State::done};
+    Barcode symbol;
+    String text;
+    bool persist{false};
+    FrameTask frame;
+};
+
+/**
+ * @brief Draw the posted scene, and send only the rows that changed.
+ *
+ * If the previous scene is not on the display, the panel is cleared first.
+ */
+class SceneTask : public CooperativeTask
+{
+public:
+    void begin()
+    {
+        state = State::draw;
+    }
+
+    bool step(const Budget &budget) override;
+
+private:
+    enum class State : uint8_t
+    {
+        draw,
+        clear,
+        present,
+        done
+    };
+
+    State state{State::done};
+    bool compare{false};
+    uint32_t started{0};
+    ClearTask clear{epd};
+};
+
+/**
+ * @brief Save a copy of a paint to flash as a 1bpp BMP, a chunk at a time.
+ *
+ * Tasks run in order, so nothing draws into the paint until the copy is done.
+ */
+class SnapshotTask : public CooperativeTask
+{
+public:
+    /**
+     * @brief Make room for the file, and open it.
+     *
+     * @return false if there is no room, or it cannot be written.
+     */
+    bool begin(Paint &source);
+
+    bool step(const Budget &budget) override;
+
+private:
+    static constexpr size_t chunk_bytes{256};
+
+    fs::File file;
+    const uint8_t *image{nullptr};
+    int width{0};
+    int height{0};
+    size_t size{0};
+    size_t written{0};
+};
+
+/**
+ * @brief Load a playlist item into a paint, and show it if it is due.
+ *
+ * The native frame of the item is used if it has one; otherwise the item is
+ * decoded, a few rows at a time, and its native frame written, so it is
+ * decoded only once. The frame is named from the file's name, size and time
+ * of writing, so a file uploaded again is decoded again; they are stored with
+ * the frame, so names that collide do not show another file's frame.
+ *
+ * PNGdec decodes a whole file in one call, so a PNG takes one step.
+ */
+class PlaylistTask : public CooperativeTask
+{
+public:
+    /**
+     * @brief Set up to load an item.
+     *
+     * @param target   Paint to load into.
+     * @param capacity Size of the paint's buffer, in bytes.
+     * @param filename File of the item.
+     * @param show     Whether to show it once loaded; otherwise it is prepared, to be shown later.
+     * @return false if the file is missing.
+     */
+    bool begin(Paint &target, size_t capacity, const char *filename, bool show);
+
+    bool step(const Budget &budget) override;
+
+private:
+    enum class State : uint8_t
+    {
+        load,
+        decode,
+        store,
+        finish,
+        done
+    };
+
+    State state{State::done};
+    Paint *target{nullptr};
+    size_t capacity{0};
+    String filename;
+    uint32_t identity[2]{};     //!< Size and time of writing of the file.
+    char cached[32]{};          //!< Path of the native frame.
+    bool show{false};
+    bool loaded{false};
+    BmpDecoder decoder{reader};
+};
+
+#ifdef ESP8266
+/**
+ * @brief Write the native frame of a playlist item ahead of time, a band of rows at a time.
+ *
+ * There is no room for a second frame buffer to decode the next item into
+ * while the current one is shown, so it is decoded into a band of rows at a
+ * time, each written to its native frame once done. The item is then shown
+ * with a single read into the frame buffer, as `PlaylistTask` finds the frame.
+ */
+class PlaylistFrameTask : public CooperativeTask
+{
+public:
+    /**
+     * @brief Set up to write the frame of an item.
+     *
+     * @return false if there is nothing to do: the file is missing, is not a
+     *         BMP that can be decoded, or its frame is already written.
+     */
+    bool begin(const char *filename);
+
+    bool step(const Budget &budget) override;
+
+private:
+    static constexpr int band_rows{20};
+
+    bool write_band();
+
+    unsigned char band_image[image_width / 8 * band_rows];
+    Paint band{band_image, image_width, band_rows};
+    int band_top{0};            //!< Row of the frame at the top of the band.
+    BmpDecoder decoder{reader};
+    NativeFrameWriter writer;
+};
+#endif
+
+static ImageTask image_task;
+static PlaylistTask playlist_task;
+#ifdef ESP8266
+static PlaylistFrameTask playlist_frame_task;
+#endif
+static QrTask qr_task;
+static BarcodeTask barcode_task;
+static SceneTask scene_task;
+static ClearTask clear_task(epd);
+static SnapshotTask snapshot_task;
 
 
 /**
  * @brief Display a message in the paint
  *
- * This will of course be later copied to the display.
+ * This will of course be later copied to the display. The message is wrapped
+ * to the width of the paint, and clipped to its height.
  * @param offset Vertical offset of message.
  * @param font   Font to use to display message.
  * @param item   Message to display.
+ * @return Vertical offset after the message.
  */
-static inline void display_status_message(int offset, sFONT &font, const char *item)
+static inline int display_status_message(int offset, Font &font, const char *item)
 {
-    paint.DrawStringAt(0, offset, item, &font, BLACK);
+    auto &layout{text_layouts.get(item, font, paint.GetWidth(), paint.GetHeight() - offset)};
+    layout.draw(paint, 0, offset, BLACK, &text_cache);
+    return offset + layout.height();
 }
 
 /**
  * @brief Display a list of messages.
  *
- * Messages displayed vertically, each line offset by the font height.
- * Messages after the first are displayed in the Font16 font.
+ * Messages displayed vertically, each below the previous one.
+ * Messages after the first are displayed in the message font.
  *
  * @tparam Args  Argument type(s).
  * @param offset Offset of first line
  * @param font   Font for first message.
  * @param item   First message.
  * @param args   Additional messages.
+ * @return Vertical offset after the last message.
  */
 template<typename...Args>
-static void display_status_message(int offset, sFONT &font, const char *item, Args...args)
+static int display_status_message(int offset, Font &font, const char *item, Args...args)
 {
-    display_status_message(offset, font, item);
-    display_status_message(offset + font.Height, Font16, args...);
+    return display_status_message(display_status_message(offset, font, item), *message_font, args...);
 }
 
 /**
  * @brief Display a list of messsages from the screen top.
  *
- * The first message is displayed in Font24, subsequent messages
- * are displayed in Font16.
+ * The first message is displayed in the title font, subsequent messages
+ * are displayed in the message font.
  *
  * @tparam Args  Argument type(s).
  * @param item   First message.
@@ -465,41 +934,52 @@ static void display_status_message(const char *item, Args...args)
     paint.SetWidth(image_width);
     paint.SetHeight(image_height);
     paint.Clear(WHITE);
-    display_status_message(0, Font24, item, args...);
+    display_status_message(0, *title_font, item, args...);
     epd.WaitUntilIdle();
     epd.SetFrameMemory(paint.GetImage(), 0, 0, paint.GetWidth(), paint.GetHeight());
     epd.DisplayFrame();
 }
 
-static int DrawFrameQRTextCode(const String &qr, int lines)
+/**
+ * @brief Draw a QR code in the display area below some status lines.
+ *
+ * The code is made as large as fits, and centred in the area.
+ *
+ * @param qr  Text to encode.
+ * @param top Bottom of the status lines.
+ * @return The height of the code, in pixels; 0 if it could not be drawn.
+ */
+static int DrawFrameQRTextCode(const String &qr, int top)
 {
     Serial.println("Generating QR Frame");
     Serial.flush();
+    int available_height{epd.height - top};
+    const QrCache::Key key{qr, 0, ECC_LOW, QrCache::fit_scale, epd.width, available_height};
     QRCode frame_qrcode;
-    uint8_t version{5};
-    uint8_t qrcodeData[qrcode_getBufferSize(version)];
-    if (qrcode_initText(&frame_qrcode, qrcodeData, version, 0, qr.c_str()) != 0)
-    {
-        return 0;
-    }
-    constexpr uint16_t blockSize{3};
-    paint.SetHeight(frame_qrcode.size * blockSize);
-    paint.SetWidth(frame_qrcode.size * blockSize);
-    paint.Clear(WHITE);
-    for (uint8_t x = 0; x < frame_qrcode.size; ++x)
+    bool encoded{qr_cache.modules(key, frame_qrcode)};
+    if (encoded || !qr_cache.load(key, paint, sizeof(image)))
     {
-        for (uint8_t y = 0; y < frame_qrcode.size; ++y)
+        QrEncoder encoder;
+        if (!encoded && (!encoder.begin(qr.c_str(), 0, ECC_LOW) || !encoder.run() || !encoder.get(frame_qrcode)))
+        {
+            return 0;
+        }
+        int quiet_zone;
+        int blockSize{qr_fit_scale(frame_qrcode.size, epd.width, available_height, quiet_zone)};
+        if (blockSize == 0)
         {
-            auto module{qrcode_getModule(&frame_qrcode, x, y)};
-            uint16_t rect_x{x * blockSize};
-            uint16_t rect_y{y * blockSize};
-            paint.DrawFilledRectangle(rect_x, rect_y, rect_x + blockSize - 1, rect_y + blockSize - 1, module ? BLACK : WHITE);
+            return 0;
         }
+        paint.SetHeight(frame_qrcode.size * blockSize);
+        paint.SetWidth(frame_qrcode.size * blockSize);
+        paint.Clear(WHITE);
+        qr_render(paint, frame_qrcode, 0, 0, blockSize);
+        qr_cache.store(key, frame_qrcode, paint);
     }
 
-    epd.SetFrameMemory(paint.GetImage(), (epd.width - paint.GetWidth()) / 2, Font24.Height + Font16.Height * lines, paint.GetWidth(), paint.GetHeight());
+    epd.SetFrameMemory(paint.GetImage(), (epd.width - paint.GetWidth()) / 2, top + (available_height - paint.GetHeight()) / 2, paint.GetWidth(), paint.GetHeight());
 
-    return frame_qrcode.size * blockSize;
+    return paint.GetHeight();
 }
 
 /**
@@ -523,15 +1003,15 @@ static void display_initialize_message(WiFiManager *w)
     Serial.println(qr_string);
 
     paint.SetWidth(epd.width);
-    paint.SetHeight(std::min(epd.height, epd.height - Font24.Height - 3*Font16.Height));
+    paint.SetHeight(epd.height);
     paint.Clear(WHITE);
 
-    display_status_message(0, Font24, "Setup WiFi",
+    int top{display_status_message(0, *title_font, "Setup WiFi",
         "Connect to",
         ssid.c_str(),
-        password);
-    epd.SetFrameMemory(paint.GetImage(), 0, 0, paint.GetWidth(), paint.GetHeight());
-    int qr_height{ DrawFrameQRTextCode(qr_string, 4) };
+        password)};
+    epd.SetFrameMemory(paint.GetImage(), 0, 0, paint.GetWidth(), top);
+    int qr_height{ DrawFrameQRTextCode(qr_string, top) };
     if (qr_height == 0)
     {
         Serial.println("QR code generation failure");
@@ -557,6 +1037,19 @@ void setup()
     epd.Clear();
     display_status_message("Initializing");
 
+    // Mounted before WiFi setup, so that the setup screen can use uploaded fonts, and its QR code can come from the cache.
+    LittleFS.begin();
+    storage.begin();
+    if (title_file_font.begin("/title.epf"))
+    {
+        title_font = &title_file_font;
+    }
+    if (message_file_font.begin("/message.epf"))
+    {
+        message_font = &message_file_font;
+    }
+    playlist.load();
+
     WiFiManager wifiManager;
 
     wifiManager.setAPCallback(display_initialize_message);
@@ -591,8 +1084,12 @@ void setup()
     //here  "AutoConnectAP"
     //and goes into a blocking loop awaiting configuration
     wifiManager.autoConnect(ssid, password);
-
-    LittleFS.begin();
+    start_clock();
+#ifdef ESP8266
+    randomSeed(ESP8266TrueRandom.random());
+#elif defined(ESP32)
+    randomSeed(esp_random());
+#endif
 
     // Set up the web server.
     server.onNotFound([](AsyncWebServerRequest *request)
@@ -616,10 +1113,12 @@ void setup()
 
     server.on("/delete", HTTP_GET, [](AsyncWebServerRequest * request) {
         auto param{ request->getParam("file")};
-        if (param != nullptr)
+        if (param == nullptr)
         {
-            LittleFS.remove(param->value());
+            request->send(405, "Missing parameter");
+            return;
         }
+        storage.remove(param->value());
         request->send(200, "text/plain", "Deleted File: " + param->value());
     });
     server.on("/download", HTTP_GET, [](AsyncWebServerRequest * request) {
@@ -634,15 +1133,62 @@ void setup()
         }
     });
 
+    server.on("/screenshot", HTTP_GET, [](AsyncWebServerRequest * request) {
+        // Served from a copy of the frame buffer, which the display task makes
+        // between steps, as it owns the frame buffer; nothing is written to flash.
+        auto screenshot{std::make_shared<Screenshot>()};
+        screenshot->image.reset(new (std::nothrow) uint8_t[sizeof(image)]);
+        if (!screenshot->image)
+        {
+            request->send(503, "text/plain", "Not enough memory for a screenshot");
+            return;
+        }
+        bool queued{false};
+        {
+            DisplayTask::Guard guard{display_task};
+            if (!screenshot_requested)
+            {
+                screenshot_pending = screenshot;
+                screenshot_requested = true;
+                queued = true;
+            }
+        }
+        if (!queued)
+        {
+            request->send(503, "text/plain", "A screenshot is already being taken");
+            return;
+        }
+        auto response{request->beginChunkedResponse("image/bmp",
+            [screenshot](uint8_t *buffer, size_t maxLen, size_t index) -> size_t {
+                if (!screenshot->ready)
+                {
+                    return RESPONSE_TRY_AGAIN;
+                }
+                return bmp1_fill(screenshot->image.get(), screenshot->width, screenshot->height, index, buffer, maxLen);
+            })};
+        response->addHeader("Content-Disposition", "inline; filename=\"screenshot.bmp\"");
+        request->send(response);
+    });
+
     server.on("/state", HTTP_GET, [](AsyncWebServerRequest * request) {
-        FSInfo64 info;
-        LittleFS.info64(info);
+        uint64_t total;
+        uint64_t used;
+        StorageManager::capacity(total, used);
         String state{"{"};
-        state += "\"currentImage\":\"" + currentImage + "\"," +
-            "\"epdstate\":\"" + epdState + "\"," +
-            "\"freestorage\":\"" + humanReadableSize((info.totalBytes - info.usedBytes)) + "\"," +
-            "\"usedstorage\":\"" + humanReadableSize((info.usedBytes)) + "\"," +
-            "\"totaltorage\":\"" + humanReadableSize((info.totalBytes)) + "\"}";
+        state += "\"currentImage\":\"" + currentImage.get() + "\"," +
+            "\"epdstate\":\"" + epdState.get() + "\"," +
+            "\"freestorage\":\"" + humanReadableSize((total - used)) + "\"," +
+            "\"usedstorage\":\"" + humanReadableSize((used)) + "\"," +
+            "\"totaltorage\":\"" + humanReadableSize((total)) + "\"," +
+            "\"storage\":{";
+        for (size_t i = 0; i < static_cast<size_t>(StorageClass::count); ++i)
+        {
+            auto storage_class{static_cast<StorageClass>(i)};
+            state += String(i == 0 ? "" : ",") + "\"" + StorageManager::class_name(storage_class) + "\":{" +
+                "\"used\":\"" + humanReadableSize(storage.usage(storage_class)) + "\"," +
+                "\"quota\":\"" + humanReadableSize(storage.quota(storage_class)) + "\"}";
+        }
+        state += "}}";
         request->send(200, "application/json", state);
     });
     server.on("/display", HTTP_GET, [](AsyncWebServerRequest * request) {
@@ -650,32 +1196,74 @@ void setup()
         if (param != nullptr)
         {
             String name{param->value()};
-            if (LittleFS.exists(name))
+            if (!LittleFS.exists(name))
+            {
+                request->send(404, "text/plain", "Image file " + name + " not found");
+            }
+            else if (display_task.post(DisplayCommandType::image, name.c_str()))
             {
-                currentImage = name;
-                epdState = "displaying image";
-                display_image(&name);
-                request->send(200, "text/plain", "Loaded image file: " + name);
+                request->send(200, "text/plain", "Displaying image file: " + name);
             }
             else
             {
-                request->send(404, "text/plain", "Image file " + name + " not found");
+                request->send(503, "text/plain", "Display busy");
             }
         }
     });
     server.on("/sleep", HTTP_GET, [](AsyncWebServerRequest * request) {
-        epd.Sleep();
-        epdState = "sleeping";
+        if (!display_task.post(DisplayCommandType::sleep))
+        {
+            request->send(503, "text/plain", "Display busy");
+            return;
+        }
         request->send(200, "OK");
     });
     server.on("/clear", HTTP_GET, [](AsyncWebServerRequest * request) {
-        currentImage = "<none>";
-        epdState = "cleared";
-        epd.HDirInit();
-        epd.Clear();
+        if (!display_task.post(DisplayCommandType::clear))
+        {
+            request->send(503, "text/plain", "Display busy");
+            return;
+        }
         request->send(200, "OK");
     });
 
+    server.on("/barcode", HTTP_POST, [](AsyncWebServerRequest *request)
+    {
+        auto type{request->getParam("type", true)};
+        auto text{request->getParam("text", true)};
+        if (type == nullptr || text == nullptr)
+        {
+            request->send(405, "Missing parameters");
+            return;
+        }
+
+        BarcodeType barcode_type;
+        if (!Barcode::parse_type(type->value(), barcode_type))
+        {
+            request->send(400, "text/plain", "Unknown barcode type");
+            return;
+        }
+        // Encoded here, so a bad text is refused at once, and handed over once the display task has taken the last.
+        Barcode encoded;
+        if (!encoded.encode(barcode_type, text->value().c_str()))
+        {
+            request->send(400, "text/plain", "Text cannot be encoded as " + type->value());
+            return;
+        }
+        DisplayTask::Guard guard{display_task};
+        if (barcode_requested)
+        {
+            request->send(503, "text/plain", "Barcode generation in progress");
+            return;
+        }
+        barcode = encoded;
+        barcode_text = text->value();
+        barcode_persist = request->getParam("persist", true) != nullptr;
+        barcode_requested = true;
+
+        request->redirect("/");
+    });
+
     server.on("/qr", HTTP_POST, [](AsyncWebServerRequest *request)
     {
         auto version{request->getParam("version", true)};
@@ -687,322 +1275,1059 @@ void setup()
             return;
         }
 
-        qr_code_version = std::atoi(version->value().c_str());
-        qr_code_ecc = std::atoi(ecc->value().c_str());
-        qr_code_text = text->value();
-        qr_code_scale = request->getParam("scale", true) != nullptr;
+        int requested_version{std::atoi(version->value().c_str())};
+        int requested_ecc{std::atoi(ecc->value().c_str())};
+        if (requested_version < 0 || requested_version > QrEncoder::max_version || requested_ecc < ECC_LOW || requested_ecc > ECC_HIGH)
+        {
+            request->send(400, "text/plain", "Invalid version or ECC level");
+            return;
+        }
+        uint8_t smallest_version{QrEncoder::smallest_version(text->value().c_str(), requested_ecc)};
+        if (smallest_version == 0)
+        {
+            request->send(413, "text/plain", "Text too long for a QR code");
+            return;
+        }
+        if (requested_version != 0 && requested_version < smallest_version)
+        {
+            request->send(400, "text/plain", "Text too long for version " + String(requested_version) +
+                "; the smallest that holds it is " + String(smallest_version));
+            return;
+        }
 
-        static Ticker ticker;
-#ifdef ESP8266
-        ticker.once_ms_scheduled(500, display_qr_code);
-#else
-        ticker.once_ms(500, display_qr_code);
-#endif
+        DisplayTask::Guard guard{display_task};
+        if (qr_code_requested || qr_encoder.state() != QrEncoder::State::idle)
+        {
+            request->send(503, "text/plain", "QR code generation in progress");
+            return;
+        }
+        qr_posted = QrRequest{text->value(), requested_version, requested_ecc, request->getParam("scale", true) != nullptr,
+            request->getParam("persist", true) != nullptr};
+        qr_code_requested = true;
 
         request->redirect("/");
 
     });
-    server.begin();
-
-    String myIp{ WiFi.localIP().toString() };
-
-    epd.LDirInit();
-    epd.DisplayPartBaseWhiteImage();
 
-    paint.SetWidth(epd.width);
-    paint.SetHeight(Font24.Height + 2 * Font16.Height);
-    paint.Clear(WHITE);
-    display_status_message(0, Font24, "Ready",
-        "Connect to http://",
-        myIp.c_str());
-    epd.SetFrameMemory(paint.GetImage(), 0, 0, paint.GetWidth(), paint.GetHeight());
-    DrawFrameQRTextCode("http://"+ myIp, 3);
-    epd.DisplayFrame();
-}
+    // A JSON or MessagePack scene (see scene.h) as the request body.
+    server.on("/render", HTTP_POST, [](AsyncWebServerRequest *request)
+    {
+        if (scene_requested)
+        {
+            request->send(503, "text/plain", "Scene rendering in progress");
+            return;
+        }
+        if (scene_total > scene_max_bytes)
+        {
+            request->send(413, "text/plain", "Scene too large");
+            return;
+        }
+        if (scene_length == 0)
+        {
+            request->send(400, "text/plain", "No scene");
+            return;
+        }
+        scene_requested = true;
+        request->send(202, "text/plain", "Rendering");
+    }, nullptr, [](AsyncWebServerRequest *request, uint8_t *data, size_t len, size_t index, size_t total)
+    {
+        if (scene_requested)
+        {
+            return;
+        }
+        scene_total = total;
+        if (total > scene_max_bytes)
+        {
+            scene_length = 0;
+            return;
+        }
+        memcpy(&scene_body[index], data, len);
+        scene_length = index + len;
+    });
 
-/* The main loop -------------------------------------------------------------*/
-void loop()
-{
-}
+    server.on("/overlay", HTTP_POST, [](AsyncWebServerRequest *request)
+    {
+        // No text clears the overlay.
+        auto text{request->getParam("text", true)};
+        DisplayTask::Guard guard{display_task};
+        overlay_text = text != nullptr ? text->value() : String();
+        overlay_top = request->getParam("top", true) != nullptr;
+        overlay_opaque = request->getParam("opaque", true) != nullptr;
+        overlay_requested = true;
+        request->redirect("/");
+    });
 
-/**
- * @brief
- *
- * @param row
- * @param col
- * @param lcdidx
- * @param lcdbuffer
- */
-static inline void pushColours(int row, int col, int lcdidx, uint16_t lcdbuffer[])
-{
-    bool anyBlack = false;
-    for (int idx = 0; idx < lcdidx; ++idx)
+    server.on("/widget", HTTP_POST, [](AsyncWebServerRequest *request)
     {
-        anyBlack = anyBlack | lcdbuffer[idx] != 0;
-        paint.DrawPixel(row, col + idx, lcdbuffer[idx] != 0 ? WHITE : BLACK);
-    }
-    yield();
-}
+        auto name{request->getParam("name", true)};
+        if (name == nullptr)
+        {
+            request->send(405, "Missing parameters");
+            return;
+        }
+        DisplayTask::Guard guard{display_task};
+        if (request->getParam("remove", true) != nullptr)
+        {
+            if (!widgets.remove(name->value().c_str()))
+            {
+                request->send(404, "text/plain", "No widget " + name->value());
+                return;
+            }
+            request->redirect("/");
+            return;
+        }
 
-static constexpr int BUFFPIXEL{20};
+        auto type{request->getParam("type", true)};
+        auto x{request->getParam("x", true)};
+        auto y{request->getParam("y", true)};
+        auto w{request->getParam("w", true)};
+        auto h{request->getParam("h", true)};
+        if (type == nullptr || x == nullptr || y == nullptr || w == nullptr || h == nullptr)
+        {
+            request->send(405, "Missing parameters");
+            return;
+        }
+        WidgetType widget_type;
+        if (!WidgetBoard::parse_type(type->value(), widget_type))
+        {
+            request->send(400, "text/plain", "Unknown widget type");
+            return;
+        }
+        // Seconds; 0 or none for the type's default.
+        auto interval{request->getParam("interval", true)};
+        uint32_t interval_ms{interval != nullptr ? static_cast<uint32_t>(std::atol(interval->value().c_str())) * 1000 : 0};
+        if (!widgets.add(name->value().c_str(), widget_type, std::atoi(x->value().c_str()), std::atoi(y->value().c_str()),
+            std::atoi(w->value().c_str()), std::atoi(h->value().c_str()), interval_ms))
+        {
+            request->send(400, "text/plain", "Invalid widget, or too many widgets");
+            return;
+        }
+        request->redirect("/");
+    });
 
+    server.on("/playlist", HTTP_GET, [](AsyncWebServerRequest *request)
+    {
+        request->send(200, "application/json", playlist.to_json());
+    });
 
-/**
- * @brief Read an arbitrary binary value from a file.
- *
- * Intended for POD types, such as int16 or int32.
- *
- * @tparam T Container type.
- * @param f  File to read frm.
- * @return Data read.
+    // A JSON playlist (see playlist.h) as the request body; it replaces the playlist, and starts it.
+    server.on("/playlist", HTTP_POST, [](AsyncWebServerRequest *request)
+    {
+        if (playlist_requested)
+        {
+            request->send(503, "text/plain", "Playlist update in progress");
+            return;
+        }
+        if (playlist_total > playlist_max_bytes)
+        {
+            request->send(413, "text/plain", "Playlist too large");
+            return;
+        }
+        if (playlist_length == 0)
+        {
+            request->send(400, "text/plain", "No playlist");
+            return;
+        }
+        playlist_requested = true;
+        request->send(202, "text/plain", "Updating playlist");
+    }, nullptr, [](AsyncWebServerRequest *request, uint8_t *data, size_t len, size_t index, size_t total)
+    {
+        if (playlist_requested)
+        {
+            return;
+        }
+        playlist_total = total;
+        if (total > playlist_max_bytes)
+        {
+            playlist_length = 0;
+            return;
+        }
+        memcpy(&playlist_body[index], data, len);
+        playlist_length = index + len;
+    });
+
+    server.on("/widget/value", HTTP_POST, [](AsyncWebServerRequest *request)
+    {
+        auto name{request->getParam("name", true)};
+        auto value{request->getParam("value", true)};
+        if (name == nullptr || value == nullptr)
+        {
+            request->send(405, "Missing parameters");
+            return;
+        }
+        DisplayTask::Guard guard{display_task};
+        if (!widgets.set_value(name->value().c_str(), value->value().c_str()))
+        {
+            request->send(404, "text/plain", "No widget " + name->value());
+            return;
+        }
+        request->send(200, "text/plain", "OK");
+    });
+    String myIp{ WiFi.localIP().toString() };
+
+    epd.LDirInit();
+    epd.DisplayPartBaseWhiteImage();
+
+    paint.SetWidth(epd.width);
+    paint.SetHeight(epd.height);
+    paint.Clear(WHITE);
+    int top{display_status_message(0, *title_font, "Ready",
+        "Connect to http://",
+        myIp.c_str())};
+    epd.SetFrameMemory(paint.GetImage(), 0, 0, paint.GetWidth(), top);
+    DrawFrameQRTextCode("http://"+ myIp, top);
+    epd.DisplayFrame();
+
+    // The display belongs to the display task from here on; requests are served once it is running.
+    display_task.begin();
+    server.begin();
+}
+
+/* The main loop -------------------------------------------------------------*/
+void loop()
+{
+    display_task.poll();
+}
+
+/**
+ * @brief Carry out a command posted by a request handler; runs on the display task.
  */
-template<typename T>
-T read(File &f)
+static void run_display_command(const DisplayCommand &command)
 {
-    T result;
-    f.read(reinterpret_cast<uint8_t *>(&result), sizeof(result));
-    return result;
+    // Whatever is under way finishes first; the commands use the display too.
+    scheduler.finish(task_slice_us);
+    switch (command.type)
+    {
+    case DisplayCommandType::image:
+    {
+        String name{command.file};
+        currentImage = name;
+        epdState = "displaying image";
+        storage.touch(name);
+        display_image(&name);
+        break;
+    }
+    case DisplayCommandType::sleep:
+        epd.Sleep();
+        frames.invalidate();
+        scene_shown = false;
+        widgets_active = false;
+        playlist_paused = true;
+        epdState = "sleeping";
+        break;
+    case DisplayCommandType::clear:
+        currentImage = "<none>";
+        epdState = "cleared";
+        scene_shown = false;
+        widgets_active = false;
+        playlist_paused = true;
+        epd.HDirInit();
+        clear_task.begin();
+        scheduler.add(clear_task);
+        frames.invalidate();
+        break;
+    }
 }
 
 /**
- * @brief Read 16 bytes, in platform order.
+ * @brief Copy the frame buffer for the pending /screenshot.
  *
- * @param f File to read from.
- * @return 16 bytes, platform order.
+ * Between steps, so it is whatever the current task has drawn so far, but
+ * never a frame whose size changes part way through.
  */
-static inline uint16_t read16(File& f)
+static void take_screenshot()
 {
-    return read<uint16_t>(f);
+    std::shared_ptr<Screenshot> screenshot;
+    {
+        DisplayTask::Guard guard{display_task};
+        screenshot.swap(screenshot_pending);
+        screenshot_requested = false;
+    }
+    screenshot->width = paint.GetWidth();
+    screenshot->height = paint.GetHeight();
+    memcpy(screenshot->image.get(), paint.GetImage(), sizeof(image));
+    screenshot->ready = true;
 }
 
 /**
- * @brief Read 32 bytes, in platform order.
+ * @brief Do the work requests have left pending; runs on the display task between commands.
+ *
+ * Nothing new is started while a task is under way, as they all draw into the
+ * frame buffer; the request flags stay set until then.
  *
- * @param f File to read from.
- * @return 32 bytes, platform order.
+ * @return true while there are tasks under way, so the step is called again at once.
  */
-static inline uint32_t read32(File& f)
+static bool step_display()
 {
-    return read<uint32_t>(f);
+    if (screenshot_requested)
+    {
+        take_screenshot();
+    }
+    if (scheduler.busy())
+    {
+        return scheduler.run(task_slice_us);
+    }
+    if (qr_code_requested)
+    {
+        {
+            DisplayTask::Guard guard{display_task};
+            qr_code = qr_posted;
+            qr_code_requested = false;
+        }
+        qr_task.begin();
+        scheduler.add(qr_task);
+        return scheduler.run(task_slice_us);
+    }
+    if (barcode_requested)
+    {
+        barcode_task.begin();
+        scheduler.add(barcode_task);
+        return scheduler.run(task_slice_us);
+    }
+    if (overlay_requested)
+    {
+        display_overlay();
+    }
+    if (scene_requested)
+    {
+        scene_task.begin();
+        scheduler.add(scene_task);
+        return scheduler.run(task_slice_us);
+    }
+    step_playlist();
+    step_widgets();
+    return scheduler.run(task_slice_us);
 }
 
 /**
- * @brief Read a BMP file and push it to the paint object.
+ * @brief Read a BMP file and draw it into a paint, all at once.
  *
- * This is adapted with very minor changes from the Adafruit source.
+ * The decode yields between slices of `task_slice_us`.
  *
+ * @param target   Paint to draw into.
  * @param filename File to read from.
  * @param x        Offset in paint to store the image.
  * @param y        Offset in paint to store the image.
  */
-void bmpDraw(const char *filename, int x, int y)
+void bmpDraw(Paint &target, const char *filename, int x, int y)
 {
-
-  File     bmpFile;
-  int      bmpWidth, bmpHeight;   // W+H in pixels
-  uint8_t  bmpDepth;              // Bit depth (currently must be 24)
-  uint32_t bmpImageoffset;        // Start of image data in file
-  uint32_t rowSize;               // Not always = bmpWidth; may have padding
-  uint8_t  sdbuffer[3*BUFFPIXEL]; // pixel in buffer (R+G+B per pixel)
-  uint16_t lcdbuffer[BUFFPIXEL];  // pixel out buffer (16-bit per pixel)
-  uint8_t  buffidx = sizeof(sdbuffer); // Current position in sdbuffer
-  boolean  goodBmp = false;       // Set to true on valid header parse
-  boolean  flip    = true;        // BMP is stored bottom-to-top
-  int      w, h, row, col;
-  uint8_t  r, g, b;
-  uint32_t pos = 0, startTime = millis();
-  uint8_t  lcdidx = 0;
-  boolean  first = true;
-
-  if((x >= paint.GetWidth()) || (y >= paint.GetHeight())) return;
-
-  Serial.println();
-  Serial.print(F("Loading image '"));
-  Serial.print(filename);
-  Serial.println('\'');
-  // Open requested file on SD card
-  if (!(bmpFile = LittleFS.open(filename, "r"))) {
-    Serial.println(F("File not found"));
-    return;
-  }
-
-  // Parse BMP header
-  if(read16(bmpFile) == 0x4D42) { // BMP signature
-    Serial.println(F("File size: ")); Serial.println(read32(bmpFile));
-    (void)read32(bmpFile); // Read & ignore creator bytes
-    bmpImageoffset = read32(bmpFile); // Start of image data
-    Serial.print(F("Image Offset: ")); Serial.println(bmpImageoffset, DEC);
-    // Read DIB header
-    Serial.print(F("Header size: ")); Serial.println(read32(bmpFile));
-    bmpWidth  = read32(bmpFile);
-    bmpHeight = read32(bmpFile);
-    if(read16(bmpFile) == 1) { // # planes -- must be '1'
-      bmpDepth = read16(bmpFile); // bits per pixel
-      Serial.print(F("Bit Depth: ")); Serial.println(bmpDepth);
-      if((bmpDepth == 24) && (read32(bmpFile) == 0)) { // 0 = uncompressed
-
-        goodBmp = true; // Supported BMP format -- proceed!
-        Serial.print(F("Image size: "));
-        Serial.print(bmpWidth);
-        Serial.print('x');
-        Serial.println(bmpHeight);
-
-        // BMP rows are padded (if needed) to 4-byte boundary
-        rowSize = (bmpWidth * 3 + 3) & ~3;
-
-        // If bmpHeight is negative, image is in top-down order.
-        // This is not canon but has been observed in the wild.
-        if(bmpHeight < 0) {
-          bmpHeight = -bmpHeight;
-          flip      = false;
-        }
-
-        // Crop area to be loaded
-        w = bmpWidth;
-        h = bmpHeight;
-        if((x+w-1) >= paint.GetWidth())  w = paint.GetWidth()  - x;
-        if((y+h-1) >= paint.GetHeight()) h = paint.GetHeight() - y;
-
-        // Set TFT address window to clipped image bounds
-        // tft.setAddrWindow(x, y, x+w-1, y+h-1);
-
-        for (row=0; row<h; row++) { // For each scanline...
-          // Seek to start of scan line.  It might seem labor-
-          // intensive to be doing this on every line, but this
-          // method covers a lot of gritty details like cropping
-          // and scanline padding.  Also, the seek only takes
-          // place if the file position actually needs to change
-          // (avoids a lot of cluster math in SD library).
-          if(flip) // Bitmap is stored bottom-to-top order (normal BMP)
-            pos = bmpImageoffset + (bmpHeight - 1 - row) * rowSize;
-          else     // Bitmap is stored top-to-bottom
-            pos = bmpImageoffset + row * rowSize;
-          if(bmpFile.position() != pos) { // Need seek?
-            bmpFile.seek(pos);
-            buffidx = sizeof(sdbuffer); // Force buffer reload
-          }
-
-          for (col=0; col<w; col++) { // For each column...
-            // Time to read more pixel data?
-            if (buffidx >= sizeof(sdbuffer)) { // Indeed
-              // Push LCD buffer to the display first
-              if(lcdidx > 0) {
-                pushColours(row, col - lcdidx, lcdidx, lcdbuffer);
-                // tft.pushColors(lcdbuffer, lcdidx, first);
-                lcdidx = 0;
-                first  = false;
-              }
-              bmpFile.read(sdbuffer, sizeof(sdbuffer));
-              buffidx = 0; // Set index to beginning
-            }
-
-            // Convert pixel from BMP to TFT format
-            b = sdbuffer[buffidx++];
-            g = sdbuffer[buffidx++];
-            r = sdbuffer[buffidx++];
-            lcdbuffer[lcdidx++] = (r << 24) | (g << 8) || b; // tft.color565(r,g,b);
-          } // end pixel
-        // Write any remaining data to LCD
-            if(lcdidx > 0) {
-                pushColours(row, col - lcdidx, lcdidx, lcdbuffer);
-                lcdidx = 0;
-            // tft.pushColors(lcdbuffer, lcdidx, first);
-            }
-        } // end scanline
-        Serial.print(F("Loaded in "));
-        Serial.print(millis() - startTime);
-        Serial.println(" ms");
-      } // end goodBmp
+    BmpDecoder decoder(reader);
+    if (!decoder.begin(target, filename, x, y))
+    {
+        return;
+    }
+    while (decoder.step(Budget{task_slice_us}))
+    {
+        yield();
     }
-  }
-
-  bmpFile.close();
-  if(!goodBmp) Serial.println(F("BMP format not recognized."));
 }
 
 // The ESP8266 has insufficient program memory to support
 // reading a PNG file.
 #ifndef ESP8266
-File myfile;
 PNG png;
+//!< Paint the PNG decoder draws into.
+static Paint *png_target{&paint};
 
 void * myOpen(const char *filename, int32_t *size) {
   Serial.printf("Attempting to open %s\n", filename);
-  myfile = LittleFS.open(filename, "r");
-  *size = myfile.size();
-  return &myfile;
+  if (!reader.open(filename)) return nullptr;
+  *size = reader.size();
+  return &reader;
 }
 void myClose(void *handle) {
-  if (myfile) myfile.close();
+  reader.close();
 }
-int32_t myRead(myfile *handle, uint8_t *buffer, int32_t length) {
-  if (!myfile) return 0;
-  return myfile.read(buffer, length);
+int32_t myRead(PNGFILE *handle, uint8_t *buffer, int32_t length) {
+  if (!reader.is_open()) return 0;
+  return reader.read(buffer, length);
 }
-int32_t mySeek(myfile *handle, int32_t position) {
-  if (!myfile) return 0;
-  return myfile.seek(position);
+int32_t mySeek(PNGFILE *handle, int32_t position) {
+  if (!reader.is_open()) return 0;
+  return reader.seek(position);
 }
 
 void PNGDraw(PNGDRAW *pDraw) {
     uint16_t usPixels[320];
 
     png.getLineAsRGB565(pDraw, usPixels, PNG_RGB565_LITTLE_ENDIAN, 0xffffffff);
-    for (int i = 0; i < pDraw->iWidth && i < paint.GetWidth(); ++i)
+    for (int i = 0; i < pDraw->iWidth && i < png_target->GetWidth(); ++i)
     {
-        paint.DrawPixel(i, pDraw->y, usPixels[i] !=  0 ? BLACK : WHITE);
+        png_target->DrawPixel(i, pDraw->y, usPixels[i] !=  0 ? BLACK : WHITE);
+    }
+    if (decode_pipeline != nullptr)
+    {
+        decode_pipeline->rows_ready(pDraw->y + 1);
     }
 }
 #endif
 
-static void display_image(const String *filename)
+//!< Whether a file is of a type that can be decoded.
+static bool is_image_file(const String &filename)
 {
-    if (filename->endsWith(".png"))
-    {
 #ifndef ESP8266
-        int rc = png.open(filename->c_str(), myOpen, myClose, myRead, mySeek, PNGDraw);
-         if (rc == PNG_SUCCESS) {
-            Serial.printf("image specs: (%d x %d), %d bpp, pixel type: %d\n", png.getWidth(), png.getHeight(), png.getBpp(), png.getPixelType());
-            epdState = "active";
-            epd.LDirInit();
-            epd.Clear();
-            paint.SetWidth(image_width);
-            paint.SetHeight(image_height);
-            paint.Clear(WHITE);
-            rc = png.decode(NULL, 0);
-            png.close();
-            epd.WaitUntilIdle();
-            // Because it's full size, this is a short-cut.
-            epd.DisplayPart(paint.GetImage());
-        }
+    if (filename.endsWith(".png"))
+    {
+        return true;
+    }
 #endif
+    return filename.endsWith(".bmp") || filename.endsWith(".BMP");
+}
+
+/**
+ * @brief Decode a PNG file into a paint of the display's size, cleared to white first, in one call.
+ *
+ * @return false if it cannot be decoded; always, on the ESP8266.
+ */
+static bool decode_png(Paint &target, const String &filename)
+{
+#ifndef ESP8266
+    target.SetWidth(image_width);
+    target.SetHeight(image_height);
+    target.Clear(WHITE);
+    png_target = &target;
+    int rc = png.open(filename.c_str(), myOpen, myClose, myRead, mySeek, PNGDraw);
+    if (rc == PNG_SUCCESS) {
+        Serial.printf("image specs: (%d x %d), %d bpp, pixel type: %d\n", png.getWidth(), png.getHeight(), png.getBpp(), png.getPixelType());
+        png.decode(NULL, 0);
+        png.close();
     }
-    else if (filename->endsWith(".bmp") || filename->endsWith(".BMP"))
+    png_target = &paint;
+    return rc == PNG_SUCCESS;
+#else
+    return false;
+#endif
+}
+
+bool ImageTask::step(const Budget &budget)
+{
+    switch (state)
     {
+    case State::init:
+        scene_shown = false;
+        Serial.println("Attempting to display image");
+        if (!is_image_file(filename))
+        {
+            state = State::done;
+            return false;
+        }
         epdState = "active";
         epd.LDirInit();
-        epd.Clear();
-        Serial.println("Attempting to display image");
+        clear.begin();
+        state = State::clear;
+        return true;
+    case State::clear:
+        if (clear.step(budget))
+        {
+            return true;
+        }
+        // Bands of rows are sent as they are decoded.
+        pipeline.begin();
+        state = State::show;
+        if (filename.endsWith(".png"))
+        {
+            decode_pipeline = &pipeline;
+            decode_png(paint, filename);
+            decode_pipeline = nullptr;
+            return true;
+        }
         paint.SetWidth(image_width);
         paint.SetHeight(image_height);
         paint.Clear(WHITE);
-        bmpDraw(filename->c_str(), 0, 0);
-        // Because it's full size, this is a short-cut.
-        epd.DisplayPart(paint.GetImage());
-        currentImage = *filename;
+        if (decoder.begin(paint, filename.c_str(), 0, 0))
+        {
+            state = State::decode;
+        }
+        return true;
+    case State::decode:
+        while (decoder.next_row())
+        {
+            pipeline.rows_ready(decoder.rows_done());
+            if (budget.expired())
+            {
+                return true;
+            }
+        }
+        state = State::show;
+        return true;
+    case State::show:
+    {
+        bool sent{pipeline.active()};
+        pipeline.finish();
+        if (sent)
+        {
+            // Decoding is what is left of the total; see band_pipeline.h for
+            // timing the decoding and the transfer apart.
+            const BandPipelineTiming &timing{pipeline.timing()};
+            Serial.printf("Image decoded and sent in %lu ms: %lu ms in display calls, %lu ms composing\n",
+                static_cast<unsigned long>(timing.total / 1000), static_cast<unsigned long>(timing.send / 1000),
+                static_cast<unsigned long>(timing.compose / 1000));
+        }
+        show_image_frame(sent);
+        currentImage = filename;
+        state = State::done;
+        return false;
+    }
+    case State::done:
+        break;
+    }
+    return false;
+}
+
+static void display_image(const String *filename)
+{
+    image_task.begin(*filename);
+    scheduler.add(image_task);
+}
+
+/**
+ * @brief Draw every widget into the frame buffer; the board is shared with request handlers.
+ */
+static void draw_widgets()
+{
+    DisplayTask::Guard guard{display_task};
+    widgets.draw_all(paint, widget_style(), millis());
+}
+
+/**
+ * @brief Show a newly decoded image, under the overlay if there is one.
+ *
+ * @param sent Whether the image has already been sent to the display, as it was decoded.
+ */
+static void show_image_frame(bool sent)
+{
+    if (sent)
+    {
+        frames.sync();
+    }
+    draw_widgets();
+    widgets_active = true;
+    // The refresh is not waited for; the next frame can be drawn meanwhile.
+    if (frames.present(epd, layers, !sent).empty())
+    {
+        // Nothing was drawn over the image, but it has still to be shown.
+        epd.StartDisplayPartFrame();
+    }
+}
+
+/**
+ * @brief Redraw the caption overlay, and send only the rows it changed.
+ *
+ * The image under it is not decoded again.
+ */
+static void display_overlay()
+{
+    String text;
+    bool at_top;
+    bool opaque;
+    {
+        DisplayTask::Guard guard{display_task};
+        text = overlay_text;
+        at_top = overlay_top;
+        opaque = overlay_opaque;
+        overlay_requested = false;
+    }
+    layers.clear_overlay();
+    if (!text.isEmpty())
+    {
+        Paint &overlay{layers.paint(Layer::overlay)};
+        int width{overlay.GetWidth()};
+        auto &layout{text_layouts.get(text, *message_font, width, overlay.GetHeight() / 2, TextAlign::center)};
+        int height{layout.height()};
+        int top{at_top ? 0 : overlay.GetHeight() - height};
+        if (opaque && layers.has_mask())
+        {
+            // A white band behind the text.
+            layers.paint(Layer::mask).DrawFilledRectangle(0, top, width - 1, top + height - 1, BLACK);
+            layers.mark(Layer::mask, 0, top, width, top + height);
+        }
+        layout.draw(overlay, 0, top, BLACK, &text_cache);
+        layers.mark(Layer::overlay, 0, top, width, top + height);
+    }
+    frames.present(epd, layers);
+    epdState = text.isEmpty() ? "overlay cleared" : "showing overlay";
+}
+
+static void draw_scene_image(const char *filename, int x, int y)
+{
+    bmpDraw(paint, filename, x, y);
+}
+
+/**
+ * @brief Draw the posted scene, and the widgets, into the frame buffer.
+ *
+ * @return false if the scene is not valid.
+ */
+static bool draw_scene()
+{
+    paint.SetWidth(image_width);
+    paint.SetHeight(image_height);
+
+    String error;
+    SceneContext context{title_font, message_font, &text_layouts, &text_cache, draw_scene_image};
+    bool drawn{scene_render(paint, scene_body, scene_length, context, error)};
+    scene_length = 0;
+    scene_requested = false;
+    if (!drawn)
+    {
+        Serial.println(error);
+        epdState = error;
+        return false;
+    }
+    // The widgets are part of the frame compared, so unchanged ones send nothing.
+    draw_widgets();
+    widgets_active = true;
+    return true;
+}
+
+/**
+ * @brief Draw the scene, clear the panel unless the previous scene is on it, then send what changed.
+ *
+ * If the previous scene is on the display, the frame is compared with what
+ * was last sent.
+ */
+bool SceneTask::step(const Budget &budget)
+{
+    switch (state)
+    {
+    case State::draw:
+        started = millis();
+        compare = scene_shown;
+        if (!draw_scene())
+        {
+            state = State::done;
+            return false;
+        }
+        if (compare)
+        {
+            state = State::present;
+            return true;
+        }
+        epdState = "active";
+        epd.LDirInit();
+        clear.begin();
+        state = State::clear;
+        return true;
+    case State::clear:
+        if (clear.step(budget))
+        {
+            return true;
+        }
+        state = State::present;
+        return true;
+    case State::present:
+    {
+        DirtyRegion sent{frames.present(epd, layers, !compare)};
+        int changed_rows{sent.y1 - sent.y0};
+        scene_shown = true;
+        currentImage = "scene";
+        epdState = "showing scene, " + String(changed_rows) + " rows changed";
+        Serial.println("Scene rendered in " + String(millis() - started) + " ms, " + String(changed_rows) + " rows changed");
+        state = State::done;
+        return false;
+    }
+    case State::done:
+        break;
+    }
+    return false;
+}
+
+static WidgetStyle widget_style()
+{
+    return WidgetStyle{message_font, &text_layouts, &text_cache};
+}
+
+/**
+ * @brief Redraw the widgets that are due, in one partial refresh.
+ */
+static void step_widgets()
+{
+    if (!widgets_active || widgets.count() == 0)
+    {
+        return;
+    }
+    int drawn;
+    {
+        // Only the drawing needs the board; the refresh is waited for without the lock.
+        DisplayTask::Guard guard{display_task};
+        drawn = widgets.step(paint, widget_style(), millis());
+    }
+    if (drawn > 0)
+    {
+        // The changes are found by comparing with what was last sent, and sent with one refresh.
+        frames.present(epd, layers);
+        epdState = "updated " + String(drawn) + " widgets";
+    }
+}
+
+/**
+ * @brief Fetch the time from the network, in the playlist's time zone.
+ */
+static void start_clock()
+{
+#ifdef ESP8266
+    configTime(playlist.timezone(), "pool.ntp.org");
+#else
+    configTzTime(playlist.timezone(), "pool.ntp.org");
+#endif
+}
+
+//!< Local minute of the day, or -1 if the time is not known.
+static int minute_of_day()
+{
+    time_t now{time(nullptr)};
+    if (now < clock_set_after)
+    {
+        return -1;
+    }
+    struct tm local;
+    localtime_r(&now, &local);
+    return local.tm_hour * 60 + local.tm_min;
+}
+
+/**
+ * @brief Name the native frame of a playlist item.
+ *
+ * @param filename File of the item.
+ * @param identity Set to the size and time of writing of the file.
+ * @param path     Set to the path of the frame.
+ * @return false if the file is missing.
+ */
+static bool playlist_frame_path(const char *filename, uint32_t (&identity)[2], char (&path)[32])
+{
+    fs::File file = LittleFS.open(filename, "r");
+    if (!file)
+    {
+        return false;
+    }
+    identity[0] = static_cast<uint32_t>(file.size());
+    identity[1] = static_cast<uint32_t>(file.getLastWrite());
+    file.close();
+    uint32_t hash{fnv1a(fnv1a(fnv1a_basis, filename, strlen(filename)), identity, sizeof(identity))};
+    snprintf(path, sizeof(path), "%s/pl-%08x.bin", StorageManager::native_cache_dir, static_cast<unsigned int>(hash));
+    return true;
+}
+
+bool PlaylistTask::begin(Paint &paint_target, size_t paint_capacity, const char *name, bool show_loaded)
+{
+    if (!playlist_frame_path(name, identity, cached))
+    {
+        return false;
+    }
+    target = &paint_target;
+    capacity = paint_capacity;
+    filename = name;
+    show = show_loaded;
+    loaded = false;
+    state = State::load;
+    return true;
+}
+
+bool PlaylistTask::step(const Budget &budget)
+{
+    const FrameSource source{identity, sizeof(identity), filename.c_str(), filename.length()};
+    switch (state)
+    {
+    case State::load:
+        if (native_frame_load(storage, cached, *target, capacity, source))
+        {
+            loaded = true;
+            state = State::finish;
+            return true;
+        }
+        state = State::finish;
+        if (filename.endsWith(".png"))
+        {
+            loaded = decode_png(*target, filename);
+            if (loaded)
+            {
+                state = State::store;
+            }
+            return true;
+        }
+        if (!is_image_file(filename))
+        {
+            return true;
+        }
+        target->SetWidth(image_width);
+        target->SetHeight(image_height);
+        target->Clear(WHITE);
+        if (decoder.begin(*target, filename.c_str(), 0, 0))
+        {
+            state = State::decode;
+        }
+        return true;
+    case State::decode:
+        if (decoder.step(budget))
+        {
+            return true;
+        }
+        loaded = true;
+        state = State::store;
+        return true;
+    case State::store:
+        native_frame_store(storage, cached, *target, source);
+        state = State::finish;
+        return true;
+    case State::finish:
+        state = State::done;
+        if (show)
+        {
+            show_playlist_item(loaded);
+        }
+#ifndef ESP8266
+        else
+        {
+            playlist_prepared = loaded;
+        }
+#endif
+        return false;
+    case State::done:
+        break;
+    }
+    return false;
+}
+
+#ifdef ESP8266
+bool PlaylistFrameTask::begin(const char *filename)
+{
+    uint32_t identity[2];
+    char cached[32];
+    if (!is_image_file(filename) || !playlist_frame_path(filename, identity, cached) || LittleFS.exists(cached))
+    {
+        return false;
+    }
+    band.Clear(WHITE);
+    band_top = 0;
+    if (!decoder.begin_banded(band, filename, image_width, image_height))
+    {
+        return false;
+    }
+    const FrameSource source{identity, sizeof(identity), filename, strlen(filename)};
+    if (!writer.begin(storage, cached, image_width, image_height, source))
+    {
+        reader.close();
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Write the band to the frame, and clear it for the next.
+ *
+ * Rows of the frame below the image are left white.
+ */
+bool PlaylistFrameTask::write_band()
+{
+    int rows{std::min<int>(band_rows, image_height - band_top)};
+    bool written{writer.write(band_image, image_width / 8 * rows)};
+    band_top += rows;
+    band.Clear(WHITE);
+    decoder.next_band();
+    return written;
+}
+
+bool PlaylistFrameTask::step(const Budget &budget)
+{
+    while (decoder.next_row())
+    {
+        if (decoder.rows_done() == band_top + band_rows)
+        {
+            write_band();
+        }
+        if (budget.expired())
+        {
+            return true;
+        }
+    }
+    while (band_top < static_cast<int>(image_height))
+    {
+        write_band();
+    }
+    writer.finish();
+    return false;
+}
+#endif
+
+/**
+ * @brief Apply a posted playlist, save it, and start it from the beginning.
+ */
+static void apply_playlist()
+{
+    String error;
+    bool parsed{playlist.parse(playlist_body, playlist_length, error)};
+    playlist_length = 0;
+    playlist_requested = false;
+    if (!parsed)
+    {
+        Serial.println(error);
+        epdState = error;
+        return;
+    }
+    if (!playlist.save(storage))
+    {
+        Serial.println("Playlist not saved");
+    }
+    start_clock();
+    playlist_paused = false;
+    playlist_current = -1;
+    playlist_upcoming = -1;
+    playlist_next_at = millis();
+#ifndef ESP8266
+    playlist_prepared = false;
+#else
+    playlist_written = -1;
+#endif
+    epdState = playlist.enabled() ? "playlist started" : "playlist stopped";
+}
+
+/**
+ * @brief Show the playlist item loaded into the frame buffer.
+ *
+ * This is the SPI push and a partial refresh; the display is not cleared between items.
+ *
+ * @param loaded false if it could not be loaded; another is tried shortly.
+ */
+static void show_playlist_item(bool loaded)
+{
+    const PlaylistItem &item{playlist.item(playlist_upcoming)};
+    if (!loaded)
+    {
+        Serial.println(String("Playlist item not shown: ") + item.file);
+        playlist_upcoming = -1;
+        playlist_next_at = millis() + 1000;
+        return;
+    }
+    scene_shown = false;
+    epd.LDirInit();
+    show_image_frame();
+    currentImage = item.file;
+    epdState = String("playlist: ") + item.file;
+    playlist_current = playlist_upcoming;
+    playlist_upcoming = -1;
+}
+
+/**
+ * @brief Show the next playlist item: at once if it was prepared, otherwise once it is loaded.
+ */
+static void show_next_playlist_item(int minute)
+{
+    auto now{millis()};
+    if (playlist_upcoming < 0 || !playlist.eligible(playlist_upcoming, minute))
+    {
+        playlist_upcoming = playlist.next(minute);
+#ifndef ESP8266
+        playlist_prepared = false;
+#endif
+    }
+    if (playlist_upcoming < 0)
+    {
+        // Nothing may be shown now; look again in a minute.
+        playlist_next_at = now + 60000;
+        return;
+    }
+    const PlaylistItem &item{playlist.item(playlist_upcoming)};
+    playlist_next_at = now + item.dwell * 1000UL;
+    if (playlist_upcoming == playlist_current)
+    {
+        // Already shown.
+        playlist_upcoming = -1;
+        return;
+    }
+
+#ifndef ESP8266
+    if (playlist_prepared)
+    {
+        memcpy(image, next_image, sizeof(image));
+        paint.SetWidth(next_paint.GetWidth());
+        paint.SetHeight(next_paint.GetHeight());
+        playlist_prepared = false;
+        show_playlist_item(true);
+        return;
+    }
+#endif
+    if (!playlist_task.begin(paint, sizeof(image), item.file, true))
+    {
+        show_playlist_item(false);
+        return;
+    }
+    scheduler.add(playlist_task);
+}
+
+/**
+ * @brief Choose the next playlist item, and start decoding it, or writing its native frame, while the current one is shown.
+ */
+static void prepare_playlist_item(int minute)
+{
+    if (playlist_upcoming < 0)
+    {
+        playlist_upcoming = playlist.next(minute);
+    }
+#ifndef ESP8266
+    if (playlist_upcoming >= 0 && playlist_upcoming != playlist_current && !playlist_prepared &&
+        playlist_task.begin(next_paint, sizeof(next_image), playlist.item(playlist_upcoming).file, false))
+    {
+        scheduler.add(playlist_task);
     }
+#else
+    if (playlist_upcoming >= 0 && playlist_upcoming != playlist_current && playlist_upcoming != playlist_written)
+    {
+        playlist_written = playlist_upcoming;
+        if (playlist_frame_task.begin(playlist.item(playlist_upcoming).file))
+        {
+            scheduler.add(playlist_frame_task);
+        }
+    }
+#endif
+}
 
+static void step_playlist()
+{
+    if (playlist_requested)
+    {
+        apply_playlist();
+    }
+    if (playlist_paused || !playlist.enabled())
+    {
+        return;
+    }
+    int minute{minute_of_day()};
+    if (static_cast<int32_t>(millis() - playlist_next_at) < 0)
+    {
+        prepare_playlist_item(minute);
+        return;
+    }
+    show_next_playlist_item(minute);
 }
+
 static void handleUpload(AsyncWebServerRequest *request, String filename, size_t index, uint8_t *data, size_t len, bool final)
 {
     String logmessage = "Client:" + request->client()->remoteIP().toString() + " " + request->url();
     Serial.println(logmessage);
 
+    String path{"/" + filename};
     if (!index) {
         logmessage = "Upload Start: " + String(filename);
-        // open the file on first call and store the file handle in the request object
-        request->_tempFile = LittleFS.open("/" + filename, "w");
         Serial.println(logmessage);
+        // Make room, evicting derived files if required, before accepting the upload.
+        // The content length includes the multipart overhead, so this errs on the safe side.
+        // An upload replaces any existing file of the same name, but only once it is accepted.
+        if (!storage.reserve_replacing(path, request->contentLength()))
+        {
+            Serial.println("Insufficient storage for " + filename);
+            return;
+        }
+        // open the file on first call and store the file handle in the request object
+        request->_tempFile = LittleFS.open(path, "w");
+    }
+
+    if (!request->_tempFile)
+    {
+        if (final)
+        {
+            request->send(507, "text/plain", "Insufficient storage for " + filename);
+        }
+        return;
     }
 
     if (len) {
@@ -1016,21 +2341,12 @@ static void handleUpload(AsyncWebServerRequest *request, String filename, size_t
         logmessage = "Upload Complete: " + String(filename) + ",size: " + String(index + len);
         // close the file handle as the upload is now done
         request->_tempFile.close();
+        storage.added(path, index + len);
         Serial.println(logmessage);
-        static Ticker loadTicker;
-        currentImage = filename;
-        epdState = "displaying image";
-#ifdef ESP8266
-        loadTicker.once_ms_scheduled(2000, [filename] ()
+        if (!display_task.post(DisplayCommandType::image, filename.c_str()))
         {
-            yield();
-            display_image(&filename);
-        });
-#else
-        static String loadFileName;
-        loadFileName = filename;
-        loadTicker.once(2.0f, display_image, &loadFileName);
-#endif
+            Serial.println("Display busy; not showing " + filename);
+        }
         request->redirect("/");
     }
 }
@@ -1039,24 +2355,29 @@ static String listFiles(bool ishtml)
 {
     String returnText = "";
     Serial.println("Listing files stored on LittleFS");
-    auto files_root = LittleFS.openDir("/");
+    File files_root = LittleFS.open("/", "r");
     if (ishtml) {
         returnText += "<table><tr><th align='left'>Name</th><th align='left'>Size</th></tr>";
     }
-    while (files_root.next()) {
+    for (File file = files_root.openNextFile(); file; file = files_root.openNextFile()) {
+        // Directories hold derived files, managed by the storage manager.
+        if (file.isDirectory()) {
+            continue;
+        }
+        String name = file.name();
         if (ishtml) {
-            returnText += "<tr align='left'><td>" + files_root.fileName() + "</td><td>" + humanReadableSize(files_root.fileSize()) + "</td>";
-            if (files_root.fileName().endsWith(".bmp") || files_root.fileName().endsWith(".BMP"))
+            returnText += "<tr align='left'><td>" + name + "</td><td>" + humanReadableSize(file.size()) + "</td>";
+            if (name.endsWith(".bmp") || name.endsWith(".BMP"))
             {
-                returnText += "<td><a href=\"/display?file=" + files_root.fileName() + "\">Display</a></td><td><image src=\"/download?file=" + files_root.fileName() + "\"></td>";
+                returnText += "<td><a href=\"/display?file=" + name + "\">Display</a></td><td><image src=\"/download?file=" + name + "\"></td>";
             }
             else
             {
                 returnText += "<td></td><td></td>";
             }
-            returnText += "<td><a href=\"/download?file=" + files_root.fileName() + "\" target=\"_blank\">Download</a><td><button onclick=\"deleteButton(\'" + files_root.fileName() + "\', \'delete\')\">Delete</button></tr>";
+            returnText += "<td><a href=\"/download?file=" + name + "\" target=\"_blank\">Download</a><td><button onclick=\"deleteButton(\'" + name + "\', \'delete\')\">Delete</button></tr>";
         } else {
-            returnText += "File: " + files_root.fileName() + "\n";
+            returnText += "File: " + name + "\n";
         }
     }
     if (ishtml) {
@@ -1067,29 +2388,30 @@ static String listFiles(bool ishtml)
 
 static String processor(const String& var)
 {
-    FSInfo64 info;
-    LittleFS.info64(info);
+    uint64_t total;
+    uint64_t used;
+    StorageManager::capacity(total, used);
     if (var == "FILELIST") {
         return listFiles(true);
     }
     if (var == "FREESPIFFS") {
-        return humanReadableSize((info.totalBytes - info.usedBytes));
+        return humanReadableSize((total - used));
     }
 
     if (var == "USEDSPIFFS") {
-        return humanReadableSize(info.usedBytes);
+        return humanReadableSize(used);
     }
 
     if (var == "TOTALSPIFFS") {
-        return humanReadableSize(info.totalBytes);
+        return humanReadableSize(total);
     }
 
     if (var == "EPDSTATE") {
-        return epdState;
+        return epdState.get();
     }
 
     if (var == "CURRENTIMAGE") {
-        return currentImage;
+        return currentImage.get();
     }
 
     return String();
@@ -1105,116 +2427,329 @@ static String humanReadableSize(const size_t bytes)
     else return String(bytes / 1024.0 / 1024.0 / 1024.0) + " GB";
 }
 
-static void display_qr_code()
+/**
+ * @brief Advance the requested QR code by as many encoder steps as fit in the budget.
+ *
+ * Each step is short enough that large versions do not trip the ESP8266
+ * watchdog, and the web server stays responsive meanwhile. Progress is
+ * reported in the EPD state.
+ */
+bool QrTask::step(const Budget &budget)
 {
-    QRCode qrcode;
-    uint8_t qrcodeData[qrcode_getBufferSize(qr_code_version)];
-    if (qrcode_initText(&qrcode, qrcodeData, qr_code_version, qr_code_ecc, qr_code_text.c_str()) != 0)
+    switch (state)
     {
-        Serial.println("QR code generation failure");
-        return;
+    case State::start:
+    {
+        qr_code_key = QrCache::Key(qr_code.text, qr_code.version, qr_code.ecc, qr_code.scale ? QrCache::fit_scale : 1, epd.width, epd.height);
+        state = State::done;
+        QRCode qrcode;
+        if (qr_cache.modules(qr_code_key, qrcode))
+        {
+            Serial.println("QR code rendered from cached modules");
+            if (draw_qr_code(qrcode))
+            {
+                frame.begin(qr_code.persist, "QR", false);
+                state = State::show;
+            }
+            return state == State::show;
+        }
+        if (qr_cache.load(qr_code_key, paint, sizeof(image)))
+        {
+            Serial.println("QR code served from cache");
+            frame.begin(qr_code.persist, "QR", false);
+            state = State::show;
+            return true;
+        }
+        if (!qr_encoder.begin(qr_code.text.c_str(), qr_code.version, qr_code.ecc))
+        {
+            Serial.println("QR code generation failure");
+            epdState = "QR code generation failed";
+            return false;
+        }
+        Serial.println("Generating QR version " + String(qr_code.version));
+        state = State::encode;
+        return true;
     }
-    yield();
-    Serial.println("Code generated");
-    Serial.flush();
-
+    case State::encode:
+        while (qr_encoder.step())
+        {
+            if (budget.expired())
+            {
+                epdState = "generating QR code " + String(qr_encoder.progress()) + "%";
+                return true;
+            }
+        }
+        state = State::done;
+        if (qr_encoder.state() == QrEncoder::State::done)
+        {
+            Serial.println("Code generated");
+            Serial.flush();
+            QRCode qrcode;
+            qr_encoder.get(qrcode);
+            if (draw_qr_code(qrcode))
+            {
+                frame.begin(qr_code.persist, "QR");
+                state = State::show;
+            }
+        }
+        qr_encoder.release();
+        return state == State::show;
+    case State::show:
+        if (frame.step(budget))
+        {
+            return true;
+        }
+        state = State::done;
+        return false;
+    case State::done:
+        break;
+    }
+    return false;
+}
 
-    if (qrcode.size > epd.height || qrcode.size > epd.width)
+/**
+ * @brief Draw a generated QR code into the paint, centred on the display, and cache it.
+ *
+ * When scaling is selected the code is drawn at the largest integer scale that
+ * leaves room for the quiet zone.
+ *
+ * @param qrcode Generated code.
+ * @return false if the code does not fit the display.
+ */
+static bool draw_qr_code(QRCode &qrcode)
+{
+    int quiet_zone;
+    int blockSize{qr_fit_scale(qrcode.size, epd.width, epd.height, quiet_zone)};
+    if (blockSize == 0)
     {
         Serial.println("QR code too large for your display, which is " + String(epd.width) + "x" + String(epd.height));
-        return;
+        epdState = "QR code too large for display";
+        return false;
     }
-
-    uint16_t blockSize{qr_code_scale ?  static_cast<int>(std::min(epd.height, epd.width)) / qrcode.size : 1};
-    Serial.println("Generated, filling display QR=" + String(qrcode.size) + " pixels with blockSize = " + String(blockSize));
+    if (!qr_code.scale)
+    {
+        blockSize = 1;
+    }
+    Serial.println("Generated version " + String(qrcode.version) + " ECC " + String(qrcode.ecc) + ", filling display QR=" + String(qrcode.size) +
+        " pixels with blockSize = " + String(blockSize) + ", quiet zone " + String(quiet_zone) + " modules");
     Serial.flush();
-    epd.HDirInit();
-    epd.Clear();
 
     paint.SetHeight(epd.width);
     paint.SetWidth(epd.height);
     paint.Clear(WHITE);
     uint16_t display_x = (paint.GetWidth() - qrcode.size * blockSize) / 2;
     uint16_t display_y = (paint.GetHeight() - qrcode.size * blockSize) / 2;
-    for (uint8_t x = 0; x < qrcode.size; ++x)
+    auto renderStart{millis()};
+    qr_render(paint, qrcode, display_x, display_y, blockSize);
+    Serial.println("Rendered in " + String(millis() - renderStart) + " ms");
+    qr_cache.store(qr_code_key, qrcode, paint);
+    return true;
+}
+
+void FrameTask::begin(bool persist, const char *description, bool clear)
+{
+    this->persist = persist;
+    this->description = description;
+    scene_shown = false;
+    widgets_active = false;
+    if (clear)
+    {
+        epd.HDirInit();
+        this->clear.begin();
+        state = State::clear;
+        return;
+    }
+    // The panel is only reset and set up again if something else has used it since.
+    epd.HDirResume();
+    row = 0;
+    state = State::send;
+}
+
+bool FrameTask::step(const Budget &budget)
+{
+    // Sent as `Epd::DisplayPart` sends it, a row at a time.
+    constexpr unsigned char write_black_ram{0x24};
+    const int row_bytes{(static_cast<int>(epd.width) + 7) / 8};
+    const int rows{static_cast<int>(epd.height)};
+    switch (state)
     {
-        for (uint8_t y = 0; y < qrcode.size; ++y)
+    case State::clear:
+        if (clear.step(budget))
         {
-            auto module{qrcode_getModule(&qrcode, x, y)};
-            uint16_t rect_x{display_x + x * blockSize};
-            uint16_t rect_y{display_y + y * blockSize};
-            paint.DrawFilledRectangle(rect_x, rect_y, rect_x + blockSize - 1, rect_y + blockSize - 1, module ? BLACK : WHITE);
+            return true;
         }
-        yield();
+        row = 0;
+        state = State::send;
+        return true;
+    case State::send:
+        if (row == 0)
+        {
+            epd.SendCommand(write_black_ram);
+        }
+        while (row < rows)
+        {
+            epd.WriteFrameMemory(paint.GetImage() + row * row_bytes, row_bytes);
+            ++row;
+            if (budget.expired())
+            {
+                return true;
+            }
+        }
+        epd.StartDisplayPartFrame();
+        state = State::refresh;
+        return true;
+    case State::refresh:
+        if (epd.IsBusy())
+        {
+            return true;
+        }
+        frames.sync();
+        // The current image can always be fetched from RAM with /screenshot;
+        // only write it to flash when asked.
+        if (persist)
+        {
+            snapshot(paint);
+        }
+        epdState = String("showing generated ") + description;
+        currentImage = String("generated ") + description;
+        state = State::done;
+        return false;
+    case State::done:
+        break;
     }
-    // Center paint.
-    epd.WaitUntilIdle();
-    epd.DisplayPart(paint.GetImage());
-    snapshot(paint);
+    return false;
+}
+
+void BarcodeTask::begin()
+{
+    DisplayTask::Guard guard{display_task};
+    symbol = barcode;
+    text = barcode_text;
+    persist = barcode_persist;
+    barcode_requested = false;
+    state = State::draw;
+}
 
-    epdState = "showing generated QR";
-    currentImage = "generated QR";
+bool BarcodeTask::step(const Budget &budget)
+{
+    switch (state)
+    {
+    case State::draw:
+        if (!draw_barcode(symbol, text))
+        {
+            state = State::done;
+            return false;
+        }
+        frame.begin(persist, "barcode");
+        state = State::show;
+        return true;
+    case State::show:
+        if (frame.step(budget))
+        {
+            return true;
+        }
+        state = State::done;
+        return false;
+    case State::done:
+        break;
+    }
+    return false;
 }
 
-template<typename T, size_t N>
-static inline size_t countof(const T (&)[N])
+/**
+ * @brief Draw a barcode into the paint, centred on the display.
+ *
+ * Linear symbols are drawn with their text underneath when it fits.
+ *
+ * @return false if the symbol does not fit the display.
+ */
+static bool draw_barcode(const Barcode &symbol, const String &text)
 {
-    return N;
+    paint.SetHeight(epd.width);
+    paint.SetWidth(epd.height);
+    paint.Clear(WHITE);
+
+    int scale{barcode_fit_scale(symbol, paint.GetWidth(), paint.GetHeight())};
+    if (scale == 0)
+    {
+        Serial.println("Barcode too large for your display, which is " + String(epd.width) + "x" + String(epd.height));
+        epdState = "barcode too large for display";
+        return false;
+    }
+    int symbol_width{symbol.width() * scale};
+    int symbol_height{symbol.linear() ? paint.GetHeight() / 2 : symbol.height() * scale};
+    bool show_text{symbol.linear() && TextLayout::measure(text.c_str(), text.length(), *message_font) <= paint.GetWidth()};
+    int total_height{symbol_height + (show_text ? message_font->line_height() : 0)};
+    int display_x{(paint.GetWidth() - symbol_width) / 2};
+    int display_y{(paint.GetHeight() - total_height) / 2};
+
+    auto renderStart{millis()};
+    barcode_render(paint, symbol, display_x, display_y, scale, symbol_height);
+    if (show_text)
+    {
+        text_layouts.get(text, *message_font, paint.GetWidth(), message_font->line_height(), TextAlign::center).draw(paint, 0, display_y + symbol_height, BLACK, &text_cache);
+    }
+    Serial.println("Barcode " + String(symbol.width()) + "x" + String(symbol.height()) + " modules rendered at scale " + String(scale) +
+        " in " + String(millis() - renderStart) + " ms");
+    return true;
 }
 
+/**
+ * @brief Save a copy of the paint to flash as a 1bpp BMP, a slice at a time.
+ *
+ * @param snapshotPaint Paint to save.
+ */
 static void snapshot(Paint &snapshotPaint)
 {
-    static const char *outfile{ "/generated-qr-code.bmp" };
-    fs::File image = LittleFS.open(outfile, "w");
-    if (image)
-    {
-        int convert_width{0};
-        int convert_height{0};
-        convert_width = snapshotPaint.GetWidth();
-        convert_height = snapshotPaint.GetHeight();
-        auto imageData{snapshotPaint.GetImage()};
-        constexpr int snapshot_row_height{ 1 };
-
-        uint8_t bmpfileheader[14] = {'B','M', 0,0,0,0, 0,0, 0,0, 54,0,0,0};
-        uint8_t bmpinfoheader[40] = {40,0,0,0, 0,0,0,0, 0,0,0,0, 1,0, 24,0};
-        int filesize = countof(bmpfileheader) + countof(bmpinfoheader) + 3*convert_width*convert_height;
-
-        bmpfileheader[ 2] = static_cast<uint8_t>(filesize    );
-        bmpfileheader[ 3] = static_cast<uint8_t>(filesize>> 8);
-        bmpfileheader[ 4] = static_cast<uint8_t>(filesize>>16);
-        bmpfileheader[ 5] = static_cast<uint8_t>(filesize>>24);
-
-        bmpinfoheader[ 4] = static_cast<uint8_t>(       convert_width    );
-        bmpinfoheader[ 5] = static_cast<uint8_t>(       convert_width>> 8);
-        bmpinfoheader[ 6] = static_cast<uint8_t>(       convert_width>>16);
-        bmpinfoheader[ 7] = static_cast<uint8_t>(       convert_width>>24);
-        bmpinfoheader[ 8] = static_cast<uint8_t>(       convert_height    );
-        bmpinfoheader[ 9] = static_cast<uint8_t>(       convert_height>> 8);
-        bmpinfoheader[10] = static_cast<uint8_t>(       convert_height>>16);
-        bmpinfoheader[11] = static_cast<uint8_t>(       convert_height>>24);
-
-
-        image.write(bmpfileheader, countof(bmpfileheader));
-        image.write(bmpinfoheader, countof(bmpinfoheader));
-        // Bottom to top to account for the BMP format.
-        uint8_t rect[convert_width * snapshot_row_height * 3];
-        for (int row = convert_height - 1; row >= 0; --row)
-        {
-            for (int col = 0; col < convert_width; ++col)
-            {
-                uint8_t rgb{ (imageData[(row * convert_width + col) / 8] & (0x80 >> (col % 8))) != 0 ? 0xFFu : 0 };
-                // Set bitmap colour to white or black.
-                rect[col * 3] = rgb;
-                rect[col * 3 + 1] = rgb;
-                rect[col * 3 + 2] = rgb;
-            }
-            image.write(rect, sizeof(rect));
-            static const uint8_t padding[3] { 0, 0, 0 };
-            if (convert_width % 4 != 0)
-            {
-                image.write(padding, 4 - (convert_width % 4));
-            }
+    if (!scheduler.queued(snapshot_task) && snapshot_task.begin(snapshotPaint))
+    {
+        scheduler.add(snapshot_task);
+    }
+}
+
+//!< Where snapshots are saved.
+static const char *snapshot_file{ "/generated-qr-code.bmp" };
+
+bool SnapshotTask::begin(Paint &source)
+{
+    image = source.GetImage();
+    width = source.GetWidth();
+    height = source.GetHeight();
+    size = bmp1_file_size(width, height);
+    written = 0;
+    if (LittleFS.exists(snapshot_file))
+    {
+        storage.remove(snapshot_file);
+    }
+    if (!storage.reserve(StorageClass::snapshot, size))
+    {
+        Serial.println("No room for snapshot");
+        return false;
+    }
+    file = LittleFS.open(snapshot_file, "w");
+    return static_cast<bool>(file);
+}
+
+bool SnapshotTask::step(const Budget &budget)
+{
+    uint8_t buffer[chunk_bytes];
+    while (written < size)
+    {
+        size_t length{bmp1_fill(image, width, height, written, buffer, sizeof(buffer))};
+        if (file.write(buffer, length) != length)
+        {
+            Serial.println("Snapshot write failed");
+            file.close();
+            LittleFS.remove(snapshot_file);
+            return false;
+        }
+        written += length;
+        if (budget.expired())
+        {
+            return written < size;
         }
-        image.close();
     }
+    file.close();
+    storage.added(snapshot_file, size);
+    return false;
 }
\ No newline at end of file
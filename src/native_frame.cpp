@@ -0,0 +1,162 @@
+/**
+ * @file native_frame.cpp
+ * @brief Frames stored on LittleFS exactly as `Paint` holds them.
+ */
+#include "native_frame.h"
+
+#include <algorithm>
+#include <LittleFS.h>
+
+namespace
+{
+    //!< "QRF2", little endian; the format was first used for QR codes.
+    constexpr uint32_t frame_magic{0x32465251};
+
+    struct FrameHeader
+    {
+        uint32_t magic;
+        uint16_t width;
+        uint16_t height;
+        uint32_t source_length;     //!< Of the source, which follows the header.
+    };
+
+    /**
+     * @brief Read the source of a frame and compare it with @p source.
+     */
+    bool same_source(fs::File &file, const FrameSource &source)
+    {
+        uint8_t buffer[32];
+        static_assert(sizeof(buffer) >= FrameSource::max_parameters, "parameters must fit the buffer");
+        if (source.parameters_length > FrameSource::max_parameters ||
+            file.read(buffer, source.parameters_length) != static_cast<int>(source.parameters_length) ||
+            memcmp(buffer, source.parameters, source.parameters_length) != 0)
+        {
+            return false;
+        }
+        for (size_t offset = 0; offset < source.text_length; offset += sizeof(buffer))
+        {
+            size_t count{std::min(sizeof(buffer), source.text_length - offset)};
+            if (file.read(buffer, count) != static_cast<int>(count) || memcmp(buffer, &source.text[offset], count) != 0)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+}
+
+bool native_frame_load(StorageManager &storage, const char *path, Paint &paint, size_t capacity, const FrameSource &source)
+{
+    if (!LittleFS.exists(path))
+    {
+        return false;
+    }
+    fs::File file = LittleFS.open(path, "r");
+    if (!file)
+    {
+        return false;
+    }
+    FrameHeader header;
+    bool loaded{false};
+    bool valid{false};
+    if (file.read(reinterpret_cast<uint8_t *>(&header), sizeof(header)) == sizeof(header) && header.magic == frame_magic &&
+        header.width % 8 == 0 && static_cast<size_t>(header.width / 8) * header.height <= capacity)
+    {
+        valid = true;
+        size_t length{static_cast<size_t>(header.width / 8) * header.height};
+        if (header.source_length == source.parameters_length + source.text_length && same_source(file, source) &&
+            file.read(paint.GetImage(), length) == static_cast<int>(length))
+        {
+            paint.SetWidth(header.width);
+            paint.SetHeight(header.height);
+            loaded = true;
+        }
+    }
+    file.close();
+    if (!valid)
+    {
+        Serial.println(String("Discarding bad cached frame ") + path);
+        storage.remove(path);
+        return false;
+    }
+    if (!loaded)
+    {
+        return false;
+    }
+    storage.touch(path);
+    return true;
+}
+
+bool native_frame_store(StorageManager &storage, const char *path, Paint &paint, const FrameSource &source)
+{
+    if (LittleFS.exists(path))
+    {
+        return true;
+    }
+    NativeFrameWriter writer;
+    if (!writer.begin(storage, path, paint.GetWidth(), paint.GetHeight(), source))
+    {
+        return false;
+    }
+    writer.write(paint.GetImage(), static_cast<size_t>(paint.GetWidth() / 8) * paint.GetHeight());
+    return writer.finish();
+}
+
+bool NativeFrameWriter::begin(StorageManager &manager, const char *name, int width, int height, const FrameSource &source)
+{
+    storage = &manager;
+    path = name;
+    good = false;
+    remaining = static_cast<size_t>(width / 8) * height;
+    size_t source_length{source.parameters_length + source.text_length};
+    size = sizeof(FrameHeader) + source_length + remaining;
+    if (!storage->reserve(StorageClass::native_cache, size))
+    {
+        return false;
+    }
+    file = LittleFS.open(name, "w");
+    if (!file)
+    {
+        return false;
+    }
+    const FrameHeader header{frame_magic, static_cast<uint16_t>(width), static_cast<uint16_t>(height), static_cast<uint32_t>(source_length)};
+    good = file.write(reinterpret_cast<const uint8_t *>(&header), sizeof(header)) == sizeof(header) &&
+        (source.parameters_length == 0 ||
+            file.write(static_cast<const uint8_t *>(source.parameters), source.parameters_length) == source.parameters_length) &&
+        (source.text_length == 0 || file.write(reinterpret_cast<const uint8_t *>(source.text), source.text_length) == source.text_length);
+    if (!good)
+    {
+        finish();
+    }
+    return good;
+}
+
+bool NativeFrameWriter::write(const uint8_t *rows, size_t length)
+{
+    good = good && length <= remaining && file.write(rows, length) == length;
+    if (good)
+    {
+        remaining -= length;
+    }
+    return good;
+}
+
+bool NativeFrameWriter::finish()
+{
+    if (!file)
+    {
+        return false;
+    }
+    file.close();
+    bool written{good && remaining == 0};
+    good = false;
+    if (written)
+    {
+        storage->added(path, size);
+    }
+    else
+    {
+        LittleFS.remove(path);
+    }
+    return written;
+}
@@ -0,0 +1,102 @@
+/**
+ * @file native_frame.h
+ * @brief Frames stored on LittleFS exactly as `Paint` holds them.
+ *
+ * A native frame is a small header and what the frame was made from, followed
+ * by the packed rows of a paint, so loading one is a single read into the frame
+ * buffer, with nothing to decode. They are kept under `/cache` as derived
+ * files, and evicted by the `StorageManager` when space runs short.
+ */
+#ifndef NATIVE_FRAME_H
+#define NATIVE_FRAME_H
+
+#include <Arduino.h>
+#include <FS.h>
+#include "epd/epdpaint.h"
+#include "storage_manager.h"
+
+/**
+ * @brief What a frame was made from.
+ *
+ * Frames are named by a hash, which can collide; the source is stored with the
+ * frame, and a frame is only loaded for the same source.
+ */
+struct FrameSource
+{
+    static constexpr size_t max_parameters{16};
+
+    const void *parameters;     //!< Fixed-size parameters, at most `max_parameters` bytes.
+    size_t parameters_length;
+    const char *text;           //!< Text, not necessarily terminated.
+    size_t text_length;
+};
+
+/**
+ * @brief Load a native frame into a paint.
+ *
+ * On success the paint's width and height are set to those of the frame. A
+ * frame that cannot be read is removed; a frame made from another source is
+ * left as it is.
+ *
+ * @param storage  Storage manager, told of the access.
+ * @param path     Absolute path of the frame.
+ * @param paint    Destination paint.
+ * @param capacity Size of the paint's buffer, in bytes.
+ * @param source   What the frame must have been made from.
+ * @return true if the frame was loaded.
+ */
+bool native_frame_load(StorageManager &storage, const char *path, Paint &paint, size_t capacity, const FrameSource &source = FrameSource{});
+
+/**
+ * @brief Write the frame in a paint, unless it has already been written.
+ *
+ * @param storage Storage manager, which makes room for the frame.
+ * @param path    Absolute path of the frame, under `StorageManager::native_cache_dir`.
+ * @param paint   Paint holding the frame, unrotated.
+ * @param source  What the frame was made from.
+ * @return true if the frame is now stored.
+ */
+bool native_frame_store(StorageManager &storage, const char *path, Paint &paint, const FrameSource &source = FrameSource{});
+
+/**
+ * @brief Write a native frame a band of rows at a time, for a frame with no buffer of its own.
+ */
+class NativeFrameWriter
+{
+public:
+    /**
+     * @brief Make room for the frame, and write all but its rows.
+     *
+     * @param storage Storage manager, which makes room for the frame.
+     * @param path    Absolute path of the frame, under `StorageManager::native_cache_dir`.
+     * @param width   Width of the frame; a multiple of 8, as in `Paint`.
+     * @param height  Height of the frame.
+     * @param source  What the frame was made from.
+     * @return false if there is no room, or it cannot be written.
+     */
+    bool begin(StorageManager &storage, const char *path, int width, int height, const FrameSource &source = FrameSource{});
+
+    /**
+     * @brief Write the next rows, packed as `Paint` holds them.
+     *
+     * @return false if they could not all be written, or there are more than the frame has.
+     */
+    bool write(const uint8_t *rows, size_t length);
+
+    /**
+     * @brief Close the frame; it is kept only if all of its rows were written.
+     *
+     * @return true if the frame is now stored.
+     */
+    bool finish();
+
+private:
+    StorageManager *storage{nullptr};
+    fs::File file;
+    String path;
+    size_t size{0};         //!< Of the file, once written.
+    size_t remaining{0};    //!< Bytes of rows still to be written.
+    bool good{false};
+};
+
+#endif
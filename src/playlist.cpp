@@ -0,0 +1,229 @@
+/**
+ * @file playlist.cpp
+ * @brief Images shown in turn, each for its own time.
+ */
+#include "playlist.h"
+
+#include <algorithm>
+#include <ArduinoJson.h>
+#include <LittleFS.h>
+
+namespace
+{
+    constexpr int minutes_per_day{24 * 60};
+
+    /**
+     * @brief Parse "HH:MM" as a minute of the day.
+     *
+     * @return The minute, or -1 if the time is not valid.
+     */
+    int parse_time(const char *text)
+    {
+        int hour{0};
+        int minute{0};
+        if (sscanf(text, "%d:%d", &hour, &minute) != 2 || hour < 0 || hour > 23 || minute < 0 || minute > 59)
+        {
+            return -1;
+        }
+        return hour * 60 + minute;
+    }
+
+    void format_time(char *buffer, size_t size, int minute_of_day)
+    {
+        snprintf(buffer, size, "%02d:%02d", minute_of_day / 60, minute_of_day % 60);
+    }
+}
+
+bool Playlist::parse(const uint8_t *data, size_t length, String &error)
+{
+    JsonDocument document;
+    DeserializationError result{deserializeJson(document, data, length)};
+    if (result)
+    {
+        error = String("Invalid playlist: ") + result.c_str();
+        return false;
+    }
+    JsonArrayConst entries{document["items"].as<JsonArrayConst>()};
+    if (entries.size() > max_items)
+    {
+        error = "Too many items; at most " + String(max_items);
+        return false;
+    }
+    const char *zone{document["tz"] | "UTC0"};
+    if (strlen(zone) >= max_timezone)
+    {
+        error = "Time zone too long";
+        return false;
+    }
+
+    // Check everything before replacing anything.
+    PlaylistItem parsed[max_items];
+    size_t parsed_count{0};
+    for (JsonVariantConst value : entries)
+    {
+        JsonObjectConst entry{value.as<JsonObjectConst>()};
+        const char *file{entry["file"] | ""};
+        if (*file != '/' || strlen(file) >= PlaylistItem::max_file)
+        {
+            error = String("Invalid file name ") + file;
+            return false;
+        }
+        PlaylistItem &item{parsed[parsed_count++]};
+        strcpy(item.file, file);
+        item.dwell = std::max<int>(1, std::min<int>(entry["dwell"] | default_dwell, UINT16_MAX));
+        item.from = item.to = PlaylistItem::always;
+        if (!entry["from"].isNull() || !entry["to"].isNull())
+        {
+            int from{parse_time(entry["from"] | "")};
+            int to{parse_time(entry["to"] | "")};
+            if (from < 0 || to < 0)
+            {
+                error = String("Invalid time window for ") + file;
+                return false;
+            }
+            item.from = from;
+            item.to = to;
+        }
+    }
+
+    std::copy(&parsed[0], &parsed[parsed_count], &items[0]);
+    item_count = parsed_count;
+    is_enabled = document["enabled"] | true;
+    shuffled = document["shuffle"] | false;
+    strcpy(tz, zone);
+    restart();
+    return true;
+}
+
+String Playlist::to_json() const
+{
+    JsonDocument document;
+    document["enabled"] = is_enabled;
+    document["shuffle"] = shuffled;
+    document["tz"] = tz;
+    JsonArray entries{document["items"].to<JsonArray>()};
+    for (size_t i = 0; i < item_count; ++i)
+    {
+        JsonObject entry{entries.add<JsonObject>()};
+        entry["file"] = items[i].file;
+        entry["dwell"] = items[i].dwell;
+        if (items[i].from != items[i].to)
+        {
+            char time[8];
+            format_time(time, sizeof(time), items[i].from);
+            entry["from"] = time;
+            format_time(time, sizeof(time), items[i].to);
+            entry["to"] = time;
+        }
+    }
+    String json;
+    serializeJson(document, json);
+    return json;
+}
+
+bool Playlist::load()
+{
+    if (!LittleFS.exists(path))
+    {
+        return false;
+    }
+    fs::File file = LittleFS.open(path, "r");
+    if (!file)
+    {
+        return false;
+    }
+    // Read it whole; it is at most a few hundred bytes per item.
+    String json{file.readString()};
+    file.close();
+    String error;
+    if (!parse(reinterpret_cast<const uint8_t *>(json.c_str()), json.length(), error))
+    {
+        Serial.println(error);
+        return false;
+    }
+    return true;
+}
+
+bool Playlist::save(StorageManager &storage) const
+{
+    String json{to_json()};
+    // The saved playlist is kept if there is no room for the new one.
+    if (!storage.reserve_replacing(path, json.length()))
+    {
+        return false;
+    }
+    fs::File file = LittleFS.open(path, "w");
+    if (!file)
+    {
+        return false;
+    }
+    bool written{file.write(reinterpret_cast<const uint8_t *>(json.c_str()), json.length()) == json.length()};
+    file.close();
+    if (!written)
+    {
+        LittleFS.remove(path);
+        return false;
+    }
+    storage.added(path, json.length());
+    return true;
+}
+
+bool Playlist::eligible(size_t index, int minute_of_day) const
+{
+    const PlaylistItem &item{items[index]};
+    if (item.from == item.to)
+    {
+        return true;
+    }
+    if (minute_of_day < 0 || minute_of_day >= minutes_per_day)
+    {
+        return false;
+    }
+    // A window such as 22:00 to 06:00 spans midnight.
+    return item.from < item.to ? minute_of_day >= item.from && minute_of_day < item.to
+        : minute_of_day >= item.from || minute_of_day < item.to;
+}
+
+void Playlist::shuffle_order()
+{
+    // Fisher-Yates.
+    for (size_t i = item_count - 1; i > 0; --i)
+    {
+        size_t j{static_cast<size_t>(random(i + 1))};
+        std::swap(order[i], order[j]);
+    }
+}
+
+void Playlist::restart()
+{
+    for (size_t i = 0; i < item_count; ++i)
+    {
+        order[i] = i;
+    }
+    if (shuffled && item_count > 1)
+    {
+        shuffle_order();
+    }
+    position = 0;
+}
+
+int Playlist::next(int minute_of_day)
+{
+    for (size_t tried = 0; tried < item_count; ++tried)
+    {
+        if (position >= item_count)
+        {
+            position = 0;
+            if (shuffled && item_count > 1)
+            {
+                shuffle_order();
+            }
+        }
+        size_t index{order[position++]};
+        if (eligible(index, minute_of_day))
+        {
+            return index;
+        }
+    }
+    return -1;
+}
@@ -0,0 +1,122 @@
+/**
+ * @file playlist.h
+ * @brief Images shown in turn, each for its own time.
+ *
+ * A playlist is stored on LittleFS as JSON, and posted in the same form:
+ *
+ *     {"enabled": true, "shuffle": false, "tz": "EST5EDT,M3.2.0,M11.1.0",
+ *      "items": [
+ *          {"file": "/weather.bmp", "dwell": 300},
+ *          {"file": "/menu.bmp", "dwell": 60, "from": "11:00", "to": "14:00"}
+ *      ]}
+ *
+ * "dwell" is in seconds. An item with "from" and "to" is only shown between
+ * those local times, which may span midnight; it is skipped while the time is
+ * not known. "tz" is a POSIX time zone, used for the windows and the clock
+ * widget. With "shuffle", the items are shown in a new random order on each
+ * pass.
+ *
+ * The playlist only chooses items; showing them, and preparing the next one
+ * while the current one is shown, is up to the caller.
+ */
+#ifndef PLAYLIST_H
+#define PLAYLIST_H
+
+#include <Arduino.h>
+#include "storage_manager.h"
+
+struct PlaylistItem
+{
+    static constexpr size_t max_file{32};
+    //!< `from` and `to` are equal for an item shown at any time.
+    static constexpr uint16_t always{0};
+
+    char file[max_file];
+    uint16_t dwell;   //!< Seconds.
+    uint16_t from;    //!< Minute of the day.
+    uint16_t to;      //!< Minute of the day.
+};
+
+class Playlist
+{
+public:
+    static constexpr size_t max_items{16};
+    static constexpr size_t max_timezone{40};
+    static constexpr const char *path{"/playlist.json"};
+    static constexpr uint16_t default_dwell{60};
+
+    /**
+     * @brief Replace the playlist with one in JSON.
+     *
+     * @param data   JSON.
+     * @param length Length of the JSON, in bytes.
+     * @param error  Set to the reason if the playlist is rejected.
+     * @return true if the playlist was replaced.
+     */
+    bool parse(const uint8_t *data, size_t length, String &error);
+
+    //!< The playlist in JSON, as it is posted.
+    String to_json() const;
+
+    /**
+     * @brief Read the playlist saved on LittleFS, if there is one.
+     */
+    bool load();
+
+    /**
+     * @brief Save the playlist to LittleFS.
+     */
+    bool save(StorageManager &storage) const;
+
+    bool enabled() const
+    {
+        return is_enabled && item_count > 0;
+    }
+
+    const char *timezone() const
+    {
+        return tz;
+    }
+
+    size_t count() const
+    {
+        return item_count;
+    }
+
+    const PlaylistItem &item(size_t index) const
+    {
+        return items[index];
+    }
+
+    /**
+     * @brief Whether an item may be shown now.
+     *
+     * @param index         Item.
+     * @param minute_of_day Local time, or -1 if it is not known.
+     */
+    bool eligible(size_t index, int minute_of_day) const;
+
+    /**
+     * @brief Move to the next item that may be shown now.
+     *
+     * @param minute_of_day Local time, or -1 if it is not known.
+     * @return The item's index, or -1 if no item may be shown now.
+     */
+    int next(int minute_of_day);
+
+    //!< Start again from the first item (or a new random order).
+    void restart();
+
+private:
+    void shuffle_order();
+
+    PlaylistItem items[max_items];
+    size_t item_count{0};
+    bool is_enabled{false};
+    bool shuffled{false};
+    char tz[max_timezone]{"UTC0"};
+    uint8_t order[max_items]{};
+    size_t position{0};  //!< In `order` of the next item to consider.
+};
+
+#endif
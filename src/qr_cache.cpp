@@ -0,0 +1,118 @@
+/**
+ * @file qr_cache.cpp
+ * @brief Cache of encoded QR codes, and of their rendered frames.
+ */
+#include "qr_cache.h"
+
+#include "fnv1a.h"
+
+QrCache::Key::Key(const String &text, uint8_t version, uint8_t ecc, int scale, int width, int height):
+    text(text),
+    parameters{version, ecc, static_cast<int16_t>(scale), static_cast<int16_t>(width), static_cast<int16_t>(height)}
+{
+    const int16_t hashed[]{version, ecc, parameters.scale, parameters.width, parameters.height};
+    hash = fnv1a(fnv1a(fnv1a_basis, text.c_str(), text.length()), hashed, sizeof(hashed));
+}
+
+void QrCache::path(const Key &key, char *buffer, size_t size)
+{
+    snprintf(buffer, size, "%s/qr-%08x.bin", StorageManager::native_cache_dir, static_cast<unsigned int>(key.hash));
+}
+
+FrameSource QrCache::source(const Key &key)
+{
+    return FrameSource{&key.parameters, sizeof(key.parameters), key.text.c_str(), key.text.length()};
+}
+
+QrCache::Entry *QrCache::find(const Key &key)
+{
+    for (size_t i = 0; i < entry_count; ++i)
+    {
+        const Entry &entry{entries[i]};
+        if (entry.hash == key.hash && memcmp(&entry.parameters, &key.parameters, sizeof(key.parameters)) == 0 &&
+            entry.text_length == key.text.length() &&
+            memcmp(&arena[entry.offset + entry.length - entry.text_length], key.text.c_str(), entry.text_length) == 0)
+        {
+            return &entries[i];
+        }
+    }
+    return nullptr;
+}
+
+void QrCache::evict(size_t index)
+{
+    // Frames are packed in entry order; close the gap.
+    Entry removed{entries[index]};
+    memmove(&arena[removed.offset], &arena[removed.offset + removed.length], arena_used - removed.offset - removed.length);
+    arena_used -= removed.length;
+    for (size_t i = index + 1; i < entry_count; ++i)
+    {
+        entries[i].offset -= removed.length;
+        entries[i - 1] = entries[i];
+    }
+    --entry_count;
+}
+
+bool QrCache::insert(const Key &key, const QRCode &qrcode)
+{
+    size_t modules_length{(static_cast<size_t>(qrcode.size) * qrcode.size + 7) / 8};
+    size_t length{modules_length + key.text.length()};
+    if (length > arena_size)
+    {
+        return false;
+    }
+    while (entry_count == max_entries || arena_used + length > arena_size)
+    {
+        size_t oldest{0};
+        for (size_t i = 1; i < entry_count; ++i)
+        {
+            if (entries[i].last_access < entries[oldest].last_access)
+            {
+                oldest = i;
+            }
+        }
+        evict(oldest);
+    }
+    memcpy(&arena[arena_used], qrcode.modules, modules_length);
+    memcpy(&arena[arena_used + modules_length], key.text.c_str(), key.text.length());
+    entries[entry_count++] = Entry{key.hash, key.parameters, qrcode.version, qrcode.ecc, qrcode.mode, qrcode.mask, qrcode.size,
+        static_cast<uint16_t>(arena_used), static_cast<uint16_t>(length), static_cast<uint16_t>(key.text.length()), ++access_clock};
+    arena_used += length;
+    return true;
+}
+
+bool QrCache::modules(const Key &key, QRCode &qrcode)
+{
+    auto entry{find(key)};
+    if (entry == nullptr)
+    {
+        return false;
+    }
+    entry->last_access = ++access_clock;
+    qrcode.version = entry->version;
+    qrcode.ecc = entry->ecc;
+    qrcode.mode = entry->mode;
+    qrcode.mask = entry->mask;
+    qrcode.size = entry->size;
+    qrcode.modules = &arena[entry->offset];
+    return true;
+}
+
+bool QrCache::load(const Key &key, Paint &paint, size_t capacity)
+{
+    char name[32];
+    path(key, name, sizeof(name));
+    return native_frame_load(storage, name, paint, capacity, source(key));
+}
+
+void QrCache::store(const Key &key, const QRCode &qrcode, Paint &paint)
+{
+    if (find(key) == nullptr)
+    {
+        insert(key, qrcode);
+    }
+
+    char name[32];
+    path(key, name, sizeof(name));
+    native_frame_store(storage, name, paint, source(key));
+}
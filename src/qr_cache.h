@@ -0,0 +1,140 @@
+/**
+ * @file qr_cache.h
+ * @brief Cache of encoded QR codes, and of their rendered frames.
+ *
+ * The modules of recently used codes are kept in a small RAM arena, so a hit
+ * there is a render, with no encode. Modules take far less room than frames: a
+ * version 10 code is 407 bytes, against 5000 for a 200x200 frame, so several
+ * codes fit where only one frame would.
+ *
+ * Every frame is also written to LittleFS under `/cache`, as a native frame
+ * stored exactly as `Paint` holds it, and managed by the `StorageManager`. A
+ * hit there is a read into the frame buffer, with no encode and no render;
+ * frames survive a restart and are evicted with the other derived files when
+ * space runs short.
+ */
+#ifndef QR_CACHE_H
+#define QR_CACHE_H
+
+#include <Arduino.h>
+#include <qrcode.h>
+#include "epd/epdpaint.h"
+#include "native_frame.h"
+#include "storage_manager.h"
+
+class QrCache
+{
+public:
+    //!< Scale value meaning "the largest that fits the area".
+    static constexpr int fit_scale{0};
+
+    explicit QrCache(StorageManager &storage) : storage(storage)
+    {
+    }
+
+    /**
+     * @brief What a cached frame is made from, and its hash.
+     *
+     * The area is part of the key because the frame layout depends on it. The
+     * hash names the frame; everything else is compared on a hit, so codes
+     * whose hashes collide are never mistaken for one another.
+     */
+    class Key
+    {
+    public:
+        Key() = default;
+
+        /**
+         * @param text    Encoded text.
+         * @param version Requested version; 0 for automatic.
+         * @param ecc     Requested minimum ECC level.
+         * @param scale   Requested scale, or `fit_scale`.
+         * @param width   Width of the area the code is fitted to.
+         * @param height  Height of the area the code is fitted to.
+         */
+        Key(const String &text, uint8_t version, uint8_t ecc, int scale, int width, int height);
+
+    private:
+        friend class QrCache;
+
+        struct Parameters
+        {
+            uint8_t version;
+            uint8_t ecc;
+            int16_t scale;
+            int16_t width;
+            int16_t height;
+        };
+
+        String text;
+        Parameters parameters{};
+        uint32_t hash{0};
+    };
+
+    /**
+     * @brief Look up the modules of a code in RAM.
+     *
+     * @param key    What the code is made from.
+     * @param qrcode Set to the code on a hit; its modules are in the cache, and
+     *               are valid until the next `store`.
+     * @return true on a hit.
+     */
+    bool modules(const Key &key, QRCode &qrcode);
+
+    /**
+     * @brief Load a cached frame from LittleFS into a paint.
+     *
+     * On a hit the paint's width and height are set to those of the frame,
+     * and the frame is read into its buffer.
+     *
+     * @param key        What the frame is made from.
+     * @param paint      Destination paint.
+     * @param capacity   Size of the paint's buffer, in bytes.
+     * @return true on a hit.
+     */
+    bool load(const Key &key, Paint &paint, size_t capacity);
+
+    /**
+     * @brief Store a code's modules, and the frame it was rendered into.
+     *
+     * @param key    What the code is made from.
+     * @param qrcode Encoded code; it may be one returned by `modules`.
+     * @param paint  Paint holding the rendered code, unrotated.
+     */
+    void store(const Key &key, const QRCode &qrcode, Paint &paint);
+
+private:
+    //!< RAM set aside for modules; enough for eight version 10 codes, or one version 25.
+    static constexpr size_t arena_size{2048};
+    static constexpr size_t max_entries{8};
+
+    struct Entry
+    {
+        uint32_t hash;
+        Key::Parameters parameters;
+        uint8_t version;        //!< Of the code, as encoded.
+        uint8_t ecc;
+        uint8_t mode;
+        uint8_t mask;
+        uint8_t size;
+        uint16_t offset;        //!< Of the modules in the arena; the text follows them.
+        uint16_t length;        //!< Of the modules and the text.
+        uint16_t text_length;
+        uint32_t last_access;
+    };
+
+    Entry *find(const Key &key);
+    bool insert(const Key &key, const QRCode &qrcode);
+    void evict(size_t index);
+    static void path(const Key &key, char *buffer, size_t size);
+    static FrameSource source(const Key &key);
+
+    StorageManager &storage;
+    uint8_t arena[arena_size];
+    size_t arena_used{0};
+    Entry entries[max_entries]{};
+    size_t entry_count{0};
+    uint32_t access_clock{0};
+};
+
+#endif
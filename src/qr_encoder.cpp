@@ -0,0 +1,846 @@
+/**
+ * @file qr_encoder.cpp
+ * @brief QR code encoder that runs in small steps.
+ *
+ * The algorithms follow ISO/IEC 18004; the structure is close to Project Nayuki's
+ * QR Code generator (MIT licence).
+ */
+#include "qr_encoder.h"
+
+#include <algorithm>
+#include <stdlib.h>
+
+namespace
+{
+    //!< Grid size of the largest version, in bytes.
+    constexpr size_t max_modules_bytes{(177 * 177 + 7) / 8};
+    //!< Total codewords of the largest version.
+    constexpr size_t max_codewords{3706};
+
+    /**
+     * @brief Pool of work buffers.
+     *
+     * One encode at a time is all there is RAM for on the ESP8266.
+     */
+    struct WorkBuffer
+    {
+        uint8_t modules[max_modules_bytes];
+        uint8_t codewords[max_codewords];
+        bool in_use;
+    };
+    constexpr size_t pool_size{1};
+    WorkBuffer pool[pool_size];
+
+    WorkBuffer *acquire()
+    {
+        for (auto &buffer : pool)
+        {
+            if (!buffer.in_use)
+            {
+                buffer.in_use = true;
+                return &buffer;
+            }
+        }
+        return nullptr;
+    }
+
+    // Indexed by ECC level (ECC_LOW to ECC_HIGH) and version.
+    const int8_t ecc_codewords_per_block[4][41] PROGMEM = {
+        {-1,  7, 10, 15, 20, 26, 18, 20, 24, 30, 18, 20, 24, 26, 30, 22, 24, 28, 30, 28, 28, 28, 28, 30, 30, 26, 28, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30},
+        {-1, 10, 16, 26, 18, 24, 16, 18, 22, 22, 26, 30, 22, 22, 24, 24, 28, 28, 26, 26, 26, 26, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28},
+        {-1, 13, 22, 18, 26, 18, 24, 18, 22, 20, 24, 28, 26, 24, 20, 30, 24, 28, 28, 26, 30, 28, 30, 30, 30, 30, 28, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30},
+        {-1, 17, 28, 22, 16, 22, 28, 26, 26, 24, 28, 24, 28, 22, 24, 24, 30, 28, 28, 26, 28, 30, 24, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30, 30},
+    };
+
+    const int8_t error_correction_blocks[4][41] PROGMEM = {
+        {-1, 1, 1, 1, 1, 1, 2, 2, 2, 2, 4,  4,  4,  4,  4,  6,  6,  6,  6,  7,  8,  8,  9,  9, 10, 12, 12, 12, 13, 14, 15, 16, 17, 18, 19, 19, 20, 21, 22, 24, 25},
+        {-1, 1, 1, 1, 2, 2, 4, 4, 4, 5, 5,  5,  8,  9,  9, 10, 10, 11, 13, 14, 16, 17, 17, 18, 20, 21, 23, 25, 26, 28, 29, 31, 33, 35, 37, 38, 40, 43, 45, 47, 49},
+        {-1, 1, 1, 2, 2, 4, 4, 6, 6, 8, 8,  8, 10, 12, 16, 12, 17, 16, 18, 21, 20, 23, 23, 25, 27, 29, 34, 34, 35, 38, 40, 43, 45, 48, 51, 53, 56, 59, 62, 65, 68},
+        {-1, 1, 1, 2, 4, 4, 4, 5, 6, 8, 8, 11, 11, 16, 16, 18, 16, 19, 21, 25, 25, 25, 34, 30, 32, 35, 37, 40, 42, 45, 48, 51, 54, 57, 60, 63, 66, 70, 74, 77, 81},
+    };
+
+    //!< Format information ECC level bits, indexed by ECC_LOW to ECC_HIGH.
+    constexpr uint8_t ecc_format_bits[4]{1, 0, 3, 2};
+
+    constexpr const char *alphanumeric_charset{"0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ $%*+-./:"};
+
+    uint8_t read_table(const int8_t (&table)[4][41], uint8_t ecc, uint8_t version)
+    {
+        return static_cast<uint8_t>(pgm_read_byte(&table[ecc][version]));
+    }
+
+    /**
+     * @brief Number of modules available for data and ECC, excluding function patterns.
+     */
+    uint16_t raw_data_modules(uint8_t version)
+    {
+        uint32_t result{(16u * version + 128) * version + 64};
+        if (version >= 2)
+        {
+            uint32_t alignments{version / 7u + 2};
+            result -= (25 * alignments - 10) * alignments - 55;
+            if (version >= 7)
+            {
+                result -= 36;
+            }
+        }
+        return static_cast<uint16_t>(result);
+    }
+
+    uint8_t character_count_bits(uint8_t mode, uint8_t version)
+    {
+        uint8_t range{static_cast<uint8_t>(version <= 9 ? 0 : version <= 26 ? 1 : 2)};
+        switch (mode)
+        {
+        case MODE_NUMERIC:
+            return 10 + 2 * range;
+        case MODE_ALPHANUMERIC:
+            return 9 + 2 * range;
+        default:
+            return range == 0 ? 8 : 16;
+        }
+    }
+
+    int alphanumeric_value(char c)
+    {
+        auto position{strchr(alphanumeric_charset, c)};
+        return c != '\0' && position != nullptr ? position - alphanumeric_charset : -1;
+    }
+
+    uint8_t gf_multiply(uint8_t x, uint8_t y)
+    {
+        // Russian peasant multiplication in GF(2^8) modulo x^8 + x^4 + x^3 + x^2 + 1.
+        uint8_t z{0};
+        for (int i = 7; i >= 0; --i)
+        {
+            z = static_cast<uint8_t>((z << 1) ^ ((z >> 7) * 0x1D));
+            z ^= ((y >> i) & 1) * x;
+        }
+        return z;
+    }
+
+    class BitWriter
+    {
+    public:
+        explicit BitWriter(uint8_t *buffer) : buffer(buffer)
+        {
+        }
+
+        void append(uint32_t value, uint8_t bits)
+        {
+            for (int i = bits - 1; i >= 0; --i, ++position)
+            {
+                if ((value >> i) & 1)
+                {
+                    buffer[position >> 3] |= 0x80 >> (position & 7);
+                }
+            }
+        }
+
+        uint32_t length() const
+        {
+            return position;
+        }
+
+    private:
+        uint8_t *buffer;
+        uint32_t position{0};
+    };
+
+    /**
+     * @brief Run length and finder-like pattern history for the penalty score.
+     */
+    class RunHistory
+    {
+    public:
+        explicit RunHistory(uint8_t size) : size(size)
+        {
+        }
+
+        void add(int run_length)
+        {
+            if (history[0] == 0)
+            {
+                // Light border before the first run.
+                run_length += size;
+            }
+            memmove(&history[1], &history[0], sizeof(history) - sizeof(history[0]));
+            history[0] = run_length;
+        }
+
+        int count_patterns() const
+        {
+            int n{history[1]};
+            bool core{n > 0 && history[2] == n && history[3] == n * 3 && history[4] == n && history[5] == n};
+            return (core && history[0] >= n * 4 && history[6] >= n ? 1 : 0) +
+                (core && history[6] >= n * 4 && history[0] >= n ? 1 : 0);
+        }
+
+        int terminate_and_count(bool run_dark, int run_length)
+        {
+            if (run_dark)
+            {
+                add(run_length);
+                run_length = 0;
+            }
+            // Light border after the last run.
+            add(run_length + size);
+            return count_patterns();
+        }
+
+    private:
+        uint8_t size;
+        int history[7]{};
+    };
+
+    constexpr uint32_t penalty_n1{3};
+    constexpr uint32_t penalty_n2{3};
+    constexpr uint32_t penalty_n3{40};
+    constexpr uint32_t penalty_n4{10};
+}
+
+uint16_t QrEncoder::data_codewords(uint8_t version, uint8_t ecc)
+{
+    return raw_data_modules(version) / 8 -
+        read_table(ecc_codewords_per_block, ecc, version) * read_table(error_correction_blocks, ecc, version);
+}
+
+uint32_t QrEncoder::encoded_bits(const char *text, size_t length, uint8_t version, uint8_t &mode)
+{
+    bool numeric{true};
+    bool alphanumeric{true};
+    for (size_t i = 0; i < length; ++i)
+    {
+        numeric = numeric && text[i] >= '0' && text[i] <= '9';
+        alphanumeric = alphanumeric && alphanumeric_value(text[i]) >= 0;
+    }
+
+    uint32_t bits;
+    if (numeric)
+    {
+        mode = MODE_NUMERIC;
+        bits = length / 3 * 10 + (length % 3 == 0 ? 0 : length % 3 == 1 ? 4 : 7);
+    }
+    else if (alphanumeric)
+    {
+        mode = MODE_ALPHANUMERIC;
+        bits = length / 2 * 11 + (length % 2) * 6;
+    }
+    else
+    {
+        mode = MODE_BYTE;
+        bits = length * 8;
+    }
+    return 4 + character_count_bits(mode, version) + bits;
+}
+
+bool QrEncoder::fits(uint32_t data_bits, size_t length, uint8_t mode, uint8_t version, uint8_t ecc)
+{
+    uint8_t count_bits{character_count_bits(mode, version)};
+    return length < (1u << count_bits) && 4 + count_bits + data_bits <= data_codewords(version, ecc) * 8u;
+}
+
+uint8_t QrEncoder::smallest_version(const char *text, uint8_t ecc)
+{
+    size_t length{strlen(text)};
+    uint8_t text_mode;
+    // Only the character count size depends on the version.
+    uint32_t data_bits{encoded_bits(text, length, min_version, text_mode) - 4 - character_count_bits(text_mode, min_version)};
+    for (uint8_t version = min_version; version <= max_version; ++version)
+    {
+        if (fits(data_bits, length, text_mode, version, ecc))
+        {
+            return version;
+        }
+    }
+    return 0;
+}
+
+bool QrEncoder::begin(const char *text, uint8_t version, uint8_t ecc)
+{
+    release();
+    current_state = State::failed;
+    size_t length{strlen(text)};
+    if (version == 0)
+    {
+        version = smallest_version(text, ecc);
+    }
+    if (version < min_version || version > max_version || ecc > ECC_HIGH || length > 0xFFFF)
+    {
+        return false;
+    }
+    uint32_t data_bits{encoded_bits(text, length, version, mode) - 4 - character_count_bits(mode, version)};
+    if (!fits(data_bits, length, mode, version, ecc))
+    {
+        return false;
+    }
+    // Use any spare capacity for stronger error correction.
+    while (ecc < ECC_HIGH && fits(data_bits, length, mode, version, ecc + 1))
+    {
+        ++ecc;
+    }
+
+    auto buffer{acquire()};
+    if (buffer == nullptr)
+    {
+        return false;
+    }
+    modules = buffer->modules;
+    codewords = buffer->codewords;
+
+    this->text = text;
+    text_length = static_cast<uint16_t>(length);
+    this->version = version;
+    this->ecc = ecc;
+    size = 4 * version + 17;
+
+    block_count = read_table(error_correction_blocks, ecc, version);
+    ecc_length = read_table(ecc_codewords_per_block, ecc, version);
+    uint16_t raw_codewords{static_cast<uint16_t>(raw_data_modules(version) / 8)};
+    short_block_count = block_count - raw_codewords % block_count;
+    short_data_length = raw_codewords / block_count - ecc_length;
+    data_length = data_codewords(version, ecc);
+
+    // Which alignment pattern, if any, covers each row/column.
+    memset(alignment_index, -1, sizeof(alignment_index));
+    alignment_count = 0;
+    if (version > 1)
+    {
+        alignment_count = version / 7 + 2;
+        uint8_t step{static_cast<uint8_t>(version == 32 ? 26 : (version * 4 + alignment_count * 2 + 1) / (alignment_count * 2 - 2) * 2)};
+        for (uint8_t i = 0; i < alignment_count; ++i)
+        {
+            uint8_t centre{static_cast<uint8_t>(i == 0 ? 6 : size - 7 - (alignment_count - 1 - i) * step)};
+            for (int offset = -2; offset <= 2; ++offset)
+            {
+                alignment_index[centre + offset] = static_cast<int8_t>(i);
+            }
+        }
+    }
+
+    current_block = 0;
+    current_mask = 0;
+    best_mask = 0;
+    best_penalty = UINT32_MAX;
+    steps_done = 0;
+    current_state = State::encode_data;
+    return true;
+}
+
+bool QrEncoder::step()
+{
+    switch (current_state)
+    {
+    case State::encode_data:
+        encode_data();
+        current_state = State::error_correction;
+        break;
+    case State::error_correction:
+        error_correction(current_block++);
+        if (current_block == block_count)
+        {
+            current_state = State::place;
+        }
+        break;
+    case State::place:
+        place();
+        current_state = State::mask;
+        break;
+    case State::mask:
+    {
+        // Try one mask, then take it off again.
+        apply_mask(current_mask);
+        draw_format_bits(current_mask);
+        uint32_t score{penalty()};
+        if (score < best_penalty)
+        {
+            best_penalty = score;
+            best_mask = current_mask;
+        }
+        apply_mask(current_mask);
+        if (++current_mask == 8)
+        {
+            current_state = State::finish;
+        }
+        break;
+    }
+    case State::finish:
+        apply_mask(best_mask);
+        draw_format_bits(best_mask);
+        current_state = State::done;
+        break;
+    default:
+        return false;
+    }
+    ++steps_done;
+    return current_state != State::done;
+}
+
+bool QrEncoder::run()
+{
+    while (step())
+    {
+        yield();
+    }
+    return current_state == State::done;
+}
+
+uint8_t QrEncoder::progress() const
+{
+    switch (current_state)
+    {
+    case State::idle:
+    case State::failed:
+        return 0;
+    case State::done:
+        return 100;
+    default:
+        // Encode, ECC blocks, placement, eight masks and the final mask.
+        return static_cast<uint8_t>(steps_done * 100u / (block_count + 11u));
+    }
+}
+
+bool QrEncoder::get(QRCode &qrcode)
+{
+    if (current_state != State::done)
+    {
+        return false;
+    }
+    qrcode.version = version;
+    qrcode.size = size;
+    qrcode.ecc = ecc;
+    qrcode.mode = mode;
+    qrcode.mask = best_mask;
+    qrcode.modules = modules;
+    return true;
+}
+
+void QrEncoder::release()
+{
+    for (auto &buffer : pool)
+    {
+        if (buffer.modules == modules)
+        {
+            buffer.in_use = false;
+        }
+    }
+    modules = nullptr;
+    codewords = nullptr;
+    current_state = State::idle;
+}
+
+bool QrEncoder::get_module(uint8_t x, uint8_t y) const
+{
+    uint32_t offset{static_cast<uint32_t>(y) * size + x};
+    return (modules[offset >> 3] & (0x80 >> (offset & 7))) != 0;
+}
+
+void QrEncoder::set_module(uint8_t x, uint8_t y, bool dark)
+{
+    uint32_t offset{static_cast<uint32_t>(y) * size + x};
+    if (dark)
+    {
+        modules[offset >> 3] |= 0x80 >> (offset & 7);
+    }
+    else
+    {
+        modules[offset >> 3] &= ~(0x80 >> (offset & 7));
+    }
+}
+
+bool QrEncoder::is_function(uint8_t x, uint8_t y) const
+{
+    // Finder patterns, separators and format information.
+    if ((x <= 8 && y <= 8) || (x >= size - 8 && y <= 8) || (x <= 8 && y >= size - 8))
+    {
+        return true;
+    }
+    // Timing patterns.
+    if (x == 6 || y == 6)
+    {
+        return true;
+    }
+    // Version information.
+    if (version >= 7 && ((x < 6 && y >= size - 11 && y < size - 8) || (y < 6 && x >= size - 11 && x < size - 8)))
+    {
+        return true;
+    }
+    return is_alignment(alignment_index[x], alignment_index[y]);
+}
+
+bool QrEncoder::is_alignment(int8_t column, int8_t row) const
+{
+    // There are none where they would overlap the finders.
+    if (column < 0 || row < 0)
+    {
+        return false;
+    }
+    int8_t last{static_cast<int8_t>(alignment_count - 1)};
+    return !((column == 0 && row == 0) || (column == 0 && row == last) || (column == last && row == 0));
+}
+
+void QrEncoder::encode_data()
+{
+    memset(codewords, 0, data_length);
+    BitWriter writer(codewords);
+    writer.append(1u << mode, 4);
+    writer.append(text_length, character_count_bits(mode, version));
+    switch (mode)
+    {
+    case MODE_NUMERIC:
+        for (uint16_t i = 0; i < text_length; i += 3)
+        {
+            uint8_t digits{static_cast<uint8_t>(std::min<uint16_t>(3, text_length - i))};
+            uint16_t value{0};
+            for (uint8_t j = 0; j < digits; ++j)
+            {
+                value = value * 10 + (text[i + j] - '0');
+            }
+            writer.append(value, digits * 3 + 1);
+        }
+        break;
+    case MODE_ALPHANUMERIC:
+        for (uint16_t i = 0; i < text_length; i += 2)
+        {
+            if (i + 1 < text_length)
+            {
+                writer.append(alphanumeric_value(text[i]) * 45 + alphanumeric_value(text[i + 1]), 11);
+            }
+            else
+            {
+                writer.append(alphanumeric_value(text[i]), 6);
+            }
+        }
+        break;
+    default:
+        for (uint16_t i = 0; i < text_length; ++i)
+        {
+            writer.append(static_cast<uint8_t>(text[i]), 8);
+        }
+        break;
+    }
+
+    // Terminator, padding to a byte, then alternating pad bytes.
+    uint32_t capacity{data_length * 8u};
+    writer.append(0, static_cast<uint8_t>(std::min<uint32_t>(4, capacity - writer.length())));
+    writer.append(0, static_cast<uint8_t>((8 - writer.length() % 8) % 8));
+    for (uint8_t pad = 0xEC; writer.length() < capacity; pad ^= 0xEC ^ 0x11)
+    {
+        writer.append(pad, 8);
+    }
+    // The text is no longer needed.
+    text = nullptr;
+}
+
+/**
+ * @brief Compute the Reed-Solomon ECC codewords for one block.
+ *
+ * Data codewords are stored block after block; the ECC for each block follows
+ * all the data.
+ */
+void QrEncoder::error_correction(uint8_t block)
+{
+    // Generator polynomial; coefficients from highest to lowest power, leading 1 omitted.
+    uint8_t divisor[30]{};
+    divisor[ecc_length - 1] = 1;
+    uint8_t root{1};
+    for (uint8_t i = 0; i < ecc_length; ++i)
+    {
+        for (uint8_t j = 0; j < ecc_length; ++j)
+        {
+            divisor[j] = gf_multiply(divisor[j], root);
+            if (j + 1 < ecc_length)
+            {
+                divisor[j] ^= divisor[j + 1];
+            }
+        }
+        root = gf_multiply(root, 0x02);
+    }
+
+    uint16_t start{static_cast<uint16_t>(block * short_data_length + (block > short_block_count ? block - short_block_count : 0))};
+    uint16_t length{static_cast<uint16_t>(short_data_length + (block >= short_block_count ? 1 : 0))};
+    uint8_t *remainder{&codewords[data_length + block * ecc_length]};
+    memset(remainder, 0, ecc_length);
+    for (uint16_t i = 0; i < length; ++i)
+    {
+        uint8_t factor{static_cast<uint8_t>(codewords[start + i] ^ remainder[0])};
+        memmove(remainder, remainder + 1, ecc_length - 1);
+        remainder[ecc_length - 1] = 0;
+        for (uint8_t j = 0; j < ecc_length; ++j)
+        {
+            remainder[j] ^= gf_multiply(divisor[j], factor);
+        }
+    }
+}
+
+/**
+ * @brief Map a position in the interleaved codeword sequence to the codeword buffer.
+ *
+ * The interleaved sequence takes the first data codeword of each block, then the
+ * second and so on (short blocks having one codeword fewer), then the ECC
+ * codewords likewise.
+ */
+uint16_t QrEncoder::interleaved(uint16_t index) const
+{
+    uint8_t block;
+    uint16_t offset;
+    if (index < data_length)
+    {
+        if (index < short_data_length * block_count)
+        {
+            offset = index / block_count;
+            block = index % block_count;
+        }
+        else
+        {
+            // The extra codeword of the long blocks.
+            offset = short_data_length;
+            block = short_block_count + (index - short_data_length * block_count);
+        }
+        return block * short_data_length + (block > short_block_count ? block - short_block_count : 0) + offset;
+    }
+    index -= data_length;
+    offset = index / block_count;
+    block = index % block_count;
+    return data_length + block * ecc_length + offset;
+}
+
+void QrEncoder::place()
+{
+    memset(modules, 0, (static_cast<uint32_t>(size) * size + 7) / 8);
+    draw_function_patterns();
+
+    // Codewords go in two-module columns, zigzagging up and down from the right.
+    uint32_t total_bits{static_cast<uint32_t>(data_length + block_count * ecc_length) * 8};
+    uint32_t bit{0};
+    uint8_t codeword{0};
+    for (int right = size - 1; right >= 1; right -= 2)
+    {
+        if (right == 6)
+        {
+            // Skip the vertical timing pattern.
+            right = 5;
+        }
+        bool upward{((right + 1) & 2) == 0};
+        for (int vertical = 0; vertical < size; ++vertical)
+        {
+            uint8_t y{static_cast<uint8_t>(upward ? size - 1 - vertical : vertical)};
+            for (int j = 0; j < 2; ++j)
+            {
+                uint8_t x{static_cast<uint8_t>(right - j)};
+                if (is_function(x, y) || bit >= total_bits)
+                {
+                    // Remainder bits are left light.
+                    continue;
+                }
+                if ((bit & 7) == 0)
+                {
+                    codeword = codewords[interleaved(bit >> 3)];
+                }
+                if (codeword & (0x80 >> (bit & 7)))
+                {
+                    set_module(x, y, true);
+                }
+                ++bit;
+            }
+        }
+    }
+}
+
+void QrEncoder::draw_function_patterns()
+{
+    // Timing patterns.
+    for (uint8_t i = 0; i < size; ++i)
+    {
+        set_module(6, i, i % 2 == 0);
+        set_module(i, 6, i % 2 == 0);
+    }
+
+    // Finder patterns; the separators are left light.
+    const uint8_t finders[3][2]{{3, 3}, {static_cast<uint8_t>(size - 4), 3}, {3, static_cast<uint8_t>(size - 4)}};
+    for (auto &finder : finders)
+    {
+        for (int dy = -4; dy <= 4; ++dy)
+        {
+            for (int dx = -4; dx <= 4; ++dx)
+            {
+                int x{finder[0] + dx};
+                int y{finder[1] + dy};
+                if (x >= 0 && x < size && y >= 0 && y < size)
+                {
+                    int distance{std::max(abs(dx), abs(dy))};
+                    set_module(x, y, distance != 2 && distance != 4);
+                }
+            }
+        }
+    }
+
+    // Alignment patterns; the first coordinate covered by each is two before its centre.
+    auto is_first = [this](uint8_t c) { return alignment_index[c] >= 0 && (c == 0 || alignment_index[c - 1] != alignment_index[c]); };
+    for (uint8_t y = 0; y < size; ++y)
+    {
+        for (uint8_t x = 0; x < size; ++x)
+        {
+            if (!is_first(x) || !is_first(y) || !is_alignment(alignment_index[x], alignment_index[y]))
+            {
+                continue;
+            }
+            for (int dy = -2; dy <= 2; ++dy)
+            {
+                for (int dx = -2; dx <= 2; ++dx)
+                {
+                    set_module(x + 2 + dx, y + 2 + dy, std::max(abs(dx), abs(dy)) != 1);
+                }
+            }
+        }
+    }
+
+    // Version information.
+    if (version >= 7)
+    {
+        uint32_t remainder{version};
+        for (int i = 0; i < 12; ++i)
+        {
+            remainder = (remainder << 1) ^ ((remainder >> 11) * 0x1F25);
+        }
+        uint32_t bits{static_cast<uint32_t>(version) << 12 | remainder};
+        for (uint8_t i = 0; i < 18; ++i)
+        {
+            bool dark{((bits >> i) & 1) != 0};
+            uint8_t a{static_cast<uint8_t>(size - 11 + i % 3)};
+            uint8_t b{static_cast<uint8_t>(i / 3)};
+            set_module(a, b, dark);
+            set_module(b, a, dark);
+        }
+    }
+
+    // Reserve the format information; it is drawn once the mask is known.
+    draw_format_bits(0);
+}
+
+void QrEncoder::draw_format_bits(uint8_t mask_pattern)
+{
+    uint32_t data{static_cast<uint32_t>(ecc_format_bits[ecc]) << 3 | mask_pattern};
+    uint32_t remainder{data};
+    for (int i = 0; i < 10; ++i)
+    {
+        remainder = (remainder << 1) ^ ((remainder >> 9) * 0x537);
+    }
+    uint32_t bits{(data << 10 | remainder) ^ 0x5412};
+    auto bit = [bits](int i) { return ((bits >> i) & 1) != 0; };
+
+    // Around the top left finder.
+    for (int i = 0; i <= 5; ++i)
+    {
+        set_module(8, i, bit(i));
+    }
+    set_module(8, 7, bit(6));
+    set_module(8, 8, bit(7));
+    set_module(7, 8, bit(8));
+    for (int i = 9; i < 15; ++i)
+    {
+        set_module(14 - i, 8, bit(i));
+    }
+
+    // Split between the other two finders.
+    for (int i = 0; i < 8; ++i)
+    {
+        set_module(size - 1 - i, 8, bit(i));
+    }
+    for (int i = 8; i < 15; ++i)
+    {
+        set_module(8, size - 15 + i, bit(i));
+    }
+    // Always dark.
+    set_module(8, size - 8, true);
+}
+
+void QrEncoder::apply_mask(uint8_t mask_pattern)
+{
+    for (uint8_t y = 0; y < size; ++y)
+    {
+        for (uint8_t x = 0; x < size; ++x)
+        {
+            bool invert;
+            switch (mask_pattern)
+            {
+            case 0: invert = (x + y) % 2 == 0; break;
+            case 1: invert = y % 2 == 0; break;
+            case 2: invert = x % 3 == 0; break;
+            case 3: invert = (x + y) % 3 == 0; break;
+            case 4: invert = (x / 3 + y / 2) % 2 == 0; break;
+            case 5: invert = x * y % 2 + x * y % 3 == 0; break;
+            case 6: invert = (x * y % 2 + x * y % 3) % 2 == 0; break;
+            default: invert = ((x + y) % 2 + x * y % 3) % 2 == 0; break;
+            }
+            if (invert && !is_function(x, y))
+            {
+                uint32_t offset{static_cast<uint32_t>(y) * size + x};
+                modules[offset >> 3] ^= 0x80 >> (offset & 7);
+            }
+        }
+    }
+}
+
+uint32_t QrEncoder::penalty() const
+{
+    uint32_t result{0};
+
+    // Runs of the same colour and finder-like patterns, in rows then columns.
+    for (int pass = 0; pass < 2; ++pass)
+    {
+        for (uint8_t a = 0; a < size; ++a)
+        {
+            RunHistory history(size);
+            bool run_dark{false};
+            int run_length{0};
+            for (uint8_t b = 0; b < size; ++b)
+            {
+                bool dark{pass == 0 ? get_module(b, a) : get_module(a, b)};
+                if (dark == run_dark)
+                {
+                    ++run_length;
+                    if (run_length == 5)
+                    {
+                        result += penalty_n1;
+                    }
+                    else if (run_length > 5)
+                    {
+                        ++result;
+                    }
+                }
+                else
+                {
+                    history.add(run_length);
+                    if (!run_dark)
+                    {
+                        result += history.count_patterns() * penalty_n3;
+                    }
+                    run_dark = dark;
+                    run_length = 1;
+                }
+            }
+            result += history.terminate_and_count(run_dark, run_length) * penalty_n3;
+        }
+    }
+
+    // 2x2 blocks of the same colour, and the dark/light balance.
+    uint32_t dark_count{0};
+    for (uint8_t y = 0; y < size; ++y)
+    {
+        for (uint8_t x = 0; x < size; ++x)
+        {
+            bool dark{get_module(x, y)};
+            dark_count += dark ? 1 : 0;
+            if (x + 1 < size && y + 1 < size && dark == get_module(x + 1, y) &&
+                dark == get_module(x, y + 1) && dark == get_module(x + 1, y + 1))
+            {
+                result += penalty_n2;
+            }
+        }
+    }
+    uint32_t total{static_cast<uint32_t>(size) * size};
+    uint32_t difference{static_cast<uint32_t>(abs(static_cast<int32_t>(dark_count * 20) - static_cast<int32_t>(total * 10)))};
+    result += ((difference + total - 1) / total - 1) * penalty_n4;
+    return result;
+}
@@ -0,0 +1,172 @@
+/**
+ * @file qr_encoder.h
+ * @brief QR code encoder that runs in small steps.
+ *
+ * `qrcode_initText` does the whole encode, including evaluating all eight
+ * masks, in one call; for large versions that takes long enough to trigger the
+ * ESP8266 watchdog, and needs a large buffer on the stack. This encoder does
+ * the same work one step at a time, returning to the caller in between:
+ *
+ * 1. encode the text into data codewords;
+ * 2. compute the error correction for one block per step;
+ * 3. draw the function patterns and place the codewords;
+ * 4. evaluate one mask per step;
+ * 5. apply the best mask.
+ *
+ * The modules are stored in the same layout as the QRCode library uses, so the
+ * result is returned as a `QRCode` and can be used with `qrcode_getModule` and
+ * `qr_render`. Working storage comes from a static pool sized for version 40,
+ * so nothing large is allocated on the stack or the heap.
+ */
+#ifndef QR_ENCODER_H
+#define QR_ENCODER_H
+
+#include <Arduino.h>
+#include <qrcode.h>
+
+class QrEncoder
+{
+public:
+    static constexpr uint8_t min_version{1};
+    static constexpr uint8_t max_version{40};
+
+    enum class State : uint8_t
+    {
+        idle,
+        encode_data,
+        error_correction,
+        place,
+        mask,
+        finish,
+        done,
+        failed
+    };
+
+    ~QrEncoder()
+    {
+        release();
+    }
+
+    /**
+     * @brief Start encoding.
+     *
+     * The mode (numeric, alphanumeric or byte) is chosen from the text, as
+     * `qrcode_initText` does. The error correction level is raised as far as the
+     * text still fits in the version. The text is not copied; it must remain
+     * valid until the first `step` has returned.
+     *
+     * @param text    Text to encode.
+     * @param version QR version, 1 to 40, or 0 for the smallest that fits.
+     * @param ecc     Minimum error correction level, ECC_LOW to ECC_HIGH.
+     * @return true if encoding has started; false if the parameters are invalid,
+     *         the text does not fit, or no work buffer is free.
+     */
+    bool begin(const char *text, uint8_t version, uint8_t ecc);
+
+    /**
+     * @brief Do the next step of the encode.
+     *
+     * @return true if there is more to do.
+     */
+    bool step();
+
+    /**
+     * @brief Run all remaining steps, yielding between them.
+     *
+     * @return true if the code was generated.
+     */
+    bool run();
+
+    State state() const
+    {
+        return current_state;
+    }
+
+    /**
+     * @brief Progress through the steps, as a percentage.
+     */
+    uint8_t progress() const;
+
+    /**
+     * @brief Get the generated code.
+     *
+     * The modules remain in the work buffer, valid until `release` or the next `begin`.
+     *
+     * @param qrcode Filled in with the code.
+     * @return true if a code has been generated.
+     */
+    bool get(QRCode &qrcode);
+
+    /**
+     * @brief Return the work buffer to the pool.
+     */
+    void release();
+
+    /**
+     * @brief Number of data bits needed to encode a text.
+     *
+     * @param text    Text to encode.
+     * @param length  Length of the text.
+     * @param version Version; only affects the size of the character count.
+     * @param mode    Set to the mode used.
+     */
+    static uint32_t encoded_bits(const char *text, size_t length, uint8_t version, uint8_t &mode);
+
+    /**
+     * @brief Number of data codewords available in a version at an ECC level.
+     */
+    static uint16_t data_codewords(uint8_t version, uint8_t ecc);
+
+    /**
+     * @brief Smallest version that holds a text at an ECC level.
+     *
+     * @return The version, or 0 if the text does not fit in any version.
+     */
+    static uint8_t smallest_version(const char *text, uint8_t ecc);
+
+private:
+    static bool fits(uint32_t data_bits, size_t length, uint8_t mode, uint8_t version, uint8_t ecc);
+
+    bool is_function(uint8_t x, uint8_t y) const;
+    bool is_alignment(int8_t column, int8_t row) const;
+    bool get_module(uint8_t x, uint8_t y) const;
+    void set_module(uint8_t x, uint8_t y, bool dark);
+
+    void encode_data();
+    void error_correction(uint8_t block);
+    void place();
+    void draw_function_patterns();
+    void draw_format_bits(uint8_t mask_pattern);
+    void apply_mask(uint8_t mask_pattern);
+    uint32_t penalty() const;
+    uint16_t interleaved(uint16_t index) const;
+
+    State current_state{State::idle};
+    const char *text{nullptr};
+    uint16_t text_length{0};
+    uint8_t version{0};
+    uint8_t ecc{0};
+    uint8_t mode{0};
+    uint8_t size{0};
+
+    uint8_t block_count{0};
+    uint8_t short_block_count{0};
+    uint8_t ecc_length{0};
+    uint16_t short_data_length{0};
+    uint16_t data_length{0};
+
+    uint8_t current_block{0};
+    uint8_t current_mask{0};
+    uint8_t best_mask{0};
+    uint32_t best_penalty{0};
+    uint8_t steps_done{0};
+
+    //!< Alignment pattern index covering each coordinate, or -1.
+    int8_t alignment_index[4 * max_version + 17];
+    uint8_t alignment_count{0};
+
+    uint8_t *modules{nullptr};
+    uint8_t *codewords{nullptr};
+};
+
+#endif
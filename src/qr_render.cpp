@@ -0,0 +1,162 @@
+/**
+ * @file qr_render.cpp
+ * @brief Rasterize a QR code directly into packed frame buffer rows.
+ */
+#include "qr_render.h"
+
+#include <algorithm>
+#include "bit_expansion.h"
+#include "bitblit.h"
+
+namespace
+{
+    //!< Widest row that can be composed, in bytes.
+    constexpr int max_row_bytes{64};
+    //!< Quiet zone required by the standard, in modules.
+    constexpr int standard_quiet_zone{4};
+
+    /**
+     * @brief Accumulates dark-module bits and writes them out as frame buffer bytes.
+     */
+    class RowWriter
+    {
+    public:
+        explicit RowWriter(uint8_t *row) : out(row)
+        {
+        }
+
+        /**
+         * @brief Append the @p count most significant bits of @p bits.
+         */
+        void append(uint32_t bits, int count)
+        {
+            if (count < 32)
+            {
+                bits &= ~(0xFFFFFFFFu >> count);
+            }
+            accumulator |= (static_cast<uint64_t>(bits) << 32) >> pending;
+            pending += count;
+            while (pending >= 8)
+            {
+                // Dark modules are black, i.e. clear bits.
+                *out++ = static_cast<uint8_t>(~(accumulator >> 56));
+                accumulator <<= 8;
+                pending -= 8;
+            }
+        }
+
+        void flush()
+        {
+            if (pending > 0)
+            {
+                *out++ = static_cast<uint8_t>(~(accumulator >> 56));
+                accumulator = 0;
+                pending = 0;
+            }
+        }
+
+    private:
+        uint8_t *out;
+        uint64_t accumulator{0};
+        int pending{0};
+    };
+
+    void compose_row(QRCode &qrcode, uint8_t module_y, int width, int scale, uint8_t *row)
+    {
+        int modules{(width + scale - 1) / scale};
+        RowWriter writer(row);
+        if (scale <= bit_expansion_max_scale)
+        {
+            for (int module_x = 0; module_x < modules; module_x += 4)
+            {
+                uint32_t nibble{0};
+                for (int i = 0; i < 4; ++i)
+                {
+                    nibble <<= 1;
+                    if (module_x + i < qrcode.size && qrcode_getModule(&qrcode, module_x + i, module_y))
+                    {
+                        nibble |= 1;
+                    }
+                }
+                writer.append(bit_expansion(scale, nibble), 4 * scale);
+            }
+        }
+        else
+        {
+            for (int module_x = 0; module_x < modules; ++module_x)
+            {
+                uint32_t dark{qrcode_getModule(&qrcode, module_x, module_y) ? 0xFFFFFFFFu : 0};
+                for (int remaining = std::min(scale, width - module_x * scale); remaining > 0; remaining -= 32)
+                {
+                    writer.append(dark, std::min(remaining, 32));
+                }
+            }
+        }
+        writer.flush();
+    }
+}
+
+void qr_render(Paint &paint, QRCode &qrcode, int x, int y, int scale)
+{
+    if (scale < 1 || x < 0 || y < 0 || x >= paint.GetWidth())
+    {
+        return;
+    }
+
+    if (paint.GetRotate() != ROTATE_0)
+    {
+        // The packed row writes assume an unrotated frame buffer.
+        for (uint8_t module_y = 0; module_y < qrcode.size; ++module_y)
+        {
+            for (uint8_t module_x = 0; module_x < qrcode.size; ++module_x)
+            {
+                int rect_x{x + module_x * scale};
+                int rect_y{y + module_y * scale};
+                paint.DrawFilledRectangle(rect_x, rect_y, rect_x + scale - 1, rect_y + scale - 1,
+                    qrcode_getModule(&qrcode, module_x, module_y) ? 0 /* black */ : 1 /* white */);
+            }
+        }
+        return;
+    }
+
+    int width{std::min({qrcode.size * scale, paint.GetWidth() - x, max_row_bytes * 8})};
+    int stride{paint.GetWidth() / 8};
+    uint8_t *image{paint.GetImage()};
+    // Room for the last group of four modules overhanging the width.
+    uint8_t row[max_row_bytes + 4 * bit_expansion_max_scale / 8 + 1];
+
+    for (uint8_t module_y = 0; module_y < qrcode.size; ++module_y)
+    {
+        int pixel_y{y + module_y * scale};
+        if (pixel_y >= paint.GetHeight())
+        {
+            break;
+        }
+        compose_row(qrcode, module_y, width, scale, row);
+        uint8_t *first{&image[pixel_y * stride]};
+        bitblit_copy_bits(first, x, row, width);
+        for (int copy = 1; copy < scale && pixel_y + copy < paint.GetHeight(); ++copy)
+        {
+            bitblit_copy_span(&image[(pixel_y + copy) * stride], first, x, x + width);
+        }
+    }
+}
+
+int qr_fit_scale(int size, int width, int height, int &quiet_zone)
+{
+    int available{std::min(width, height)};
+    int scale{available / (size + 2 * standard_quiet_zone)};
+    if (scale > 0)
+    {
+        // Whatever is left over widens the quiet zone.
+        quiet_zone = (available / scale - size) / 2;
+        return scale;
+    }
+    if (size > available)
+    {
+        quiet_zone = 0;
+        return 0;
+    }
+    quiet_zone = (available - size) / 2;
+    return 1;
+}
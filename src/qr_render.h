@@ -0,0 +1,41 @@
+/**
+ * @file qr_render.h
+ * @brief Rasterize a QR code directly into packed frame buffer rows.
+ */
+#ifndef QR_RENDER_H
+#define QR_RENDER_H
+
+#include <qrcode.h>
+#include "epd/epdpaint.h"
+
+/**
+ * @brief Draw a QR code into a paint.
+ *
+ * Each row of modules is expanded into a row of pixels using a bit-expansion
+ * table for the scale, written into the frame buffer, and then copied to the
+ * remaining `scale - 1` pixel rows. Light modules are drawn white, so the area
+ * need not be cleared first. The code is clipped to the paint.
+ *
+ * @param paint  Destination.
+ * @param qrcode Generated code.
+ * @param x      Left edge, in pixels.
+ * @param y      Top edge, in pixels.
+ * @param scale  Size of a module, in pixels.
+ */
+void qr_render(Paint &paint, QRCode &qrcode, int x, int y, int scale);
+
+/**
+ * @brief Largest integer scale at which a code, with its quiet zone, fits an area.
+ *
+ * The quiet zone is the standard four modules where there is room; if there is
+ * not, it is reduced until the code fits at scale 1.
+ *
+ * @param size       Size of the code, in modules.
+ * @param width      Width of the area, in pixels.
+ * @param height     Height of the area, in pixels.
+ * @param quiet_zone Set to the quiet zone width, in modules.
+ * @return The scale, or 0 if the code does not fit at all.
+ */
+int qr_fit_scale(int size, int width, int height, int &quiet_zone);
+
+#endif
@@ -0,0 +1,229 @@
+/**
+ * @file scene.cpp
+ * @brief Draw a scene described as a list of drawing commands.
+ */
+#include "scene.h"
+
+#include <algorithm>
+#include <ArduinoJson.h>
+#include "bit_expansion.h"
+#include "fill_pattern.h"
+#include "qr_encoder.h"
+#include "qr_render.h"
+#include "shapes.h"
+
+namespace
+{
+    constexpr int black{0};
+    constexpr int white{1};
+
+    /**
+     * @brief Fill pattern of an item's "shade", if it is not solid.
+     */
+    class Shade
+    {
+    public:
+        explicit Shade(JsonObjectConst item):
+            level(item["shade"] | 0),
+            pattern(fill_pattern_level(level))
+        {
+        }
+
+        const FillPattern *get() const
+        {
+            return level > 0 && level < fill_pattern_levels - 1 ? &pattern : nullptr;
+        }
+
+    private:
+        int level;
+        FillPattern pattern;
+    };
+
+    TextAlign parse_align(const char *align)
+    {
+        if (strcmp(align, "center") == 0)
+        {
+            return TextAlign::center;
+        }
+        return strcmp(align, "right") == 0 ? TextAlign::right : TextAlign::left;
+    }
+
+    void draw_text(Paint &paint, JsonObjectConst item, const SceneContext &context, int colored)
+    {
+        const char *text{item["text"] | ""};
+        int x{item["x"] | 0};
+        int y{item["y"] | 0};
+        int width{item["w"] | paint.GetWidth() - x};
+        int height{item["h"] | paint.GetHeight() - y};
+        Font &font{strcmp(item["font"] | "", "title") == 0 ? *context.title_font : *context.message_font};
+        int scale{std::max(1, std::min<int>(item["size"] | 1, bit_expansion_max_scale))};
+        context.layouts->get(text, font, width, height, parse_align(item["align"] | "left"), scale)
+            .draw(paint, x, y, colored, context.text_cache);
+    }
+
+    void draw_line(Paint &paint, JsonObjectConst item, const SceneContext &, int colored)
+    {
+        int x0{item["x0"] | 0};
+        int y0{item["y0"] | 0};
+        int x1{item["x1"] | 0};
+        int y1{item["y1"] | 0};
+        if (y0 == y1)
+        {
+            paint.DrawHorizontalLine(std::min(x0, x1), y0, std::abs(x1 - x0) + 1, colored);
+        }
+        else if (x0 == x1)
+        {
+            paint.DrawVerticalLine(x0, std::min(y0, y1), std::abs(y1 - y0) + 1, colored);
+        }
+        else
+        {
+            draw_segment(paint, x0, y0, x1, y1, colored);
+        }
+    }
+
+    void draw_rect(Paint &paint, JsonObjectConst item, const SceneContext &, int colored)
+    {
+        int x{item["x"] | 0};
+        int y{item["y"] | 0};
+        int width{item["w"] | 0};
+        int height{item["h"] | 0};
+        if (width <= 0 || height <= 0)
+        {
+            return;
+        }
+        if (!(item["fill"] | false))
+        {
+            paint.DrawRectangle(x, y, x + width - 1, y + height - 1, colored);
+            return;
+        }
+        Shade shade(item);
+        int radius{item["radius"] | 0};
+        if (radius > 0)
+        {
+            fill_rounded_rectangle(paint, x, y, x + width - 1, y + height - 1, radius, colored, shade.get());
+        }
+        else
+        {
+            paint.DrawFilledRectangle(x, y, x + width - 1, y + height - 1, colored, shade.get());
+        }
+    }
+
+    void draw_circle(Paint &paint, JsonObjectConst item, const SceneContext &, int colored)
+    {
+        int x{item["x"] | 0};
+        int y{item["y"] | 0};
+        int radius{item["r"] | 0};
+        if (item["fill"] | false)
+        {
+            Shade shade(item);
+            fill_ellipse(paint, x, y, radius, radius, colored, shade.get());
+        }
+        else
+        {
+            paint.DrawCircle(x, y, radius, colored);
+        }
+    }
+
+    void draw_ellipse(Paint &paint, JsonObjectConst item, const SceneContext &, int colored)
+    {
+        Shade shade(item);
+        fill_ellipse(paint, item["x"] | 0, item["y"] | 0, item["rx"] | 0, item["ry"] | 0, colored, shade.get());
+    }
+
+    void draw_arc(Paint &paint, JsonObjectConst item, const SceneContext &, int colored)
+    {
+        Shade shade(item);
+        fill_arc(paint, item["x"] | 0, item["y"] | 0, item["r"] | 0, item["inner"] | 0, item["start"] | 0, item["end"] | 360,
+            colored, shade.get());
+    }
+
+    void draw_polygon(Paint &paint, JsonObjectConst item, const SceneContext &, int colored)
+    {
+        JsonArrayConst coordinates{item["points"].as<JsonArrayConst>()};
+        ShapePoint points[shape_max_points];
+        size_t count{std::min(coordinates.size() / 2, shape_max_points)};
+        for (size_t i = 0; i < count; ++i)
+        {
+            points[i] = ShapePoint{static_cast<int16_t>(coordinates[2 * i] | 0), static_cast<int16_t>(coordinates[2 * i + 1] | 0)};
+        }
+        Shade shade(item);
+        FillRule rule{strcmp(item["rule"] | "", "nonzero") == 0 ? FillRule::non_zero : FillRule::even_odd};
+        fill_polygon(paint, points, count, rule, colored, shade.get());
+    }
+
+    void draw_qr(Paint &paint, JsonObjectConst item, const SceneContext &, int)
+    {
+        // Scenes hold small codes; the encode is run to completion here.
+        QrEncoder encoder;
+        QRCode qrcode;
+        if (!encoder.begin(item["text"] | "", item["version"] | 0, item["ecc"] | ECC_LOW) || !encoder.run() || !encoder.get(qrcode))
+        {
+            Serial.println("Scene QR code not generated");
+            return;
+        }
+        qr_render(paint, qrcode, item["x"] | 0, item["y"] | 0, std::max(1, item["scale"] | 1));
+    }
+
+    void draw_image(Paint &, JsonObjectConst item, const SceneContext &context, int)
+    {
+        const char *file{item["file"] | ""};
+        if (context.draw_image != nullptr && *file != '\0')
+        {
+            context.draw_image(file, item["x"] | 0, item["y"] | 0);
+        }
+    }
+
+    struct ItemType
+    {
+        const char *name;
+        void (*draw)(Paint &paint, JsonObjectConst item, const SceneContext &context, int colored);
+    };
+
+    const ItemType item_types[]{
+        {"text", draw_text},
+        {"line", draw_line},
+        {"rect", draw_rect},
+        {"circle", draw_circle},
+        {"ellipse", draw_ellipse},
+        {"arc", draw_arc},
+        {"polygon", draw_polygon},
+        {"qr", draw_qr},
+        {"image", draw_image},
+        {"icon", draw_image},
+    };
+}
+
+bool scene_render(Paint &paint, const uint8_t *data, size_t length, const SceneContext &context, String &error)
+{
+    size_t start{0};
+    while (start < length && isspace(data[start]))
+    {
+        ++start;
+    }
+    JsonDocument document;
+    DeserializationError result{start < length && data[start] == '{' ? deserializeJson(document, data, length)
+        : deserializeMsgPack(document, data, length)};
+    if (result)
+    {
+        error = String("Invalid scene: ") + result.c_str();
+        return false;
+    }
+
+    paint.Clear(strcmp(document["background"] | "white", "black") == 0 ? black : white);
+    for (JsonVariantConst value : document["items"].as<JsonArrayConst>())
+    {
+        JsonObjectConst item{value.as<JsonObjectConst>()};
+        const char *type{item["type"] | ""};
+        int colored{strcmp(item["color"] | "black", "white") == 0 ? white : black};
+        for (const auto &item_type : item_types)
+        {
+            if (strcmp(type, item_type.name) == 0)
+            {
+                item_type.draw(paint, item, context, colored);
+                break;
+            }
+        }
+        yield();
+    }
+    return true;
+}
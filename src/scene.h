@@ -0,0 +1,61 @@
+/**
+ * @file scene.h
+ * @brief Draw a scene described as a list of drawing commands.
+ *
+ * A scene is a JSON object, or the same object as MessagePack:
+ *
+ *     {"background": "white", "items": [
+ *         {"type": "text", "x": 0, "y": 0, "w": 200, "h": 24, "text": "21.5°C",
+ *          "font": "title", "size": 1, "align": "center"},
+ *         {"type": "line", "x0": 0, "y0": 30, "x1": 199, "y1": 30},
+ *         {"type": "rect", "x": 10, "y": 40, "w": 50, "h": 20, "fill": true, "radius": 4, "shade": 8},
+ *         {"type": "circle", "x": 100, "y": 100, "r": 20, "fill": true},
+ *         {"type": "arc", "x": 100, "y": 150, "r": 40, "inner": 30, "start": 180, "end": 270},
+ *         {"type": "polygon", "points": [0, 199, 50, 150, 100, 180], "rule": "nonzero"},
+ *         {"type": "qr", "x": 140, "y": 140, "text": "https://example.com", "scale": 2},
+ *         {"type": "image", "file": "/icon.bmp", "x": 4, "y": 4}
+ *     ]}
+ *
+ * Every item may have a "color", "black" (the default) or "white". Filled
+ * shapes may have a "shade", a fill pattern level from 1 to 16 (solid). Text
+ * is wrapped in its box, which defaults to the rest of the paint; "font" is
+ * "message" (the default) or "title", and "size" is an integer scale. An
+ * "icon" is a stored image, as "image" is. Unknown items are skipped.
+ */
+#ifndef SCENE_H
+#define SCENE_H
+
+#include <Arduino.h>
+#include "epd/epdpaint.h"
+#include "font.h"
+#include "text_cache.h"
+#include "text_layout.h"
+
+/**
+ * @brief What a scene is drawn with, beyond the paint.
+ */
+struct SceneContext
+{
+    Font *title_font;
+    Font *message_font;
+    TextLayoutCache *layouts;
+    TextCache *text_cache;
+    //!< Draw a stored image into the paint, with its top left corner at (x, y).
+    void (*draw_image)(const char *filename, int x, int y);
+};
+
+/**
+ * @brief Draw a scene into a paint.
+ *
+ * The paint is cleared to the scene's background first.
+ *
+ * @param paint   Destination.
+ * @param data    JSON or MessagePack; JSON if the first character other than white space is '{'.
+ * @param length  Length of the data, in bytes.
+ * @param context Fonts, caches and image loader.
+ * @param error   Set to the reason if the scene cannot be parsed.
+ * @return true if the scene was drawn.
+ */
+bool scene_render(Paint &paint, const uint8_t *data, size_t length, const SceneContext &context, String &error);
+
+#endif
@@ -0,0 +1,458 @@
+/**
+ * @file shapes.cpp
+ * @brief Filled polygons, ellipses, rounded rectangles and arcs.
+ */
+#include "shapes.h"
+
+#include <algorithm>
+#include <math.h>
+
+namespace
+{
+    //!< Scale of the sines and cosines of arc angles.
+    constexpr int32_t trig_one{16384};
+
+    int32_t floor_div(int64_t numerator, int32_t denominator)
+    {
+        int64_t quotient{numerator / denominator};
+        bool inexact{quotient * denominator != numerator};
+        return static_cast<int32_t>(inexact && (numerator < 0) != (denominator < 0) ? quotient - 1 : quotient);
+    }
+
+    //!< Rows of the paint as drawn, which are its columns when it is turned.
+    int logical_height(Paint &paint)
+    {
+        int rotate{paint.GetRotate()};
+        return rotate == ROTATE_90 || rotate == ROTATE_270 ? paint.GetWidth() : paint.GetHeight();
+    }
+
+    /**
+     * @brief A polygon edge, stepped a row at a time.
+     *
+     * The edge crosses the centre of each row at `x + remainder / denominator`.
+     */
+    struct Edge
+    {
+        int16_t top;     //!< First row.
+        int16_t bottom;  //!< One past the last row.
+        int32_t x;
+        int32_t remainder;
+        int32_t denominator;
+        int32_t step;
+        int32_t step_remainder;
+        int8_t direction;  //!< 1 going down, -1 going up.
+
+        //!< First pixel whose centre is at or right of the edge.
+        int pixel() const
+        {
+            return x + (2 * remainder > denominator ? 1 : 0);
+        }
+
+        void advance()
+        {
+            x += step;
+            remainder += step_remainder;
+            if (remainder >= denominator)
+            {
+                remainder -= denominator;
+                ++x;
+            }
+        }
+    };
+
+    Edge edge_table[shape_max_points];
+    uint8_t active[shape_max_points];
+    int16_t crossing[shape_max_points];
+
+    /**
+     * @brief Half widths of the rows of an ellipse, outward from its centre.
+     *
+     * A pixel is inside if its centre is within the ellipse with half a pixel
+     * added to each radius, so that small ellipses are not lopsided. Rows must be
+     * asked for in order of increasing distance from the centre.
+     */
+    class EllipseRows
+    {
+    public:
+        EllipseRows(int radius_x, int radius_y):
+            radius_y(radius_y),
+            width_squared(static_cast<int64_t>(2 * radius_x + 1) * (2 * radius_x + 1)),
+            height_squared(static_cast<int64_t>(2 * radius_y + 1) * (2 * radius_y + 1)),
+            half_width(radius_x)
+        {
+        }
+
+        //!< Half width of the row @p dy from the centre, or -1 if the row is outside.
+        int at(int dy)
+        {
+            if (dy > radius_y || dy < -radius_y)
+            {
+                return -1;
+            }
+            int64_t row{4 * static_cast<int64_t>(dy) * dy * width_squared};
+            while (half_width > 0 &&
+                4 * static_cast<int64_t>(half_width) * half_width * height_squared + row > width_squared * height_squared)
+            {
+                --half_width;
+            }
+            return half_width;
+        }
+
+    private:
+        int radius_y;
+        int64_t width_squared;
+        int64_t height_squared;
+        int half_width;
+    };
+
+    /**
+     * @brief Pixel columns, relative to the centre, within at most 180 degrees of an arc.
+     *
+     * The wedge is the intersection of two half planes, each of which limits
+     * a row to one side of a column.
+     */
+    class Wedge
+    {
+    public:
+        Wedge(int start_angle, int end_angle, bool include_end):
+            start_cos(trig(cosf, start_angle)),
+            start_sin(trig(sinf, start_angle)),
+            end_cos(trig(cosf, end_angle)),
+            end_sin(trig(sinf, end_angle)),
+            include_end(include_end)
+        {
+        }
+
+        /**
+         * @brief Columns of row @p dy in the wedge.
+         *
+         * @return false if there are none.
+         */
+        bool columns(int dy, int &first, int &last) const
+        {
+            first = INT16_MIN;
+            last = INT16_MAX;
+            // Clockwise of the start: start_sin * x <= start_cos * dy.
+            // Anticlockwise of the end: -end_sin * x <= -end_cos * dy.
+            return limit(start_sin, start_cos * dy, true, first, last) &&
+                limit(-end_sin, -end_cos * dy, include_end, first, last) && first <= last;
+        }
+
+    private:
+        static int32_t trig(float (*function)(float), int angle)
+        {
+            return static_cast<int32_t>(lroundf(function(angle * static_cast<float>(M_PI) / 180.0f) * trig_one));
+        }
+
+        //!< Narrow [first, last] to the columns x with k * x <= m, or k * x < m if not @p inclusive.
+        static bool limit(int32_t k, int32_t m, bool inclusive, int &first, int &last)
+        {
+            if (k == 0)
+            {
+                return inclusive ? m >= 0 : m > 0;
+            }
+            if (k > 0)
+            {
+                int32_t bound{inclusive ? floor_div(m, k) : -floor_div(-m, k) - 1};
+                last = std::min<int32_t>(last, bound);
+            }
+            else
+            {
+                int32_t bound{inclusive ? -floor_div(-m, k) : floor_div(m, k) + 1};
+                first = std::max<int32_t>(first, bound);
+            }
+            return true;
+        }
+
+        int32_t start_cos;
+        int32_t start_sin;
+        int32_t end_cos;
+        int32_t end_sin;
+        bool include_end;
+    };
+
+    //!< Draw the columns [first, last] of a row, relative to @p x, that are also within [from, to].
+    void draw_clipped(Paint &paint, int x, int row, int first, int last, int from, int to, int colored, const FillPattern *pattern)
+    {
+        first = std::max(first, from);
+        last = std::min(last, to);
+        if (first <= last)
+        {
+            paint.DrawSpan(x + first, x + last + 1, row, colored, pattern);
+        }
+    }
+}
+
+void fill_polygon(Paint &paint, const ShapePoint *points, size_t count, FillRule rule, int colored, const FillPattern *pattern)
+{
+    count = std::min(count, shape_max_points);
+
+    // Edge table, sorted by first row; horizontal edges cross no row centres.
+    size_t edge_count{0};
+    for (size_t i = 0; i < count; ++i)
+    {
+        ShapePoint from{points[i]};
+        ShapePoint to{points[(i + 1) % count]};
+        if (from.y == to.y)
+        {
+            continue;
+        }
+        int8_t direction{1};
+        if (from.y > to.y)
+        {
+            std::swap(from, to);
+            direction = -1;
+        }
+        Edge edge;
+        edge.top = from.y;
+        edge.bottom = to.y;
+        edge.direction = direction;
+        int32_t dx{to.x - from.x};
+        edge.denominator = 2 * (to.y - from.y);
+        edge.step = floor_div(2 * dx, edge.denominator);
+        edge.step_remainder = 2 * dx - edge.step * edge.denominator;
+        // Stepped to the first row when it becomes active.
+        edge.x = from.x;
+        edge.remainder = 0;
+        size_t position{edge_count++};
+        while (position > 0 && edge_table[position - 1].top > edge.top)
+        {
+            edge_table[position] = edge_table[position - 1];
+            --position;
+        }
+        edge_table[position] = edge;
+    }
+    if (edge_count == 0)
+    {
+        return;
+    }
+
+    int bottom{0};
+    for (size_t i = 0; i < edge_count; ++i)
+    {
+        bottom = std::max<int>(bottom, edge_table[i].bottom);
+    }
+    bottom = std::min(bottom, logical_height(paint));
+
+    size_t next_edge{0};
+    size_t active_count{0};
+    for (int row = std::max<int>(edge_table[0].top, 0); row < bottom; ++row)
+    {
+        // Start the edges that reach this row, at its centre.
+        while (next_edge < edge_count && edge_table[next_edge].top <= row)
+        {
+            Edge &edge{edge_table[next_edge]};
+            // The step is 2 dx / denominator; the centre of row k is (2 k + 1) dx / denominator across.
+            int64_t numerator{(2 * static_cast<int64_t>(row - edge.top) + 1) * (edge.step * edge.denominator + edge.step_remainder) / 2};
+            int32_t whole{floor_div(numerator, edge.denominator)};
+            edge.x += whole;
+            edge.remainder = static_cast<int32_t>(numerator - static_cast<int64_t>(whole) * edge.denominator);
+            if (edge.bottom > row)
+            {
+                active[active_count++] = static_cast<uint8_t>(next_edge);
+            }
+            ++next_edge;
+        }
+
+        // Crossings of the row, left to right; the active edges stay nearly sorted.
+        size_t crossings{0};
+        for (size_t i = 0; i < active_count; ++i)
+        {
+            uint8_t index{active[i]};
+            int pixel{edge_table[index].pixel()};
+            size_t position{i};
+            while (position > 0 && edge_table[active[position - 1]].pixel() > pixel)
+            {
+                active[position] = active[position - 1];
+                crossing[position] = crossing[position - 1];
+                --position;
+            }
+            active[position] = index;
+            crossing[position] = static_cast<int16_t>(pixel);
+            ++crossings;
+        }
+
+        int winding{0};
+        for (size_t i = 0; i < crossings; ++i)
+        {
+            int previous{winding};
+            winding += rule == FillRule::even_odd ? (winding == 0 ? 1 : -1) : edge_table[active[i]].direction;
+            if (previous == 0 && winding != 0)
+            {
+                // Find where the inside ends.
+                size_t j{i + 1};
+                for (; j < crossings; ++j)
+                {
+                    winding += rule == FillRule::even_odd ? (winding == 0 ? 1 : -1) : edge_table[active[j]].direction;
+                    if (winding == 0)
+                    {
+                        break;
+                    }
+                }
+                if (j < crossings)
+                {
+                    paint.DrawSpan(crossing[i], crossing[j], row, colored, pattern);
+                }
+                i = j;
+            }
+        }
+
+        // Step to the next row, dropping the edges that end.
+        size_t kept{0};
+        for (size_t i = 0; i < active_count; ++i)
+        {
+            Edge &edge{edge_table[active[i]]};
+            if (edge.bottom > row + 1)
+            {
+                edge.advance();
+                active[kept++] = active[i];
+            }
+        }
+        active_count = kept;
+    }
+}
+
+void fill_ellipse(Paint &paint, int x, int y, int radius_x, int radius_y, int colored, const FillPattern *pattern)
+{
+    if (radius_x < 0 || radius_y < 0)
+    {
+        return;
+    }
+    EllipseRows rows(radius_x, radius_y);
+    for (int dy = 0; dy <= radius_y; ++dy)
+    {
+        int half_width{rows.at(dy)};
+        paint.DrawSpan(x - half_width, x + half_width + 1, y + dy, colored, pattern);
+        if (dy != 0)
+        {
+            paint.DrawSpan(x - half_width, x + half_width + 1, y - dy, colored, pattern);
+        }
+    }
+}
+
+void fill_rounded_rectangle(Paint &paint, int x0, int y0, int x1, int y1, int radius, int colored, const FillPattern *pattern)
+{
+    if (x0 > x1)
+    {
+        std::swap(x0, x1);
+    }
+    if (y0 > y1)
+    {
+        std::swap(y0, y1);
+    }
+    radius = std::max(0, std::min({radius, (x1 - x0) / 2, (y1 - y0) / 2}));
+
+    // The corners are quarters of a circle whose centre rows are the first and last full rows.
+    int top{y0 + radius};
+    int bottom{y1 - radius};
+    EllipseRows rows(radius, radius);
+    for (int dy = 0; dy <= radius; ++dy)
+    {
+        int inset{radius - rows.at(dy)};
+        paint.DrawSpan(x0 + inset, x1 - inset + 1, top - dy, colored, pattern);
+        if (dy != 0 || bottom != top)
+        {
+            paint.DrawSpan(x0 + inset, x1 - inset + 1, bottom + dy, colored, pattern);
+        }
+    }
+    for (int row = top + 1; row < bottom; ++row)
+    {
+        paint.DrawSpan(x0, x1 + 1, row, colored, pattern);
+    }
+}
+
+void fill_arc(Paint &paint, int x, int y, int outer_radius, int inner_radius, int start_angle, int end_angle, int colored, const FillPattern *pattern)
+{
+    if (outer_radius < 0)
+    {
+        return;
+    }
+    int sweep{end_angle - start_angle};
+    bool whole{sweep >= 360};
+    sweep = (sweep % 360 + 360) % 360;
+    if (!whole && sweep == 0)
+    {
+        return;
+    }
+
+    // A wider arc is two wedges, the first not including the ray they share.
+    Wedge first_wedge(start_angle, start_angle + std::min(sweep, 180), sweep <= 180);
+    Wedge second_wedge(start_angle + 180, start_angle + sweep, true);
+    int wedges{whole ? 0 : sweep <= 180 ? 1 : 2};
+
+    EllipseRows outer(outer_radius, outer_radius);
+    EllipseRows inner(inner_radius, inner_radius);
+    int height{logical_height(paint)};
+    for (int dy = 0; dy <= outer_radius; ++dy)
+    {
+        int outer_half{outer.at(dy)};
+        int inner_half{inner_radius > 0 ? inner.at(dy) : -1};
+        for (int side = 0; side < (dy == 0 ? 1 : 2); ++side)
+        {
+            int offset{side == 0 ? dy : -dy};
+            int row{y + offset};
+            if (row < 0 || row >= height)
+            {
+                continue;
+            }
+            // The ring is one run of the row, or two either side of the hole.
+            int runs[2][2]{{-outer_half, outer_half}, {1, 0}};
+            if (inner_half >= 0)
+            {
+                runs[0][1] = -inner_half - 1;
+                runs[1][0] = inner_half + 1;
+                runs[1][1] = outer_half;
+            }
+            for (auto &run : runs)
+            {
+                if (run[0] > run[1])
+                {
+                    continue;
+                }
+                if (wedges == 0)
+                {
+                    draw_clipped(paint, x, row, run[0], run[1], run[0], run[1], colored, pattern);
+                    continue;
+                }
+                int first;
+                int last;
+                if (first_wedge.columns(offset, first, last))
+                {
+                    draw_clipped(paint, x, row, run[0], run[1], first, last, colored, pattern);
+                }
+                if (wedges == 2 && second_wedge.columns(offset, first, last))
+                {
+                    draw_clipped(paint, x, row, run[0], run[1], first, last, colored, pattern);
+                }
+            }
+        }
+    }
+}
+
+void draw_segment(Paint &paint, int x0, int y0, int x1, int y1, int colored)
+{
+    int dx{std::abs(x1 - x0)};
+    int dy{-std::abs(y1 - y0)};
+    int step_x{x0 < x1 ? 1 : -1};
+    int step_y{y0 < y1 ? 1 : -1};
+    int error{dx + dy};
+    while (true)
+    {
+        paint.DrawPixel(x0, y0, colored);
+        if (x0 == x1 && y0 == y1)
+        {
+            return;
+        }
+        int twice{2 * error};
+        if (twice >= dy)
+        {
+            error += dy;
+            x0 += step_x;
+        }
+        if (twice <= dx)
+        {
+            error += dx;
+            y0 += step_y;
+        }
+    }
+}
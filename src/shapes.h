@@ -0,0 +1,112 @@
+/**
+ * @file shapes.h
+ * @brief Filled polygons, ellipses, rounded rectangles and arcs, and lines.
+ *
+ * Every shape is converted to horizontal spans, one per row (or two, for a
+ * ring), which `Paint::DrawSpan` fills a byte at a time, solid or with a
+ * fill pattern. No pixel is drawn twice.
+ *
+ * Polygon vertices are pixel coordinates, and a pixel is inside if its centre
+ * is: a polygon with corners (0, 0) and (10, 10) covers pixels 0 to 9 in each
+ * direction, so polygons that share an edge do not overlap.
+ */
+#ifndef SHAPES_H
+#define SHAPES_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "epd/epdpaint.h"
+#include "fill_pattern.h"
+
+struct ShapePoint
+{
+    int16_t x;
+    int16_t y;
+};
+
+enum class FillRule
+{
+    even_odd,  //!< Inside where a ray crosses the outline an odd number of times.
+    non_zero,  //!< Inside where the outline winds around the point.
+};
+
+/**
+ * @brief Draw a line, including both end points.
+ *
+ * `Paint::DrawLine` stops as soon as either coordinate reaches its end, so it
+ * leaves a gap before the end of any line that is not at 45 degrees, and skips
+ * horizontal and vertical lines; this is the full Bresenham line.
+ *
+ * @param paint   Destination.
+ * @param colored Colour of the line.
+ */
+void draw_segment(Paint &paint, int x0, int y0, int x1, int y1, int colored);
+
+//!< Most vertices in a polygon; more are ignored.
+static constexpr size_t shape_max_points{64};
+
+/**
+ * @brief Fill a polygon.
+ *
+ * The outline is closed from the last point back to the first. Edges are
+ * sorted into an edge table by their first row, moved to the active edge
+ * table as the scan reaches them, and stepped from row to row with integer
+ * arithmetic.
+ *
+ * @param paint   Destination.
+ * @param points  Vertices.
+ * @param count   Number of vertices.
+ * @param rule    Rule deciding which parts of a self-intersecting outline are inside.
+ * @param colored Colour of the fill.
+ * @param pattern If not null, only the pixels of its set bits are filled.
+ */
+void fill_polygon(Paint &paint, const ShapePoint *points, size_t count, FillRule rule, int colored,
+    const FillPattern *pattern = nullptr);
+
+/**
+ * @brief Fill an axis-aligned ellipse.
+ *
+ * @param paint    Destination.
+ * @param x        Centre.
+ * @param y        Centre.
+ * @param radius_x Horizontal radius, in pixels.
+ * @param radius_y Vertical radius, in pixels.
+ * @param colored  Colour of the fill.
+ * @param pattern  If not null, only the pixels of its set bits are filled.
+ */
+void fill_ellipse(Paint &paint, int x, int y, int radius_x, int radius_y, int colored,
+    const FillPattern *pattern = nullptr);
+
+/**
+ * @brief Fill a rectangle with rounded corners.
+ *
+ * The corners are inclusive, as for `Paint::DrawFilledRectangle`.
+ *
+ * @param radius  Of the corners; reduced to fit the rectangle.
+ * @param colored Colour of the fill.
+ * @param pattern If not null, only the pixels of its set bits are filled.
+ */
+void fill_rounded_rectangle(Paint &paint, int x0, int y0, int x1, int y1, int radius, int colored,
+    const FillPattern *pattern = nullptr);
+
+/**
+ * @brief Fill part of a ring, such as the band of a gauge.
+ *
+ * Angles are in degrees, clockwise from the positive x axis (three o'clock);
+ * the arc runs clockwise from @p start_angle to @p end_angle. An arc of 360
+ * degrees or more is the whole ring.
+ *
+ * @param paint        Destination.
+ * @param x            Centre.
+ * @param y            Centre.
+ * @param outer_radius Of the ring, in pixels.
+ * @param inner_radius Of the hole in the ring; 0 fills a pie slice.
+ * @param start_angle  Start of the arc.
+ * @param end_angle    End of the arc.
+ * @param colored      Colour of the fill.
+ * @param pattern      If not null, only the pixels of its set bits are filled.
+ */
+void fill_arc(Paint &paint, int x, int y, int outer_radius, int inner_radius, int start_angle, int end_angle, int colored,
+    const FillPattern *pattern = nullptr);
+
+#endif
@@ -0,0 +1,342 @@
+/**
+ * @file storage_manager.cpp
+ * @brief Per-class quotas and LRU eviction for files stored on LittleFS.
+ */
+#include "storage_manager.h"
+
+#include <LittleFS.h>
+
+namespace
+{
+    //!< Quota of each class, as a percentage of the file system size.
+    constexpr uint8_t quota_percent[static_cast<size_t>(StorageClass::count)]{
+        100,    // original
+        30,     // native_cache
+        10,     // thumbnail
+        10,     // snapshot
+    };
+
+    constexpr const char *legacy_snapshot{"/generated-qr-code.bmp"};
+
+    bool in_directory(const String &path, const char *dir)
+    {
+        return path.startsWith(dir) && path.length() > strlen(dir) && path[strlen(dir)] == '/';
+    }
+}
+
+StorageManager::Lock::Lock(const StorageManager &storage):
+    storage(storage)
+{
+#ifdef ESP32
+    if (storage.lock != nullptr)
+    {
+        xSemaphoreTakeRecursive(storage.lock, portMAX_DELAY);
+    }
+#endif
+}
+
+StorageManager::Lock::~Lock()
+{
+#ifdef ESP32
+    if (storage.lock != nullptr)
+    {
+        xSemaphoreGiveRecursive(storage.lock);
+    }
+#endif
+}
+
+void StorageManager::begin()
+{
+#ifdef ESP32
+    if (lock == nullptr)
+    {
+        lock = xSemaphoreCreateRecursiveMutex();
+    }
+#endif
+    Lock hold{*this};
+#ifdef ESP8266
+    FSInfo64 info;
+    LittleFS.info64(info);
+    block_size = info.blockSize != 0 ? info.blockSize : block_size;
+#endif
+    uint64_t total;
+    uint64_t used;
+    capacity(total, used);
+    for (size_t i = 0; i < static_cast<size_t>(StorageClass::count); ++i)
+    {
+        class_quota[i] = static_cast<size_t>(total * quota_percent[i] / 100);
+        class_usage[i] = 0;
+    }
+    entry_count = 0;
+    access_clock = 0;
+
+    scan("/");
+    scan(native_cache_dir);
+    scan(thumbnail_dir);
+    scan(snapshot_dir);
+}
+
+StorageClass StorageManager::classify(const String &path)
+{
+    if (in_directory(path, native_cache_dir))
+    {
+        return StorageClass::native_cache;
+    }
+    if (in_directory(path, thumbnail_dir))
+    {
+        return StorageClass::thumbnail;
+    }
+    if (in_directory(path, snapshot_dir) || path == legacy_snapshot)
+    {
+        return StorageClass::snapshot;
+    }
+    return StorageClass::original;
+}
+
+const char *StorageManager::class_name(StorageClass storage_class)
+{
+    switch (storage_class)
+    {
+    case StorageClass::original:
+        return "originals";
+    case StorageClass::native_cache:
+        return "nativecache";
+    case StorageClass::thumbnail:
+        return "thumbnails";
+    case StorageClass::snapshot:
+        return "snapshots";
+    default:
+        return "unknown";
+    }
+}
+
+void StorageManager::capacity(uint64_t &total, uint64_t &used)
+{
+#ifdef ESP8266
+    FSInfo64 info;
+    LittleFS.info64(info);
+    total = info.totalBytes;
+    used = info.usedBytes;
+#else
+    total = LittleFS.totalBytes();
+    used = LittleFS.usedBytes();
+#endif
+}
+
+bool StorageManager::reserve(StorageClass storage_class, size_t bytes, size_t replaced)
+{
+    Lock hold{*this};
+    auto index{static_cast<size_t>(storage_class)};
+    if (bytes > class_quota[index])
+    {
+        return false;
+    }
+
+    // Originals are never evicted; anything else makes room within its own class first.
+    while (class_usage[index] - std::min(replaced, class_usage[index]) + bytes > class_quota[index])
+    {
+        if (storage_class == StorageClass::original || !evict(least_recently_used(storage_class)))
+        {
+            return false;
+        }
+    }
+
+    // Then any derived file is fair game to make room on the file system. Allow
+    // a block for rounding and metadata.
+    while (free_bytes() + replaced < bytes + block_size)
+    {
+        if (!evict(least_recently_used(StorageClass::count)))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool StorageManager::reserve_replacing(const String &path, size_t bytes)
+{
+    Lock hold{*this};
+    auto storage_class{classify(path)};
+    if (!LittleFS.exists(path))
+    {
+        return reserve(storage_class, bytes);
+    }
+    if (storage_class != StorageClass::original)
+    {
+        // Derived files can be regenerated, and reserving could evict this one.
+        remove(path);
+        return reserve(storage_class, bytes);
+    }
+
+    size_t replaced{0};
+    {
+        File file{LittleFS.open(path, "r")};
+        if (file)
+        {
+            replaced = file.size();
+        }
+    }
+    if (!reserve(storage_class, bytes, replaced))
+    {
+        return false;
+    }
+    remove(path);
+    return true;
+}
+
+void StorageManager::added(const String &path, size_t size)
+{
+    Lock hold{*this};
+    auto storage_class{classify(path)};
+    auto index{static_cast<size_t>(storage_class)};
+    if (storage_class == StorageClass::original)
+    {
+        class_usage[index] += size;
+        return;
+    }
+
+    Entry *entry{find(path)};
+    if (entry != nullptr)
+    {
+        class_usage[index] -= entry->size;
+    }
+    else
+    {
+        if (path.length() >= max_path)
+        {
+            // Can't be tracked, so can't be evicted later; don't keep it.
+            LittleFS.remove(path);
+            return;
+        }
+        if (entry_count == max_entries && !evict(least_recently_used(StorageClass::count)))
+        {
+            return;
+        }
+        entry = &entries[entry_count++];
+        strcpy(entry->path, path.c_str());
+        entry->storage_class = storage_class;
+    }
+    entry->size = size;
+    entry->last_access = ++access_clock;
+    class_usage[index] += size;
+}
+
+bool StorageManager::remove(const String &path)
+{
+    Lock hold{*this};
+    Entry *entry{find(path)};
+    if (entry != nullptr)
+    {
+        return evict(entry);
+    }
+
+    size_t size{0};
+    {
+        File file{LittleFS.open(path, "r")};
+        if (!file)
+        {
+            return false;
+        }
+        size = file.size();
+    }
+    if (!LittleFS.remove(path))
+    {
+        return false;
+    }
+    auto index{static_cast<size_t>(classify(path))};
+    class_usage[index] -= std::min(size, class_usage[index]);
+    return true;
+}
+
+void StorageManager::touch(const String &path)
+{
+    Lock hold{*this};
+    Entry *entry{find(path)};
+    if (entry != nullptr)
+    {
+        entry->last_access = ++access_clock;
+    }
+}
+
+StorageManager::Entry *StorageManager::find(const String &path)
+{
+    for (size_t i = 0; i < entry_count; ++i)
+    {
+        if (path == entries[i].path)
+        {
+            return &entries[i];
+        }
+    }
+    return nullptr;
+}
+
+/**
+ * @brief Find the least recently used derived file.
+ *
+ * @param storage_class Class to search, or `StorageClass::count` for any derived class.
+ * @return Entry, or nullptr if there is none.
+ */
+StorageManager::Entry *StorageManager::least_recently_used(StorageClass storage_class)
+{
+    Entry *oldest{nullptr};
+    for (size_t i = 0; i < entry_count; ++i)
+    {
+        if (storage_class != StorageClass::count && entries[i].storage_class != storage_class)
+        {
+            continue;
+        }
+        if (oldest == nullptr || entries[i].last_access < oldest->last_access)
+        {
+            oldest = &entries[i];
+        }
+    }
+    return oldest;
+}
+
+bool StorageManager::evict(Entry *entry)
+{
+    if (entry == nullptr)
+    {
+        return false;
+    }
+    Serial.println("Evicting " + String(entry->path));
+    LittleFS.remove(entry->path);
+    auto index{static_cast<size_t>(entry->storage_class)};
+    class_usage[index] -= std::min(static_cast<size_t>(entry->size), class_usage[index]);
+    // Entries are unordered; fill the hole with the last one.
+    *entry = entries[--entry_count];
+    return true;
+}
+
+void StorageManager::scan(const char *dir)
+{
+    String prefix{dir};
+    if (!prefix.endsWith("/"))
+    {
+        prefix += '/';
+    }
+    File directory{LittleFS.open(dir, "r")};
+    if (!directory || !directory.isDirectory())
+    {
+        return;
+    }
+    for (File file{directory.openNextFile()}; file; file = directory.openNextFile())
+    {
+        if (file.isDirectory())
+        {
+            continue;
+        }
+        String path{prefix + file.name()};
+        // Derived files found in the root (the legacy snapshot) are picked up here;
+        // derived directories are scanned separately.
+        added(path, file.size());
+    }
+}
+
+size_t StorageManager::free_bytes() const
+{
+    uint64_t total;
+    uint64_t used;
+    capacity(total, used);
+    return static_cast<size_t>(total - used);
+}
@@ -0,0 +1,178 @@
+/**
+ * @file storage_manager.h
+ * @brief Per-class quotas and LRU eviction for files stored on LittleFS.
+ *
+ * Files are classified by location:
+ * - `/cache/...`      native (pre-decoded) frames;
+ * - `/thumbs/...`     thumbnails;
+ * - `/snapshots/...`  snapshots, plus the legacy `/generated-qr-code.bmp`;
+ * - everything else   originals, i.e. uploaded files.
+ *
+ * Everything other than an original is derived and can be regenerated, so
+ * it is evicted, least recently used first, before a write is refused.
+ * Originals are never evicted.
+ *
+ * The methods can be called from request handlers and the display task at
+ * once; on the ESP32 each holds a lock while it updates the accounts. The
+ * lock is not held while a file is written, which is the caller's business.
+ */
+#ifndef STORAGE_MANAGER_H
+#define STORAGE_MANAGER_H
+
+#include <Arduino.h>
+
+#ifdef ESP32
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+#endif
+
+enum class StorageClass : uint8_t
+{
+    original,
+    native_cache,
+    thumbnail,
+    snapshot,
+    count
+};
+
+class StorageManager
+{
+public:
+    static constexpr const char *native_cache_dir{"/cache"};
+    static constexpr const char *thumbnail_dir{"/thumbs"};
+    static constexpr const char *snapshot_dir{"/snapshots"};
+
+    /**
+     * @brief Scan the file system and compute quotas.
+     *
+     * Must be called after `LittleFS.begin()`.
+     */
+    void begin();
+
+    /**
+     * @brief Determine the storage class of a path.
+     *
+     * @param path Absolute path.
+     * @return Class of the path.
+     */
+    static StorageClass classify(const String &path);
+
+    /**
+     * @brief Get the name of a storage class, as used in `/state`.
+     */
+    static const char *class_name(StorageClass storage_class);
+
+    /**
+     * @brief Get the size of the file system, and how much of it is in use.
+     *
+     * @param total Set to the size, in bytes.
+     * @param used  Set to the bytes in use.
+     */
+    static void capacity(uint64_t &total, uint64_t &used);
+
+    /**
+     * @brief Make room for a new file.
+     *
+     * Least recently used derived files are evicted until the class quota
+     * and the free space on the file system allow @p bytes to be written.
+     *
+     * @param storage_class Class of the file to be written.
+     * @param bytes         Size of the file to be written.
+     * @param replaced      Size of a file of the same class that the new file
+     *                      replaces, and that is removed before it is written.
+     * @return true if there is now room for the file, false if it should be rejected.
+     */
+    bool reserve(StorageClass storage_class, size_t bytes, size_t replaced = 0);
+
+    /**
+     * @brief Make room for a file that replaces @p path, if it exists.
+     *
+     * The existing file is counted as room to be reclaimed, and removed only
+     * if there is room for the new one; otherwise it is left as it was.
+     *
+     * @param path  Absolute path.
+     * @param bytes Size of the file to be written.
+     * @return true if the file can now be written, false if it should be rejected.
+     */
+    bool reserve_replacing(const String &path, size_t bytes);
+
+    /**
+     * @brief Record that a file has been written (or rewritten).
+     *
+     * @param path Absolute path.
+     * @param size File size.
+     */
+    void added(const String &path, size_t size);
+
+    /**
+     * @brief Remove a file and stop accounting for it.
+     *
+     * @param path Absolute path.
+     * @return true if the file was removed.
+     */
+    bool remove(const String &path);
+
+    /**
+     * @brief Record that a file has been read, making it most recently used.
+     *
+     * @param path Absolute path.
+     */
+    void touch(const String &path);
+
+    size_t usage(StorageClass storage_class) const
+    {
+        return class_usage[static_cast<size_t>(storage_class)];
+    }
+
+    size_t quota(StorageClass storage_class) const
+    {
+        return class_quota[static_cast<size_t>(storage_class)];
+    }
+
+private:
+    //!< Holds the lock on the accounts; recursive, as public methods call one another.
+    class Lock
+    {
+    public:
+        explicit Lock(const StorageManager &storage);
+        ~Lock();
+
+        Lock(const Lock &) = delete;
+        Lock &operator=(const Lock &) = delete;
+
+    private:
+        const StorageManager &storage;
+    };
+
+    //!< Maximum number of derived files tracked for eviction.
+    static constexpr size_t max_entries{32};
+    //!< LittleFS on the ESP8266 limits names to 31 characters; allow for the directory.
+    static constexpr size_t max_path{48};
+
+    struct Entry
+    {
+        char path[max_path];
+        uint32_t size;
+        uint32_t last_access;
+        StorageClass storage_class;
+    };
+
+    Entry *find(const String &path);
+    Entry *least_recently_used(StorageClass storage_class);
+    bool evict(Entry *entry);
+    void scan(const char *dir);
+    size_t free_bytes() const;
+
+    Entry entries[max_entries]{};
+    size_t entry_count{0};
+    uint32_t access_clock{0};
+    size_t block_size{4096};
+    size_t class_usage[static_cast<size_t>(StorageClass::count)]{};
+    size_t class_quota[static_cast<size_t>(StorageClass::count)]{};
+#ifdef ESP32
+    //!< Created by `begin`, which runs before anything else uses the storage manager.
+    SemaphoreHandle_t lock{nullptr};
+#endif
+};
+
+#endif
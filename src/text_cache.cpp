@@ -0,0 +1,254 @@
+/**
+ * @file text_cache.cpp
+ * @brief Cache of rendered strings.
+ */
+#include "text_cache.h"
+
+#include <algorithm>
+#include "bitblit.h"
+#include "fnv1a.h"
+
+namespace
+{
+    bool get_bit(const uint8_t *bitmap, int stride, int x, int y)
+    {
+        return (bitmap[y * stride + x / 8] & (0x80 >> (x % 8))) != 0;
+    }
+
+    void set_bit(uint8_t *bitmap, int stride, int x, int y)
+    {
+        bitmap[y * stride + x / 8] |= 0x80 >> (x % 8);
+    }
+}
+
+uint32_t TextCache::key(const char *text, size_t length, Font &font, int scale, int rotate)
+{
+    uint32_t hash{fnv1a(fnv1a_basis, text, length)};
+    const Font *font_address{&font};
+    hash = fnv1a(hash, &font_address, sizeof(font_address));
+    const int16_t parameters[]{static_cast<int16_t>(length), static_cast<int16_t>(scale), static_cast<int16_t>(rotate)};
+    return fnv1a(hash, parameters, sizeof(parameters));
+}
+
+TextCache::Entry *TextCache::find(uint32_t key, const char *text, size_t length, Font &font, int scale, int rotate)
+{
+    for (size_t i = 0; i < entry_count; ++i)
+    {
+        const Entry &entry{entries[i]};
+        if (entry.key == key && entry.font == &font && entry.scale == scale && entry.rotate == rotate &&
+            entry.text_length == length && memcmp(&arena[entry.offset + entry.length - length], text, length) == 0)
+        {
+            entries[i].last_access = ++access_clock;
+            return &entries[i];
+        }
+    }
+    return nullptr;
+}
+
+void TextCache::evict(size_t index)
+{
+    // Bitmaps are packed in entry order; close the gap.
+    Entry removed{entries[index]};
+    memmove(&arena[removed.offset], &arena[removed.offset + removed.length], arena_used - removed.offset - removed.length);
+    arena_used -= removed.length;
+    for (size_t i = index + 1; i < entry_count; ++i)
+    {
+        entries[i].offset -= removed.length;
+        entries[i - 1] = entries[i];
+    }
+    --entry_count;
+}
+
+TextCache::Entry *TextCache::render(uint32_t key, const char *text, size_t length, Font &font, int scale, int rotate)
+{
+    // Find the extent of the ink.
+    int left{0};
+    int right{0};
+    int top{0};
+    int bottom{0};
+    int pen{0};
+    const char *end{text + length};
+    for (const char *position = text; position != end;)
+    {
+        Glyph glyph;
+        if (!font.find(utf8_next(position, end), glyph))
+        {
+            continue;
+        }
+        if (glyph.metrics.width != 0)
+        {
+            int glyph_left{pen + glyph.metrics.x_offset * scale};
+            int glyph_top{glyph.metrics.y_offset * scale};
+            left = std::min(left, glyph_left);
+            right = std::max(right, glyph_left + glyph.metrics.width * scale);
+            top = std::min(top, glyph_top);
+            bottom = std::max(bottom, glyph_top + glyph.metrics.height * scale);
+        }
+        pen += glyph.metrics.advance * scale;
+    }
+    int width{right - left};
+    int height{bottom - top};
+    if (width == 0 || height == 0)
+    {
+        return nullptr;
+    }
+
+    bool turned{rotate == ROTATE_90 || rotate == ROTATE_270};
+    int stride{(width + 7) / 8};
+    int rotated_stride{turned ? (height + 7) / 8 : stride};
+    size_t bitmap_length{static_cast<size_t>(rotated_stride) * (turned ? width : height)};
+    // A rotated bitmap is rendered unrotated after the space for it, then turned into place;
+    // the text is kept after the bitmap, once that space is free again.
+    size_t scratch_length{rotate == ROTATE_0 ? 0 : static_cast<size_t>(stride) * height};
+    size_t reserved{bitmap_length + std::max(scratch_length, length)};
+    if (reserved > arena_size)
+    {
+        return nullptr;
+    }
+    while (entry_count == max_entries || arena_used + reserved > arena_size)
+    {
+        size_t oldest{0};
+        for (size_t i = 1; i < entry_count; ++i)
+        {
+            if (entries[i].last_access < entries[oldest].last_access)
+            {
+                oldest = i;
+            }
+        }
+        evict(oldest);
+    }
+
+    uint8_t *bitmap{&arena[arena_used]};
+    uint8_t *unrotated{bitmap + (rotate == ROTATE_0 ? 0 : bitmap_length)};
+    memset(unrotated, 0, static_cast<size_t>(stride) * height);
+    {
+        // Set bits are ink.
+        Paint ink(unrotated, width, height);
+        pen = -left;
+        for (const char *position = text; position != end;)
+        {
+            pen += ink.DrawCharAt(pen, -top, utf8_next(position, end), &font, 1, scale);
+        }
+    }
+
+    if (rotate != ROTATE_0)
+    {
+        memset(bitmap, 0, bitmap_length);
+        for (int y = 0; y < height; ++y)
+        {
+            for (int x = 0; x < width; ++x)
+            {
+                if (!get_bit(unrotated, stride, x, y))
+                {
+                    continue;
+                }
+                if (rotate == ROTATE_90)
+                {
+                    set_bit(bitmap, rotated_stride, height - 1 - y, x);
+                }
+                else if (rotate == ROTATE_180)
+                {
+                    set_bit(bitmap, rotated_stride, width - 1 - x, height - 1 - y);
+                }
+                else
+                {
+                    set_bit(bitmap, rotated_stride, y, width - 1 - x);
+                }
+            }
+        }
+    }
+
+    memcpy(bitmap + bitmap_length, text, length);
+    Entry &entry{entries[entry_count++]};
+    entry = Entry{key, static_cast<int16_t>(left), static_cast<int16_t>(top), static_cast<uint16_t>(width), static_cast<uint16_t>(height),
+        static_cast<uint16_t>(arena_used), static_cast<uint16_t>(bitmap_length + length), ++access_clock,
+        &font, static_cast<uint16_t>(length), static_cast<uint8_t>(scale), static_cast<uint8_t>(rotate)};
+    arena_used += bitmap_length + length;
+    return &entry;
+}
+
+void TextCache::blit(Paint &paint, const Entry &entry, int x, int y, int colored)
+{
+    // Map the unrotated box to the frame buffer, as `Paint::DrawPixel` does; a rotated
+    // paint never draws into the first column and/or row of the frame.
+    int frame_width{paint.GetWidth()};
+    int frame_height{paint.GetHeight()};
+    int left{x + entry.left};
+    int top{y + entry.top};
+    int rotate{paint.GetRotate()};
+    bool turned{rotate == ROTATE_90 || rotate == ROTATE_270};
+    int bitmap_width{turned ? entry.height : entry.width};
+    int bitmap_height{turned ? entry.width : entry.height};
+    int frame_x{left};
+    int frame_y{top};
+    int first_column{0};
+    int first_row{0};
+    if (rotate == ROTATE_90)
+    {
+        frame_x = frame_width - (top + entry.height - 1);
+        frame_y = left;
+        first_column = 1;
+    }
+    else if (rotate == ROTATE_180)
+    {
+        frame_x = frame_width - (left + entry.width - 1);
+        frame_y = frame_height - (top + entry.height - 1);
+        first_column = 1;
+        first_row = 1;
+    }
+    else if (rotate == ROTATE_270)
+    {
+        frame_x = top;
+        frame_y = frame_height - (left + entry.width - 1);
+        first_row = 1;
+    }
+
+    int stride{(bitmap_width + 7) / 8};
+    int frame_stride{frame_width / 8};
+    bool set{IF_INVERT_COLOR ? colored != 0 : colored == 0};
+    int count{std::min(bitmap_width, frame_width - frame_x)};
+    for (int row = 0; row < bitmap_height; ++row)
+    {
+        int frame_row{frame_y + row};
+        if (frame_row < first_row || frame_row >= frame_height || count <= 0)
+        {
+            continue;
+        }
+        const uint8_t *source{&arena[entry.offset + row * stride]};
+        if (frame_x >= first_column)
+        {
+            bitblit_merge_bits(&paint.GetImage()[frame_row * frame_stride], frame_x, source, count, set);
+            continue;
+        }
+        // Clipped on the left; rare enough to go a pixel at a time.
+        for (int column = first_column - frame_x; column < count; ++column)
+        {
+            if (get_bit(source, stride, column, 0))
+            {
+                paint.DrawAbsolutePixel(frame_x + column, frame_row, colored);
+            }
+        }
+    }
+}
+
+void TextCache::draw(Paint &paint, int x, int y, const char *text, size_t length, Font &font, int colored, int scale)
+{
+    uint32_t text_key{key(text, length, font, scale, paint.GetRotate())};
+    auto entry{find(text_key, text, length, font, scale, paint.GetRotate())};
+    if (entry == nullptr)
+    {
+        entry = render(text_key, text, length, font, scale, paint.GetRotate());
+    }
+    if (entry != nullptr)
+    {
+        blit(paint, *entry, x, y, colored);
+        return;
+    }
+
+    // Too large to cache.
+    const char *end{text + length};
+    while (text != end)
+    {
+        x += paint.DrawCharAt(x, y, utf8_next(text, end), &font, colored, scale);
+    }
+}
@@ -0,0 +1,69 @@
+/**
+ * @file text_cache.h
+ * @brief Cache of rendered strings.
+ *
+ * A string is rendered once into a packed bitmap of its ink, already rotated
+ * for the paint it is drawn into; drawing it again merges that bitmap into the
+ * frame buffer a row at a time, with no glyph lookups. Bitmaps are kept in a
+ * fixed arena, and the least recently drawn are evicted to make room.
+ */
+#ifndef TEXT_CACHE_H
+#define TEXT_CACHE_H
+
+#include <Arduino.h>
+#include "epd/epdpaint.h"
+#include "font.h"
+
+class TextCache
+{
+public:
+    //!< Bytes of bitmaps cached; a string with a larger bitmap is drawn directly.
+    static constexpr size_t arena_size{2048};
+    static constexpr size_t max_entries{16};
+
+    /**
+     * @brief Draw a string, as `Paint::DrawStringAt` would.
+     *
+     * @param paint   Destination.
+     * @param x       Pen position of the first character.
+     * @param y       Top of the line.
+     * @param text    UTF-8 text; need not be terminated.
+     * @param length  Length of the text, in bytes.
+     * @param font    Font.
+     * @param colored Colour of the text.
+     * @param scale   Integer scale of the text, 1 to 8.
+     */
+    void draw(Paint &paint, int x, int y, const char *text, size_t length, Font &font, int colored, int scale = 1);
+
+private:
+    struct Entry
+    {
+        uint32_t key;
+        int16_t left;      //!< Of the ink, relative to the pen position.
+        int16_t top;       //!< Of the ink, relative to the top of the line.
+        uint16_t width;    //!< Of the unrotated string, in pixels.
+        uint16_t height;   //!< Of the unrotated string, in pixels.
+        uint16_t offset;   //!< Of the rotated bitmap in the arena; the text follows it.
+        uint16_t length;   //!< Of the bitmap and the text.
+        uint32_t last_access;
+        const Font *font;
+        uint16_t text_length;
+        uint8_t scale;
+        uint8_t rotate;
+    };
+
+    static uint32_t key(const char *text, size_t length, Font &font, int scale, int rotate);
+    //!< The key alone could collide; the text and the parameters are compared too.
+    Entry *find(uint32_t key, const char *text, size_t length, Font &font, int scale, int rotate);
+    Entry *render(uint32_t key, const char *text, size_t length, Font &font, int scale, int rotate);
+    void evict(size_t index);
+    void blit(Paint &paint, const Entry &entry, int x, int y, int colored);
+
+    Entry entries[max_entries];
+    size_t entry_count{0};
+    uint8_t arena[arena_size];
+    size_t arena_used{0};
+    uint32_t access_clock{0};
+};
+
+#endif
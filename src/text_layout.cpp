@@ -0,0 +1,158 @@
+/**
+ * @file text_layout.cpp
+ * @brief Measure, wrap, align and clip text within a box.
+ */
+#include "text_layout.h"
+
+int TextLayout::measure(const char *text, size_t length, Font &font, int scale)
+{
+    const char *end{text + length};
+    int width{0};
+    while (text != end)
+    {
+        width += font.advance(utf8_next(text, end));
+    }
+    return width * scale;
+}
+
+void TextLayout::layout(const String &text, Font &font, int box_width, int box_height, TextAlign align, int scale)
+{
+    this->text = text;
+    this->font = &font;
+    this->box_width = box_width;
+    this->box_height = box_height;
+    this->align = align;
+    this->scale = scale;
+    line_count = 0;
+    clipped = false;
+
+    const char *characters{this->text.c_str()};
+    size_t length{this->text.length()};
+    size_t visible_lines{std::min(max_lines, static_cast<size_t>(std::max(box_height / (font.line_height() * scale), 0)))};
+    size_t position{0};
+    while (position < length)
+    {
+        if (line_count == visible_lines)
+        {
+            clipped = true;
+            break;
+        }
+
+        // Take characters until the box is full, remembering the last space.
+        size_t start{position};
+        size_t end{position};
+        size_t last_space{length};
+        int width{0};
+        while (end < length && characters[end] != '\n')
+        {
+            const char *next_character{&characters[end]};
+            int character_width{font.advance(utf8_next(next_character, &characters[length])) * scale};
+            if (width + character_width > box_width)
+            {
+                break;
+            }
+            if (characters[end] == ' ')
+            {
+                last_space = end;
+            }
+            width += character_width;
+            end = next_character - characters;
+        }
+
+        size_t next;
+        if (end < length && characters[end] != '\n')
+        {
+            // Wrap at the last space, or within the word if there is none.
+            if (last_space != length && last_space > start)
+            {
+                end = last_space;
+                next = last_space + 1;
+            }
+            else
+            {
+                if (end == start)
+                {
+                    // Not even one character fits; take it anyway, and let drawing clip it.
+                    const char *next_character{&characters[end]};
+                    utf8_next(next_character, &characters[length]);
+                    end = next_character - characters;
+                }
+                next = end;
+            }
+            while (next < length && characters[next] == ' ')
+            {
+                ++next;
+            }
+        }
+        else
+        {
+            next = end < length ? end + 1 : end;
+        }
+        while (end > start && characters[end - 1] == ' ')
+        {
+            --end;
+        }
+
+        int line_width{measure(&characters[start], end - start, font, scale)};
+        int x{0};
+        if (align == TextAlign::center)
+        {
+            x = (box_width - line_width) / 2;
+        }
+        else if (align == TextAlign::right)
+        {
+            x = box_width - line_width;
+        }
+        line[line_count++] = Line{static_cast<uint16_t>(start), static_cast<uint16_t>(end - start), static_cast<int16_t>(std::max(x, 0)),
+            static_cast<int16_t>(line_width)};
+        position = next;
+    }
+}
+
+void TextLayout::draw(Paint &paint, int x, int y, int colored, TextCache *cache) const
+{
+    const char *characters{text.c_str()};
+    for (size_t i = 0; i < line_count; ++i)
+    {
+        int pen_x{x + line[i].x};
+        int right{x + box_width};
+        const char *position{&characters[line[i].start]};
+        const char *end{position + line[i].length};
+        if (cache != nullptr && line[i].x + line[i].width <= box_width)
+        {
+            cache->draw(paint, pen_x, y, position, line[i].length, *font, colored, scale);
+            position = end;
+        }
+        while (position != end)
+        {
+            uint32_t codepoint{utf8_next(position, end)};
+            if (pen_x + font->advance(codepoint) * scale > right)
+            {
+                // Clip; only a character wider than the box can get here.
+                break;
+            }
+            pen_x += paint.DrawCharAt(pen_x, y, codepoint, font, colored, scale);
+        }
+        y += font->line_height() * scale;
+    }
+}
+
+const TextLayout &TextLayoutCache::get(const String &text, Font &font, int box_width, int box_height, TextAlign align, int scale)
+{
+    size_t oldest{0};
+    for (size_t i = 0; i < max_entries; ++i)
+    {
+        if (last_access[i] != 0 && layouts[i].matches(text, font, box_width, box_height, align, scale))
+        {
+            last_access[i] = ++access_clock;
+            return layouts[i];
+        }
+        if (last_access[i] < last_access[oldest])
+        {
+            oldest = i;
+        }
+    }
+    layouts[oldest].layout(text, font, box_width, box_height, align, scale);
+    last_access[oldest] = ++access_clock;
+    return layouts[oldest];
+}
@@ -0,0 +1,135 @@
+/**
+ * @file text_layout.h
+ * @brief Measure, wrap, align and clip text within a box.
+ *
+ * A `TextLayout` is computed once from the text, font, box size and
+ * alignment, and can then be drawn any number of times. `TextLayoutCache`
+ * keeps the most recently used layouts, so laying out identical text again is
+ * free.
+ */
+#ifndef TEXT_LAYOUT_H
+#define TEXT_LAYOUT_H
+
+#include <Arduino.h>
+#include "epd/epdpaint.h"
+#include "font.h"
+#include "text_cache.h"
+
+enum class TextAlign : uint8_t
+{
+    left,
+    center,
+    right
+};
+
+class TextLayout
+{
+public:
+    static constexpr size_t max_lines{16};
+
+    /**
+     * @brief Measure the width of some text, without drawing it.
+     *
+     * @param text   UTF-8 text; need not be terminated.
+     * @param length Number of bytes to measure.
+     * @param font   Font.
+     * @param scale  Integer scale of the text.
+     * @return Width, in pixels.
+     */
+    static int measure(const char *text, size_t length, Font &font, int scale = 1);
+
+    /**
+     * @brief Lay out text in a box.
+     *
+     * Lines are broken at spaces, or within a word that is wider than the box,
+     * and at newlines. Lines that do not fit in the height of the box are dropped.
+     *
+     * @param text       Text.
+     * @param font       Font.
+     * @param box_width  Width of the box, in pixels.
+     * @param box_height Height of the box, in pixels.
+     * @param align      Horizontal alignment of each line.
+     * @param scale      Integer scale of the text, 1 to 8.
+     */
+    void layout(const String &text, Font &font, int box_width, int box_height, TextAlign align, int scale = 1);
+
+    /**
+     * @brief Draw the text.
+     *
+     * @param paint   Destination.
+     * @param x       Left of the box.
+     * @param y       Top of the box.
+     * @param colored Colour of the text.
+     * @param cache   If not null, lines are drawn through this cache of rendered strings.
+     */
+    void draw(Paint &paint, int x, int y, int colored, TextCache *cache = nullptr) const;
+
+    //!< Height of the laid out lines, in pixels.
+    int height() const
+    {
+        return line_count * font->line_height() * scale;
+    }
+
+    size_t lines() const
+    {
+        return line_count;
+    }
+
+    //!< Whether some of the text did not fit.
+    bool truncated() const
+    {
+        return clipped;
+    }
+
+    /**
+     * @brief Whether this is the layout of the given parameters.
+     */
+    bool matches(const String &text, Font &font, int box_width, int box_height, TextAlign align, int scale) const
+    {
+        return this->font == &font && this->box_width == box_width && this->box_height == box_height &&
+            this->align == align && this->scale == scale && this->text == text;
+    }
+
+private:
+    struct Line
+    {
+        uint16_t start;
+        uint16_t length;
+        int16_t x;
+        int16_t width;
+    };
+
+    String text;
+    Font *font{nullptr};
+    int box_width{0};
+    int box_height{0};
+    TextAlign align{TextAlign::left};
+    int scale{1};
+    Line line[max_lines];
+    size_t line_count{0};
+    bool clipped{false};
+};
+
+/**
+ * @brief Small cache of recently used layouts.
+ */
+class TextLayoutCache
+{
+public:
+    /**
+     * @brief Get the layout of some text, laying it out if it is not cached.
+     *
+     * The reference is valid until the next call.
+     */
+    const TextLayout &get(const String &text, Font &font, int box_width, int box_height, TextAlign align = TextAlign::left,
+        int scale = 1);
+
+private:
+    static constexpr size_t max_entries{6};
+
+    TextLayout layouts[max_entries];
+    uint32_t last_access[max_entries]{};
+    uint32_t access_clock{0};
+};
+
+#endif
@@ -0,0 +1,261 @@
+/**
+ * @file widgets.cpp
+ * @brief Named regions of the display, each redrawn on its own schedule.
+ */
+#include "widgets.h"
+
+#include <algorithm>
+#include <time.h>
+#include "bit_expansion.h"
+#include "shapes.h"
+
+namespace
+{
+    constexpr int black{0};
+    constexpr int white{1};
+
+    //!< Times before this are not set from the network; 2020-01-01.
+    constexpr time_t time_set_after{1577836800};
+
+    /**
+     * @brief Draw one line of text, as large as fits, in the middle of a widget.
+     */
+    void draw_centered(Paint &paint, const Widget &widget, const WidgetStyle &style, const String &text)
+    {
+        int scale{std::max(1, std::min<int>(widget.height / style.font->line_height(), bit_expansion_max_scale))};
+        while (scale > 1 && TextLayout::measure(text.c_str(), text.length(), *style.font, scale) > widget.width)
+        {
+            --scale;
+        }
+        auto &layout{style.layouts->get(text, *style.font, widget.width, widget.height, TextAlign::center, scale)};
+        layout.draw(paint, widget.x, widget.y + (widget.height - layout.height()) / 2, black, style.text_cache);
+    }
+
+    void render_clock(Paint &paint, const Widget &widget, const WidgetStyle &style)
+    {
+        char text[8];
+        time_t now{time(nullptr)};
+        if (now > time_set_after)
+        {
+            struct tm local;
+            localtime_r(&now, &local);
+            snprintf(text, sizeof(text), "%02d:%02d", local.tm_hour, local.tm_min);
+        }
+        else
+        {
+            // No network time; show the time since start instead.
+            uint32_t minutes{static_cast<uint32_t>(millis() / 60000)};
+            snprintf(text, sizeof(text), "+%u:%02u", static_cast<unsigned>(minutes / 60 % 100), static_cast<unsigned>(minutes % 60));
+        }
+        draw_centered(paint, widget, style, text);
+    }
+
+    void render_counter(Paint &paint, const Widget &widget, const WidgetStyle &style)
+    {
+        draw_centered(paint, widget, style, widget.text);
+    }
+
+    void render_text(Paint &paint, const Widget &widget, const WidgetStyle &style)
+    {
+        style.layouts->get(widget.text, *style.font, widget.width, widget.height)
+            .draw(paint, widget.x, widget.y, black, style.text_cache);
+    }
+
+    void render_sparkline(Paint &paint, const Widget &widget, const WidgetStyle &)
+    {
+        size_t count{widget.sample_count};
+        if (count == 0)
+        {
+            return;
+        }
+        // Oldest first.
+        size_t first{count < Widget::max_samples ? size_t{0} : size_t{widget.next_sample}};
+        auto sample = [&widget, first](size_t i)
+        {
+            return widget.samples[(first + i) % Widget::max_samples];
+        };
+        int low{sample(0)};
+        int high{low};
+        for (size_t i = 1; i < count; ++i)
+        {
+            low = std::min<int>(low, sample(i));
+            high = std::max<int>(high, sample(i));
+        }
+        int range{std::max(1, high - low)};
+        int bottom{widget.y + widget.height - 1};
+        int span{widget.width - 1};
+        int previous_x{widget.x};
+        int previous_y{bottom - (sample(0) - low) * (widget.height - 1) / range};
+        if (count == 1)
+        {
+            paint.DrawHorizontalLine(widget.x, previous_y, widget.width, black);
+            return;
+        }
+        for (size_t i = 1; i < count; ++i)
+        {
+            int x{widget.x + static_cast<int>(i * span / (count - 1))};
+            int y{bottom - (sample(i) - low) * (widget.height - 1) / range};
+            draw_segment(paint, previous_x, previous_y, x, y, black);
+            previous_x = x;
+            previous_y = y;
+        }
+    }
+
+    struct TypeEntry
+    {
+        const char *name;
+        WidgetType type;
+        WidgetRender render;
+        uint32_t default_interval;
+    };
+
+    const TypeEntry widget_types[]{
+        {"clock", WidgetType::clock, render_clock, 60000},
+        {"counter", WidgetType::counter, render_counter, 0},
+        {"text", WidgetType::text, render_text, 0},
+        {"sparkline", WidgetType::sparkline, render_sparkline, 0},
+    };
+}
+
+bool WidgetBoard::parse_type(const String &name, WidgetType &type)
+{
+    for (const auto &entry : widget_types)
+    {
+        if (name == entry.name)
+        {
+            type = entry.type;
+            return true;
+        }
+    }
+    return false;
+}
+
+Widget *WidgetBoard::find(const char *name)
+{
+    for (size_t i = 0; i < widget_count; ++i)
+    {
+        if (strcmp(widgets[i].name, name) == 0)
+        {
+            return &widgets[i];
+        }
+    }
+    return nullptr;
+}
+
+bool WidgetBoard::add(const char *name, WidgetType type, int x, int y, int width, int height, uint32_t interval, WidgetRender render)
+{
+    if (*name == '\0' || strlen(name) >= Widget::max_name || width <= 0 || height <= 0 || x < 0 || y < 0)
+    {
+        return false;
+    }
+    if (type != WidgetType::custom)
+    {
+        render = nullptr;
+        for (const auto &entry : widget_types)
+        {
+            if (entry.type == type)
+            {
+                render = entry.render;
+                interval = interval != 0 ? interval : entry.default_interval;
+            }
+        }
+    }
+    if (render == nullptr)
+    {
+        return false;
+    }
+
+    Widget *widget{find(name)};
+    if (widget == nullptr)
+    {
+        if (widget_count == max_widgets)
+        {
+            return false;
+        }
+        widget = &widgets[widget_count++];
+    }
+    *widget = Widget{};
+    strcpy(widget->name, name);
+    widget->type = type;
+    widget->render = render;
+    widget->x = x;
+    widget->y = y;
+    widget->width = width;
+    widget->height = height;
+    widget->interval = interval;
+    widget->due = true;
+    return true;
+}
+
+bool WidgetBoard::remove(const char *name)
+{
+    Widget *widget{find(name)};
+    if (widget == nullptr)
+    {
+        return false;
+    }
+    // What it last drew is left on the display.
+    size_t index{static_cast<size_t>(widget - widgets)};
+    std::copy(&widgets[index + 1], &widgets[widget_count], &widgets[index]);
+    --widget_count;
+    return true;
+}
+
+bool WidgetBoard::set_value(const char *name, const char *value)
+{
+    Widget *widget{find(name)};
+    if (widget == nullptr)
+    {
+        return false;
+    }
+    if (widget->type == WidgetType::sparkline)
+    {
+        widget->samples[widget->next_sample] = static_cast<int16_t>(std::max(-32768L, std::min(atol(value), 32767L)));
+        widget->next_sample = (widget->next_sample + 1) % Widget::max_samples;
+        widget->sample_count = std::min<size_t>(widget->sample_count + 1, Widget::max_samples);
+    }
+    strncpy(widget->text, value, Widget::max_text - 1);
+    widget->text[Widget::max_text - 1] = '\0';
+    widget->due = true;
+    return true;
+}
+
+void WidgetBoard::invalidate()
+{
+    for (size_t i = 0; i < widget_count; ++i)
+    {
+        widgets[i].due = true;
+    }
+}
+
+void WidgetBoard::draw(Paint &paint, Widget &widget, const WidgetStyle &style, uint32_t now)
+{
+    paint.DrawFilledRectangle(widget.x, widget.y, widget.x + widget.width - 1, widget.y + widget.height - 1, white);
+    widget.render(paint, widget, style);
+    widget.last_drawn = now;
+    widget.due = false;
+}
+
+void WidgetBoard::draw_all(Paint &paint, const WidgetStyle &style, uint32_t now)
+{
+    for (size_t i = 0; i < widget_count; ++i)
+    {
+        draw(paint, widgets[i], style, now);
+    }
+}
+
+int WidgetBoard::step(Paint &paint, const WidgetStyle &style, uint32_t now)
+{
+    int drawn{0};
+    for (size_t i = 0; i < widget_count; ++i)
+    {
+        Widget &widget{widgets[i]};
+        if (!widget.due && (widget.interval == 0 || now - widget.last_drawn < widget.interval))
+        {
+            continue;
+        }
+        draw(paint, widget, style, now);
+        ++drawn;
+    }
+    return drawn;
+}
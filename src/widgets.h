@@ -0,0 +1,134 @@
+/**
+ * @file widgets.h
+ * @brief Named regions of the display, each redrawn on its own schedule.
+ *
+ * A widget is a rectangle of the frame buffer with a render callback, an
+ * update interval, and a value pushed to it (over HTTP, for the built-in
+ * types). The scheduler redraws every widget that is due, either because its
+ * interval has passed or because it has a new value; the caller then sends
+ * what changed to the display (`FrameBuffers::present`), followed by one
+ * partial refresh. Only the bytes (8 pixel
+ * columns, as the display's frame memory is addressed) that changed are sent,
+ * so a clock whose minutes alone changed sends a few bytes of a few rows.
+ */
+#ifndef WIDGETS_H
+#define WIDGETS_H
+
+#include <Arduino.h>
+#include "epd/epdpaint.h"
+#include "font.h"
+#include "text_cache.h"
+#include "text_layout.h"
+
+enum class WidgetType : uint8_t
+{
+    clock,      //!< Time of day, or time since start if the time is not set.
+    counter,    //!< A number, large.
+    text,       //!< Wrapped text.
+    sparkline,  //!< The last values pushed, as a line.
+    custom      //!< Drawn by a callback given to `WidgetBoard::add`.
+};
+
+struct WidgetStyle
+{
+    Font *font;
+    TextLayoutCache *layouts;
+    TextCache *text_cache;
+};
+
+struct Widget;
+
+/**
+ * @brief Draw a widget; its rectangle has been cleared to white.
+ */
+typedef void (*WidgetRender)(Paint &paint, const Widget &widget, const WidgetStyle &style);
+
+struct Widget
+{
+    static constexpr size_t max_name{16};
+    static constexpr size_t max_text{32};
+    static constexpr size_t max_samples{32};
+
+    char name[max_name];
+    WidgetType type;
+    WidgetRender render;
+    int16_t x;
+    int16_t y;
+    int16_t width;
+    int16_t height;
+    uint32_t interval;   //!< Between redraws, in ms; 0 to redraw only when a value is pushed.
+    uint32_t last_drawn;
+    bool due;
+    char text[max_text];             //!< Last value pushed.
+    int16_t samples[max_samples];    //!< Sparkline values, oldest first once the buffer is full.
+    uint8_t sample_count;
+    uint8_t next_sample;
+};
+
+class WidgetBoard
+{
+public:
+    static constexpr size_t max_widgets{8};
+
+    /**
+     * @brief Define a widget, replacing one of the same name.
+     *
+     * @param name     Name, up to `Widget::max_name - 1` characters.
+     * @param type     Type; for `WidgetType::custom`, @p render draws it.
+     * @param x        Left of the rectangle, in pixels.
+     * @param y        Top of the rectangle, in pixels.
+     * @param width    Of the rectangle, in pixels.
+     * @param height   Of the rectangle, in pixels.
+     * @param interval Between redraws, in ms; 0 to redraw only when a value is pushed.
+     * @param render   Render callback of a custom widget.
+     * @return false if there is no room, or the parameters are invalid.
+     */
+    bool add(const char *name, WidgetType type, int x, int y, int width, int height, uint32_t interval, WidgetRender render = nullptr);
+
+    bool remove(const char *name);
+
+    /**
+     * @brief Push a value to a widget; it is redrawn at the next step.
+     *
+     * @return false if there is no widget of the name.
+     */
+    bool set_value(const char *name, const char *value);
+
+    //!< Redraw every widget at the next step, as after the frame buffer has been redrawn.
+    void invalidate();
+
+    /**
+     * @brief Draw every widget into the frame buffer, without sending anything.
+     */
+    void draw_all(Paint &paint, const WidgetStyle &style, uint32_t now);
+
+    /**
+     * @brief Redraw the widgets that are due into the frame buffer, without sending anything.
+     *
+     * The caller sends what changed, with one refresh for them all.
+     *
+     * @return The number of widgets redrawn.
+     */
+    int step(Paint &paint, const WidgetStyle &style, uint32_t now);
+
+    size_t count() const
+    {
+        return widget_count;
+    }
+
+    const Widget &get(size_t index) const
+    {
+        return widgets[index];
+    }
+
+    static bool parse_type(const String &name, WidgetType &type);
+
+private:
+    Widget *find(const char *name);
+    void draw(Paint &paint, Widget &widget, const WidgetStyle &style, uint32_t now);
+
+    Widget widgets[max_widgets];
+    size_t widget_count{0};
+};
+
+#endif
@@ -0,0 +1,321 @@
+/**
+ * @file Arduino.h
+ * @brief Enough of the Arduino core for the native test environment.
+ *
+ * The modules under test use `String`, timing, pins and flash access. Here
+ * `String` wraps `std::string`, time comes from `std::chrono`, flash is
+ * ordinary memory, and pins are an array a test can inspect; a test can also
+ * set `arduino_pin_hook` to see every `digitalWrite` as it happens.
+ */
+#ifndef NATIVE_ARDUINO_H
+#define NATIVE_ARDUINO_H
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+
+#define PROGMEM
+#define PSTR(text) (text)
+#define F(text) (text)
+
+#define HIGH 1
+#define LOW 0
+#define INPUT 0
+#define OUTPUT 1
+#define MSBFIRST 1
+
+typedef uint8_t byte;
+typedef bool boolean;
+
+inline uint8_t pgm_read_byte(const void *address)
+{
+    return *static_cast<const uint8_t *>(address);
+}
+
+inline uint16_t pgm_read_word(const void *address)
+{
+    uint16_t value;
+    memcpy(&value, address, sizeof(value));
+    return value;
+}
+
+inline uint32_t pgm_read_dword(const void *address)
+{
+    uint32_t value;
+    memcpy(&value, address, sizeof(value));
+    return value;
+}
+
+#define memcpy_P memcpy
+#define strlen_P strlen
+
+class String
+{
+public:
+    String() = default;
+
+    String(const char *text):
+        value(text != nullptr ? text : "")
+    {
+    }
+
+    String(const std::string &text):
+        value(text)
+    {
+    }
+
+    explicit String(char c):
+        value(1, c)
+    {
+    }
+
+    explicit String(int number):
+        value(std::to_string(number))
+    {
+    }
+
+    explicit String(unsigned number):
+        value(std::to_string(number))
+    {
+    }
+
+    explicit String(long number):
+        value(std::to_string(number))
+    {
+    }
+
+    explicit String(unsigned long number):
+        value(std::to_string(number))
+    {
+    }
+
+    const char *c_str() const
+    {
+        return value.c_str();
+    }
+
+    unsigned length() const
+    {
+        return static_cast<unsigned>(value.size());
+    }
+
+    bool isEmpty() const
+    {
+        return value.empty();
+    }
+
+    bool reserve(unsigned size)
+    {
+        value.reserve(size);
+        return true;
+    }
+
+    bool concat(const char *text, unsigned length)
+    {
+        value.append(text, length);
+        return true;
+    }
+
+    bool startsWith(const String &prefix) const
+    {
+        return value.compare(0, prefix.value.size(), prefix.value) == 0;
+    }
+
+    bool endsWith(const String &suffix) const
+    {
+        return value.size() >= suffix.value.size() &&
+            value.compare(value.size() - suffix.value.size(), suffix.value.size(), suffix.value) == 0;
+    }
+
+    int indexOf(char c, unsigned from = 0) const
+    {
+        auto found{value.find(c, from)};
+        return found == std::string::npos ? -1 : static_cast<int>(found);
+    }
+
+    String substring(unsigned from, unsigned to = ~0u) const
+    {
+        if (from >= value.size())
+        {
+            return String();
+        }
+        return String(value.substr(from, to == ~0u ? std::string::npos : to - from));
+    }
+
+    long toInt() const
+    {
+        return atol(value.c_str());
+    }
+
+    char operator[](unsigned index) const
+    {
+        return value[index];
+    }
+
+    String &operator+=(const String &text)
+    {
+        value += text.value;
+        return *this;
+    }
+
+    String &operator+=(const char *text)
+    {
+        value += text;
+        return *this;
+    }
+
+    String &operator+=(char c)
+    {
+        value += c;
+        return *this;
+    }
+
+    bool operator==(const String &text) const
+    {
+        return value == text.value;
+    }
+
+    bool operator==(const char *text) const
+    {
+        return value == text;
+    }
+
+    bool operator!=(const String &text) const
+    {
+        return value != text.value;
+    }
+
+    friend String operator+(const String &left, const String &right)
+    {
+        return String(left.value + right.value);
+    }
+
+    friend String operator+(const String &left, const char *right)
+    {
+        return String(left.value + right);
+    }
+
+    friend String operator+(const char *left, const String &right)
+    {
+        return String(left + right.value);
+    }
+
+private:
+    std::string value;
+};
+
+class Print
+{
+public:
+    virtual ~Print() = default;
+
+    virtual size_t write(uint8_t c)
+    {
+        return fwrite(&c, 1, 1, stdout);
+    }
+
+    size_t print(const String &text)
+    {
+        return fwrite(text.c_str(), 1, text.length(), stdout);
+    }
+
+    size_t print(const char *text)
+    {
+        return fputs(text, stdout) >= 0 ? strlen(text) : 0;
+    }
+
+    size_t println(const String &text)
+    {
+        return print(text) + print("\n");
+    }
+
+    size_t println(const char *text = "")
+    {
+        return print(text) + print("\n");
+    }
+
+    template<typename...Args>
+    size_t printf(const char *format, Args...args)
+    {
+        return static_cast<size_t>(::printf(format, args...));
+    }
+
+    void flush()
+    {
+        fflush(stdout);
+    }
+};
+
+class HardwareSerial : public Print
+{
+public:
+    void begin(unsigned long)
+    {
+    }
+};
+
+inline HardwareSerial Serial;
+
+namespace arduino_native
+{
+    inline const auto started{std::chrono::steady_clock::now()};
+}
+
+inline unsigned long millis()
+{
+    return static_cast<unsigned long>(std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - arduino_native::started).count());
+}
+
+inline unsigned long micros()
+{
+    return static_cast<unsigned long>(std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - arduino_native::started).count());
+}
+
+inline void delay(unsigned long ms)
+{
+    std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+}
+
+inline void delayMicroseconds(unsigned int us)
+{
+    std::this_thread::sleep_for(std::chrono::microseconds(us));
+}
+
+inline void yield()
+{
+    std::this_thread::yield();
+}
+
+//!< Levels of the pins, as last written; a test may set an input's level.
+//!< Atomic, as a fake peripheral may sample them from a thread of its own.
+inline std::atomic<int> arduino_pins[64];
+//!< Called with each `digitalWrite`, after the level is recorded, if set.
+inline void (*arduino_pin_hook)(int pin, int value){nullptr};
+
+inline void pinMode(int, int)
+{
+}
+
+inline void digitalWrite(int pin, int value)
+{
+    arduino_pins[pin] = value;
+    if (arduino_pin_hook != nullptr)
+    {
+        arduino_pin_hook(pin, value);
+    }
+}
+
+inline int digitalRead(int pin)
+{
+    return arduino_pins[pin];
+}
+
+#endif
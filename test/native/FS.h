@@ -0,0 +1,141 @@
+/**
+ * @file FS.h
+ * @brief Enough of the Arduino file system API for the native test environment.
+ *
+ * Files live in memory, in `fs::FS::files`; a test adds the files it needs.
+ * Every `File::read` is recorded in `fs::FS::reads`, so a test can see how a
+ * module uses the file system as well as what it gets from it.
+ */
+#ifndef NATIVE_FS_H
+#define NATIVE_FS_H
+
+#include <Arduino.h>
+
+#include <map>
+#include <memory>
+#include <vector>
+
+namespace fs
+{
+    enum SeekMode
+    {
+        SeekSet,
+        SeekCur,
+        SeekEnd
+    };
+
+    //!< One `File::read`: where it started, and how many bytes were asked for.
+    struct FileRead
+    {
+        size_t position;
+        size_t length;
+    };
+
+    class File
+    {
+    public:
+        File() = default;
+
+        File(std::shared_ptr<std::string> data, std::vector<FileRead> *reads):
+            data(std::move(data)),
+            reads(reads)
+        {
+        }
+
+        explicit operator bool() const
+        {
+            return data != nullptr;
+        }
+
+        size_t size() const
+        {
+            return data != nullptr ? data->size() : 0;
+        }
+
+        size_t position() const
+        {
+            return offset;
+        }
+
+        bool seek(uint32_t position, SeekMode mode = SeekSet)
+        {
+            size_t base{mode == SeekSet ? 0 : mode == SeekCur ? offset : size()};
+            if (data == nullptr || base + position > size())
+            {
+                return false;
+            }
+            offset = base + position;
+            return true;
+        }
+
+        int read(uint8_t *destination, size_t length)
+        {
+            if (data == nullptr)
+            {
+                return -1;
+            }
+            reads->push_back(FileRead{offset, length});
+            length = std::min(length, size() - offset);
+            memcpy(destination, data->data() + offset, length);
+            offset += length;
+            return static_cast<int>(length);
+        }
+
+        size_t write(const uint8_t *source, size_t length)
+        {
+            if (data == nullptr)
+            {
+                return 0;
+            }
+            data->replace(offset, std::min(length, size() - offset), reinterpret_cast<const char *>(source), length);
+            offset += length;
+            return length;
+        }
+
+        void close()
+        {
+            data.reset();
+            offset = 0;
+        }
+
+    private:
+        std::shared_ptr<std::string> data;
+        std::vector<FileRead> *reads{nullptr};
+        size_t offset{0};
+    };
+
+    class FS
+    {
+    public:
+        File open(const char *path, const char *mode)
+        {
+            auto found{files.find(path)};
+            if (mode[0] == 'w')
+            {
+                auto &data{files[path]};
+                data = std::make_shared<std::string>();
+                return File(data, &reads);
+            }
+            return found != files.end() ? File(found->second, &reads) : File();
+        }
+
+        bool exists(const char *path)
+        {
+            return files.count(path) != 0;
+        }
+
+        bool remove(const char *path)
+        {
+            return files.erase(path) != 0;
+        }
+
+        //!< Contents of the files, by path.
+        std::map<std::string, std::shared_ptr<std::string>> files;
+        //!< Reads from any file, in order.
+        std::vector<FileRead> reads;
+    };
+}
+
+using fs::File;
+
+#endif
@@ -0,0 +1,12 @@
+/**
+ * @file LittleFS.h
+ * @brief The LittleFS instance, for the native test environment: an in-memory `fs::FS`.
+ */
+#ifndef NATIVE_LITTLEFS_H
+#define NATIVE_LITTLEFS_H
+
+#include <FS.h>
+
+inline fs::FS LittleFS;
+
+#endif
@@ -0,0 +1,10 @@
+/**
+ * @file pgmspace.h
+ * @brief Flash access, for the native test environment: flash is ordinary memory.
+ */
+#ifndef NATIVE_PGMSPACE_H
+#define NATIVE_PGMSPACE_H
+
+#include <Arduino.h>
+
+#endif
@@ -0,0 +1,584 @@
+/**
+ * @file test_barcode.cpp
+ * @brief Known-answer tests for the Code 128, EAN-13 and Data Matrix encoders.
+ *
+ * Expected symbols are built here from the symbology tables; Data Matrix
+ * symbols are read back through a placement of the test's own (ISO/IEC 16022
+ * annex F) and their check codewords verified by syndromes.
+ */
+#include <unity.h>
+
+#include <string>
+#include <vector>
+#include "barcode.h"
+
+namespace
+{
+    std::string row(const Barcode &barcode, int y = 0)
+    {
+        std::string modules;
+        for (int x = 0; x < barcode.width(); ++x)
+        {
+            modules += barcode.module(x, y) ? '1' : '0';
+        }
+        return modules;
+    }
+
+    //!< Code 128 symbols as bar and space widths, bar first (ISO/IEC 15417 table 1).
+    const char *const code128_widths[]{
+        "212222", "222122", "222221", "121223", "121322", "131222", "122213", "122312", "132212", "221213",
+        "221312", "231212", "112232", "122132", "122231", "113222", "123122", "123221", "223211", "221132",
+        "221231", "213212", "223112", "312131", "311222", "321122", "321221", "312212", "322112", "322211",
+        "212123", "212321", "232121", "111323", "131123", "131321", "112313", "132113", "132311", "211313",
+        "231113", "231311", "112133", "112331", "132131", "113123", "113321", "133121", "313121", "211331",
+        "231131", "213113", "213311", "213131", "311123", "311321", "331121", "312113", "312311", "332111",
+        "314111", "221411", "431111", "111224", "111422", "121124", "121421", "141122", "141221", "112214",
+        "112412", "122114", "122411", "142112", "142211", "241211", "221114", "413111", "241112", "134111",
+        "111242", "121142", "121241", "114212", "124112", "124211", "411212", "421112", "421211", "212141",
+        "214121", "412121", "111143", "111341", "131141", "114113", "114311", "411113", "411311", "113141",
+        "114131", "311141", "411131", "211412", "211214", "211232",
+    };
+
+    std::string code128_symbol(const char *widths)
+    {
+        std::string modules;
+        bool dark{true};
+        for (const char *width = widths; *width != '\0'; ++width)
+        {
+            modules.append(*width - '0', dark ? '1' : '0');
+            dark = !dark;
+        }
+        return modules;
+    }
+
+    /**
+     * @brief Split a Code 128 symbol into its values, checking the stop pattern.
+     */
+    std::vector<int> code128_values(const Barcode &barcode)
+    {
+        std::string modules{row(barcode)};
+        TEST_ASSERT_EQUAL(0, (modules.size() - 13) % 11);
+        TEST_ASSERT_EQUAL_STRING("1100011101011", modules.substr(modules.size() - 13).c_str());
+        std::vector<int> values;
+        for (size_t start = 0; start + 13 < modules.size(); start += 11)
+        {
+            std::string symbol{modules.substr(start, 11)};
+            int value{-1};
+            for (int i = 0; i < 106; ++i)
+            {
+                if (symbol == code128_symbol(code128_widths[i]))
+                {
+                    value = i;
+                }
+            }
+            TEST_ASSERT_TRUE_MESSAGE(value >= 0, symbol.c_str());
+            values.push_back(value);
+        }
+        return values;
+    }
+
+    void check_code128(const char *text, std::vector<int> expected)
+    {
+        Barcode barcode;
+        TEST_ASSERT_TRUE(barcode.encode(BarcodeType::code128, text));
+        TEST_ASSERT_EQUAL(1, barcode.height());
+        TEST_ASSERT_EQUAL(11 * (expected.size() + 1) + 13, barcode.width());
+        int checksum{expected[0]};
+        for (size_t i = 1; i < expected.size(); ++i)
+        {
+            checksum += expected[i] * i;
+        }
+        expected.push_back(checksum % 103);
+        auto values{code128_values(barcode)};
+        TEST_ASSERT_EQUAL(expected.size(), values.size());
+        for (size_t i = 0; i < expected.size(); ++i)
+        {
+            TEST_ASSERT_EQUAL(expected[i], values[i]);
+        }
+    }
+
+    std::string ean_digit(int digit, char parity)
+    {
+        const char *l_patterns[]{"0001101", "0011001", "0010011", "0111101", "0100011",
+                                 "0110001", "0101111", "0111011", "0110111", "0001011"};
+        std::string pattern{l_patterns[digit]};
+        if (parity == 'L')
+        {
+            return pattern;
+        }
+        for (auto &module : pattern)
+        {
+            module = module == '1' ? '0' : '1';
+        }
+        return parity == 'R' ? pattern : std::string(pattern.rbegin(), pattern.rend());
+    }
+
+    int gf_multiply(int x, int y)
+    {
+        int z{0};
+        for (; y != 0; y >>= 1)
+        {
+            if (y & 1)
+            {
+                z ^= x;
+            }
+            x <<= 1;
+            if (x & 0x100)
+            {
+                x ^= 0x12D;
+            }
+        }
+        return z;
+    }
+
+    /**
+     * @brief Whether a Data Matrix codeword sequence evaluates to 0 at alpha^1 to alpha^ecc.
+     */
+    bool syndromes_zero(const std::vector<int> &codewords, int ecc)
+    {
+        int root{1};
+        for (int i = 1; i <= ecc; ++i)
+        {
+            root = gf_multiply(root, 2);
+            int value{0};
+            for (int codeword : codewords)
+            {
+                value = gf_multiply(value, root) ^ codeword;
+            }
+            if (value != 0)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /**
+     * @brief Where each bit of each codeword goes in the mapping matrix, as
+     *        codeword * 8 + bit (bit 0 the most significant); -1 for the fixed
+     *        dark corner, -2 for its light neighbours.
+     */
+    class Placement
+    {
+    public:
+        explicit Placement(int size) : size(size), cells(size * size, unplaced)
+        {
+            int codeword{0};
+            int r{4};
+            int c{0};
+            do
+            {
+                if (r == size && c == 0)
+                {
+                    corner(codeword++, {{size - 1, 0}, {size - 1, 1}, {size - 1, 2}, {0, size - 2},
+                                        {0, size - 1}, {1, size - 1}, {2, size - 1}, {3, size - 1}});
+                }
+                if (r == size - 2 && c == 0 && size % 4 != 0)
+                {
+                    corner(codeword++, {{size - 3, 0}, {size - 2, 0}, {size - 1, 0}, {0, size - 4},
+                                        {0, size - 3}, {0, size - 2}, {0, size - 1}, {1, size - 1}});
+                }
+                if (r == size - 2 && c == 0 && size % 8 == 4)
+                {
+                    corner(codeword++, {{size - 3, 0}, {size - 2, 0}, {size - 1, 0}, {0, size - 2},
+                                        {0, size - 1}, {1, size - 1}, {2, size - 1}, {3, size - 1}});
+                }
+                if (r == size + 4 && c == 2 && size % 8 == 0)
+                {
+                    corner(codeword++, {{size - 1, 0}, {size - 1, size - 1}, {0, size - 3}, {0, size - 2},
+                                        {0, size - 1}, {1, size - 3}, {1, size - 2}, {1, size - 1}});
+                }
+                do
+                {
+                    if (r < size && c >= 0 && at(r, c) == unplaced)
+                    {
+                        utah(r, c, codeword++);
+                    }
+                    r -= 2;
+                    c += 2;
+                } while (r >= 0 && c < size);
+                r += 1;
+                c += 3;
+                do
+                {
+                    if (r >= 0 && c < size && at(r, c) == unplaced)
+                    {
+                        utah(r, c, codeword++);
+                    }
+                    r += 2;
+                    c -= 2;
+                } while (r < size && c >= 0);
+                r += 3;
+                c += 1;
+            } while (r < size || c < size);
+            if (at(size - 1, size - 1) == unplaced)
+            {
+                at(size - 1, size - 1) = at(size - 2, size - 2) = -1;
+                at(size - 1, size - 2) = at(size - 2, size - 1) = -2;
+            }
+            codewords = codeword;
+        }
+
+        int &at(int r, int c)
+        {
+            return cells[r * size + c];
+        }
+
+        int size;
+        int codewords{0};
+
+    private:
+        static constexpr int unplaced{-3};
+
+        void module(int r, int c, int codeword, int bit)
+        {
+            if (r < 0)
+            {
+                r += size;
+                c += 4 - ((size + 4) % 8);
+            }
+            if (c < 0)
+            {
+                c += size;
+                r += 4 - ((size + 4) % 8);
+            }
+            at(r, c) = codeword * 8 + bit;
+        }
+
+        void utah(int r, int c, int codeword)
+        {
+            const int offsets[8][2]{{-2, -2}, {-2, -1}, {-1, -2}, {-1, -1}, {-1, 0}, {0, -2}, {0, -1}, {0, 0}};
+            for (int bit = 0; bit < 8; ++bit)
+            {
+                module(r + offsets[bit][0], c + offsets[bit][1], codeword, bit);
+            }
+        }
+
+        void corner(int codeword, std::vector<std::pair<int, int>> positions)
+        {
+            for (int bit = 0; bit < 8; ++bit)
+            {
+                module(positions[bit].first, positions[bit].second, codeword, bit);
+            }
+        }
+
+        std::vector<int> cells;
+    };
+
+    /**
+     * @brief Check the finder and timing patterns of each region, and read the codewords back.
+     */
+    std::vector<int> read_datamatrix(const Barcode &barcode, int region)
+    {
+        int block{region + 2};
+        int regions{barcode.width() / block};
+        TEST_ASSERT_EQUAL(regions * block, barcode.width());
+        TEST_ASSERT_EQUAL(barcode.width(), barcode.height());
+        for (int y = 0; y < barcode.height(); ++y)
+        {
+            for (int x = 0; x < barcode.width(); ++x)
+            {
+                int region_x{x % block};
+                int region_y{y % block};
+                if (region_x == 0 || region_y == block - 1)
+                {
+                    TEST_ASSERT_TRUE(barcode.module(x, y));
+                }
+                else if (region_y == 0)
+                {
+                    TEST_ASSERT_EQUAL(region_x % 2 == 0, barcode.module(x, y));
+                }
+                else if (region_x == block - 1)
+                {
+                    TEST_ASSERT_EQUAL(region_y % 2 == 1, barcode.module(x, y));
+                }
+            }
+        }
+
+        Placement placement{regions * region};
+        std::vector<int> codewords(placement.codewords);
+        for (int r = 0; r < placement.size; ++r)
+        {
+            for (int c = 0; c < placement.size; ++c)
+            {
+                bool dark{barcode.module(c / region * block + 1 + c % region, r / region * block + 1 + r % region)};
+                int cell{placement.at(r, c)};
+                if (cell < 0)
+                {
+                    TEST_ASSERT_EQUAL(cell == -1, dark);
+                }
+                else if (dark)
+                {
+                    codewords[cell / 8] |= 0x80 >> (cell % 8);
+                }
+            }
+        }
+        return codewords;
+    }
+
+    std::vector<int> datamatrix_pads(std::vector<int> data, size_t capacity)
+    {
+        if (data.size() < capacity)
+        {
+            data.push_back(129);
+        }
+        while (data.size() < capacity)
+        {
+            int pad{129 + (149 * static_cast<int>(data.size() + 1)) % 253 + 1};
+            data.push_back(pad > 254 ? pad - 254 : pad);
+        }
+        return data;
+    }
+}
+
+void setUp()
+{
+}
+
+void tearDown()
+{
+}
+
+void test_code128_start_stop_and_check_patterns()
+{
+    Barcode barcode;
+    TEST_ASSERT_TRUE(barcode.encode(BarcodeType::code128, "PJJ123C"));
+    std::string modules{row(barcode)};
+    TEST_ASSERT_EQUAL(9 * 11 + 13, modules.size());
+    // Start B, check symbol 55, stop.
+    TEST_ASSERT_EQUAL_STRING("11010010000", modules.substr(0, 11).c_str());
+    TEST_ASSERT_EQUAL_STRING("11101000110", modules.substr(88, 11).c_str());
+    TEST_ASSERT_EQUAL_STRING("1100011101011", modules.substr(99).c_str());
+
+    TEST_ASSERT_TRUE(barcode.encode(BarcodeType::code128, "12345678"));
+    modules = row(barcode);
+    TEST_ASSERT_EQUAL(6 * 11 + 13, modules.size());
+    // Start C, check symbol 47.
+    TEST_ASSERT_EQUAL_STRING("11010011100", modules.substr(0, 11).c_str());
+    TEST_ASSERT_EQUAL_STRING("10001110110", modules.substr(55, 11).c_str());
+
+    TEST_ASSERT_TRUE(barcode.encode(BarcodeType::code128, "AB123456CD"));
+    modules = row(barcode);
+    // Code C after "AB", code B after the digits, check symbol 94.
+    TEST_ASSERT_EQUAL_STRING("10111011110", modules.substr(33, 11).c_str());
+    TEST_ASSERT_EQUAL_STRING("10111101110", modules.substr(77, 11).c_str());
+    TEST_ASSERT_EQUAL_STRING("10001011110", modules.substr(110, 11).c_str());
+}
+
+void test_code128_code_sets()
+{
+    check_code128("PJJ123C", {104, 48, 42, 42, 17, 18, 19, 35});
+    check_code128("12345678", {105, 12, 34, 56, 78});
+    check_code128("42", {105, 42});
+    check_code128("AB123456CD", {104, 33, 34, 99, 12, 34, 56, 100, 35, 36});
+    // Four digits in the middle stay in code set B.
+    check_code128("A1234B", {104, 33, 17, 18, 19, 20, 34});
+    // An odd run of digits leaves its first digit, or its last, in code set B.
+    check_code128("A12345", {104, 33, 17, 99, 23, 45});
+    check_code128("1234567", {105, 12, 34, 56, 100, 23});
+}
+
+void test_code128_every_printable_character()
+{
+    // Digits apart, so code set B carries every character.
+    std::string text;
+    for (int c = ' '; c <= 127; ++c)
+    {
+        text += static_cast<char>(c);
+        if (c >= '0' && c <= '9')
+        {
+            text += '_';
+        }
+    }
+    // In halves, as the symbol holds up to 64 symbols.
+    for (size_t start = 0; start < text.size(); start += 48)
+    {
+        std::string half{text.substr(start, 48)};
+        std::vector<int> expected{104};
+        for (char c : half)
+        {
+            expected.push_back(c - ' ');
+        }
+        check_code128(half.c_str(), expected);
+    }
+
+    // Three bars and three spaces in 11 modules, bar modules even: a single
+    // wrong width in the table breaks this.
+    for (const char *widths : code128_widths)
+    {
+        int bars{0};
+        int total{0};
+        for (int i = 0; i < 6; ++i)
+        {
+            total += widths[i] - '0';
+            bars += i % 2 == 0 ? widths[i] - '0' : 0;
+        }
+        TEST_ASSERT_EQUAL(11, total);
+        TEST_ASSERT_EQUAL(0, bars % 2);
+    }
+}
+
+void test_code128_rejects_invalid_text()
+{
+    Barcode barcode;
+    TEST_ASSERT_FALSE(barcode.encode(BarcodeType::code128, ""));
+    TEST_ASSERT_FALSE(barcode.encode(BarcodeType::code128, "A\tB"));
+    TEST_ASSERT_FALSE(barcode.encode(BarcodeType::code128, "caf\xc3\xa9"));
+    TEST_ASSERT_FALSE(barcode.encode(BarcodeType::code128, std::string(70, 'A').c_str()));
+}
+
+void test_ean13_known_symbol()
+{
+    // First digit 4 selects L G L L G G for the left half.
+    const char *parity{"LGLLGG"};
+    const char *text{"4006381333931"};
+    std::string expected{"101"};
+    for (int i = 1; i <= 6; ++i)
+    {
+        expected += ean_digit(text[i] - '0', parity[i - 1]);
+    }
+    expected += "01010";
+    for (int i = 7; i <= 12; ++i)
+    {
+        expected += ean_digit(text[i] - '0', 'R');
+    }
+    expected += "101";
+
+    Barcode barcode;
+    TEST_ASSERT_TRUE(barcode.encode(BarcodeType::ean13, text));
+    TEST_ASSERT_EQUAL(95, barcode.width());
+    TEST_ASSERT_EQUAL(1, barcode.height());
+    TEST_ASSERT_EQUAL_STRING(expected.c_str(), row(barcode).c_str());
+
+    // Without the check digit, it is computed.
+    TEST_ASSERT_TRUE(barcode.encode(BarcodeType::ean13, "400638133393"));
+    TEST_ASSERT_EQUAL_STRING(expected.c_str(), row(barcode).c_str());
+}
+
+void test_ean13_every_first_digit()
+{
+    const char *parities[]{"LLLLLL", "LLGLGG", "LLGGLG", "LLGGGL", "LGLLGG",
+                           "LGGLLG", "LGGGLL", "LGLGLG", "LGLGGL", "LGGLGL"};
+    for (int first = 0; first < 10; ++first)
+    {
+        std::string text{std::to_string(first) + "12345678901"};
+        int sum{0};
+        for (int i = 0; i < 12; ++i)
+        {
+            sum += (text[i] - '0') * (i % 2 == 0 ? 1 : 3);
+        }
+        text += static_cast<char>('0' + (10 - sum % 10) % 10);
+
+        std::string expected{"101"};
+        for (int i = 1; i <= 6; ++i)
+        {
+            expected += ean_digit(text[i] - '0', parities[first][i - 1]);
+        }
+        expected += "01010";
+        for (int i = 7; i <= 12; ++i)
+        {
+            expected += ean_digit(text[i] - '0', 'R');
+        }
+        expected += "101";
+
+        Barcode barcode;
+        TEST_ASSERT_TRUE(barcode.encode(BarcodeType::ean13, text.c_str()));
+        TEST_ASSERT_EQUAL_STRING(expected.c_str(), row(barcode).c_str());
+    }
+}
+
+void test_ean13_rejects_invalid_text()
+{
+    Barcode barcode;
+    TEST_ASSERT_FALSE(barcode.encode(BarcodeType::ean13, "4006381333932"));
+    TEST_ASSERT_FALSE(barcode.encode(BarcodeType::ean13, "40063813339a"));
+    TEST_ASSERT_FALSE(barcode.encode(BarcodeType::ean13, "40063813339"));
+    TEST_ASSERT_FALSE(barcode.encode(BarcodeType::ean13, "40063813339310"));
+}
+
+void test_datamatrix_known_symbol()
+{
+    // The ISO/IEC 16022 example: "123456" in a 10x10 symbol.
+    Barcode barcode;
+    TEST_ASSERT_TRUE(barcode.encode(BarcodeType::datamatrix, "123456"));
+    TEST_ASSERT_EQUAL(10, barcode.width());
+    auto codewords{read_datamatrix(barcode, 8)};
+    std::vector<int> expected{142, 164, 186, 114, 25, 5, 88, 102};
+    TEST_ASSERT_EQUAL(expected.size(), codewords.size());
+    for (size_t i = 0; i < expected.size(); ++i)
+    {
+        TEST_ASSERT_EQUAL(expected[i], codewords[i]);
+    }
+}
+
+void test_datamatrix_pads_and_check_codewords()
+{
+    struct Case
+    {
+        std::string text;
+        std::vector<int> data;
+        int size;
+        int region;
+        int capacity;
+        int ecc;
+    };
+    std::string letters;
+    for (int i = 0; i < 50; ++i)
+    {
+        letters += static_cast<char>('A' + i % 26);
+    }
+    std::vector<int> letter_codewords;
+    for (char c : letters)
+    {
+        letter_codewords.push_back(c + 1);
+    }
+    std::vector<Case> cases{
+        {"ABCD", {66, 67, 68, 69}, 12, 10, 5, 7},
+        {"a1\xe9" "12", {98, 50, 235, 106, 142}, 12, 10, 5, 7},
+        {"Hello, world", {73, 102, 109, 109, 112, 45, 33, 120, 112, 115, 109, 101}, 16, 14, 12, 12},
+        {letters, letter_codewords, 32, 14, 62, 36},
+    };
+    for (const auto &test : cases)
+    {
+        Barcode barcode;
+        TEST_ASSERT_TRUE(barcode.encode(BarcodeType::datamatrix, test.text.c_str()));
+        TEST_ASSERT_EQUAL(test.size, barcode.width());
+        auto codewords{read_datamatrix(barcode, test.region)};
+        TEST_ASSERT_EQUAL(test.capacity + test.ecc, codewords.size());
+        auto data{datamatrix_pads(test.data, test.capacity)};
+        for (int i = 0; i < test.capacity; ++i)
+        {
+            TEST_ASSERT_EQUAL(data[i], codewords[i]);
+        }
+        TEST_ASSERT_TRUE(syndromes_zero(codewords, test.ecc));
+    }
+}
+
+void test_datamatrix_largest_symbol()
+{
+    Barcode barcode;
+    TEST_ASSERT_TRUE(barcode.encode(BarcodeType::datamatrix, std::string(174, 'x').c_str()));
+    TEST_ASSERT_EQUAL(48, barcode.width());
+    auto codewords{read_datamatrix(barcode, 22)};
+    TEST_ASSERT_EQUAL(174 + 68, codewords.size());
+    TEST_ASSERT_EQUAL('x' + 1, codewords[173]);
+    TEST_ASSERT_TRUE(syndromes_zero(codewords, 68));
+
+    TEST_ASSERT_FALSE(barcode.encode(BarcodeType::datamatrix, std::string(175, 'x').c_str()));
+}
+
+int main(int, char **)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_code128_start_stop_and_check_patterns);
+    RUN_TEST(test_code128_code_sets);
+    RUN_TEST(test_code128_every_printable_character);
+    RUN_TEST(test_code128_rejects_invalid_text);
+    RUN_TEST(test_ean13_known_symbol);
+    RUN_TEST(test_ean13_every_first_digit);
+    RUN_TEST(test_ean13_rejects_invalid_text);
+    RUN_TEST(test_datamatrix_known_symbol);
+    RUN_TEST(test_datamatrix_pads_and_check_codewords);
+    RUN_TEST(test_datamatrix_largest_symbol);
+    return UNITY_END();
+}
@@ -0,0 +1,189 @@
+/**
+ * @file test_bitblit.cpp
+ * @brief The byte-span row operations, against a pixel at a time reference.
+ *
+ * Each operation is run at every destination shift (and source length, for
+ * the bit copies) over rows of varied contents; pixels outside the range
+ * must be left as they were.
+ */
+#include <unity.h>
+
+#include <vector>
+#include "bitblit.h"
+
+namespace
+{
+    constexpr int row_bytes{8};
+    constexpr int row_pixels{row_bytes * 8};
+
+    bool pixel(const uint8_t *row, int x)
+    {
+        return (row[x >> 3] & (0x80 >> (x & 7))) != 0;
+    }
+
+    void set_pixel(uint8_t *row, int x, bool value)
+    {
+        if (value)
+        {
+            row[x >> 3] |= 0x80 >> (x & 7);
+        }
+        else
+        {
+            row[x >> 3] &= ~(0x80 >> (x & 7));
+        }
+    }
+
+    std::vector<uint8_t> pattern(int seed, int length = row_bytes)
+    {
+        std::vector<uint8_t> bytes(length);
+        uint32_t state{static_cast<uint32_t>(seed) * 2654435761u + 1};
+        for (auto &byte : bytes)
+        {
+            state = state * 1103515245u + 12345u;
+            byte = static_cast<uint8_t>(state >> 16);
+        }
+        return bytes;
+    }
+
+    void check_rows(const std::vector<uint8_t> &expected, const std::vector<uint8_t> &actual, int x0, int x1)
+    {
+        for (int i = 0; i < row_bytes; ++i)
+        {
+            if (expected[i] != actual[i])
+            {
+                char message[64];
+                snprintf(message, sizeof(message), "byte %d, pixels [%d, %d)", i, x0, x1);
+                TEST_ASSERT_EQUAL_HEX8_MESSAGE(expected[i], actual[i], message);
+            }
+        }
+    }
+}
+
+void setUp()
+{
+}
+
+void tearDown()
+{
+}
+
+void test_fill_every_span()
+{
+    for (int x0 = 0; x0 < row_pixels; ++x0)
+    {
+        for (int x1 = x0; x1 <= row_pixels; ++x1)
+        {
+            for (bool set : {false, true})
+            {
+                auto row{pattern(x0 * row_pixels + x1)};
+                auto expected{row};
+                for (int x = x0; x < x1; ++x)
+                {
+                    set_pixel(expected.data(), x, set);
+                }
+                bitblit_fill(row.data(), x0, x1, set);
+                check_rows(expected, row, x0, x1);
+            }
+        }
+    }
+}
+
+void test_fill_pattern_every_span()
+{
+    for (int x0 = 0; x0 < row_pixels; ++x0)
+    {
+        for (int x1 = x0; x1 <= row_pixels; ++x1)
+        {
+            for (bool set : {false, true})
+            {
+                uint8_t fill{static_cast<uint8_t>(0x5A ^ (x0 * 3) ^ x1)};
+                auto row{pattern(x0 * row_pixels + x1)};
+                auto expected{row};
+                for (int x = x0; x < x1; ++x)
+                {
+                    if (fill & (0x80 >> (x & 7)))
+                    {
+                        set_pixel(expected.data(), x, set);
+                    }
+                }
+                bitblit_fill_pattern(row.data(), x0, x1, fill, set);
+                check_rows(expected, row, x0, x1);
+            }
+        }
+    }
+}
+
+void test_copy_span_every_span()
+{
+    for (int x0 = 0; x0 < row_pixels; ++x0)
+    {
+        for (int x1 = x0; x1 <= row_pixels; ++x1)
+        {
+            auto row{pattern(x0 * row_pixels + x1)};
+            auto source{pattern(x0 + x1 * row_pixels + 7)};
+            auto expected{row};
+            for (int x = x0; x < x1; ++x)
+            {
+                set_pixel(expected.data(), x, pixel(source.data(), x));
+            }
+            bitblit_copy_span(row.data(), source.data(), x0, x1);
+            check_rows(expected, row, x0, x1);
+        }
+    }
+}
+
+void test_copy_bits_every_shift_and_length()
+{
+    for (int x = 0; x < row_pixels; ++x)
+    {
+        for (int count = 0; x + count <= row_pixels; ++count)
+        {
+            auto row{pattern(x * row_pixels + count)};
+            // Exactly the source bytes the run needs.
+            auto source{pattern(count * row_pixels + x + 3, (count + 7) / 8)};
+            auto expected{row};
+            for (int i = 0; i < count; ++i)
+            {
+                set_pixel(expected.data(), x + i, pixel(source.data(), i));
+            }
+            bitblit_copy_bits(row.data(), x, source.data(), count);
+            check_rows(expected, row, x, x + count);
+        }
+    }
+}
+
+void test_merge_bits_every_shift_and_length()
+{
+    for (int x = 0; x < row_pixels; ++x)
+    {
+        for (int count = 0; x + count <= row_pixels; ++count)
+        {
+            for (bool set : {false, true})
+            {
+                auto row{pattern(x * row_pixels + count)};
+                auto source{pattern(count * row_pixels + x + 5, (count + 7) / 8)};
+                auto expected{row};
+                for (int i = 0; i < count; ++i)
+                {
+                    if (pixel(source.data(), i))
+                    {
+                        set_pixel(expected.data(), x + i, set);
+                    }
+                }
+                bitblit_merge_bits(row.data(), x, source.data(), count, set);
+                check_rows(expected, row, x, x + count);
+            }
+        }
+    }
+}
+
+int main(int, char **)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_fill_every_span);
+    RUN_TEST(test_fill_pattern_every_span);
+    RUN_TEST(test_copy_span_every_span);
+    RUN_TEST(test_copy_bits_every_shift_and_length);
+    RUN_TEST(test_merge_bits_every_shift_and_length);
+    return UNITY_END();
+}
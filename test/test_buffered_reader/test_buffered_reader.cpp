@@ -0,0 +1,193 @@
+/**
+ * @file test_buffered_reader.cpp
+ * @brief BufferedReader against an in-memory file: the bytes it returns, and
+ *        the block-aligned reads it makes to get them.
+ */
+#include <unity.h>
+
+#include <LittleFS.h>
+#include <string>
+#include "buffered_reader.h"
+
+namespace
+{
+    constexpr size_t file_size{10000};
+    const char *const filename{"/test.bin"};
+
+    BufferedReader reader;
+
+    uint8_t byte_at(size_t position)
+    {
+        return static_cast<uint8_t>(position * 31 + position / 251);
+    }
+
+    void check_bytes(const uint8_t *data, size_t position, size_t length)
+    {
+        TEST_ASSERT_NOT_NULL(data);
+        for (size_t i = 0; i < length; ++i)
+        {
+            TEST_ASSERT_EQUAL(byte_at(position + i), data[i]);
+        }
+    }
+
+    void check_read_positions(std::initializer_list<size_t> positions)
+    {
+        TEST_ASSERT_EQUAL(positions.size(), LittleFS.reads.size());
+        size_t i{0};
+        for (size_t position : positions)
+        {
+            TEST_ASSERT_EQUAL(position, LittleFS.reads[i++].position);
+        }
+    }
+
+    void check_aligned_reads()
+    {
+        for (const auto &read : LittleFS.reads)
+        {
+            TEST_ASSERT_EQUAL(0, read.position % BufferedReader::block_size);
+            TEST_ASSERT_TRUE(read.length <= BufferedReader::buffer_size ||
+                             read.length % BufferedReader::block_size == 0);
+        }
+    }
+}
+
+void setUp()
+{
+    std::string data(file_size, '\0');
+    for (size_t i = 0; i < file_size; ++i)
+    {
+        data[i] = static_cast<char>(byte_at(i));
+    }
+    LittleFS.files.clear();
+    LittleFS.files[filename] = std::make_shared<std::string>(data);
+    TEST_ASSERT_TRUE(reader.open(filename));
+    LittleFS.reads.clear();
+}
+
+void tearDown()
+{
+    reader.close();
+}
+
+void test_open_missing_file()
+{
+    BufferedReader missing;
+    TEST_ASSERT_FALSE(missing.open("/missing.bin"));
+    TEST_ASSERT_FALSE(missing.is_open());
+    TEST_ASSERT_NULL(missing.peek(1));
+}
+
+void test_forward_reads_whole_buffers()
+{
+    TEST_ASSERT_EQUAL(file_size, reader.size());
+    size_t position{0};
+    while (position + 7 <= file_size)
+    {
+        check_bytes(reader.peek(7), position, 7);
+        reader.consume(7);
+        position += 7;
+    }
+    TEST_ASSERT_EQUAL(position, reader.position());
+    // A whole buffer per read; a field straddling the end of the buffer
+    // starts the next one at the block it is in.
+    check_read_positions({0, 1536, 3584, 5120, 7168, 8704});
+    check_aligned_reads();
+}
+
+void test_backward_reads_preceding_data()
+{
+    // Rows of a bottom-up image, last first.
+    constexpr size_t row{100};
+    reader.set_direction(BufferedReader::Direction::backward);
+    for (size_t position = file_size - row;; position -= row)
+    {
+        TEST_ASSERT_TRUE(reader.seek(position));
+        check_bytes(reader.peek(row), position, row);
+        if (position < row)
+        {
+            break;
+        }
+    }
+    // The buffer ends at the block after each row, so it holds the rows before it.
+    check_read_positions({8192, 6656, 5120, 3584, 2048, 512, 0});
+    check_aligned_reads();
+}
+
+void test_unaligned_fallback()
+{
+    // A whole buffer's worth from an unaligned position can't be block aligned.
+    TEST_ASSERT_TRUE(reader.seek(100));
+    check_bytes(reader.peek(BufferedReader::buffer_size), 100, BufferedReader::buffer_size);
+    TEST_ASSERT_EQUAL(1, LittleFS.reads.size());
+    TEST_ASSERT_EQUAL(100, LittleFS.reads[0].position);
+
+    TEST_ASSERT_NULL(reader.peek(BufferedReader::buffer_size + 1));
+}
+
+void test_large_read_bypasses_the_buffer()
+{
+    TEST_ASSERT_TRUE(reader.seek(100));
+    check_bytes(reader.peek(4), 100, 4);
+
+    // The buffered bytes, then whole blocks straight into the destination,
+    // then the rest through the buffer.
+    std::string destination(7000, '\0');
+    auto data{reinterpret_cast<uint8_t *>(&destination[0])};
+    TEST_ASSERT_EQUAL(destination.size(), reader.read(data, destination.size()));
+    check_bytes(data, 100, destination.size());
+    TEST_ASSERT_EQUAL(7100, reader.position());
+    TEST_ASSERT_EQUAL(3, LittleFS.reads.size());
+    TEST_ASSERT_EQUAL(2048, LittleFS.reads[1].position);
+    TEST_ASSERT_EQUAL(4608, LittleFS.reads[1].length);
+    check_aligned_reads();
+}
+
+void test_small_reads_and_values()
+{
+    uint8_t bytes[10];
+    for (size_t position = 0; position < 3000; position += sizeof(bytes))
+    {
+        TEST_ASSERT_EQUAL(sizeof(bytes), reader.read(bytes, sizeof(bytes)));
+        check_bytes(bytes, position, sizeof(bytes));
+    }
+    TEST_ASSERT_EQUAL(2, LittleFS.reads.size());
+
+    uint32_t value;
+    TEST_ASSERT_TRUE(reader.seek(2046));
+    TEST_ASSERT_TRUE(reader.read(value));
+    uint32_t expected;
+    uint8_t expected_bytes[4]{byte_at(2046), byte_at(2047), byte_at(2048), byte_at(2049)};
+    memcpy(&expected, expected_bytes, sizeof(expected));
+    TEST_ASSERT_EQUAL(expected, value);
+    TEST_ASSERT_EQUAL(2050, reader.position());
+}
+
+void test_end_of_file()
+{
+    TEST_ASSERT_TRUE(reader.seek(file_size));
+    TEST_ASSERT_FALSE(reader.seek(file_size + 1));
+    TEST_ASSERT_NULL(reader.peek(1));
+
+    TEST_ASSERT_TRUE(reader.seek(file_size - 3));
+    uint32_t value;
+    TEST_ASSERT_FALSE(reader.read(value));
+    check_bytes(reader.peek(3), file_size - 3, 3);
+
+    uint8_t bytes[8];
+    TEST_ASSERT_EQUAL(3, reader.read(bytes, sizeof(bytes)));
+    check_bytes(bytes, file_size - 3, 3);
+    TEST_ASSERT_EQUAL(0, reader.read(bytes, sizeof(bytes)));
+}
+
+int main(int, char **)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_open_missing_file);
+    RUN_TEST(test_forward_reads_whole_buffers);
+    RUN_TEST(test_backward_reads_preceding_data);
+    RUN_TEST(test_unaligned_fallback);
+    RUN_TEST(test_large_read_bypasses_the_buffer);
+    RUN_TEST(test_small_reads_and_values);
+    RUN_TEST(test_end_of_file);
+    return UNITY_END();
+}
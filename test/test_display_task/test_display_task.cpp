@@ -0,0 +1,161 @@
+/**
+ * @file test_display_task.cpp
+ * @brief The display task runs commands posted from other threads, in order, on its own thread.
+ */
+#include <unity.h>
+
+#include <atomic>
+#include <string>
+#include <thread>
+#include "display_task.h"
+
+namespace
+{
+    constexpr int command_count{500};
+
+    SharedString *status{nullptr};
+    std::atomic<int> handled{0};
+    std::atomic<int> steps{0};
+    std::atomic<bool> out_of_order{false};
+    std::thread::id handler_thread;
+    int next_index{0};
+
+    void handle(const DisplayCommand &command)
+    {
+        if (command.type != DisplayCommandType::image)
+        {
+            return;
+        }
+        if (next_index == 0)
+        {
+            handler_thread = std::this_thread::get_id();
+        }
+        if (atoi(command.file) != next_index)
+        {
+            out_of_order = true;
+        }
+        ++next_index;
+        *status = String("shown ") + command.file;
+        ++handled;
+    }
+
+    bool step()
+    {
+        ++steps;
+        return false;
+    }
+
+    bool wait_for_handled(int count)
+    {
+        for (int i = 0; i < 5000 && handled < count; ++i)
+        {
+            delay(1);
+        }
+        return handled == count;
+    }
+}
+
+void setUp()
+{
+    handled = 0;
+    steps = 0;
+    out_of_order = false;
+    next_index = 0;
+}
+
+void tearDown()
+{
+}
+
+void test_post_refuses_a_full_queue_and_a_long_name()
+{
+    DisplayTask idle{handle, step};
+    // Not started, so nothing is taken off the queue.
+    for (size_t i = 0; i < DisplayTask::queue_length; ++i)
+    {
+        TEST_ASSERT_TRUE(idle.post(DisplayCommandType::sleep));
+    }
+    TEST_ASSERT_FALSE(idle.post(DisplayCommandType::sleep));
+
+    DisplayTask other{handle, step};
+    std::string name(DisplayCommand::max_file, 'a');
+    TEST_ASSERT_FALSE(other.post(DisplayCommandType::image, name.c_str()));
+    name.pop_back();
+    TEST_ASSERT_TRUE(other.post(DisplayCommandType::image, name.c_str()));
+}
+
+void test_commands_posted_from_another_thread_run_in_order_on_the_task()
+{
+    DisplayTask display{handle, step};
+    SharedString shown{display, "idle"};
+    status = &shown;
+    display.begin();
+
+    std::atomic<bool> posting{true};
+    std::atomic<bool> torn{false};
+    std::thread::id poster_thread;
+    std::thread poster([&display, &poster_thread]()
+    {
+        poster_thread = std::this_thread::get_id();
+        for (int i = 0; i < command_count;)
+        {
+            if (display.post(DisplayCommandType::image, std::to_string(i).c_str()))
+            {
+                ++i;
+            }
+            else
+            {
+                // The queue is full; the display task empties it.
+                std::this_thread::yield();
+            }
+        }
+    });
+    // Another handler thread reads what the display task writes, under the guard.
+    std::thread reader([&shown, &posting, &torn]()
+    {
+        while (posting)
+        {
+            String value{shown.get()};
+            if (value != "idle" && !value.startsWith("shown "))
+            {
+                torn = true;
+            }
+        }
+    });
+
+    poster.join();
+    bool finished{wait_for_handled(command_count)};
+    posting = false;
+    reader.join();
+
+    TEST_ASSERT_TRUE(finished);
+    TEST_ASSERT_FALSE(out_of_order);
+    TEST_ASSERT_FALSE(torn);
+    TEST_ASSERT_TRUE(handler_thread != std::this_thread::get_id());
+    TEST_ASSERT_TRUE(handler_thread != poster_thread);
+    TEST_ASSERT_TRUE(shown.get() == String("shown ") + std::to_string(command_count - 1).c_str());
+    // The step runs between commands once the queue is empty.
+    for (int i = 0; i < 1000 && steps == 0; ++i)
+    {
+        delay(1);
+    }
+    TEST_ASSERT_TRUE(steps > 0);
+}
+
+void test_guard_is_recursive()
+{
+    DisplayTask display{handle, step};
+    display.begin();
+    DisplayTask::Guard outer{display};
+    DisplayTask::Guard inner{display};
+    TEST_ASSERT_TRUE(display.post(DisplayCommandType::clear));
+}
+
+int main(int, char **)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_post_refuses_a_full_queue_and_a_long_name);
+    RUN_TEST(test_commands_posted_from_another_thread_run_in_order_on_the_task);
+    RUN_TEST(test_guard_is_recursive);
+    return UNITY_END();
+}
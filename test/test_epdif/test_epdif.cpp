@@ -0,0 +1,168 @@
+/**
+ * @file test_epdif.cpp
+ * @brief Chip select and DC around transfers that complete asynchronously, against the fake bus.
+ *
+ * The fake bus completes queued transactions on a thread of its own, as DMA
+ * does; chip select must only rise once the last transaction of a transfer is
+ * done, and DC must not change while any is on the wire.
+ */
+#include <unity.h>
+
+#include <vector>
+#include "epd/epdif.h"
+
+namespace
+{
+    struct PinEvent
+    {
+        int pin;
+        int value;
+        unsigned int in_flight;     //!< Transactions on the wire when the pin was written.
+        unsigned int sent;          //!< Bytes sent by then.
+    };
+
+    std::vector<PinEvent> events;
+
+    void record(int pin, int value)
+    {
+        events.push_back(PinEvent{pin, value, EpdIfFakeBus::InFlight(), EpdIfFakeBus::Sent(nullptr, 0)});
+    }
+
+    std::vector<unsigned char> pattern(size_t length)
+    {
+        std::vector<unsigned char> data(length);
+        for (size_t i = 0; i < length; ++i)
+        {
+            data[i] = static_cast<unsigned char>(i * 7 + i / 256);
+        }
+        return data;
+    }
+
+    std::vector<EpdIfFakeByte> sent()
+    {
+        std::vector<EpdIfFakeByte> bytes(EpdIfFakeBus::Sent(nullptr, 0));
+        EpdIfFakeBus::Sent(bytes.data(), bytes.size());
+        return bytes;
+    }
+
+    std::vector<PinEvent> writes_of(int pin)
+    {
+        std::vector<PinEvent> found;
+        for (const auto &event : events)
+        {
+            if (event.pin == pin)
+            {
+                found.push_back(event);
+            }
+        }
+        return found;
+    }
+}
+
+void setUp()
+{
+    EpdIf::IfInit();
+    EpdIfFakeBus::Reset();
+    digitalWrite(CS_PIN, HIGH);
+    digitalWrite(DC_PIN, HIGH);
+    events.clear();
+    arduino_pin_hook = record;
+}
+
+void tearDown()
+{
+    arduino_pin_hook = nullptr;
+}
+
+void test_chip_select_rises_only_after_the_last_chunk()
+{
+    // More chunks than the queue holds, so queueing also waits for completions.
+    auto data{pattern(20000)};
+    EpdIf::SpiTransferAsync(data.data(), data.size());
+
+    // Queued, not sent: the caller is free meanwhile.
+    TEST_ASSERT_EQUAL(0, EpdIf::SpiTransferDone());
+    TEST_ASSERT_EQUAL(LOW, digitalRead(CS_PIN));
+    EpdIf::SpiWaitTransfer();
+    TEST_ASSERT_EQUAL(1, EpdIf::SpiTransferDone());
+
+    auto cs{writes_of(CS_PIN)};
+    TEST_ASSERT_EQUAL(2, cs.size());
+    TEST_ASSERT_EQUAL(LOW, cs[0].value);
+    TEST_ASSERT_EQUAL(0, cs[0].sent);
+    TEST_ASSERT_EQUAL(HIGH, cs[1].value);
+    TEST_ASSERT_EQUAL(0, cs[1].in_flight);
+    TEST_ASSERT_EQUAL(data.size(), cs[1].sent);
+
+    auto bytes{sent()};
+    TEST_ASSERT_EQUAL(data.size(), bytes.size());
+    for (size_t i = 0; i < bytes.size(); ++i)
+    {
+        TEST_ASSERT_EQUAL(data[i], bytes[i].value);
+        TEST_ASSERT_EQUAL(LOW, bytes[i].cs);
+        TEST_ASSERT_EQUAL(HIGH, bytes[i].dc);
+    }
+    TEST_ASSERT_EQUAL(0, EpdIfFakeBus::PinsChangedMidTransfer());
+}
+
+void test_dc_is_not_changed_while_a_transfer_is_pending()
+{
+    auto data{pattern(9000)};
+    EpdIf::SpiTransferAsync(data.data(), data.size());
+    // As SendCommand does next.
+    EpdIf::DigitalWrite(DC_PIN, LOW);
+    EpdIf::SpiTransfer(0x22);
+
+    auto dc{writes_of(DC_PIN)};
+    TEST_ASSERT_EQUAL(1, dc.size());
+    TEST_ASSERT_EQUAL(0, dc[0].in_flight);
+    TEST_ASSERT_EQUAL(data.size(), dc[0].sent);
+
+    auto bytes{sent()};
+    TEST_ASSERT_EQUAL(data.size() + 1, bytes.size());
+    TEST_ASSERT_EQUAL(HIGH, bytes[data.size() - 1].dc);
+    TEST_ASSERT_EQUAL(0x22, bytes[data.size()].value);
+    TEST_ASSERT_EQUAL(LOW, bytes[data.size()].dc);
+    TEST_ASSERT_EQUAL(LOW, bytes[data.size()].cs);
+    TEST_ASSERT_EQUAL(0, EpdIfFakeBus::PinsChangedMidTransfer());
+}
+
+void test_each_transfer_has_its_own_chip_select()
+{
+    auto first{pattern(5000)};
+    auto second{pattern(300)};
+    EpdIf::SpiTransferAsync(first.data(), first.size());
+    // Waits for the first transfer, and its chip select, before starting.
+    EpdIf::SpiTransferAsync(second.data(), second.size());
+    EpdIf::SpiWaitTransfer();
+
+    auto cs{writes_of(CS_PIN)};
+    TEST_ASSERT_EQUAL(4, cs.size());
+    TEST_ASSERT_EQUAL(LOW, cs[0].value);
+    TEST_ASSERT_EQUAL(HIGH, cs[1].value);
+    TEST_ASSERT_EQUAL(first.size(), cs[1].sent);
+    TEST_ASSERT_EQUAL(LOW, cs[2].value);
+    TEST_ASSERT_EQUAL(first.size(), cs[2].sent);
+    TEST_ASSERT_EQUAL(HIGH, cs[3].value);
+    TEST_ASSERT_EQUAL(first.size() + second.size(), cs[3].sent);
+    TEST_ASSERT_EQUAL(0, EpdIfFakeBus::PinsChangedMidTransfer());
+}
+
+void test_single_bytes_are_sent_at_once()
+{
+    EpdIf::SpiTransfer(0x12);
+    auto cs{writes_of(CS_PIN)};
+    TEST_ASSERT_EQUAL(2, cs.size());
+    TEST_ASSERT_EQUAL(1, cs[1].sent);
+    TEST_ASSERT_EQUAL(1, EpdIf::SpiTransferDone());
+}
+
+int main(int, char **)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_chip_select_rises_only_after_the_last_chunk);
+    RUN_TEST(test_dc_is_not_changed_while_a_transfer_is_pending);
+    RUN_TEST(test_each_transfer_has_its_own_chip_select);
+    RUN_TEST(test_single_bytes_are_sent_at_once);
+    return UNITY_END();
+}
@@ -0,0 +1,572 @@
+/**
+ * @file test_qr_encoder.cpp
+ * @brief Known answers for the stepped QR encoder, read back from the symbol.
+ *
+ * The symbol is read as a decoder would: the format information gives the ECC
+ * level and mask, the mask is removed, and the codewords are read back in the
+ * placement order of ISO/IEC 18004, then split into their blocks. The data
+ * and error correction codewords of "HELLO WORLD" at 1-Q are those worked
+ * through at thonky.com; for larger symbols every block must have zero
+ * Reed-Solomon syndromes, and the data must decode back to the text.
+ */
+#include <unity.h>
+
+#include <string>
+#include <vector>
+#include "qr_encoder.h"
+
+namespace
+{
+    struct Blocks
+    {
+        int count;          //!< Of blocks.
+        int short_count;    //!< Of blocks one data codeword shorter than the rest.
+        int short_data;     //!< Data codewords in a short block.
+        int ecc;            //!< Error correction codewords per block.
+    };
+
+    //!< Format information ECC level bits, indexed by ECC_LOW to ECC_HIGH.
+    constexpr int format_level[]{1, 0, 3, 2};
+
+    uint32_t format_bits(int ecc, int mask)
+    {
+        uint32_t data{static_cast<uint32_t>(format_level[ecc] << 3 | mask)};
+        uint32_t remainder{data};
+        for (int i = 0; i < 10; ++i)
+        {
+            remainder = (remainder << 1) ^ ((remainder >> 9) * 0x537);
+        }
+        return ((data << 10) | remainder) ^ 0x5412;
+    }
+
+    uint32_t version_bits(int version)
+    {
+        uint32_t remainder{static_cast<uint32_t>(version)};
+        for (int i = 0; i < 12; ++i)
+        {
+            remainder = (remainder << 1) ^ ((remainder >> 11) * 0x1F25);
+        }
+        return static_cast<uint32_t>(version) << 12 | remainder;
+    }
+
+    std::vector<int> alignment_positions(int version)
+    {
+        if (version == 1)
+        {
+            return {};
+        }
+        int count{version / 7 + 2};
+        int step{version == 32 ? 26 : (version * 4 + count * 2 + 1) / (count * 2 - 2) * 2};
+        std::vector<int> positions{6};
+        for (int i = 0, position = version * 4 + 10; i < count - 1; ++i, position -= step)
+        {
+            positions.insert(positions.begin() + 1, position);
+        }
+        return positions;
+    }
+
+    /**
+     * @brief A generated symbol, read as a decoder reads it.
+     */
+    class Symbol
+    {
+    public:
+        explicit Symbol(QRCode &qrcode):
+            qrcode(qrcode),
+            size(qrcode.size),
+            function(size * size, false)
+        {
+            mark_function_patterns();
+        }
+
+        bool dark(int x, int y) const
+        {
+            return qrcode_getModule(&qrcode, x, y);
+        }
+
+        //!< The first copy of the format information, next to the top left finder.
+        uint32_t format_first() const
+        {
+            uint32_t bits{0};
+            for (int i = 0; i < 6; ++i)
+            {
+                bits |= dark(8, i) << i;
+            }
+            bits |= dark(8, 7) << 6 | dark(8, 8) << 7 | dark(7, 8) << 8;
+            for (int i = 9; i < 15; ++i)
+            {
+                bits |= dark(14 - i, 8) << i;
+            }
+            return bits;
+        }
+
+        //!< The second copy, split between the other two finders.
+        uint32_t format_second() const
+        {
+            uint32_t bits{0};
+            for (int i = 0; i < 8; ++i)
+            {
+                bits |= dark(size - 1 - i, 8) << i;
+            }
+            for (int i = 8; i < 15; ++i)
+            {
+                bits |= dark(8, size - 15 + i) << i;
+            }
+            return bits;
+        }
+
+        //!< The version information below the top right finder, and its transpose.
+        bool version_information(uint32_t &below, uint32_t &beside) const
+        {
+            below = 0;
+            beside = 0;
+            for (int i = 0; i < 18; ++i)
+            {
+                int a{size - 11 + i % 3};
+                int b{i / 3};
+                below |= static_cast<uint32_t>(dark(b, a)) << i;
+                beside |= static_cast<uint32_t>(dark(a, b)) << i;
+            }
+            return below == beside;
+        }
+
+        //!< Whether a module is dark under a mask pattern.
+        static bool masked(int mask, int x, int y)
+        {
+            switch (mask)
+            {
+            case 0: return (x + y) % 2 == 0;
+            case 1: return y % 2 == 0;
+            case 2: return x % 3 == 0;
+            case 3: return (x + y) % 3 == 0;
+            case 4: return (x / 3 + y / 2) % 2 == 0;
+            case 5: return x * y % 2 + x * y % 3 == 0;
+            case 6: return (x * y % 2 + x * y % 3) % 2 == 0;
+            default: return ((x + y) % 2 + x * y % 3) % 2 == 0;
+            }
+        }
+
+        //!< The codewords, in placement order, with the mask removed.
+        std::vector<uint8_t> codewords(int mask, int total) const
+        {
+            std::vector<uint8_t> result(total, 0);
+            int index{0};
+            for (int right = size - 1; right >= 1; right -= 2)
+            {
+                if (right == 6)
+                {
+                    right = 5;
+                }
+                for (int vertical = 0; vertical < size; ++vertical)
+                {
+                    for (int j = 0; j < 2; ++j)
+                    {
+                        int x{right - j};
+                        bool upward{((right + 1) & 2) == 0};
+                        int y{upward ? size - 1 - vertical : vertical};
+                        if (function[y * size + x] || index >= total * 8)
+                        {
+                            continue;
+                        }
+                        if (dark(x, y) != masked(mask, x, y))
+                        {
+                            result[index / 8] |= 0x80 >> (index % 8);
+                        }
+                        ++index;
+                    }
+                }
+            }
+            return result;
+        }
+
+    private:
+        void mark(int x0, int y0, int width, int height)
+        {
+            for (int y = std::max(y0, 0); y < std::min(y0 + height, size); ++y)
+            {
+                for (int x = std::max(x0, 0); x < std::min(x0 + width, size); ++x)
+                {
+                    function[y * size + x] = true;
+                }
+            }
+        }
+
+        void mark_function_patterns()
+        {
+            // Finders with their separators and format information.
+            mark(0, 0, 9, 9);
+            mark(size - 8, 0, 8, 9);
+            mark(0, size - 8, 9, 8);
+            // Timing patterns.
+            mark(6, 0, 1, size);
+            mark(0, 6, size, 1);
+            auto positions{alignment_positions(qrcode.version)};
+            int count{static_cast<int>(positions.size())};
+            for (int i = 0; i < count; ++i)
+            {
+                for (int j = 0; j < count; ++j)
+                {
+                    bool on_finder{(i == 0 && j == 0) || (i == 0 && j == count - 1) || (i == count - 1 && j == 0)};
+                    if (!on_finder)
+                    {
+                        mark(positions[i] - 2, positions[j] - 2, 5, 5);
+                    }
+                }
+            }
+            if (qrcode.version >= 7)
+            {
+                mark(size - 11, 0, 3, 6);
+                mark(0, size - 11, 6, 3);
+            }
+        }
+
+        QRCode &qrcode;
+        int size;
+        std::vector<bool> function;
+    };
+
+    uint8_t gf_multiply(uint8_t a, uint8_t b)
+    {
+        int product{0};
+        for (int i = 7; i >= 0; --i)
+        {
+            product = (product << 1) ^ ((product >> 7) * 0x11D);
+            product ^= ((b >> i) & 1) * a;
+        }
+        return static_cast<uint8_t>(product);
+    }
+
+    //!< Whether a block, data then error correction, has zero syndromes.
+    bool syndromes_zero(const std::vector<uint8_t> &block, int ecc)
+    {
+        uint8_t root{1};
+        for (int i = 0; i < ecc; ++i)
+        {
+            uint8_t value{0};
+            for (uint8_t codeword : block)
+            {
+                value = gf_multiply(value, root) ^ codeword;
+            }
+            if (value != 0)
+            {
+                return false;
+            }
+            root = gf_multiply(root, 2);
+        }
+        return true;
+    }
+
+    //!< Split interleaved codewords into blocks; short blocks come first.
+    std::vector<std::vector<uint8_t>> deinterleave(const std::vector<uint8_t> &codewords, const Blocks &blocks)
+    {
+        std::vector<std::vector<uint8_t>> result(blocks.count);
+        size_t index{0};
+        for (int i = 0; i <= blocks.short_data; ++i)
+        {
+            for (int b = 0; b < blocks.count; ++b)
+            {
+                if (i < blocks.short_data || b >= blocks.short_count)
+                {
+                    result[b].push_back(codewords[index++]);
+                }
+            }
+        }
+        for (int i = 0; i < blocks.ecc; ++i)
+        {
+            for (int b = 0; b < blocks.count; ++b)
+            {
+                result[b].push_back(codewords[index++]);
+            }
+        }
+        return result;
+    }
+
+    class BitReader
+    {
+    public:
+        explicit BitReader(const std::vector<uint8_t> &data) : data(data)
+        {
+        }
+
+        uint32_t read(int count)
+        {
+            uint32_t value{0};
+            for (int i = 0; i < count; ++i, ++position)
+            {
+                value = value << 1 | ((data[position / 8] >> (7 - position % 8)) & 1);
+            }
+            return value;
+        }
+
+    private:
+        const std::vector<uint8_t> &data;
+        size_t position{0};
+    };
+
+    //!< Decode the data codewords of a single segment symbol.
+    std::string decode(const std::vector<uint8_t> &data, int version)
+    {
+        static const char alphanumeric[]{"0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ $%*+-./:"};
+        int size_class{version < 10 ? 0 : version < 27 ? 1 : 2};
+        BitReader reader{data};
+        std::string text;
+        switch (reader.read(4))
+        {
+        case 1:
+        {
+            static constexpr int count_bits[]{10, 12, 14};
+            for (uint32_t left = reader.read(count_bits[size_class]); left > 0; left -= std::min<uint32_t>(left, 3))
+            {
+                int digits{static_cast<int>(std::min<uint32_t>(left, 3))};
+                std::string group{std::to_string(reader.read(digits * 3 + 1))};
+                text += std::string(digits - group.size(), '0') + group;
+            }
+            break;
+        }
+        case 2:
+        {
+            static constexpr int count_bits[]{9, 11, 13};
+            uint32_t count{reader.read(count_bits[size_class])};
+            for (; count >= 2; count -= 2)
+            {
+                uint32_t pair{reader.read(11)};
+                text += alphanumeric[pair / 45];
+                text += alphanumeric[pair % 45];
+            }
+            if (count == 1)
+            {
+                text += alphanumeric[reader.read(6)];
+            }
+            break;
+        }
+        case 4:
+        {
+            static constexpr int count_bits[]{8, 16, 16};
+            for (uint32_t count = reader.read(count_bits[size_class]); count > 0; --count)
+            {
+                text += static_cast<char>(reader.read(8));
+            }
+            break;
+        }
+        default:
+            return "<unknown mode>";
+        }
+        return text;
+    }
+
+    /**
+     * @brief A code with its own copy of the modules.
+     *
+     * The encoder has a single work buffer, and a failed assertion leaves the
+     * test without running destructors, so it is released at once.
+     */
+    struct Generated
+    {
+        QRCode qrcode{};
+        std::vector<uint8_t> modules;
+        bool ok{false};
+
+        Generated(const char *text, uint8_t version, uint8_t ecc)
+        {
+            QrEncoder encoder;
+            ok = encoder.begin(text, version, ecc) && encoder.run() && encoder.get(qrcode);
+            if (ok)
+            {
+                modules.assign(qrcode.modules, qrcode.modules + (qrcode.size * qrcode.size + 7) / 8);
+                qrcode.modules = modules.data();
+            }
+        }
+    };
+
+    //!< Mask from the format information, checking both copies against the ECC level.
+    int read_mask(Symbol &symbol, int ecc)
+    {
+        uint32_t first{symbol.format_first()};
+        TEST_ASSERT_EQUAL(first, symbol.format_second());
+        for (int mask = 0; mask < 8; ++mask)
+        {
+            if (format_bits(ecc, mask) == first)
+            {
+                return mask;
+            }
+        }
+        TEST_FAIL_MESSAGE("format information matches no mask");
+        return -1;
+    }
+
+    /**
+     * @brief Read a symbol back, check every block, and return its data codewords.
+     */
+    std::vector<uint8_t> read_data(Generated &generated, const Blocks &blocks)
+    {
+        Symbol symbol{generated.qrcode};
+        int mask{read_mask(symbol, generated.qrcode.ecc)};
+        TEST_ASSERT_EQUAL(mask, generated.qrcode.mask);
+        int data_total{blocks.count * blocks.short_data + (blocks.count - blocks.short_count)};
+        int total{data_total + blocks.count * blocks.ecc};
+        TEST_ASSERT_EQUAL(data_total, QrEncoder::data_codewords(generated.qrcode.version, generated.qrcode.ecc));
+        auto split{deinterleave(symbol.codewords(mask, total), blocks)};
+        std::vector<uint8_t> data;
+        for (const auto &block : split)
+        {
+            TEST_ASSERT_TRUE(syndromes_zero(block, blocks.ecc));
+            data.insert(data.end(), block.begin(), block.end() - blocks.ecc);
+        }
+        return data;
+    }
+}
+
+void setUp()
+{
+}
+
+void tearDown()
+{
+}
+
+void test_format_bits_match_the_standard_table()
+{
+    static const char *const low[]{"111011111000100", "111001011110011", "111110110101010", "111100010011101",
+        "110011000101111", "110001100011000", "110110001000001", "110100101110110"};
+    static const char *const medium[]{"101010000010010", "101000100100101", "101111001111100", "101101101001011",
+        "100010111111001", "100000011001110", "100111110010111", "100101010100000"};
+    for (int mask = 0; mask < 8; ++mask)
+    {
+        TEST_ASSERT_EQUAL(strtoul(low[mask], nullptr, 2), format_bits(ECC_LOW, mask));
+        TEST_ASSERT_EQUAL(strtoul(medium[mask], nullptr, 2), format_bits(ECC_MEDIUM, mask));
+    }
+    TEST_ASSERT_EQUAL(strtoul("000111110010010100", nullptr, 2), version_bits(7));
+}
+
+void test_hello_world_matches_the_worked_example()
+{
+    // Asked for M; Q still fits in version 1, so the level is raised to it.
+    Generated generated{"HELLO WORLD", 1, ECC_MEDIUM};
+    TEST_ASSERT_TRUE(generated.ok);
+    TEST_ASSERT_EQUAL(1, generated.qrcode.version);
+    TEST_ASSERT_EQUAL(21, generated.qrcode.size);
+    TEST_ASSERT_EQUAL(ECC_QUARTILE, generated.qrcode.ecc);
+    TEST_ASSERT_EQUAL(MODE_ALPHANUMERIC, generated.qrcode.mode);
+
+    Symbol symbol{generated.qrcode};
+    int mask{read_mask(symbol, ECC_QUARTILE)};
+    static const uint8_t expected[]{32, 91, 11, 120, 209, 114, 220, 77, 67, 64, 236, 17, 236,
+        168, 72, 22, 82, 217, 54, 156, 0, 46, 15, 180, 122, 16};
+    auto codewords{symbol.codewords(mask, sizeof(expected))};
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(expected, codewords.data(), sizeof(expected));
+
+    // The finders, timing patterns and dark module.
+    for (int i = 0; i < 7; ++i)
+    {
+        TEST_ASSERT_TRUE(symbol.dark(i, 0));
+        TEST_ASSERT_TRUE(symbol.dark(20, i));
+        TEST_ASSERT_TRUE(symbol.dark(0, 20 - i));
+    }
+    TEST_ASSERT_TRUE(symbol.dark(3, 3));
+    TEST_ASSERT_FALSE(symbol.dark(1, 1));
+    TEST_ASSERT_FALSE(symbol.dark(7, 7));
+    for (int i = 8; i < 13; ++i)
+    {
+        TEST_ASSERT_EQUAL(i % 2 == 0, symbol.dark(i, 6));
+        TEST_ASSERT_EQUAL(i % 2 == 0, symbol.dark(6, i));
+    }
+    TEST_ASSERT_TRUE(symbol.dark(8, 13));
+}
+
+void test_version_1_medium_error_correction()
+{
+    // 18 alphanumeric characters do not fit 1-Q, so M is kept.
+    Generated generated{"HELLO WORLD 123456", 1, ECC_MEDIUM};
+    TEST_ASSERT_TRUE(generated.ok);
+    TEST_ASSERT_EQUAL(ECC_MEDIUM, generated.qrcode.ecc);
+    auto data{read_data(generated, Blocks{1, 1, 16, 10})};
+    TEST_ASSERT_EQUAL_STRING("HELLO WORLD 123456", decode(data, 1).c_str());
+}
+
+void test_hello_world_at_1_m_has_the_known_error_correction()
+{
+    // The data codewords of the worked 1-M example, encoded at the fixed level.
+    static const uint8_t data[]{32, 91, 11, 120, 209, 114, 220, 77, 67, 64, 236, 17, 236, 17, 236, 17};
+    static const uint8_t ecc[]{196, 35, 39, 119, 235, 215, 231, 226, 93, 23};
+    std::vector<uint8_t> block(data, data + sizeof(data));
+    block.insert(block.end(), ecc, ecc + sizeof(ecc));
+    TEST_ASSERT_TRUE(syndromes_zero(block, sizeof(ecc)));
+    block.back() ^= 1;
+    TEST_ASSERT_FALSE(syndromes_zero(block, sizeof(ecc)));
+}
+
+void test_version_5_blocks_at_quartile_and_high()
+{
+    // Too long for 5-H, so Q is kept.
+    const char *longer{"THE QUICK BROWN FOX JUMPS OVER THE LAZY DOG 0123456789 $%*+-./: ABCDEFGHIJ"};
+    Generated quartile{longer, 5, ECC_QUARTILE};
+    TEST_ASSERT_TRUE(quartile.ok);
+    TEST_ASSERT_EQUAL(ECC_QUARTILE, quartile.qrcode.ecc);
+    TEST_ASSERT_EQUAL_STRING(longer, decode(read_data(quartile, Blocks{4, 2, 15, 18}), 5).c_str());
+
+    const char *text{"THE QUICK BROWN FOX JUMPS OVER THE LAZY DOG 0123456789"};
+    Generated high{text, 5, ECC_HIGH};
+    TEST_ASSERT_TRUE(high.ok);
+    TEST_ASSERT_EQUAL_STRING(text, decode(read_data(high, Blocks{4, 2, 11, 22}), 5).c_str());
+}
+
+void test_version_7_has_version_information()
+{
+    Generated generated{"01234567890123456789012345678901234567890123456789", 7, ECC_HIGH};
+    TEST_ASSERT_TRUE(generated.ok);
+    TEST_ASSERT_EQUAL(45, generated.qrcode.size);
+    TEST_ASSERT_EQUAL(MODE_NUMERIC, generated.qrcode.mode);
+    Symbol symbol{generated.qrcode};
+    uint32_t below;
+    uint32_t beside;
+    TEST_ASSERT_TRUE(symbol.version_information(below, beside));
+    TEST_ASSERT_EQUAL(version_bits(7), below);
+    // 7-H: four blocks of 13 data codewords and one of 14, each with 26 error correction codewords.
+    auto data{read_data(generated, Blocks{5, 4, 13, 26})};
+    TEST_ASSERT_EQUAL_STRING("01234567890123456789012345678901234567890123456789", decode(data, 7).c_str());
+}
+
+void test_version_40_low_byte_mode()
+{
+    std::string text;
+    for (int i = 0; text.size() < 2900; ++i)
+    {
+        text += "Line " + std::to_string(i) + ": the quick brown fox; ";
+    }
+    text.resize(2900);
+    Generated generated{text.c_str(), 40, ECC_LOW};
+    TEST_ASSERT_TRUE(generated.ok);
+    TEST_ASSERT_EQUAL(177, generated.qrcode.size);
+    TEST_ASSERT_EQUAL(MODE_BYTE, generated.qrcode.mode);
+    TEST_ASSERT_EQUAL(ECC_LOW, generated.qrcode.ecc);
+    auto data{read_data(generated, Blocks{25, 19, 118, 30})};
+    TEST_ASSERT_TRUE(decode(data, 40) == text);
+}
+
+void test_smallest_version_and_capacity()
+{
+    TEST_ASSERT_EQUAL(1, QrEncoder::smallest_version("HELLO WORLD", ECC_QUARTILE));
+    TEST_ASSERT_EQUAL(2, QrEncoder::smallest_version("HELLO WORLD", ECC_HIGH));
+    TEST_ASSERT_EQUAL(19, QrEncoder::data_codewords(1, ECC_LOW));
+    TEST_ASSERT_EQUAL(9, QrEncoder::data_codewords(1, ECC_HIGH));
+    TEST_ASSERT_EQUAL(2956, QrEncoder::data_codewords(40, ECC_LOW));
+    TEST_ASSERT_EQUAL(1276, QrEncoder::data_codewords(40, ECC_HIGH));
+    std::string too_long(2954, 'a');
+    TEST_ASSERT_EQUAL(0, QrEncoder::smallest_version(too_long.c_str(), ECC_LOW));
+    QrEncoder encoder;
+    TEST_ASSERT_FALSE(encoder.begin(too_long.c_str(), 40, ECC_LOW));
+}
+
+int main(int, char **)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_format_bits_match_the_standard_table);
+    RUN_TEST(test_hello_world_matches_the_worked_example);
+    RUN_TEST(test_version_1_medium_error_correction);
+    RUN_TEST(test_hello_world_at_1_m_has_the_known_error_correction);
+    RUN_TEST(test_version_5_blocks_at_quartile_and_high);
+    RUN_TEST(test_version_7_has_version_information);
+    RUN_TEST(test_version_40_low_byte_mode);
+    RUN_TEST(test_smallest_version_and_capacity);
+    return UNITY_END();
+}
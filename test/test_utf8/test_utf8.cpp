@@ -0,0 +1,149 @@
+/**
+ * @file test_utf8.cpp
+ * @brief utf8_next on every valid codepoint, and on malformed sequences.
+ *
+ * A malformed sequence must decode as U+FFFD and consume exactly one byte, so
+ * the text after it decodes as it would have on its own.
+ */
+#include <unity.h>
+
+#include <string>
+#include <vector>
+#include "font.h"
+
+namespace
+{
+    constexpr uint32_t replacement{0xFFFD};
+
+    std::string encode(uint32_t codepoint)
+    {
+        std::string bytes;
+        if (codepoint < 0x80)
+        {
+            bytes += static_cast<char>(codepoint);
+        }
+        else if (codepoint < 0x800)
+        {
+            bytes += static_cast<char>(0xC0 | (codepoint >> 6));
+            bytes += static_cast<char>(0x80 | (codepoint & 0x3F));
+        }
+        else if (codepoint < 0x10000)
+        {
+            bytes += static_cast<char>(0xE0 | (codepoint >> 12));
+            bytes += static_cast<char>(0x80 | ((codepoint >> 6) & 0x3F));
+            bytes += static_cast<char>(0x80 | (codepoint & 0x3F));
+        }
+        else
+        {
+            bytes += static_cast<char>(0xF0 | (codepoint >> 18));
+            bytes += static_cast<char>(0x80 | ((codepoint >> 12) & 0x3F));
+            bytes += static_cast<char>(0x80 | ((codepoint >> 6) & 0x3F));
+            bytes += static_cast<char>(0x80 | (codepoint & 0x3F));
+        }
+        return bytes;
+    }
+
+    /**
+     * @brief Decode a whole text; the text is copied so reading past its end is caught by sanitizers.
+     */
+    std::vector<uint32_t> decode(const std::string &text)
+    {
+        std::vector<char> bytes(text.begin(), text.end());
+        std::vector<uint32_t> codepoints;
+        const char *position{bytes.data()};
+        const char *end{bytes.data() + bytes.size()};
+        while (position < end)
+        {
+            const char *before{position};
+            codepoints.push_back(utf8_next(position, end));
+            TEST_ASSERT_TRUE(position > before && position <= end);
+        }
+        return codepoints;
+    }
+
+    void check_decode(const std::string &text, std::vector<uint32_t> expected)
+    {
+        auto codepoints{decode(text)};
+        TEST_ASSERT_EQUAL(expected.size(), codepoints.size());
+        for (size_t i = 0; i < expected.size(); ++i)
+        {
+            TEST_ASSERT_EQUAL_HEX32(expected[i], codepoints[i]);
+        }
+    }
+}
+
+void setUp()
+{
+}
+
+void tearDown()
+{
+}
+
+void test_every_valid_codepoint()
+{
+    for (uint32_t codepoint = 0; codepoint <= 0x10FFFF; ++codepoint)
+    {
+        if (codepoint >= 0xD800 && codepoint <= 0xDFFF)
+        {
+            continue;
+        }
+        std::string bytes{encode(codepoint)};
+        const char *position{bytes.data()};
+        uint32_t decoded{utf8_next(position, bytes.data() + bytes.size())};
+        if (decoded != codepoint || position != bytes.data() + bytes.size())
+        {
+            char message[48];
+            snprintf(message, sizeof(message), "U+%04X", static_cast<unsigned>(codepoint));
+            TEST_FAIL_MESSAGE(message);
+        }
+    }
+}
+
+void test_mixed_text()
+{
+    check_decode("A\xc3\xa9\xe2\x82\xac\xf0\x9f\x98\x80z", {'A', 0xE9, 0x20AC, 0x1F600, 'z'});
+}
+
+void test_malformed_sequences_consume_one_byte()
+{
+    // A lone continuation byte, and bytes that never lead.
+    check_decode("a\x80" "b", {'a', replacement, 'b'});
+    check_decode("\xbf\xf8\xfe\xff", {replacement, replacement, replacement, replacement});
+    // A lead byte without its continuation bytes.
+    check_decode("\xc3" "A", {replacement, 'A'});
+    check_decode("\xe2\x82" "A", {replacement, replacement, 'A'});
+    check_decode("\xf0\x9f\x98" "A", {replacement, replacement, replacement, 'A'});
+    // A lead byte where a continuation byte should be.
+    check_decode("\xc3\xc3\xa9", {replacement, 0xE9});
+    check_decode("\xe2\x82\xe2\x82\xac", {replacement, replacement, 0x20AC});
+    // Overlong forms.
+    check_decode("\xc0\xaf", {replacement, replacement});
+    check_decode("\xc1\xbf", {replacement, replacement});
+    check_decode("\xe0\x9f\xbf", {replacement, replacement, replacement});
+    check_decode("\xf0\x8f\xbf\xbf", {replacement, replacement, replacement, replacement});
+    // Surrogates, and beyond U+10FFFF.
+    check_decode("\xed\xa0\x80", {replacement, replacement, replacement});
+    check_decode("\xed\xbf\xbf", {replacement, replacement, replacement});
+    check_decode("\xf4\x90\x80\x80", {replacement, replacement, replacement, replacement});
+    // The values either side of the surrogates, and U+10FFFF, still decode.
+    check_decode("\xed\x9f\xbf\xee\x80\x80\xf4\x8f\xbf\xbf", {0xD7FF, 0xE000, 0x10FFFF});
+}
+
+void test_truncated_at_the_end()
+{
+    // The sequence is cut short by the end of the text, not by a terminator.
+    check_decode("\xe2\x82", {replacement, replacement});
+    check_decode("\xf0\x9f\x98", {replacement, replacement, replacement});
+    check_decode(std::string("\xc3\xa9", 1), {replacement});
+}
+
+int main(int, char **)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_every_valid_codepoint);
+    RUN_TEST(test_mixed_text);
+    RUN_TEST(test_malformed_sequences_consume_one_byte);
+    RUN_TEST(test_truncated_at_the_end);
+    return UNITY_END();
+}
@@ -0,0 +1,13 @@
+"""
+PlatformIO extra script: regenerate the built-in fonts selected in
+src/font_config.h before building; see make_font.py.
+"""
+import os
+import sys
+
+Import("env")  # noqa: F821 - provided by PlatformIO
+
+sys.path.insert(0, os.path.join(env.subst("$PROJECT_DIR"), "tools"))  # noqa: F821
+import make_font  # noqa: E402
+
+make_font.build_builtin(env.subst("$PROJECT_DIR"))  # noqa: F821
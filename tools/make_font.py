@@ -0,0 +1,313 @@
+#!/usr/bin/env python3
+"""
+Generate proportional fonts from the fixed-width Waveshare sFONT tables.
+
+Each printable ASCII glyph is trimmed to its ink, and given an advance of its
+ink width plus a gap. Latin-1 letters are composed from their base letter
+and an accent drawn above (or, for the cedilla, below) it; the base letter
+of an accented i has its dot removed.
+
+Built-in fonts: the sizes and characters selected in src/font_config.h are
+written to src/font_prop<size>.cpp as BitmapFont tables (see src/font.h),
+with repeated glyph rows removed. This runs before each build, as a
+PlatformIO extra script (tools/build_fonts.py); a file is only rewritten if
+its contents change.
+
+    make_font.py [project directory]
+
+Font files: a font file to upload and load with FileFont (see
+src/file_font.h), with every character.
+
+    make_font.py <source font .c> <output .epf>
+
+e.g.  tools/make_font.py src/epd/font24.c title.epf
+"""
+import os
+import re
+import struct
+import sys
+
+# Accents, as rows of pixels; each is centred over the ink of its base letter.
+ACCENTS = {
+    'grave': ['##...', '..##.'],
+    'acute': ['...##', '.##..'],
+    'circumflex': ['.###.', '##.##'],
+    'tilde': ['.##.#', '#.##.'],
+    'diaeresis': ['##.##', '##.##'],
+    'ring': ['.###.', '##.##', '.###.'],
+    'cedilla': ['..##', '.##.'],
+}
+
+# Latin-1 characters composed from a base letter and an accent.
+COMPOSED = {
+    0xC0: ('A', 'grave'), 0xC1: ('A', 'acute'), 0xC2: ('A', 'circumflex'), 0xC3: ('A', 'tilde'),
+    0xC4: ('A', 'diaeresis'), 0xC5: ('A', 'ring'), 0xC7: ('C', 'cedilla'),
+    0xC8: ('E', 'grave'), 0xC9: ('E', 'acute'), 0xCA: ('E', 'circumflex'), 0xCB: ('E', 'diaeresis'),
+    0xCC: ('I', 'grave'), 0xCD: ('I', 'acute'), 0xCE: ('I', 'circumflex'), 0xCF: ('I', 'diaeresis'),
+    0xD1: ('N', 'tilde'),
+    0xD2: ('O', 'grave'), 0xD3: ('O', 'acute'), 0xD4: ('O', 'circumflex'), 0xD5: ('O', 'tilde'),
+    0xD6: ('O', 'diaeresis'),
+    0xD9: ('U', 'grave'), 0xDA: ('U', 'acute'), 0xDB: ('U', 'circumflex'), 0xDC: ('U', 'diaeresis'),
+    0xDD: ('Y', 'acute'),
+    0xE0: ('a', 'grave'), 0xE1: ('a', 'acute'), 0xE2: ('a', 'circumflex'), 0xE3: ('a', 'tilde'),
+    0xE4: ('a', 'diaeresis'), 0xE5: ('a', 'ring'), 0xE7: ('c', 'cedilla'),
+    0xE8: ('e', 'grave'), 0xE9: ('e', 'acute'), 0xEA: ('e', 'circumflex'), 0xEB: ('e', 'diaeresis'),
+    0xEC: ('i', 'grave'), 0xED: ('i', 'acute'), 0xEE: ('i', 'circumflex'), 0xEF: ('i', 'diaeresis'),
+    0xF1: ('n', 'tilde'),
+    0xF2: ('o', 'grave'), 0xF3: ('o', 'acute'), 0xF4: ('o', 'circumflex'), 0xF5: ('o', 'tilde'),
+    0xF6: ('o', 'diaeresis'),
+    0xF9: ('u', 'grave'), 0xFA: ('u', 'acute'), 0xFB: ('u', 'circumflex'), 0xFC: ('u', 'diaeresis'),
+    0xFD: ('y', 'acute'), 0xFF: ('y', 'diaeresis'),
+}
+
+DEGREE = ['.##.', '#..#', '#..#', '.##.']
+
+# As in src/font_config.h.
+CHARSET_REFERENCED = 0
+CHARSET_ASCII = 1
+CHARSET_LATIN1 = 2
+
+# As in src/font.h.
+REPLACEMENT = ord('?')
+MAX_GLYPH_BYTES = 64
+
+GENERATED = re.compile(r'font_prop\d+\.cpp$')
+
+
+def load_sfont(path):
+    """Return (width, height, {character: set of (x, y) ink pixels})."""
+    source = open(path).read()
+    width, height = map(int, re.search(r'sFONT\s+\w+\s*=\s*\{\s*\w+,\s*(\d+),[^,]*?(\d+)', source, re.S).groups())
+    table = source[source.index('_Table'):]
+    table = table[table.index('{') + 1:table.index('};')]
+    table = re.sub(r'/\*.*?\*/', '', re.sub(r'//.*', '', table), flags=re.S)
+    data = [int(value, 16) for value in re.findall(r'0x[0-9A-Fa-f]+', table)]
+    row_bytes = (width + 7) // 8
+    glyphs = {}
+    for index in range(95):
+        pixels = set()
+        for y in range(height):
+            for x in range(width):
+                byte = data[(index * height + y) * row_bytes + x // 8]
+                if byte & (0x80 >> (x % 8)):
+                    pixels.add((x, y))
+        glyphs[chr(32 + index)] = pixels
+    return width, height, glyphs
+
+
+def place(pixels, rows, left, top):
+    for y, row in enumerate(rows):
+        for x, cell in enumerate(row):
+            if cell == '#':
+                pixels.add((left + x, top + y))
+
+
+def compose(glyphs, base, accent):
+    pixels = set(glyphs[base])
+    if base == 'i':
+        # Remove the dot.
+        x_height = min(y for _, y in glyphs['x'])
+        pixels = {(x, y) for x, y in pixels if y >= x_height}
+    rows = ACCENTS[accent]
+    left_ink = min(x for x, _ in pixels)
+    right_ink = max(x for x, _ in pixels)
+    left = (left_ink + right_ink + 1 - len(rows[0])) // 2
+    if accent == 'cedilla':
+        top = max(y for _, y in pixels) + 1
+    else:
+        top = min(y for _, y in pixels) - 1 - len(rows)
+    place(pixels, rows, left, top)
+    return pixels
+
+
+def build(glyphs, characters=None):
+    """Return a list of (codepoint, pixels) in codepoint order, optionally of only some characters."""
+    result = [(ord(character), pixels) for character, pixels in sorted(glyphs.items())]
+    degree = set()
+    place(degree, DEGREE, 0, min(y for _, y in glyphs['A']))
+    result.append((0xB0, degree))
+    for codepoint, (base, accent) in sorted(COMPOSED.items()):
+        result.append((codepoint, compose(glyphs, base, accent)))
+    if characters is not None:
+        result = [(codepoint, pixels) for codepoint, pixels in result if chr(codepoint) in characters]
+    return result
+
+
+def encode(codepoint, pixels, width, gap):
+    """Return (metrics, bitmap bytes) of a glyph."""
+    if not pixels:
+        return (0, 0, 0, 0, (width + 1) // 2), b''
+    left = min(x for x, _ in pixels)
+    top = min(y for _, y in pixels)
+    glyph_width = max(x for x, _ in pixels) - left + 1
+    glyph_height = max(y for _, y in pixels) - top + 1
+    row_bytes = (glyph_width + 7) // 8
+    bitmap = bytearray(row_bytes * glyph_height)
+    for x, y in pixels:
+        x -= left
+        y -= top
+        bitmap[y * row_bytes + x // 8] |= 0x80 >> (x % 8)
+    return (glyph_width, glyph_height, 0, top, glyph_width + gap), bytes(bitmap)
+
+
+def character_name(codepoint):
+    if codepoint == ord('\\'):
+        return 'backslash'
+    return chr(codepoint)
+
+
+def glyph_entries(source, characters=None):
+    """Return (height, [(codepoint, metrics, bitmap)]) of a proportional version of an sFONT."""
+    width, height, glyphs = load_sfont(source)
+    gap = max(1, width // 8)
+    entries = []
+    for codepoint, pixels in build(glyphs, characters):
+        metrics, bitmap = encode(codepoint, pixels, width, gap)
+        entries.append((codepoint, metrics, bitmap))
+    return height, entries
+
+
+def deduplicate_rows(metrics, bitmap):
+    """Encode a bitmap as flags of rows repeating the row above, followed by the other rows."""
+    row_bytes = (metrics[0] + 7) // 8
+    rows = [bitmap[i * row_bytes:(i + 1) * row_bytes] for i in range(metrics[1])]
+    flags = bytearray((len(rows) + 7) // 8)
+    unique = bytearray()
+    for y, row in enumerate(rows):
+        if y > 0 and row == rows[y - 1]:
+            flags[y // 8] |= 0x80 >> (y % 8)
+        else:
+            unique += row
+    return bytes(flags + unique)
+
+
+def write_file_font(output, height, entries):
+    """Write a font file for FileFont."""
+    with open(output, 'wb') as file:
+        file.write(struct.pack('<4sHBB', b'EPF1', len(entries), height, 0))
+        offset = 0
+        for codepoint, metrics, bitmap in entries:
+            file.write(struct.pack('<IHBBbbBB', offset, codepoint, *metrics, 0))
+            offset += len(bitmap)
+        for _, _, bitmap in entries:
+            file.write(bitmap)
+
+
+def font_source(output, name, source, height, entries):
+    """Return the source of a BitmapFont."""
+    bitmaps = bytearray()
+    index = []
+    for codepoint, metrics, bitmap in entries:
+        if len(bitmap) > MAX_GLYPH_BYTES:
+            sys.exit('%s: glyph U+%04X is larger than BitmapFont::max_glyph_bytes' % (name, codepoint))
+        index.append((codepoint, len(bitmaps), metrics))
+        bitmaps += deduplicate_rows(metrics, bitmap)
+    if len(bitmaps) > 0xFFFF:
+        sys.exit('%s: bitmap table too large' % name)
+    direct_count = 0
+    while direct_count < len(index) and index[direct_count][0] == index[0][0] + direct_count:
+        direct_count += 1
+
+    lines = [
+        '/**',
+        ' * @file %s' % os.path.basename(output),
+        ' * @brief Proportional font %s, generated from %s by tools/make_font.py.' % (name, os.path.basename(source)),
+        ' *',
+        ' * Do not edit; see font_config.h.',
+        ' */',
+        '#include "font.h"',
+        '',
+        'namespace',
+        '{',
+        '    const uint8_t bitmaps[] PROGMEM = {',
+    ]
+    for start in range(0, len(bitmaps), 16):
+        lines.append('        ' + ' '.join('0x%02X,' % byte for byte in bitmaps[start:start + 16]))
+    lines += ['    };', '', '    const FontGlyph glyphs[] PROGMEM = {']
+    for codepoint, offset, metrics in index:
+        lines.append('        {0x%04X, %5d, {%2d, %2d, %d, %2d, %2d}},  // %s' %
+                     ((codepoint, offset) + metrics + (character_name(codepoint),)))
+    lines += ['    };', '}', '']
+    lines.append('BitmapFont %s{glyphs, sizeof(glyphs) / sizeof(glyphs[0]), bitmaps, %d, 0x%04X, %d};' %
+                 (name, height, index[0][0] if index else 0, direct_count))
+    return '\n'.join(lines) + '\n'
+
+
+def read_config(project):
+    """Return the #defines of src/font_config.h."""
+    defines = {}
+    with open(os.path.join(project, 'src', 'font_config.h'), encoding='utf-8') as file:
+        for line in file:
+            match = re.match(r'\s*#define\s+(\w+)\s+(".*?"|\w+)', line)
+            if match:
+                defines[match.group(1)] = match.group(2)
+    for name, value in defines.items():
+        if value in defines:
+            defines[name] = defines[value]
+    return defines
+
+
+def literal_characters(project):
+    """Return the characters of the string literals in src, other than in generated files."""
+    characters = set()
+    source_dir = os.path.join(project, 'src')
+    for directory, _, files in os.walk(source_dir):
+        for file_name in files:
+            if not file_name.endswith(('.cpp', '.h')) or GENERATED.match(file_name):
+                continue
+            with open(os.path.join(directory, file_name), encoding='utf-8') as file:
+                text = file.read()
+            for literal in re.findall(r'"((?:[^"\\\n]|\\.)*)"', text):
+                characters.update(re.sub(r'\\.', '', literal))
+    return characters
+
+
+def build_builtin(project):
+    """Generate the built-in fonts selected in src/font_config.h."""
+    config = read_config(project)
+    sizes = config['FONT_SIZES'].strip('"').split()
+    charset = int(config['FONT_CHARSET'])
+    if charset == CHARSET_REFERENCED:
+        characters = literal_characters(project)
+        characters.update(config['FONT_EXTRA_CHARACTERS'].strip('"'))
+        characters.add(chr(REPLACEMENT))
+    elif charset == CHARSET_ASCII:
+        characters = set(chr(codepoint) for codepoint in range(32, 127))
+    else:
+        characters = None
+
+    source_dir = os.path.join(project, 'src')
+    wanted = set()
+    for size in sizes:
+        name = 'Prop%s' % size
+        output = os.path.join(source_dir, 'font_prop%s.cpp' % size)
+        source = os.path.join(source_dir, 'epd', 'font%s.c' % size)
+        height, entries = glyph_entries(source, characters)
+        text = font_source(output, name, source, height, entries)
+        wanted.add(os.path.basename(output))
+        if os.path.exists(output):
+            with open(output, encoding='utf-8') as file:
+                if file.read() == text:
+                    continue
+        print('Generating %s: %d glyphs' % (os.path.basename(output), len(entries)))
+        with open(output, 'w', encoding='utf-8') as file:
+            file.write(text)
+    for file_name in os.listdir(source_dir):
+        if GENERATED.match(file_name) and file_name not in wanted:
+            print('Removing %s' % file_name)
+            os.remove(os.path.join(source_dir, file_name))
+
+
+def main():
+    if len(sys.argv) == 3:
+        source, output = sys.argv[1:]
+        height, entries = glyph_entries(source)
+        write_file_font(output, height, entries)
+    elif len(sys.argv) <= 2:
+        build_builtin(sys.argv[1] if len(sys.argv) == 2 else os.path.join(os.path.dirname(os.path.abspath(__file__)), '..'))
+    else:
+        sys.exit(__doc__)
+
+
+if __name__ == '__main__':
+    main()